@@ -0,0 +1,464 @@
+#include "Animation/AnimationAssets.hpp"
+#include "Animation/Easing/Easing.hpp"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+
+#if defined(SPF_CABINWALK_ENABLE_SIMD) && (defined(_M_X64) || defined(__SSE2__))
+#define SPF_CABINWALK_SIMD_DECODE 1
+#include <emmintrin.h>
+#else
+#define SPF_CABINWALK_SIMD_DECODE 0
+#endif
+
+namespace SPF_CabinWalk::AnimationAssets
+{
+    // =================================================================================================
+    // Internal State
+    // =================================================================================================
+
+    static const char G_ASSET_MAGIC[8] = "CWANIM";
+    constexpr uint32_t G_ASSET_VERSION = 2; // Version 1 files, which always store KeyRecords, still load.
+    constexpr size_t G_MAX_PATH = 260;
+    constexpr uint32_t G_CHANNEL_COUNT = 6;
+    constexpr std::chrono::seconds G_POLL_INTERVAL{1};
+
+    // The whole file, read once and never written: header | transitions | keys.
+    static std::unique_ptr<std::byte[]> g_arena;
+    static size_t g_arena_size = 0;
+    // The keys as KeyRecords: into the arena, or into g_decoded_keys for a quantized file.
+    static const KeyRecord *g_keys = nullptr;
+    static std::unique_ptr<KeyRecord[]> g_decoded_keys;
+    static char g_path[G_MAX_PATH] = {};
+    static std::filesystem::file_time_type g_loaded_write_time;
+    static std::chrono::steady_clock::time_point g_last_poll;
+
+    // =================================================================================================
+    // Internal Helpers
+    // =================================================================================================
+
+    static const AssetHeader *Header(const std::byte *arena)
+    {
+        return reinterpret_cast<const AssetHeader *>(arena);
+    }
+
+    static const TransitionRecord *Transitions(const std::byte *arena)
+    {
+        return reinterpret_cast<const TransitionRecord *>(arena + sizeof(AssetHeader));
+    }
+
+    static const std::byte *KeySection(const std::byte *arena)
+    {
+        return arena + sizeof(AssetHeader) + Header(arena)->transition_count * sizeof(TransitionRecord);
+    }
+
+    static uint64_t GetKeySectionSize(const AssetHeader &header)
+    {
+        if (header.key_format == KeyFormat::Quantized)
+        {
+            return static_cast<uint64_t>(header.transition_count) * G_CHANNEL_COUNT * sizeof(ChannelRange) +
+                   static_cast<uint64_t>(header.key_count) * QuantizedLayout::BYTES_PER_KEY;
+        }
+        return static_cast<uint64_t>(header.key_count) * sizeof(KeyRecord);
+    }
+
+    /**
+     * @brief Decodes `count` quantized values to `min + q * span / 65535`, eight at a time with SSE2.
+     * @details Both paths round identically, so a file decodes to the same keys with or without SIMD.
+     */
+    static void DecodeUnorm16(const uint16_t *quantized, uint32_t count, float min, float span, float *out)
+    {
+        uint32_t i = 0;
+#if SPF_CABINWALK_SIMD_DECODE
+        const __m128 bias = _mm_set1_ps(min);
+        const __m128 scale = _mm_set1_ps(span);
+        const __m128 steps = _mm_set1_ps(QuantizedLayout::VALUE_STEPS);
+        const __m128i zero = _mm_setzero_si128();
+        for (; i + 8 <= count; i += 8)
+        {
+            const __m128i q = _mm_loadu_si128(reinterpret_cast<const __m128i *>(quantized + i));
+            const __m128 low = _mm_cvtepi32_ps(_mm_unpacklo_epi16(q, zero));
+            const __m128 high = _mm_cvtepi32_ps(_mm_unpackhi_epi16(q, zero));
+            _mm_storeu_ps(out + i, _mm_add_ps(bias, _mm_div_ps(_mm_mul_ps(low, scale), steps)));
+            _mm_storeu_ps(out + i + 4, _mm_add_ps(bias, _mm_div_ps(_mm_mul_ps(high, scale), steps)));
+        }
+#endif
+        for (; i < count; ++i)
+        {
+            out[i] = min + static_cast<float>(quantized[i]) * span / QuantizedLayout::VALUE_STEPS;
+        }
+    }
+
+    static uint16_t QuantizeUnorm16(float value, float min, float span)
+    {
+        if (!(span > 0.0f))
+        {
+            return 0;
+        }
+        const float q = (value - min) / span * QuantizedLayout::VALUE_STEPS + 0.5f;
+        return !(q > 0.0f) ? 0 : (q >= QuantizedLayout::VALUE_STEPS ? 65535 : static_cast<uint16_t>(q));
+    }
+
+    /**
+     * @brief Expands the key columns of a quantized file image into KeyRecords.
+     * @details The image must have passed ValidateLayout(). Progress has one range for the whole file
+     *          and is decoded in one pass; values are decoded per channel run, each with its own range.
+     */
+    static std::unique_ptr<KeyRecord[]> DecodeKeys(const std::byte *arena)
+    {
+        const AssetHeader *header = Header(arena);
+        const uint32_t count = header->key_count;
+        const ChannelRange *ranges = reinterpret_cast<const ChannelRange *>(KeySection(arena));
+        const uint16_t *progress = reinterpret_cast<const uint16_t *>(ranges + header->transition_count * G_CHANNEL_COUNT);
+        const uint16_t *values = progress + count;
+        const uint8_t *easing_ids = reinterpret_cast<const uint8_t *>(values + count);
+        const uint8_t *binding_channels = easing_ids + count;
+
+        // Progress and value columns; a key that no record covers decodes to zero.
+        auto decoded = std::make_unique<float[]>(2 * static_cast<size_t>(count));
+        float *decoded_progress = decoded.get();
+        float *decoded_values = decoded_progress + count;
+        DecodeUnorm16(progress, count, 0.0f, 1.0f, decoded_progress);
+        std::memset(decoded_values, 0, count * sizeof(float));
+
+        const TransitionRecord *transitions = Transitions(arena);
+        for (uint32_t i = 0; i < header->transition_count; ++i)
+        {
+            uint32_t key = transitions[i].first_key;
+            for (uint32_t channel = 0; channel < G_CHANNEL_COUNT; ++channel)
+            {
+                const ChannelRange &range = ranges[i * G_CHANNEL_COUNT + channel];
+                const uint32_t channel_count = transitions[i].channel_key_counts[channel];
+                DecodeUnorm16(values + key, channel_count, range.min, range.span, decoded_values + key);
+                key += channel_count;
+            }
+        }
+
+        auto keys = std::make_unique<KeyRecord[]>(count);
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            keys[i] = {decoded_progress[i], decoded_values[i], easing_ids[i], static_cast<Binding>(binding_channels[i] >> 4),
+                       static_cast<uint8_t>(binding_channels[i] & 0x0F), 0};
+        }
+        return keys;
+    }
+
+    /**
+     * @brief Checks that the header and every record of a file image are in range, so readers need no checks.
+     */
+    static bool ValidateLayout(const std::byte *arena, size_t size)
+    {
+        if (size < sizeof(AssetHeader))
+        {
+            return false;
+        }
+
+        const AssetHeader *header = Header(arena);
+        if (std::memcmp(header->magic, G_ASSET_MAGIC, sizeof(header->magic)) != 0 || header->version < 1 || header->version > G_ASSET_VERSION)
+        {
+            return false;
+        }
+        if (header->key_format != KeyFormat::Float && (header->version < 2 || header->key_format != KeyFormat::Quantized))
+        {
+            return false;
+        }
+
+        const uint64_t expected = sizeof(AssetHeader) + static_cast<uint64_t>(header->transition_count) * sizeof(TransitionRecord) + GetKeySectionSize(*header);
+        if (expected != size)
+        {
+            return false;
+        }
+
+        const TransitionRecord *transitions = Transitions(arena);
+        for (uint32_t i = 0; i < header->transition_count; ++i)
+        {
+            const TransitionRecord &record = transitions[i];
+            if (record.variant > 1 || record.from == record.to)
+            {
+                return false;
+            }
+
+            uint32_t count = 0;
+            for (uint8_t channel_count : record.channel_key_counts)
+            {
+                count += channel_count;
+            }
+            if (record.first_key > header->key_count || count > header->key_count - record.first_key)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Checks that every key of a file is in range, after decoding it if it is quantized.
+     * @details Both formats get the same checks: finite values, progress within [0, 1] and, within each
+     *          channel of each record, progress that never goes back. Float files are taken as written,
+     *          so this is all that stands between a hand-edited file and the evaluator.
+     */
+    static bool ValidateKeys(const std::byte *arena, const KeyRecord *keys)
+    {
+        const AssetHeader *header = Header(arena);
+        for (uint32_t i = 0; i < header->key_count; ++i)
+        {
+            const KeyRecord &key = keys[i];
+            // Custom easing ids are assigned at runtime and mean nothing in a file.
+            if (key.easing_id >= static_cast<uint8_t>(Easing::EasingId::BuiltInCount) ||
+                static_cast<uint8_t>(key.binding) > static_cast<uint8_t>(Binding::Target) ||
+                key.source_channel >= G_CHANNEL_COUNT)
+            {
+                return false;
+            }
+            if (!std::isfinite(key.progress) || !std::isfinite(key.value) || key.progress < 0.0f || key.progress > 1.0f)
+            {
+                return false;
+            }
+        }
+
+        const TransitionRecord *transitions = Transitions(arena);
+        for (uint32_t i = 0; i < header->transition_count; ++i)
+        {
+            uint32_t key = transitions[i].first_key;
+            for (uint8_t channel_count : transitions[i].channel_key_counts)
+            {
+                for (uint32_t k = key + 1; k < key + channel_count; ++k)
+                {
+                    if (keys[k].progress < keys[k - 1].progress)
+                    {
+                        return false;
+                    }
+                }
+                key += channel_count;
+            }
+        }
+        return true;
+    }
+
+    // =================================================================================================
+    // Public Functions
+    // =================================================================================================
+
+    bool Load(const char *path)
+    {
+        if (!path || !path[0])
+        {
+            return false;
+        }
+
+        std::FILE *file = std::fopen(path, "rb");
+        if (!file)
+        {
+            return false;
+        }
+
+        std::fseek(file, 0, SEEK_END);
+        const long length = std::ftell(file);
+        std::fseek(file, 0, SEEK_SET);
+
+        bool loaded = false;
+        if (length > 0)
+        {
+            const size_t size = static_cast<size_t>(length);
+            auto arena = std::make_unique<std::byte[]>(size);
+            if (std::fread(arena.get(), 1, size, file) == size && ValidateLayout(arena.get(), size))
+            {
+                std::unique_ptr<KeyRecord[]> decoded_keys;
+                const KeyRecord *keys = reinterpret_cast<const KeyRecord *>(KeySection(arena.get()));
+                if (Header(arena.get())->key_format == KeyFormat::Quantized)
+                {
+                    decoded_keys = DecodeKeys(arena.get());
+                    keys = decoded_keys.get();
+                }
+
+                if (ValidateKeys(arena.get(), keys))
+                {
+                    g_arena = std::move(arena);
+                    g_arena_size = size;
+                    g_decoded_keys = std::move(decoded_keys);
+                    g_keys = keys;
+                    loaded = true;
+                }
+            }
+        }
+        std::fclose(file);
+
+        if (loaded)
+        {
+            std::strncpy(g_path, path, G_MAX_PATH - 1);
+            g_path[G_MAX_PATH - 1] = '\0';
+            std::error_code error;
+            g_loaded_write_time = std::filesystem::last_write_time(g_path, error);
+            g_last_poll = std::chrono::steady_clock::now();
+        }
+        return loaded;
+    }
+
+    void Unload()
+    {
+        g_arena.reset();
+        g_arena_size = 0;
+        g_keys = nullptr;
+        g_decoded_keys.reset();
+        g_path[0] = '\0';
+    }
+
+    bool IsLoaded()
+    {
+        return g_arena != nullptr;
+    }
+
+    const TransitionRecord *Find(uint8_t from, uint8_t to, uint8_t variant)
+    {
+        if (!g_arena)
+        {
+            return nullptr;
+        }
+
+        const TransitionRecord *transitions = Transitions(g_arena.get());
+        for (uint32_t i = 0; i < Header(g_arena.get())->transition_count; ++i)
+        {
+            if (transitions[i].from == from && transitions[i].to == to && transitions[i].variant == variant)
+            {
+                return &transitions[i];
+            }
+        }
+        return nullptr;
+    }
+
+    const KeyRecord *GetKeys(const TransitionRecord &record)
+    {
+        return g_keys + record.first_key;
+    }
+
+    uint32_t GetKeyCount(const TransitionRecord &record)
+    {
+        uint32_t count = 0;
+        for (uint8_t channel_count : record.channel_key_counts)
+        {
+            count += channel_count;
+        }
+        return count;
+    }
+
+    /**
+     * @brief Writes the key section of a KeyFormat::Quantized file.
+     * @return True if everything was written.
+     */
+    static bool WriteQuantizedKeys(std::FILE *file, const std::vector<TransitionRecord> &transitions, const std::vector<KeyRecord> &keys)
+    {
+        const size_t count = keys.size();
+        std::vector<ChannelRange> ranges(transitions.size() * G_CHANNEL_COUNT, ChannelRange{0.0f, 0.0f});
+        std::vector<uint16_t> values(2 * count, 0); // Progress column, then value column.
+        std::vector<uint8_t> bytes(2 * count, 0);   // Easing id column, then binding/channel column.
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            const KeyRecord &key = keys[i];
+            values[i] = QuantizeUnorm16(key.progress, 0.0f, 1.0f);
+            bytes[i] = key.easing_id;
+            bytes[count + i] = static_cast<uint8_t>(static_cast<uint8_t>(key.binding) << 4 | (key.source_channel & 0x0F));
+        }
+
+        for (size_t t = 0; t < transitions.size(); ++t)
+        {
+            uint32_t first = transitions[t].first_key;
+            for (uint32_t channel = 0; channel < G_CHANNEL_COUNT; ++channel)
+            {
+                const uint32_t end = first + transitions[t].channel_key_counts[channel];
+                if (first < end && end <= count)
+                {
+                    float min = keys[first].value;
+                    float max = min;
+                    for (uint32_t k = first + 1; k < end; ++k)
+                    {
+                        min = keys[k].value < min ? keys[k].value : min;
+                        max = keys[k].value > max ? keys[k].value : max;
+                    }
+
+                    ChannelRange &range = ranges[t * G_CHANNEL_COUNT + channel];
+                    range = {min, max - min};
+                    for (uint32_t k = first; k < end; ++k)
+                    {
+                        values[count + k] = QuantizeUnorm16(keys[k].value, range.min, range.span);
+                    }
+                }
+                first = end;
+            }
+        }
+
+        bool written = ranges.empty() || std::fwrite(ranges.data(), sizeof(ChannelRange), ranges.size(), file) == ranges.size();
+        if (written && count > 0)
+        {
+            written = std::fwrite(values.data(), sizeof(uint16_t), values.size(), file) == values.size() &&
+                      std::fwrite(bytes.data(), sizeof(uint8_t), bytes.size(), file) == bytes.size();
+        }
+        return written;
+    }
+
+    bool Save(const char *path, const std::vector<TransitionRecord> &transitions, const std::vector<KeyRecord> &keys, KeyFormat format)
+    {
+        if (!path || !path[0])
+        {
+            return false;
+        }
+
+        std::FILE *file = std::fopen(path, "wb");
+        if (!file)
+        {
+            return false;
+        }
+
+        AssetHeader header = {};
+        std::memcpy(header.magic, G_ASSET_MAGIC, sizeof(header.magic));
+        header.version = G_ASSET_VERSION;
+        header.transition_count = static_cast<uint32_t>(transitions.size());
+        header.key_count = static_cast<uint32_t>(keys.size());
+        header.key_format = format;
+
+        bool written = std::fwrite(&header, sizeof(header), 1, file) == 1;
+        if (written && !transitions.empty())
+        {
+            written = std::fwrite(transitions.data(), sizeof(TransitionRecord), transitions.size(), file) == transitions.size();
+        }
+        if (written && format == KeyFormat::Quantized)
+        {
+            written = WriteQuantizedKeys(file, transitions, keys);
+        }
+        else if (written && !keys.empty())
+        {
+            written = std::fwrite(keys.data(), sizeof(KeyRecord), keys.size(), file) == keys.size();
+        }
+        return std::fclose(file) == 0 && written;
+    }
+
+    bool HasChangedOnDisk()
+    {
+        if (!g_path[0])
+        {
+            return false;
+        }
+
+        const auto now = std::chrono::steady_clock::now();
+        if (now - g_last_poll < G_POLL_INTERVAL)
+        {
+            return false;
+        }
+        g_last_poll = now;
+
+        std::error_code error;
+        const auto write_time = std::filesystem::last_write_time(g_path, error);
+        if (error || write_time == g_loaded_write_time)
+        {
+            return false;
+        }
+
+        // Report each change once, even if the new contents then fail to load.
+        g_loaded_write_time = write_time;
+        return true;
+    }
+
+} // namespace SPF_CabinWalk::AnimationAssets
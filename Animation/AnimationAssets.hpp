@@ -0,0 +1,145 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+namespace SPF_CabinWalk::AnimationAssets
+{
+    /**
+     * @brief How a keyframe value is resolved when a transition is played.
+     */
+    enum class Binding : uint8_t
+    {
+        Absolute = 0, // `value` is used as is.
+        Start = 1,    // start_state.<source_channel> + value
+        Target = 2    // target_state.<source_channel> + value
+    };
+
+    /**
+     * @brief How the keys of an asset file are stored.
+     */
+    enum class KeyFormat : uint32_t
+    {
+        Float = 0,    // `key_count` KeyRecords.
+        Quantized = 1 // ChannelRanges and key columns; see QuantizedLayout.
+    };
+
+    /**
+     * @brief The header at the start of an animation asset file.
+     * @details It is followed by `transition_count` TransitionRecords, then the keys in `key_format`.
+     *          Version 1 files have no key format and always store KeyRecords.
+     */
+    struct AssetHeader
+    {
+        char magic[8];             // "CWANIM"
+        uint32_t version;
+        uint32_t transition_count;
+        uint32_t key_count;
+        KeyFormat key_format;
+    };
+
+    /**
+     * @brief One transition curve set. Its keys are stored channel by channel, each channel sorted by progress.
+     */
+    struct TransitionRecord
+    {
+        uint8_t from;                 // AnimationController::CameraPosition
+        uint8_t to;                   // AnimationController::CameraPosition
+        uint8_t variant;              // 1 for the shape used when more moves follow, 0 otherwise.
+        uint8_t reserved;
+        uint32_t first_key;           // Index of the first KeyRecord.
+        uint64_t duration_us;
+        uint8_t channel_key_counts[6]; // Per Animation::Channel.
+        uint8_t reserved2[2];
+    };
+
+    /**
+     * @brief One keyframe, relative to the start or target state where the curve follows them.
+     */
+    struct KeyRecord
+    {
+        float progress;
+        float value;           // Absolute value, or offset from the bound channel.
+        uint8_t easing_id;     // Easing::EasingId
+        Binding binding;
+        uint8_t source_channel; // Animation::Channel the offset applies to.
+        uint8_t reserved;
+    };
+
+    /**
+     * @brief The value range of one channel of one transition in a quantized file.
+     * @details A quantized value q decodes to `min + q * span / 65535`.
+     */
+    struct ChannelRange
+    {
+        float min;
+        float span;
+    };
+
+    /**
+     * @brief The key section of a KeyFormat::Quantized file, 6 bytes per key instead of 12.
+     * @details `transition_count * 6` ChannelRanges (per TransitionRecord, per Animation::Channel), then
+     *          the key columns, each `key_count` long and in KeyRecord order:
+     *
+     *            uint16_t progress;       // progress * 65535
+     *            uint16_t value;          // (value - range.min) / range.span * 65535
+     *            uint8_t easing_id;
+     *            uint8_t binding_channel; // binding << 4 | source_channel
+     *
+     *          Keys are decoded to KeyRecords once, on load, so readers never see the quantized form.
+     */
+    namespace QuantizedLayout
+    {
+        constexpr float VALUE_STEPS = 65535.0f;
+        constexpr uint64_t BYTES_PER_KEY = 2 * sizeof(uint16_t) + 2 * sizeof(uint8_t);
+    }
+
+    /**
+     * @brief Loads an asset file into the arena, replacing what was loaded before.
+     * @param path The asset file.
+     * @return True on success. On failure the previous contents stay loaded.
+     */
+    bool Load(const char *path);
+
+    /**
+     * @brief Drops the loaded asset.
+     */
+    void Unload();
+
+    /**
+     * @brief Checks whether an asset is loaded.
+     */
+    bool IsLoaded();
+
+    /**
+     * @brief Finds the curves of a transition in the loaded asset.
+     * @return The record, or nullptr if the asset does not override this transition.
+     */
+    const TransitionRecord *Find(uint8_t from, uint8_t to, uint8_t variant);
+
+    /**
+     * @brief Gets the keys of a record returned by Find(), decoded if the file is quantized. They stay
+     *        valid until the next Load() or Unload().
+     */
+    const KeyRecord *GetKeys(const TransitionRecord &record);
+
+    /**
+     * @brief Gets the total number of keys of a record.
+     */
+    uint32_t GetKeyCount(const TransitionRecord &record);
+
+    /**
+     * @brief Writes an asset file.
+     * @param format KeyFormat::Quantized halves the key section, at a precision of 1/65535 of the
+     *        duration and of each channel's value range.
+     * @return True on success.
+     */
+    bool Save(const char *path, const std::vector<TransitionRecord> &transitions, const std::vector<KeyRecord> &keys,
+              KeyFormat format = KeyFormat::Float);
+
+    /**
+     * @brief Checks, at most once per second, whether the loaded file changed on disk.
+     * @return True if it changed since it was loaded.
+     */
+    bool HasChangedOnDisk();
+
+} // namespace SPF_CabinWalk::AnimationAssets
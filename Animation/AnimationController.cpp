@@ -1,11 +1,30 @@
 #include "Animation/AnimationController.hpp"
 #include "SPF_CabinWalk.hpp"
 #include "Hooks/CameraHookManager.hpp"
+#include "Camera/CameraFacade.hpp"
+#include "Diagnostics/Profiler.hpp"
+#include "Diagnostics/DebugOverlay.hpp"
+#include "Diagnostics/Latency.hpp"
+#include "Input/InputQueue.hpp" // For NowMicroseconds
 #include "Animation/StandingAnimController.hpp" 
-#include <utility> // For std::pair
-#include <map>
-#include <functional>
+#include "Animation/BakedTransition.hpp"
+#include "Animation/SequenceBuilder.hpp"
+#include "Animation/AnimationAssets.hpp"
+#include "Animation/FactoryContext.hpp"
+#include "Animation/AnimationScheduler.hpp"
+#include "Animation/LayerStack.hpp"
+#include "Animation/ReversedTransition.hpp"
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <initializer_list>
+#include <iterator> // For std::size
 #include <memory>
+#include <string>
+#include <thread>
+#include <utility> // For std::swap
+#include <vector>
 
 #include "Sequences/DriverToPassenger.hpp"
 #include "Sequences/PassengerToDriver.hpp"
@@ -25,25 +44,245 @@ namespace SPF_CabinWalk::AnimationController
     static PluginContext *g_anim_ctx = nullptr;
 
     // --- New Animation System State ---
-    static std::unique_ptr<Animation::AnimationSequence> g_active_sequence = nullptr;
+    // The playing transition itself belongs to the AnimationScheduler.
     static CameraPosition g_current_pos = CameraPosition::Driver;
     static CameraPosition g_target_pos = CameraPosition::Driver;
 
-    // Factory map to store functions that create AnimationSequence objects for specific transitions
-    static std::map<
-        std::pair<CameraPosition, CameraPosition>,
-        std::function<std::unique_ptr<Animation::AnimationSequence>(const Animation::CurrentCameraState& start_state, const Animation::CurrentCameraState& target_state)>
-    > g_sequence_factory;
+    constexpr size_t POSITION_COUNT = static_cast<size_t>(CameraPosition::None);
+
+    /**
+     * @brief One cell of the transition table.
+     */
+    struct TransitionEntry
+    {
+        Animation::SequenceFactory factory = nullptr; // Null if the transition is not registered.
+        // Set if `factory` plays the transition [to][from] backwards; its bakes then share that
+        // transition's keys (see BakeTransition()).
+        const Animation::Reversal* reversal = nullptr;
+    };
+
+    // Registered transitions, indexed [from][to].
+    static TransitionEntry g_transitions[POSITION_COUNT][POSITION_COUNT];
+    // Hash of the current settings, as far as transition factories read them.
+    static uint64_t g_transition_settings_hash = 0;
+
+    /**
+     * @brief Every transition baked for one settings hash.
+     */
+    struct BakeSet
+    {
+        // Indexed [from][to][has_pending_moves]: some factories shape the last leg differently when more
+        // moves follow (e.g. DriverToStanding), so each flag gets its own bake.
+        Animation::BakedTransition baked[POSITION_COUNT][POSITION_COUNT][2];
+        // The factories the set was baked from, to spot transitions registered again while it was baking.
+        Animation::SequenceFactory factories[POSITION_COUNT][POSITION_COUNT] = {};
+        const Animation::Reversal* reversals[POSITION_COUNT][POSITION_COUNT] = {};
+        // Cells whose factory was registered again while a sequence of theirs was playing or fading out;
+        // they are skipped by new moves and reset once nothing plays from them (see ResetStaleCells).
+        bool stale[POSITION_COUNT][POSITION_COUNT] = {};
+        uint64_t settings_hash = 0;
+    };
+
+    // --- Transition Rebake ---
+    // Transitions are played from the front set. A settings change rebakes them on a worker thread into the
+    // back set, which is swapped in at the start of a frame; until then moves build their sequences directly.
+    // The set that was swapped out stays untouched while a transition from it is still playing.
+    static BakeSet g_bake_sets[2];
+    static BakeSet* g_front_bakes = &g_bake_sets[0];
+    static BakeSet* g_back_bakes = &g_bake_sets[1];
+    static bool g_back_bakes_in_use = false;
+    static std::thread g_bake_worker;
+    // The back set once the worker has finished baking it; taken by the game thread.
+    static std::atomic<BakeSet*> g_finished_bakes{nullptr};
+    static bool g_bake_running = false;
+    // Set when the front set no longer matches the settings; a rebake starts once the back set is free.
+    static bool g_rebake_pending = false;
+    // The settings the worker bakes from, copied when it starts so it never reads them while they change.
+    static AppSettings g_bake_settings;
+
+    // All-pairs fastest routes over the registered transitions, weighted by their durations.
+    // g_route_next[from][to] is the first hop of the fastest route, or None if `to` is unreachable.
+    static CameraPosition g_route_next[POSITION_COUNT][POSITION_COUNT];
+    // Set when a transition is registered after the table was built; the next route lookup rebuilds it.
+    static bool g_routes_stale = true;
+    // Set when the animation asset must be (re)loaded; done in Update once no transition is playing.
+    static bool g_assets_reload_pending = false;
+
+    // The position whose outgoing transitions PrewarmOutgoingTransitions() last prepared, or None once a
+    // bake, registration, asset or settings change may have undone that.
+    static CameraPosition g_prewarmed_pos = CameraPosition::None;
 
     // Cache for the driver's initial state, to be used for the return journey
     static Animation::CurrentCameraState g_cached_driver_state;
-    // Tracks simulation time to calculate delta time for animations
-    static uint64_t last_simulation_time = 0;
-    // Stores a sequence of moves for a chained animation.
-    static std::queue<CameraPosition> g_pending_moves;
-    // Flag to indicate that settings have been updated and may need to be reapplied.
+
+    // --- Routes ---
+    /**
+     * @brief One leg of a chained move.
+     */
+    struct RouteLeg
+    {
+        CameraPosition target;
+        // Whether the leg may start while the previous one is still finishing (see JoinNextLeg()). False when
+        // the camera has to settle first, e.g. to walk to the seat after arriving at Standing.
+        bool seamless;
+    };
+
+    // A route never visits a position twice; the extra slot holds a move queued behind a stance change.
+    constexpr size_t MAX_ROUTE_LEGS = POSITION_COUNT + 1;
+
+    /**
+     * @brief The legs of a chained move still to be played, compiled when the move is requested.
+     * @details A ring buffer held inline, so planning and playing a route never allocates.
+     */
+    struct Route
+    {
+        RouteLeg legs[MAX_ROUTE_LEGS];
+        size_t head = 0;
+        size_t count = 0;
+    };
+    static Route g_route;
+
+    // A seamless leg starts this long before the previous one ends; the two are cross-faded over that time,
+    // so the camera keeps its velocity through the intermediate position instead of stopping on it.
+    constexpr uint64_t ROUTE_JOIN_US = 150000;
+    // Set when the settings changed while the camera moved; the pose preview starts once it settles.
     static bool g_settings_dirty = false;
 
+    // --- Settings Live Preview ---
+    // A slider drag changes a setting many times per second. The pose of the current position is eased
+    // toward its latest value once per frame, and the azimuth re-evaluation waits until the settings
+    // have stopped changing for AZIMUTH_SETTINGS_DEBOUNCE.
+    constexpr std::chrono::milliseconds AZIMUTH_SETTINGS_DEBOUNCE{300};
+    static bool g_pose_preview_active = false;
+    static bool g_azimuth_settings_dirty = false;
+    // Set when the debounce ran out while the camera moved; the re-evaluation is sent once it settles.
+    static bool g_azimuth_notify_on_settle = false;
+    static std::chrono::steady_clock::time_point g_last_settings_change;
+    static std::chrono::steady_clock::time_point g_last_preview_frame;
+    // When the last transition finished, for the gap to the next leg of a route (Latency::Metric::ChainGap).
+    static uint64_t g_sequence_end_us = 0;
+    // Set by the JoinNextLeg event of the active transition; stays set while a join has to wait for a
+    // retarget fade or for a seamless leg to be queued.
+    static bool g_join_due = false;
+
+    // --- Retargeting ---
+    // A transition interrupted by a new request keeps playing underneath its replacement for
+    // RETARGET_BLEND_US while the replacement fades in, so the camera never jumps or stops dead.
+    // A route join fades the previous leg out over whatever was left of it instead.
+    constexpr uint64_t RETARGET_BLEND_US = 250000;
+    // A request that arrived during a stance animation, started by the Settled event that ends it.
+    static CameraPosition g_deferred_request = CameraPosition::None;
+
+    // --- Debug Statistics ---
+    static std::chrono::steady_clock::time_point g_allocation_window_start;
+    static uint64_t g_allocation_window_start_count = 0;
+    static uint64_t g_allocations_per_second = 0;
+
+    // =================================================================================================
+    // Built-in Transitions
+    // =================================================================================================
+
+    struct BuiltinTransition
+    {
+        CameraPosition from;
+        CameraPosition to;
+        Animation::SequenceFactory factory;
+        const Animation::Reversal* reversal = nullptr; // Registered instead of `factory`; see TransitionEntry::reversal.
+    };
+
+    // Registered by Initialize(). Extensions can add more at run time through RegisterSequence().
+    constexpr BuiltinTransition BUILTIN_TRANSITIONS[] = {
+        // --- Seat <-> Seat ---
+        {CameraPosition::Driver, CameraPosition::Passenger, AnimationSequences::CreateDriverToPassengerSequence},
+        {CameraPosition::Passenger, CameraPosition::Driver, AnimationSequences::CreatePassengerToDriverSequence},
+
+        // --- Seats <-> Standing ---
+        {CameraPosition::Driver, CameraPosition::Standing, AnimationSequences::CreateDriverToStandingSequence},
+        {CameraPosition::Standing, CameraPosition::Driver, AnimationSequences::CreateStandingToDriverSequence},
+        {CameraPosition::Passenger, CameraPosition::Standing, AnimationSequences::CreatePassengerToStandingSequence},
+        {CameraPosition::Standing, CameraPosition::Passenger, AnimationSequences::CreateStandingToPassengerSequence},
+
+        // --- Sofa External ---
+        {CameraPosition::Standing, CameraPosition::SofaSit1, AnimationSequences::CreateStandingToSofaSequence},
+        {CameraPosition::SofaSit1, CameraPosition::Standing, AnimationSequences::CreateSofaToStandingSequence},
+
+        // --- Sofa Internal ---
+        {CameraPosition::SofaSit1, CameraPosition::SofaLie, AnimationSequences::CreateSofaSit1ToLieSequence},
+        // Retraces SofaSit2 -> SofaSit1, looking towards the new spot instead of back at the old one.
+        {CameraPosition::SofaSit1, CameraPosition::SofaSit2, nullptr,
+         &Animation::REVERSAL_OF<AnimationSequences::CreateSofaSit2ToSit1Sequence, AnimationSequences::CreateSofaSit1ToSit2Sequence,
+                                 Animation::ChannelBit(Animation::Channel::RotationYaw)>},
+        {CameraPosition::SofaLie, CameraPosition::SofaSit2, AnimationSequences::CreateSofaLieToSit2Sequence},
+        {CameraPosition::SofaLie, CameraPosition::SofaSit1, AnimationSequences::CreateSofaLieToSofa1Sequence}, // Shortcut animation
+        {CameraPosition::SofaSit2, CameraPosition::SofaSit1, AnimationSequences::CreateSofaSit2ToSit1Sequence},
+    };
+
+    constexpr bool IsBuiltinTableWellFormed()
+    {
+        for (size_t i = 0; i < std::size(BUILTIN_TRANSITIONS); ++i)
+        {
+            const BuiltinTransition& t = BUILTIN_TRANSITIONS[i];
+            if (t.from == t.to || static_cast<size_t>(t.from) >= POSITION_COUNT || static_cast<size_t>(t.to) >= POSITION_COUNT || !t.factory == !t.reversal)
+            {
+                return false;
+            }
+            bool has_forward = false;
+            for (size_t j = 0; j < std::size(BUILTIN_TRANSITIONS); ++j)
+            {
+                const BuiltinTransition& other = BUILTIN_TRANSITIONS[j];
+                if (j < i && other.from == t.from && other.to == t.to)
+                {
+                    return false; // Registered twice
+                }
+                has_forward = has_forward || (other.from == t.to && other.to == t.from && !other.reversal);
+            }
+            if (t.reversal && !has_forward)
+            {
+                return false; // A reversal needs the transition it plays backwards
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Checks that every listed position can reach every other one through the built-in transitions.
+     */
+    constexpr bool AreBuiltinsConnected(std::initializer_list<CameraPosition> positions)
+    {
+        bool reachable[POSITION_COUNT][POSITION_COUNT] = {};
+        for (const BuiltinTransition& t : BUILTIN_TRANSITIONS)
+        {
+            reachable[static_cast<size_t>(t.from)][static_cast<size_t>(t.to)] = true;
+        }
+        for (size_t via = 0; via < POSITION_COUNT; ++via)
+        {
+            for (size_t from = 0; from < POSITION_COUNT; ++from)
+            {
+                for (size_t to = 0; to < POSITION_COUNT; ++to)
+                {
+                    reachable[from][to] = reachable[from][to] || (reachable[from][via] && reachable[via][to]);
+                }
+            }
+        }
+        for (CameraPosition from : positions)
+        {
+            for (CameraPosition to : positions)
+            {
+                if (from != to && !reachable[static_cast<size_t>(from)][static_cast<size_t>(to)])
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    static_assert(IsBuiltinTableWellFormed(), "Built-in transitions must be unique, valid and have a factory, and reversals a forward transition");
+    // Bed has no animations yet and is not offered by any keybind.
+    static_assert(AreBuiltinsConnected({CameraPosition::Driver, CameraPosition::Passenger, CameraPosition::Standing,
+                                        CameraPosition::SofaSit1, CameraPosition::SofaLie, CameraPosition::SofaSit2}),
+                  "Every position reachable by a keybind needs a route to and from every other one");
+
     // =================================================================================================
     // Internal Helpers
     // =================================================================================================
@@ -70,258 +309,1051 @@ namespace SPF_CabinWalk::AnimationController
         }
     }
 
-    // =================================================================================================
-    // Public Functions
-    // =================================================================================================
+    /**
+     * @brief Appends a leg to the pending route. Does nothing if the route is full.
+     */
+    static void PushLeg(CameraPosition target, bool seamless)
+    {
+        if (g_route.count < MAX_ROUTE_LEGS)
+        {
+            g_route.legs[(g_route.head + g_route.count) % MAX_ROUTE_LEGS] = {target, seamless};
+            ++g_route.count;
+        }
+    }
 
-    void NotifySettingsUpdated()
+    /**
+     * @brief Removes the next leg from the pending route. The route must not be empty.
+     */
+    static CameraPosition PopLeg()
     {
-        g_settings_dirty = true;
+        const CameraPosition target = g_route.legs[g_route.head].target;
+        g_route.head = (g_route.head + 1) % MAX_ROUTE_LEGS;
+        --g_route.count;
+        return target;
     }
 
-    void Initialize(PluginContext *ctx)
+    /**
+     * @brief Checks whether a leg to `next` can start while the leg arriving at `via` is still playing.
+     * @details Mirrors the stance checks of MoveTo(): after arriving at Standing, a seat or the sofa is only
+     *          joined directly if no walk is needed to reach it. Every other position needs no settling.
+     */
+    static bool CanJoinSeamlessly(CameraPosition via, CameraPosition next)
     {
-        g_anim_ctx = ctx;
-        g_current_pos = CameraPosition::Driver; // Always start at driver's seat by default
+        if (via != CameraPosition::Standing)
+        {
+            return true;
+        }
 
-        // Initialize sub-controllers
-        StandingAnimController::Initialize(ctx);
+        const float standing_z = GetTargetTransformForPosition(CameraPosition::Standing).position.z;
+        if (next == CameraPosition::Driver || next == CameraPosition::Passenger)
+        {
+            return standing_z < 0 || StandingAnimController::IsWithinStep(GetTargetZForPosition(next), standing_z);
+        }
+        if (next == CameraPosition::SofaSit1)
+        {
+            return StandingAnimController::IsWithinStep(GetTargetZForPosition(next), standing_z);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Checks whether the front bake set was baked for the current settings.
+     */
+    static bool AreFrontBakesCurrent()
+    {
+        return g_front_bakes->settings_hash == g_transition_settings_hash;
+    }
 
-        // --- Register Actual Sequence Factories ---
-        RegisterSequence(CameraPosition::Driver, CameraPosition::Passenger,
-            [](const Animation::CurrentCameraState& start_state, const Animation::CurrentCameraState& target_state) {
-                return AnimationSequences::CreateDriverToPassengerSequence(start_state, target_state);
+    /**
+     * @brief Checks whether the active or the fading sequence plays the keys of a bake, itself or through a reversal.
+     */
+    static bool AreKeysPlaying(const BakeSet& bakes, const Animation::BakedTransition& baked)
+    {
+        const Animation::BakedTransition* source = baked.GetKeySource();
+        for (const auto& row : bakes.baked)
+        {
+            for (const auto& cell : row)
+            {
+                for (const Animation::BakedTransition& other : cell)
+                {
+                    if (other.GetKeySource() == source && (other.Owns(AnimationScheduler::GetTransition()) || other.Owns(AnimationScheduler::GetFadingTransition())))
+                    {
+                        return true;
+                    }
+                }
             }
-        );
+        }
+        return false;
+    }
 
-        RegisterSequence(CameraPosition::Passenger, CameraPosition::Driver,
-            [](const Animation::CurrentCameraState& start_state, const Animation::CurrentCameraState& target_state) {
-                return AnimationSequences::CreatePassengerToDriverSequence(start_state, target_state);
+    /**
+     * @brief Bakes one transition of a bake set.
+     * @details A reversed transition shares the keys of its forward transition's bake when that is already
+     *          valid, and only bakes its overridden channels; otherwise its factory is baked like any other.
+     * @return True if the transition could be baked.
+     */
+    static bool BakeTransition(BakeSet& bakes, size_t from, size_t to, uint8_t variant, Animation::SequenceFactory factory,
+                               const Animation::Reversal* reversal, uint64_t settings_hash)
+    {
+        Animation::BakedTransition& baked = bakes.baked[from][to][variant];
+        if (reversal && !bakes.stale[to][from])
+        {
+            // Variant 0 of the forward bake: the reversal always builds the forward with no move following.
+            Animation::BakedTransition& forward = bakes.baked[to][from][0];
+            if (forward.IsValidFor(settings_hash) && !forward.IsPinned() &&
+                baked.BakeReversed(forward, reversal->overrides, reversal->override_channels, settings_hash))
+            {
+                return true;
             }
-        );
+        }
+        return baked.Bake(factory, settings_hash);
+    }
+
+    /**
+     * @brief Returns a ready-to-start sequence for a transition, using the baked cache when possible.
+     * @details A cache entry is (re)baked lazily the first time it is needed for the current settings hash.
+     *          Transitions that cannot be baked, and every transition while a rebake is still running, fall
+     *          back to running the factory.
+     * @param[out] owned Receives a sequence built by the factory, which it owns; left empty for a baked one.
+     */
+    Animation::AnimationSequence* AcquireTransitionSequence(
+        CameraPosition from,
+        CameraPosition to,
+        const Animation::CurrentCameraState& start_state,
+        const Animation::CurrentCameraState& target_state,
+        std::unique_ptr<Animation::AnimationSequence>& owned)
+    {
+        SPF_CABINWALK_PROFILE_ZONE(TransitionAcquire);
+
+        const TransitionEntry& entry = g_transitions[static_cast<size_t>(from)][static_cast<size_t>(to)];
+        const Animation::SequenceFactory factory = entry.factory;
+        const uint8_t variant = HasPendingMoves() ? 1 : 0;
+        if (g_front_bakes->stale[static_cast<size_t>(from)][static_cast<size_t>(to)])
+        {
+            // Baked from the factory registered before; the new one runs until the cell can be reset.
+            owned = factory(start_state, target_state);
+            return owned.get();
+        }
 
-        // --- Driver <-> Standing Sequences ---
-        RegisterSequence(CameraPosition::Driver, CameraPosition::Standing,
-            [](const Animation::CurrentCameraState& start_state, const Animation::CurrentCameraState& target_state) {
-                return AnimationSequences::CreateDriverToStandingSequence(start_state, target_state);
+        auto& baked = g_front_bakes->baked[static_cast<size_t>(from)][static_cast<size_t>(to)][variant];
+        if (AreFrontBakesCurrent() && !baked.WasBakedFor(g_transition_settings_hash))
+        {
+            if (!BakeTransition(*g_front_bakes, static_cast<size_t>(from), static_cast<size_t>(to), variant, factory, entry.reversal, g_transition_settings_hash) &&
+                g_anim_ctx->loggerHandle)
+            {
+                char log_buffer[256];
+                g_anim_ctx->formattingAPI->Fmt_Format(log_buffer, sizeof(log_buffer), "[AnimationController] Transition %d -> %d cannot be baked; it will be rebuilt on every move.", static_cast<int>(from), static_cast<int>(to));
+                g_anim_ctx->loadAPI->logger->Log(g_anim_ctx->loggerHandle, SPF_LOG_DEBUG, log_buffer);
+            }
+        }
+
+        // Binding keys that are playing, e.g. the way back while a retarget fades out the way there, would move those too.
+        if (baked.IsValidFor(g_transition_settings_hash) && !AreKeysPlaying(*g_front_bakes, baked))
+        {
+            return baked.Bind(start_state, target_state);
+        }
+
+        owned = factory(start_state, target_state);
+        return owned.get();
+    }
+
+    static bool JoinNextLeg();
+
+    /**
+     * @brief Makes the target of the active transition the current position.
+     * @details The camera hook applies the position's state on its next call, and arriving at Standing
+     *          resets the stance there.
+     */
+    static void ArriveAtTarget()
+    {
+        g_current_pos = g_target_pos;
+        CameraHookManager::SetCurrentCameraPosition(g_current_pos);
+        if (g_current_pos == CameraPosition::Standing)
+        {
+            StandingAnimController::OnEnterStandingState();
+        }
+    }
+
+    /**
+     * @brief Sets the event markers of a transition that is about to start.
+     * @details A seamless next leg may join ROUTE_JOIN_US before the end. The marker is set on every
+     *          transition, since legs can be queued after it starts; JoinNextLeg() checks the route.
+     */
+    static void SetTransitionEvents(Animation::AnimationSequence& sequence)
+    {
+        g_join_due = false;
+
+        const uint64_t duration_us = sequence.GetDuration();
+        const float join_progress = duration_us > ROUTE_JOIN_US ? static_cast<float>(duration_us - ROUTE_JOIN_US) / static_cast<float>(duration_us) : 0.0f;
+
+        sequence.ClearEvents();
+        sequence.AddEvent(join_progress, Animation::SequenceEvent::JoinNextLeg);
+        sequence.AddEvent(1.0f, Animation::SequenceEvent::Arrive);
+    }
+
+    /**
+     * @brief Reacts to the events a step of the active transition fired, once the scheduler has composed its pose.
+     * @details Called for steps from Update() and from the camera hook alike, so arrival work lands on the
+     *          frame the camera arrives.
+     * @param events The Animation::EventBit() of each marker the step reached.
+     * @return True if a transition is still playing: the active one, or the next leg it joined.
+     */
+    static bool OnTransitionStep(uint32_t events)
+    {
+        const bool is_playing = AnimationScheduler::IsTransitionPlaying();
+        if (!is_playing)
+        {
+            g_sequence_end_us = InputQueue::NowMicroseconds();
+        }
+
+        if (events & Animation::EventBit(Animation::SequenceEvent::JoinNextLeg))
+        {
+            g_join_due = true;
+        }
+        if (g_join_due && JoinNextLeg())
+        {
+            return true;
+        }
+        if (events & Animation::EventBit(Animation::SequenceEvent::Arrive))
+        {
+            ArriveAtTarget();
+        }
+        return is_playing;
+    }
+
+    /**
+     * @brief Starts easing the camera toward the settings-defined pose of the current position.
+     * @details Only positions that are actually defined by settings have one to ease to.
+     */
+    static void StartPosePreview()
+    {
+        if (!g_pose_preview_active)
+        {
+            g_last_preview_frame = std::chrono::steady_clock::now();
+        }
+        g_pose_preview_active = (g_current_pos != CameraPosition::Driver && g_anim_ctx && g_anim_ctx->cameraAPI);
+        g_settings_dirty = false;
+    }
+
+    /**
+     * @brief Drops the pose preview, so a new move owns the camera.
+     */
+    static void StopPosePreview()
+    {
+        g_pose_preview_active = false;
+        LayerStack::Clear(LayerStack::Layer::SettingsPreview);
+    }
+
+    /**
+     * @brief Eases the camera toward the settings-defined pose of the current position, one step per frame.
+     * @details Smoothing time comes from `settings.performance.settings_preview_smoothing_ms`; 0 snaps.
+     *          The target is re-read every frame, so it follows a slider that is still being dragged.
+     */
+    void UpdatePosePreview()
+    {
+        const auto now = std::chrono::steady_clock::now();
+        const float dt = std::chrono::duration<float>(now - g_last_preview_frame).count();
+        g_last_preview_frame = now;
+
+        const Animation::Transform target = GetTargetTransformForPosition(g_current_pos);
+        const int32_t smoothing_ms = g_anim_ctx->settings.performance.settings_preview_smoothing_ms;
+
+        float alpha = 1.0f;
+        if (smoothing_ms > 0)
+        {
+            alpha = 1.0f - std::exp(-dt * 1000.0f / static_cast<float>(smoothing_ms));
+        }
+
+        Animation::CurrentCameraState state = CameraFacade::GetState();
+        const float dx = target.position.x - state.position.x;
+        const float dy = target.position.y - state.position.y;
+        const float dz = target.position.z - state.position.z;
+        const float dyaw = Animation::AngleDelta(state.rotation.x, target.rotation.x);
+        const float dpitch = target.rotation.y - state.rotation.y;
+
+        constexpr float SETTLED = 0.0005f;
+        if (alpha >= 1.0f || (std::fabs(dx) < SETTLED && std::fabs(dy) < SETTLED && std::fabs(dz) < SETTLED &&
+                              std::fabs(dyaw) < SETTLED && std::fabs(dpitch) < SETTLED))
+        {
+            state.position = target.position;
+            state.rotation.x = target.rotation.x;
+            state.rotation.y = target.rotation.y;
+            LayerStack::Set(LayerStack::Layer::SettingsPreview, state, LayerStack::LAYER_ALL);
+            LayerStack::Compose();
+            if (g_current_pos == CameraPosition::Standing)
+            {
+                StandingAnimController::OnEnterStandingState(); // The walker starts from the new pose.
             }
-        );
+            LayerStack::Clear(LayerStack::Layer::SettingsPreview);
+            g_pose_preview_active = false;
+
+            if (g_anim_ctx->loggerHandle)
+            {
+                char log_buffer[256];
+                g_anim_ctx->formattingAPI->Fmt_Format(log_buffer, sizeof(log_buffer), "[AnimationController] Applied settings directly to camera for position %d.", static_cast<int>(g_current_pos));
+                g_anim_ctx->loadAPI->logger->Log(g_anim_ctx->loggerHandle, SPF_LOG_DEBUG, log_buffer);
+            }
+            return;
+        }
+
+        state.position = {state.position.x + dx * alpha, state.position.y + dy * alpha, state.position.z + dz * alpha};
+        state.rotation.x = Animation::WrapAngle(state.rotation.x + dyaw * alpha);
+        state.rotation.y = state.rotation.y + dpitch * alpha;
+        LayerStack::Set(LayerStack::Layer::SettingsPreview, state, LayerStack::LAYER_ALL);
+    }
+
+    /**
+     * @brief Samples the sequence allocation counter once per second and logs the rate when it changes.
+     */
+    void UpdateAllocationRate()
+    {
+        const auto now = std::chrono::steady_clock::now();
+        if (now - g_allocation_window_start < std::chrono::seconds(1))
+        {
+            return;
+        }
+
+        const uint64_t count = Animation::SequenceBuilder::GetAllocationCount();
+        const uint64_t rate = count - g_allocation_window_start_count;
+        g_allocation_window_start = now;
+        g_allocation_window_start_count = count;
+
+        if (rate != g_allocations_per_second && g_anim_ctx->loggerHandle)
+        {
+            char log_buffer[128];
+            g_anim_ctx->formattingAPI->Fmt_Format(log_buffer, sizeof(log_buffer), "[AnimationController] Sequence allocations: %llu/s", static_cast<unsigned long long>(rate));
+            g_anim_ctx->loadAPI->logger->Log(g_anim_ctx->loggerHandle, SPF_LOG_DEBUG, log_buffer);
+        }
+        g_allocations_per_second = rate;
+    }
+
+    /**
+     * @brief Gets how long a registered transition plays, in microseconds, as the current settings make it.
+     * @details Reads the baked sequence, baking it first if needed; transitions that cannot be baked are
+     *          built once with neutral states just to read their duration.
+     */
+    uint64_t GetTransitionDuration(size_t from, size_t to)
+    {
+        const Animation::SequenceFactory factory = g_transitions[from][to].factory;
+        auto& baked = g_front_bakes->baked[from][to][0];
+        if (AreFrontBakesCurrent() && !baked.WasBakedFor(g_transition_settings_hash))
+        {
+            BakeTransition(*g_front_bakes, from, to, 0, factory, g_transitions[from][to].reversal, g_transition_settings_hash);
+        }
+        if (baked.IsValidFor(g_transition_settings_hash))
+        {
+            return baked.GetDuration();
+        }
+
+        const Animation::CurrentCameraState neutral_state = {};
+        const std::unique_ptr<Animation::AnimationSequence> sequence = factory(neutral_state, neutral_state);
+        return sequence ? sequence->GetDuration() : 0;
+    }
+
+    /**
+     * @brief Rebuilds g_route_next from the registered transitions (Floyd-Warshall over a handful of positions).
+     */
+    void BuildRouteTable()
+    {
+        constexpr uint64_t UNREACHABLE = UINT64_MAX;
+        uint64_t cost[POSITION_COUNT][POSITION_COUNT];
+
+        for (size_t from = 0; from < POSITION_COUNT; ++from)
+        {
+            for (size_t to = 0; to < POSITION_COUNT; ++to)
+            {
+                cost[from][to] = (from == to) ? 0 : UNREACHABLE;
+                g_route_next[from][to] = (from == to) ? static_cast<CameraPosition>(to) : CameraPosition::None;
+
+                if (from != to && g_transitions[from][to].factory)
+                {
+                    // Every hop costs at least 1 us, so a zero-length transition never makes a longer route look free.
+                    const uint64_t duration = GetTransitionDuration(from, to);
+                    cost[from][to] = duration > 0 ? duration : 1;
+                    g_route_next[from][to] = static_cast<CameraPosition>(to);
+                }
+            }
+        }
+
+        for (size_t via = 0; via < POSITION_COUNT; ++via)
+        {
+            for (size_t from = 0; from < POSITION_COUNT; ++from)
+            {
+                if (cost[from][via] == UNREACHABLE)
+                {
+                    continue;
+                }
+                for (size_t to = 0; to < POSITION_COUNT; ++to)
+                {
+                    if (cost[via][to] != UNREACHABLE && cost[from][via] + cost[via][to] < cost[from][to])
+                    {
+                        cost[from][to] = cost[from][via] + cost[via][to];
+                        g_route_next[from][to] = g_route_next[from][via];
+                    }
+                }
+            }
+        }
+
+        g_routes_stale = false;
+    }
+
+    /**
+     * @brief Bakes every registered transition for the current settings so the first keypress is free.
+     * @details Does nothing while the front set is stale; the rebake worker bakes the whole set then.
+     */
+    void WarmTransitionCache()
+    {
+        if (!AreFrontBakesCurrent())
+        {
+            return;
+        }
+
+        // Forward transitions first, so their reversals can be derived from them.
+        const uint8_t variant = HasPendingMoves() ? 1 : 0;
+        for (const bool reversed : {false, true})
+        {
+            for (size_t from = 0; from < POSITION_COUNT; ++from)
+            {
+                for (size_t to = 0; to < POSITION_COUNT; ++to)
+                {
+                    const TransitionEntry& entry = g_transitions[from][to];
+                    if (entry.factory && (entry.reversal != nullptr) == reversed && !g_front_bakes->baked[from][to][variant].WasBakedFor(g_transition_settings_hash))
+                    {
+                        BakeTransition(*g_front_bakes, from, to, variant, entry.factory, entry.reversal, g_transition_settings_hash);
+                    }
+                }
+            }
+        }
+    }
+
+    bool PrewarmOutgoingTransitions()
+    {
+        const size_t from = static_cast<size_t>(g_current_pos);
+        if (!g_anim_ctx || g_prewarmed_pos == g_current_pos || from >= POSITION_COUNT || IsAnimating() || !AreFrontBakesCurrent())
+        {
+            return false;
+        }
+
+        // Both variants, since whether more moves follow is only known once the move is planned.
+        for (uint8_t variant = 0; variant < 2; ++variant)
+        {
+            const Animation::FactoryContext context = {&g_anim_ctx->settings, variant == 1};
+            const Animation::FactoryContextScope scope(context);
+            for (size_t to = 0; to < POSITION_COUNT; ++to)
+            {
+                const TransitionEntry& entry = g_transitions[from][to];
+                if (entry.factory && !g_front_bakes->baked[from][to][variant].WasBakedFor(g_transition_settings_hash))
+                {
+                    BakeTransition(*g_front_bakes, from, to, variant, entry.factory, entry.reversal, g_transition_settings_hash);
+                }
+            }
+        }
+
+        if (g_routes_stale)
+        {
+            BuildRouteTable();
+        }
+
+        g_prewarmed_pos = g_current_pos;
+        return true;
+    }
+
+    /**
+     * @brief Bakes every registered transition into the back set on the worker thread.
+     * @details Runs on the game thread: it copies the settings and the factories the worker needs, so the
+     *          worker touches nothing but the back set until it hands it over through g_finished_bakes.
+     */
+    static void StartRebake()
+    {
+        g_rebake_pending = false;
+        g_bake_settings = g_anim_ctx->settings;
+
+        BakeSet* bakes = g_back_bakes;
+        bakes->settings_hash = g_transition_settings_hash;
+        for (size_t from = 0; from < POSITION_COUNT; ++from)
+        {
+            for (size_t to = 0; to < POSITION_COUNT; ++to)
+            {
+                bakes->factories[from][to] = g_transitions[from][to].factory;
+                bakes->reversals[from][to] = g_transitions[from][to].reversal;
+            }
+        }
+
+        g_bake_running = true;
+        g_bake_worker = std::thread([bakes]()
+        {
+            for (uint8_t variant = 0; variant < 2; ++variant)
+            {
+                const Animation::FactoryContext context = {&g_bake_settings, variant == 1};
+                const Animation::FactoryContextScope scope(context);
+                // Forward transitions first, so their reversals share their keys instead of baking their own.
+                for (const bool reversed : {false, true})
+                {
+                    for (size_t from = 0; from < POSITION_COUNT; ++from)
+                    {
+                        for (size_t to = 0; to < POSITION_COUNT; ++to)
+                        {
+                            if ((bakes->reversals[from][to] != nullptr) != reversed)
+                            {
+                                continue;
+                            }
+                            bakes->baked[from][to][variant].Reset();
+                            if (bakes->factories[from][to])
+                            {
+                                BakeTransition(*bakes, from, to, variant, bakes->factories[from][to], bakes->reversals[from][to], bakes->settings_hash);
+                            }
+                        }
+                    }
+                }
+            }
+            g_finished_bakes.store(bakes, std::memory_order_release);
+        });
+    }
+
+    /**
+     * @brief Makes a finished back set the front set.
+     * @details Curves pinned by the animation asset move over from the old front set, and transitions
+     *          registered again while the set was baking are reset so they bake lazily from their new
+     *          factory. A transition still playing from the old set keeps it alive as the back set.
+     */
+    static void PublishBakes(BakeSet* bakes)
+    {
+        for (size_t from = 0; from < POSITION_COUNT; ++from)
+        {
+            for (size_t to = 0; to < POSITION_COUNT; ++to)
+            {
+                // A reversal sharing its forward's keys is stale too once the forward is registered again.
+                const bool factory_changed = bakes->factories[from][to] != g_transitions[from][to].factory ||
+                                             bakes->reversals[from][to] != g_transitions[from][to].reversal ||
+                                             (bakes->reversals[from][to] && bakes->factories[to][from] != g_transitions[to][from].factory);
+                for (uint8_t variant = 0; variant < 2; ++variant)
+                {
+                    Animation::BakedTransition& baked = bakes->baked[from][to][variant];
+                    Animation::BakedTransition& old_baked = g_front_bakes->baked[from][to][variant];
+                    if (old_baked.IsPinned())
+                    {
+                        // The sequence is heap-owned, so one that is playing survives the swap.
+                        std::swap(baked, old_baked);
+                    }
+                    else if (factory_changed)
+                    {
+                        baked.Reset();
+                    }
+                }
+            }
+        }
+        for (size_t from = 0; from < POSITION_COUNT; ++from)
+        {
+            for (size_t to = 0; to < POSITION_COUNT; ++to)
+            {
+                bakes->factories[from][to] = g_transitions[from][to].factory;
+                bakes->reversals[from][to] = g_transitions[from][to].reversal;
+            }
+        }
+
+        g_back_bakes = g_front_bakes;
+        g_front_bakes = bakes;
+        g_back_bakes_in_use = AnimationScheduler::GetTransition() || AnimationScheduler::GetFadingTransition();
+
+        // Durations may have changed, which can change the fastest routes.
+        BuildRouteTable();
+        g_prewarmed_pos = CameraPosition::None;
+    }
+
+    /**
+     * @brief Checks whether the active or the fading sequence plays from a cell's bakes, or from a reversal of them.
+     */
+    static bool IsCellPlaying(const BakeSet& bakes, size_t from, size_t to)
+    {
+        for (const Animation::BakedTransition& baked : bakes.baked[from][to])
+        {
+            if (AreKeysPlaying(bakes, baked))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Discards the bakes of a cell, or marks it stale if resetting them now would pull a playing
+     *        sequence out from under the controller.
+     */
+    static void ResetCell(BakeSet& bakes, size_t from, size_t to)
+    {
+        if (IsCellPlaying(bakes, from, to))
+        {
+            bakes.stale[from][to] = true;
+            return;
+        }
+        for (Animation::BakedTransition& baked : bakes.baked[from][to])
+        {
+            baked.Reset();
+        }
+        bakes.stale[from][to] = false;
+    }
+
+    /**
+     * @brief Resets the stale cells of both sets that no longer play.
+     */
+    static void ResetStaleCells()
+    {
+        for (BakeSet& bakes : g_bake_sets)
+        {
+            for (size_t from = 0; from < POSITION_COUNT; ++from)
+            {
+                for (size_t to = 0; to < POSITION_COUNT; ++to)
+                {
+                    if (bakes.stale[from][to])
+                    {
+                        ResetCell(bakes, from, to);
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Publishes a finished rebake, and starts one when the front set is stale and the back set is free.
+     * @details Called at the start of each frame, so a transition never sees the front set change under it.
+     */
+    static void UpdateRebake()
+    {
+        if (BakeSet* bakes = g_finished_bakes.exchange(nullptr, std::memory_order_acquire))
+        {
+            g_bake_worker.join();
+            g_bake_running = false;
+            if (bakes->settings_hash == g_transition_settings_hash)
+            {
+                PublishBakes(bakes);
+            }
+            else
+            {
+                g_rebake_pending = true; // The settings changed again while it was baking.
+            }
+        }
+
+        if (g_back_bakes_in_use && !AnimationScheduler::GetTransition() && !AnimationScheduler::GetFadingTransition())
+        {
+            g_back_bakes_in_use = false;
+        }
+
+        ResetStaleCells();
+
+        if (g_rebake_pending && !g_bake_running && !g_back_bakes_in_use)
+        {
+            if (AreFrontBakesCurrent())
+            {
+                g_rebake_pending = false; // The settings went back to what the front set was baked for.
+            }
+            else
+            {
+                StartRebake();
+            }
+        }
+    }
+
+    /**
+     * @brief Replaces the curves of every registered transition that the loaded animation asset defines.
+     * @details Transitions pinned by an earlier asset that the current one no longer defines go back to
+     *          their factory. Must not run while a transition plays, since that may point into a bake.
+     * @return The number of transition variants taken from the asset.
+     */
+    static uint32_t ApplyAnimationAssets()
+    {
+        uint32_t applied = 0;
+        for (size_t from = 0; from < POSITION_COUNT; ++from)
+        {
+            for (size_t to = 0; to < POSITION_COUNT; ++to)
+            {
+                for (uint8_t variant = 0; variant < 2; ++variant)
+                {
+                    Animation::BakedTransition& baked = g_front_bakes->baked[from][to][variant];
+                    const AnimationAssets::TransitionRecord* record =
+                        g_transitions[from][to].factory ? AnimationAssets::Find(static_cast<uint8_t>(from), static_cast<uint8_t>(to), variant) : nullptr;
+                    if (record && baked.Load(*record, AnimationAssets::GetKeys(*record)))
+                    {
+                        ++applied;
+                    }
+                    else if (baked.IsPinned())
+                    {
+                        baked.Reset();
+                    }
+                }
+            }
+        }
+
+        // Durations may differ from the factories', which changes the fastest routes.
+        g_routes_stale = true;
+        g_prewarmed_pos = CameraPosition::None;
+        WarmTransitionCache();
+        return applied;
+    }
+
+    /**
+     * @brief Writes every bakeable transition, as the current settings shape it, to an animation asset.
+     * @details Seeds a template that can be tuned and then put in place without rebuilding the plugin. With
+     *          `settings.animation_assets.quantized` the keys are written in the compact quantized format.
+     */
+    static bool ExportAnimationAssets(const char* path)
+    {
+        std::vector<AnimationAssets::TransitionRecord> records;
+        std::vector<AnimationAssets::KeyRecord> keys;
+        for (size_t from = 0; from < POSITION_COUNT; ++from)
+        {
+            for (size_t to = 0; to < POSITION_COUNT; ++to)
+            {
+                const Animation::SequenceFactory factory = g_transitions[from][to].factory;
+                if (!factory)
+                {
+                    continue;
+                }
+
+                for (uint8_t variant = 0; variant < 2; ++variant)
+                {
+                    // Baked apart from the front set, which may hold curves pinned by an earlier asset.
+                    const Animation::FactoryContext context = {&g_anim_ctx->settings, variant == 1};
+                    const Animation::FactoryContextScope scope(context);
+                    Animation::BakedTransition baked;
+                    baked.Bake(factory, g_transition_settings_hash);
+
+                    AnimationAssets::TransitionRecord record = {};
+                    record.from = static_cast<uint8_t>(from);
+                    record.to = static_cast<uint8_t>(to);
+                    record.variant = variant;
+                    if (baked.IsValidFor(g_transition_settings_hash) && baked.Export(record, keys))
+                    {
+                        records.push_back(record);
+                    }
+                }
+            }
+        }
+        const AnimationAssets::KeyFormat format =
+            g_anim_ctx->settings.animation_assets.quantized ? AnimationAssets::KeyFormat::Quantized : AnimationAssets::KeyFormat::Float;
+        return AnimationAssets::Save(path, records, keys, format);
+    }
+
+    /**
+     * @brief Loads `settings.animation_assets.file`.
+     * @details If it does not exist, the transitions follow the settings and the built-in curves are written
+     *          to `<file>.builtin` as a starting point, which is never loaded under that name.
+     */
+    static void LoadAnimationAssets()
+    {
+        g_assets_reload_pending = false;
+        const char* path = g_anim_ctx->settings.animation_assets.file;
+        char log_buffer[512];
+
+        if (!path[0])
+        {
+            if (AnimationAssets::IsLoaded())
+            {
+                AnimationAssets::Unload();
+                ApplyAnimationAssets();
+            }
+            return;
+        }
+
+        std::error_code error;
+        if (!std::filesystem::exists(path, error))
+        {
+            // A seeded file would pin today's curves and silently take the effect of the duration and height
+            // settings away. The seed goes next to it instead; it only overrides once renamed to `path`.
+            const std::string template_path = std::string(path) + ".builtin";
+            if (!std::filesystem::exists(template_path, error))
+            {
+                const bool exported = ExportAnimationAssets(template_path.c_str());
+                if (g_anim_ctx->loggerHandle)
+                {
+                    g_anim_ctx->formattingAPI->Fmt_Format(log_buffer, sizeof(log_buffer), exported ? "[AnimationController] Wrote the built-in transitions to '%s'; rename it to '%s' once edited to use it." : "[AnimationController] Could not write the built-in transitions to '%s'.", template_path.c_str(), path);
+                    g_anim_ctx->loadAPI->logger->Log(g_anim_ctx->loggerHandle, exported ? SPF_LOG_INFO : SPF_LOG_WARN, log_buffer);
+                }
+            }
+
+            // Nothing to load: every transition follows the settings.
+            if (AnimationAssets::IsLoaded())
+            {
+                AnimationAssets::Unload();
+                ApplyAnimationAssets();
+            }
+            return;
+        }
+
+        if (!AnimationAssets::Load(path))
+        {
+            if (g_anim_ctx->loggerHandle)
+            {
+                g_anim_ctx->formattingAPI->Fmt_Format(log_buffer, sizeof(log_buffer), "[AnimationController] Animation asset '%s' is missing or invalid; keeping the current curves.", path);
+                g_anim_ctx->loadAPI->logger->Log(g_anim_ctx->loggerHandle, SPF_LOG_ERROR, log_buffer);
+            }
+            return;
+        }
+
+        const uint32_t applied = ApplyAnimationAssets();
+        if (g_anim_ctx->loggerHandle)
+        {
+            g_anim_ctx->formattingAPI->Fmt_Format(log_buffer, sizeof(log_buffer), "[AnimationController] Loaded %u transition curves from '%s'.", applied, path);
+            g_anim_ctx->loadAPI->logger->Log(g_anim_ctx->loggerHandle, SPF_LOG_INFO, log_buffer);
+        }
+    }
+
+    // =================================================================================================
+    // Public Functions
+    // =================================================================================================
+
+    void ReloadAnimationAssets()
+    {
+        g_assets_reload_pending = true;
+    }
+
+    void NotifySettingsUpdated()
+    {
+        g_azimuth_settings_dirty = true;
+        g_last_settings_change = std::chrono::steady_clock::now();
+
+        // A camera that is moving takes the new pose from its move; the preview waits for it to settle.
+        if (IsCameraSettled())
+        {
+            StartPosePreview();
+        }
+        else
+        {
+            g_settings_dirty = true;
+        }
+    }
+
+    void NotifyAzimuthSettingsUpdated()
+    {
+        g_azimuth_settings_dirty = true;
+        g_last_settings_change = std::chrono::steady_clock::now();
+    }
+
+    void OnSettingsReloaded()
+    {
+        if (!g_anim_ctx)
+        {
+            return;
+        }
+
+        // The front set is kept, stale, until the rebake worker has replaced it; see UpdateRebake().
+        g_transition_settings_hash = Animation::HashTransitionSettings(g_anim_ctx->settings);
+        g_rebake_pending = !AreFrontBakesCurrent();
+    }
+
+    void Initialize(PluginContext *ctx)
+    {
+        g_anim_ctx = ctx;
+        g_current_pos = CameraPosition::Driver; // Always start at driver's seat by default
+        LayerStack::Reset();
 
-        RegisterSequence(CameraPosition::Standing, CameraPosition::Driver,
-            [](const Animation::CurrentCameraState& start_state, const Animation::CurrentCameraState& target_state) {
-                return AnimationSequences::CreateStandingToDriverSequence(start_state, target_state);
-            }
-        );
+        // Initialize sub-controllers
+        StandingAnimController::Initialize(ctx);
 
-        // --- Passenger <-> Standing Sequences ---
-        RegisterSequence(CameraPosition::Passenger, CameraPosition::Standing,
-            [](const Animation::CurrentCameraState& start_state, const Animation::CurrentCameraState& target_state) {
-                return AnimationSequences::CreatePassengerToStandingSequence(start_state, target_state);
+        // --- Register the built-in transitions ---
+        for (const BuiltinTransition& transition : BUILTIN_TRANSITIONS)
+        {
+            if (transition.reversal)
+            {
+                RegisterReversedSequence(transition.from, transition.to, *transition.reversal);
             }
-        );
-
-        RegisterSequence(CameraPosition::Standing, CameraPosition::Passenger,
-            [](const Animation::CurrentCameraState& start_state, const Animation::CurrentCameraState& target_state) {
-                return AnimationSequences::CreateStandingToPassengerSequence(start_state, target_state);
+            else
+            {
+                RegisterSequence(transition.from, transition.to, transition.factory);
             }
-        );
+        }
 
-        // --- Sofa External Sequences ---
-        RegisterSequence(CameraPosition::Standing, CameraPosition::SofaSit1, AnimationSequences::CreateStandingToSofaSequence);
-        RegisterSequence(CameraPosition::SofaSit1, CameraPosition::Standing, AnimationSequences::CreateSofaToStandingSequence);
+        // --- Bake all transitions up front ---
+        g_transition_settings_hash = Animation::HashTransitionSettings(ctx->settings);
+        g_front_bakes->settings_hash = g_transition_settings_hash;
+        WarmTransitionCache();
 
-        // --- Sofa Internal Sequences ---
-        RegisterSequence(CameraPosition::SofaSit1, CameraPosition::SofaLie, AnimationSequences::CreateSofaSit1ToLieSequence);
-        RegisterSequence(CameraPosition::SofaSit1, CameraPosition::SofaSit2, AnimationSequences::CreateSofaSit1ToSit2Sequence);
-        RegisterSequence(CameraPosition::SofaLie, CameraPosition::SofaSit2, AnimationSequences::CreateSofaLieToSit2Sequence);
-        RegisterSequence(CameraPosition::SofaLie, CameraPosition::SofaSit1, AnimationSequences::CreateSofaLieToSofa1Sequence); // Shortcut animation
-        RegisterSequence(CameraPosition::SofaSit2, CameraPosition::SofaSit1, AnimationSequences::CreateSofaSit2ToSit1Sequence);
+        // --- Let the animation asset, if one is configured, replace the built-in curves ---
+        LoadAnimationAssets();
+        BuildRouteTable();
     }
-    void Update()
+
+    void Shutdown()
     {
-        if (!g_anim_ctx || !g_anim_ctx->coreAPI)
+        // The worker only touches the back set, but that must not go away under it.
+        if (g_bake_worker.joinable())
         {
-            return;
+            g_bake_worker.join();
         }
+        g_finished_bakes.store(nullptr, std::memory_order_relaxed);
+        g_bake_running = false;
+        g_rebake_pending = false;
+    }
 
-        // --- Handle settings update ---
-        if (g_settings_dirty)
+    /**
+     * @brief Starts the next pending leg of a chained move, dropping legs that leave nothing to do.
+     * @return True if a move started.
+     */
+    static bool StartNextLeg()
+    {
+        while (HasPendingMoves())
         {
-            if (!IsAnimating() && !StandingAnimController::IsAnimating())
+            Latency::Arm(Latency::Metric::ChainGap, g_sequence_end_us);
+            if (MoveTo(PopLeg()))
             {
-                // If we are idle and settings have changed, snap to the new position for the current state.
-                // This should ONLY apply to positions that are actually defined by settings.
-                if (g_current_pos != CameraPosition::Driver)
-                {
-                    const auto& target_transform = GetTargetTransformForPosition(g_current_pos);
-                    if (g_anim_ctx->cameraAPI)
-                    {
-                        g_anim_ctx->cameraAPI->Cam_SetInteriorSeatPos(target_transform.position.x, target_transform.position.y, target_transform.position.z);
-                        g_anim_ctx->cameraAPI->Cam_SetInteriorHeadRot(target_transform.rotation.x, target_transform.rotation.y);
-                        if (g_anim_ctx->loggerHandle) {
-                            char log_buffer[256];
-                            g_anim_ctx->formattingAPI->Fmt_Format(log_buffer, sizeof(log_buffer), "[AnimationController] Applied settings directly to camera for position %d.", static_cast<int>(g_current_pos));
-                            g_anim_ctx->loadAPI->logger->Log(g_anim_ctx->loggerHandle, SPF_LOG_DEBUG, log_buffer);
-                        }
-                    }
-                }
-
-                // Notify the CameraHookManager that settings have changed so it can re-evaluate its state.
-                // This needs to happen regardless of the current position.
-                CameraHookManager::NotifySettingsUpdated();
-                
-                // Reset the flag ONLY after the settings have been applied.
-                g_settings_dirty = false;
+                return true;
             }
         }
+        return false;
+    }
 
-        // --- Handle pending chained animation ---
-        if (HasPendingMoves())
+    /**
+     * @brief Reacts to the scheduler's Settled event: starts what waited for the camera to come to rest.
+     */
+    static void OnCameraSettled()
+    {
+        if (g_azimuth_notify_on_settle)
         {
-            // Check if we are in a neutral, non-animating state before triggering the next move
-            if (!IsAnimating() && !StandingAnimController::IsAnimating() && StandingAnimController::GetCurrentStance() == StandingAnimController::Stance::Standing)
-            {
-                CameraPosition next_move = g_pending_moves.front();
-                g_pending_moves.pop();
-                MoveTo(next_move); // Trigger the next move in the sequence
-                return; // The new MoveTo call will handle the rest of this frame
-            }
+            g_azimuth_notify_on_settle = false;
+            CameraHookManager::NotifySettingsUpdated();
         }
 
-        // --- 1. Handle Major Transitions ---
-        if (g_active_sequence && g_active_sequence->IsPlaying())
+        // --- A request that had to wait for a stance animation ---
+        if (g_deferred_request != CameraPosition::None)
         {
-            SPF_Timestamps timestamps;
-            g_anim_ctx->coreAPI->telemetry->Tel_GetTimestamps(g_anim_ctx->telemetryHandle, &timestamps, sizeof(SPF_Timestamps));
-            uint64_t delta_time_ms = timestamps.simulation - last_simulation_time;
-            last_simulation_time = timestamps.simulation;
-
-            bool is_playing = g_active_sequence->Update(delta_time_ms, g_anim_ctx->cameraAPI);
-
-            if (!is_playing)
+            const CameraPosition request = g_deferred_request;
+            g_deferred_request = CameraPosition::None;
+            ClearPendingMoves();
+            if (OnRequestMove(request))
             {
-                // Major animation finished
-                g_active_sequence.reset();
-                g_current_pos = g_target_pos;
-                CameraHookManager::SetCurrentCameraPosition(g_current_pos);
-
-                // If we arrived at the standing position, notify the standing controller
-                if (g_current_pos == CameraPosition::Standing)
-                {
-                    StandingAnimController::OnEnterStandingState();
-                }
-
-                // --- Immediately trigger the next move in the chain if one exists ---
-                if (HasPendingMoves())
-                {
-                    // Ensure we are in a neutral state before proceeding
-                    if (!IsAnimating() && !StandingAnimController::IsAnimating())
-                    {
-                        CameraPosition next_move = g_pending_moves.front();
-                        g_pending_moves.pop();
-                        MoveTo(next_move);
-                        return; // The new MoveTo call will handle the rest of this frame
-                    }
-                }
+                return;
             }
         }
-        // --- 2. Handle Standing "Sub-State" Animations ---
-        else if (g_current_pos == CameraPosition::Standing)
+
+        // --- The next leg of a chained move, e.g. once a stance change or a transition has finished ---
+        if (StartNextLeg())
         {
-            Animation::CurrentCameraState current_state;
-            g_anim_ctx->cameraAPI->Cam_GetInteriorSeatPos(&current_state.position.x, &current_state.position.y, &current_state.position.z);
-            g_anim_ctx->cameraAPI->Cam_GetInteriorHeadRot(&current_state.rotation.x, &current_state.rotation.y);
-            current_state.rotation.z = 0.0f; // Roll is not retrieved
+            return;
+        }
 
-            StandingAnimController::Update(current_state);
+        // --- A settings change made while the camera moved ---
+        if (g_settings_dirty)
+        {
+            StartPosePreview();
         }
     }
 
-    void MoveTo(CameraPosition target)
+    void Update(const FrameContext& frame)
     {
-        if ((g_active_sequence && g_active_sequence->IsPlaying()) || StandingAnimController::IsAnimating())
+        SPF_CABINWALK_PROFILE_ZONE(AnimationControllerUpdate);
+
+        if (!g_anim_ctx || !g_anim_ctx->coreAPI)
         {
-            return; // Animation already in progress in this or sub-controller
+            return;
         }
 
-        if (target == g_current_pos)
+        if (DebugOverlay::IsEnabled())
         {
-            return; // Already at target position
+            DebugOverlay::PublishTransition(AnimationScheduler::GetTransition(), static_cast<int32_t>(g_current_pos), static_cast<int32_t>(g_target_pos));
         }
 
-        if (!g_anim_ctx || !g_anim_ctx->cameraAPI)
+        UpdateAllocationRate();
+        UpdateRebake();
+
+        // --- Swap animation assets while no transition points into them ---
+        if (!IsAnimating())
         {
-            return; // API not ready
+            if (g_anim_ctx->settings.animation_assets.hot_reload && AnimationAssets::HasChangedOnDisk())
+            {
+                g_assets_reload_pending = true;
+            }
+            if (g_assets_reload_pending)
+            {
+                LoadAnimationAssets();
+            }
         }
 
-        // --- STANCE-BASED TRANSITIONS ---
-        if (g_current_pos == CameraPosition::Standing && (target == CameraPosition::Driver || target == CameraPosition::Passenger || target == CameraPosition::SofaSit1))
+        if (g_pose_preview_active)
         {
-            StandingAnimController::Stance current_stance = StandingAnimController::GetCurrentStance();
+            UpdatePosePreview();
+        }
 
-            if (current_stance != StandingAnimController::Stance::Standing)
+        // Notify the CameraHookManager once the settings have stopped changing, so it can re-evaluate its state.
+        // This needs to happen regardless of the current position; a camera that is moving has it sent once it settles.
+        if (g_azimuth_settings_dirty && std::chrono::steady_clock::now() - g_last_settings_change >= AZIMUTH_SETTINGS_DEBOUNCE)
+        {
+            g_azimuth_settings_dirty = false;
+            if (IsCameraSettled())
             {
-                // Not in the base standing stance, so we need to transition to it first.
-                QueueMove(target); // Set the final destination
-
-                if (current_stance == StandingAnimController::Stance::Crouching)
-                {
-                    StandingAnimController::TriggerStandUp();
-                }
-                else if (current_stance == StandingAnimController::Stance::Tiptoes)
-                {
-                    StandingAnimController::TriggerStandDown();
-                }
-                // InTransition and WalkingToFinalDestination are busy states, IsAnimating() check should have caught them.
-                return; // Exit, the Update loop will handle the pending move later.
+                CameraHookManager::NotifySettingsUpdated();
             }
-            
-            // If we get here, stance is Standing, so check if we need to walk.
-            float target_z = GetTargetZForPosition(target);
+            else
+            {
+                g_azimuth_notify_on_settle = true;
+            }
+        }
 
-            if (target == CameraPosition::Driver || target == CameraPosition::Passenger)
+        // --- Advance every motion: the transition, or the standing stance and walk ---
+        uint32_t events = 0;
+        const bool stepped = AnimationScheduler::Update(frame, &events);
+        if (AnimationScheduler::GetTransition())
+        {
+            // A step by the camera hook has been reacted to already.
+            const bool is_playing = stepped ? OnTransitionStep(events) : AnimationScheduler::IsTransitionPlaying();
+            if (!is_playing)
             {
-                // Special logic for seats: only walk if Z is non-negative
-                Animation::CurrentCameraState current_state;
-                g_anim_ctx->cameraAPI->Cam_GetInteriorSeatPos(&current_state.position.x, &current_state.position.y, &current_state.position.z);
+                // Major animation finished. Its Arrive event has made the target the current position, and
+                // its end settles the camera, which starts the next leg of the chain on this frame.
+                AnimationScheduler::StopTransition();
+            }
+        }
 
-                if (current_state.position.z < 0)
-                {
-                    // Z is negative, sit immediately by falling through
-                }
-                else
-                {
-                    // Z is non-negative, check if a walk is needed
-                    if (!StandingAnimController::CanSitDown(target, target_z))
-                    {
-                        return; // Walk was initiated
-                    }
-                }
+        // --- React to what the scheduler fired; a move started by a reaction is reported in turn ---
+        for (uint32_t fired = AnimationScheduler::TakeEvents(); fired != 0; fired = AnimationScheduler::TakeEvents())
+        {
+            if (fired & AnimationScheduler::EventBit(AnimationScheduler::Event::Started))
+            {
+                StopPosePreview();
             }
-            else if (target == CameraPosition::SofaSit1)
+            if (fired & AnimationScheduler::EventBit(AnimationScheduler::Event::Settled))
             {
-                // Generic logic for sofa: always walk if not at the target Z
-                if (!StandingAnimController::CanSitDown(target, target_z))
-                {
-                    return; // Walk was initiated
-                }
+                OnCameraSettled();
             }
-            // If we can sit immediately, fall through to the normal transition logic below.
         }
+    }
 
-        // --- NORMAL TRANSITION LOGIC ---
-        // Cache current camera state before starting animation
-        Animation::CurrentCameraState initial_state;
-        g_anim_ctx->cameraAPI->Cam_GetInteriorSeatPos(&initial_state.position.x, &initial_state.position.y, &initial_state.position.z);
-        g_anim_ctx->cameraAPI->Cam_GetInteriorHeadRot(&initial_state.rotation.x, &initial_state.rotation.y); // .x=yaw, .y=pitch
-        initial_state.rotation.z = 0.0f; // Roll is not retrieved by GetInteriorHeadRot
+    bool IsIdle()
+    {
+        return g_current_pos == CameraPosition::Driver && !AnimationScheduler::GetTransition() && !AnimationScheduler::GetFadingTransition() && !HasPendingMoves() &&
+               g_deferred_request == CameraPosition::None && !g_settings_dirty && !g_pose_preview_active &&
+               !g_azimuth_settings_dirty && !g_azimuth_notify_on_settle && !g_assets_reload_pending && !g_rebake_pending && !g_bake_running;
+    }
+
+    void AdvanceFromCameraHook(float delta_time)
+    {
+        if (!g_anim_ctx || !g_anim_ctx->settings.performance.hook_driven_animation)
+        {
+            return;
+        }
+
+        uint32_t events = 0;
+        if (AnimationScheduler::AdvanceFromCameraHook(delta_time, &events))
+        {
+            OnTransitionStep(events);
+        }
+    }
 
+    /**
+     * @brief Starts the registered transition from g_current_pos to `target`, or snaps there if there is none.
+     * @param target The position to move to.
+     * @param initial_state The camera state the transition starts from.
+     * @param cache_driver_state Whether leaving the driver's seat should remember its pose for the way back.
+     *        False when retargeting, where the camera is not actually in the seat.
+     * @return False if no sequence could be built for the transition, so the camera stays where it is.
+     */
+    static bool StartTransition(CameraPosition target, const Animation::CurrentCameraState& initial_state, bool cache_driver_state)
+    {
         // Look up the factory for the transition
-        auto it = g_sequence_factory.find({g_current_pos, target});
-        if (it != g_sequence_factory.end())
+        const bool is_registered = static_cast<size_t>(g_current_pos) < POSITION_COUNT && static_cast<size_t>(target) < POSITION_COUNT &&
+                                   g_transitions[static_cast<size_t>(g_current_pos)][static_cast<size_t>(target)].factory;
+        if (is_registered)
         {
             // If moving away from the driver's seat, cache its current state for the return trip.
-            if (g_current_pos == CameraPosition::Driver)
+            if (cache_driver_state && g_current_pos == CameraPosition::Driver)
             {
                 g_cached_driver_state = initial_state;
             }
@@ -344,15 +1376,19 @@ namespace SPF_CabinWalk::AnimationController
             }
 
             // Found a factory, create the sequence and start it
-            SPF_Timestamps timestamps;
-            g_anim_ctx->coreAPI->telemetry->Tel_GetTimestamps(g_anim_ctx->telemetryHandle, &timestamps, sizeof(SPF_Timestamps));
-            last_simulation_time = timestamps.simulation; // Reset time for new animation
-
-            g_active_sequence = it->second(initial_state, animation_target_state);
+            std::unique_ptr<Animation::AnimationSequence> owned;
+            Animation::AnimationSequence* sequence = AcquireTransitionSequence(g_current_pos, target, initial_state, animation_target_state, owned);
+            if (!sequence)
+            {
+                AnimationScheduler::EndFade();
+                return false;
+            }
 
-            g_active_sequence->Start(initial_state);
+            StopPosePreview();
+            StandingAnimController::OnLeaveStandingState();
+            SetTransitionEvents(*sequence);
+            AnimationScheduler::PlayTransition(sequence, std::move(owned), initial_state);
             g_target_pos = target;
-
         }
         else
         {
@@ -360,31 +1396,27 @@ namespace SPF_CabinWalk::AnimationController
             // This case should ideally not happen if all transitions are defined
             g_current_pos = target;
             g_target_pos = target;
-            g_active_sequence.reset();
+            AnimationScheduler::StopTransition();
+            StopPosePreview();
+            StandingAnimController::OnLeaveStandingState();
 
             // Direct snap to target using settings or cached driver state
             if (target == CameraPosition::Driver)
             {
-                if (g_anim_ctx->cameraAPI)
-                {
-                    g_anim_ctx->cameraAPI->Cam_SetInteriorSeatPos(g_cached_driver_state.position.x,
-                                                               g_cached_driver_state.position.y,
-                                                               g_cached_driver_state.position.z);
-                    g_anim_ctx->cameraAPI->Cam_SetInteriorHeadRot(g_cached_driver_state.rotation.x,
-                                                               g_cached_driver_state.rotation.y);
-                }
+                CameraFacade::SetSeatPos(g_cached_driver_state.position.x,
+                                         g_cached_driver_state.position.y,
+                                         g_cached_driver_state.position.z);
+                CameraFacade::SetHeadRot(g_cached_driver_state.rotation.x,
+                                         g_cached_driver_state.rotation.y);
             }
             else
             {
                 const auto& target_transform = GetTargetTransformForPosition(target);
-                if (g_anim_ctx->cameraAPI)
-                {
-                    g_anim_ctx->cameraAPI->Cam_SetInteriorSeatPos(target_transform.position.x,
-                                                               target_transform.position.y,
-                                                               target_transform.position.z);
-                    g_anim_ctx->cameraAPI->Cam_SetInteriorHeadRot(target_transform.rotation.x,
-                                                               target_transform.rotation.y);
-                }
+                CameraFacade::SetSeatPos(target_transform.position.x,
+                                         target_transform.position.y,
+                                         target_transform.position.z);
+                CameraFacade::SetHeadRot(target_transform.rotation.x,
+                                         target_transform.rotation.y);
             }
             // Special handling for Standing position reset stance
             if (target == CameraPosition::Standing)
@@ -393,121 +1425,300 @@ namespace SPF_CabinWalk::AnimationController
             }
             CameraHookManager::SetCurrentCameraPosition(target);
         }
+        return true;
     }
 
-    bool IsAnimating()
+    /**
+     * @brief Starts the next leg of the route early if it joins seamlessly and the active leg is nearly done.
+     * @details The active leg is treated as having arrived, and the next one starts from the pose the camera
+     *          is in right now while the active one plays out underneath it, faded out over the time it has
+     *          left. Both legs are moving through the cross-fade, so the camera flows through the intermediate
+     *          position instead of stopping on it, and no frame passes without a leg playing.
+     * @return True if the next leg was started.
+     */
+    static bool JoinNextLeg()
     {
-        return g_active_sequence && g_active_sequence->IsPlaying();
-    }
+        if (!HasPendingMoves() || !g_route.legs[g_route.head].seamless || AnimationScheduler::GetFadingTransition())
+        {
+            return false;
+        }
 
-    CameraPosition GetCurrentPosition()
-    {
-        return g_current_pos;
+        // Fired by the JoinNextLeg marker; a step that also finished the leg arrives instead.
+        const uint64_t remaining_us = AnimationScheduler::GetTransition()->GetRemainingTime();
+        if (remaining_us == 0)
+        {
+            return false;
+        }
+
+        const CameraPosition next_move = PopLeg();
+        const Animation::CurrentCameraState in_flight_state = LayerStack::Evaluate();
+        AnimationScheduler::FadeOutTransition(remaining_us);
+
+        // --- Arrive at the intermediate position ---
+        ArriveAtTarget();
+
+        Latency::Arm(Latency::Metric::ChainGap, InputQueue::NowMicroseconds());
+        StartTransition(next_move, in_flight_state, false);
+        return true;
     }
 
-    void OnRequestMove(CameraPosition final_destination)
+    bool MoveTo(CameraPosition target)
     {
-        // Don't start a new sequence if one is already in progress
-        if (HasPendingMoves() || IsAnimating() || StandingAnimController::IsAnimating())
+        if (!IsCameraSettled())
         {
-            return;
+            return false; // Animation already in progress in this or sub-controller
         }
 
-        CameraPosition current_pos = GetCurrentPosition();
-        if (current_pos == final_destination)
+        if (target == g_current_pos)
         {
-            return;
+            return false; // Already at target position
         }
 
-        ClearPendingMoves();
-
-        // --- Path definitions ---
-
-        // -- Specific Path: Seat-to-Seat --
-        if ((current_pos == CameraPosition::Driver && final_destination == CameraPosition::Passenger) ||
-            (current_pos == CameraPosition::Passenger && final_destination == CameraPosition::Driver))
+        if (!g_anim_ctx || !g_anim_ctx->cameraAPI)
         {
-            // This is a direct, single-animation move.
-            QueueMove(final_destination);
+            return false; // API not ready
         }
-        // -- Paths originating from the Sofa --
-        else if (current_pos == CameraPosition::SofaLie || current_pos == CameraPosition::SofaSit2 || current_pos == CameraPosition::SofaSit1)
+
+        // Requests arrive from keybinds as well as from Update, so the pose is read here rather than taken
+        // from the FrameContext; the facade keeps it cached for the frame.
+        const Animation::CurrentCameraState current_state = CameraFacade::GetState();
+
+        // --- STANCE-BASED TRANSITIONS ---
+        if (g_current_pos == CameraPosition::Standing && (target == CameraPosition::Driver || target == CameraPosition::Passenger || target == CameraPosition::SofaSit1))
         {
-            bool needs_to_stand = (final_destination == CameraPosition::Standing || final_destination == CameraPosition::Driver || final_destination == CameraPosition::Passenger);
+            StandingAnimController::Stance current_stance = StandingAnimController::GetCurrentStance();
 
-            // Step 1: Get to SofaSit1 if not already there.
-            if (current_pos == CameraPosition::SofaLie)
-            {
-                QueueMove(CameraPosition::SofaSit1);
-            }
-            else if (current_pos == CameraPosition::SofaSit2)
+            if (current_stance != StandingAnimController::Stance::Standing)
             {
-                QueueMove(CameraPosition::SofaSit1);
+                // Not in the base standing stance, so we need to transition to it first.
+                QueueMove(target); // Set the final destination
+
+                if (current_stance == StandingAnimController::Stance::Crouching)
+                {
+                    StandingAnimController::TriggerStandUp(current_state);
+                }
+                else if (current_stance == StandingAnimController::Stance::Tiptoes)
+                {
+                    StandingAnimController::TriggerStandDown(current_state);
+                }
+                // InTransition and WalkingToFinalDestination are busy states, IsAnimating() check should have caught them.
+                return true; // Exit, the pending move starts once the stance change has settled the camera.
             }
+            
+            // If we get here, stance is Standing, so check if we need to walk.
+            float target_z = GetTargetZForPosition(target);
 
-            // Step 2: Stand up if the destination is off the sofa.
-            if (needs_to_stand)
+            if (target == CameraPosition::Driver || target == CameraPosition::Passenger)
             {
-                QueueMove(CameraPosition::Standing);
+                // Special logic for seats: only walk if Z is non-negative
+                if (current_state.position.z < 0)
+                {
+                    // Z is negative, sit immediately by falling through
+                }
+                else
+                {
+                    // Z is non-negative, check if a walk is needed
+                    if (!StandingAnimController::CanSitDown(target, target_z, current_state))
+                    {
+                        return true; // Walk was initiated
+                    }
+                }
             }
-
-            // Step 3: Add final destination if it's not an intermediate step.
-            if (g_pending_moves.empty() || g_pending_moves.back() != final_destination)
+            else if (target == CameraPosition::SofaSit1)
             {
-                QueueMove(final_destination);
+                // Generic logic for sofa: always walk if not at the target Z
+                if (!StandingAnimController::CanSitDown(target, target_z, current_state))
+                {
+                    return true; // Walk was initiated
+                }
             }
+            // If we can sit immediately, fall through to the normal transition logic below.
+        }
+
+        // --- NORMAL TRANSITION LOGIC ---
+        return StartTransition(target, current_state, true);
+    }
+
+    bool IsAnimating()
+    {
+        // A sequence finished by the camera hook stays active until Update() has processed its completion.
+        return AnimationScheduler::GetTransition() != nullptr;
+    }
+
+    bool IsCameraSettled()
+    {
+        return AnimationScheduler::IsSettled();
+    }
+
+    CameraPosition GetCurrentPosition()
+    {
+        return g_current_pos;
+    }
+
+    bool GetActiveTransition(CameraPosition *from, CameraPosition *to, float *progress)
+    {
+        const Animation::AnimationSequence* transition = AnimationScheduler::GetTransition();
+        if (!transition)
+        {
+            return false;
         }
-        // -- Paths originating from the Seats (to non-seat destinations) --
-        else if (current_pos == CameraPosition::Driver || current_pos == CameraPosition::Passenger)
+
+        *from = g_current_pos;
+        *to = g_target_pos;
+        *progress = transition->GetProgress();
+        return true;
+    }
+
+    uint64_t GetSequenceAllocationsPerSecond()
+    {
+        return g_allocations_per_second;
+    }
+
+    /**
+     * @brief Compiles the fastest route from `origin` to `final_destination` into the pending legs.
+     */
+    static void QueueRoute(CameraPosition origin, CameraPosition final_destination)
+    {
+        if (g_routes_stale)
         {
-            // To go anywhere ELSE from a seat, we must stand up first.
-            QueueMove(CameraPosition::Standing);
+            BuildRouteTable();
+        }
 
-            if (final_destination != CameraPosition::Standing)
+        const size_t to = static_cast<size_t>(final_destination);
+        size_t from = static_cast<size_t>(origin);
+        if (from < POSITION_COUNT && to < POSITION_COUNT && g_route_next[from][to] != CameraPosition::None)
+        {
+            // Bounded by the position count, so a table that has not been built yet can never loop forever.
+            // The first hop is started directly; every later one is checked once, here, for a seamless join.
+            for (size_t hops = 0; from != to && hops < POSITION_COUNT; ++hops)
             {
-                QueueMove(final_destination);
+                const CameraPosition hop = g_route_next[from][to];
+                PushLeg(hop, hops > 0 && CanJoinSeamlessly(static_cast<CameraPosition>(from), hop));
+                from = static_cast<size_t>(hop);
             }
         }
-        // -- All other direct paths --
         else
         {
+            // No registered route; MoveTo snaps straight to the destination.
             QueueMove(final_destination);
         }
+    }
+
+    /**
+     * @brief Redirects an in-flight transition to a new destination.
+     * @details The interrupted transition is treated as having arrived at its target, the route is
+     *          planned from there, and its first hop starts from the pose the camera is in right now
+     *          while the interrupted sequence fades out underneath it.
+     * @return False if the transition was already heading there.
+     */
+    static bool Retarget(CameraPosition final_destination)
+    {
+        ClearPendingMoves();
+
+        const CameraPosition origin = g_target_pos;
+        if (origin == final_destination)
+        {
+            return false; // Already heading there; only the rest of the old chain is dropped.
+        }
+
+        QueueRoute(origin, final_destination);
+        const CameraPosition first_hop = PopLeg();
+
+        const Animation::CurrentCameraState in_flight_state = AnimationScheduler::GetTransition()->Evaluate();
+
+        // A fade that is still running is cut short; only the most recent transition fades out.
+        AnimationScheduler::FadeOutTransition(RETARGET_BLEND_US);
+        g_current_pos = origin;
+
+        StartTransition(first_hop, in_flight_state, false);
+        return true;
+    }
+
+    bool OnRequestMove(CameraPosition final_destination)
+    {
+        // A transition in progress is redirected rather than waited for.
+        if (IsAnimating())
+        {
+            g_deferred_request = CameraPosition::None;
+            return Retarget(final_destination);
+        }
+
+        // Walking is simply stopped; a stance animation is short and is allowed to finish first.
+        if (StandingAnimController::IsAnimating() && !StandingAnimController::CancelWalk())
+        {
+            g_deferred_request = final_destination;
+            return false;
+        }
+
+        CameraPosition current_pos = GetCurrentPosition();
+        if (current_pos == final_destination)
+        {
+            return false;
+        }
+
+        ClearPendingMoves();
+
+        // --- Queue every hop of the fastest route ---
+        QueueRoute(current_pos, final_destination);
 
         // --- Start the sequence ---
-        if (HasPendingMoves())
+        if (!HasPendingMoves())
         {
-            CameraPosition next_move = g_pending_moves.front();
-            g_pending_moves.pop();
-            MoveTo(next_move);
+            return false;
         }
+
+        // A transition, a walk towards the seat or the stance change that precedes it.
+        return MoveTo(PopLeg());
     }
 
     void QueueMove(CameraPosition target)
     {
-        g_pending_moves.push(target);
+        PushLeg(target, false);
     }
 
     void ClearPendingMoves()
     {
-        while (!g_pending_moves.empty())
+        g_route.head = 0;
+        g_route.count = 0;
+    }
+
+    bool HasPendingMoves()
+    {
+        return g_route.count != 0;
+    }
+
+    /**
+     * @brief Fills a cell of the transition table; see RegisterSequence().
+     */
+    static void RegisterTransition(CameraPosition from, CameraPosition to, Animation::SequenceFactory factory, const Animation::Reversal* reversal)
+    {
+        if (static_cast<size_t>(from) >= POSITION_COUNT || static_cast<size_t>(to) >= POSITION_COUNT || from == to)
         {
-            g_pending_moves.pop();
+            return;
+        }
+
+        g_transitions[static_cast<size_t>(from)][static_cast<size_t>(to)] = {factory, reversal};
+
+        // Any bake of a previously registered factory for this transition is now stale, and so are the routes,
+        // and a reversal sharing its keys. A cell still playing is reset once it stops (ResetCell); a rebake
+        // still running resets the cells when it is published.
+        ResetCell(*g_front_bakes, static_cast<size_t>(from), static_cast<size_t>(to));
+        if (g_transitions[static_cast<size_t>(to)][static_cast<size_t>(from)].reversal)
+        {
+            ResetCell(*g_front_bakes, static_cast<size_t>(to), static_cast<size_t>(from));
         }
+        g_routes_stale = true;
+        g_prewarmed_pos = CameraPosition::None;
     }
 
-    bool HasPendingMoves()
+    void RegisterSequence(CameraPosition from, CameraPosition to, Animation::SequenceFactory factory)
     {
-        return !g_pending_moves.empty();
+        RegisterTransition(from, to, factory, nullptr);
     }
 
-    void RegisterSequence(
-        CameraPosition from,
-        CameraPosition to,
-        std::function<std::unique_ptr<Animation::AnimationSequence>(const Animation::CurrentCameraState& start_state, const Animation::CurrentCameraState& target_state)> factory
-    )
+    void RegisterReversedSequence(CameraPosition from, CameraPosition to, const Animation::Reversal& reversal)
     {
-        g_sequence_factory[{from, to}] = factory;
+        RegisterTransition(from, to, reversal.factory, &reversal);
     }
 
     float GetTargetZForPosition(CameraPosition pos)
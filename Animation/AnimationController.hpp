@@ -1,19 +1,23 @@
 #pragma once
 #include <SPF_TelemetryData.h>
-#include <map>
-#include <functional>
 #include <memory> // For std::unique_ptr
-#include <queue>  // For std::queue
 
 // Include new animation system components
 #include "Animation/AnimationSequence.hpp"
 #include "Animation/Keyframe.hpp"
 #include "Animation/Track.hpp"
+#include "Animation/BakedTransition.hpp" // For Animation::SequenceFactory
+#include "Animation/FrameContext.hpp"
 #include "Animation/Positions/CameraPositions.hpp" // For CameraPositions::Transform, not for CameraPosition enum
 
 // Forward declare PluginContext
 struct PluginContext;
 
+namespace SPF_CabinWalk::Animation
+{
+    struct Reversal; // See Animation/ReversedTransition.hpp
+}
+
 namespace SPF_CabinWalk
 {
     namespace AnimationController
@@ -50,70 +54,170 @@ namespace SPF_CabinWalk
          */
         void Initialize(PluginContext *ctx);
 
+        /**
+         * @brief Waits for a transition rebake that is still running. Must be called before the plugin unloads.
+         */
+        void Shutdown();
+
         /**
          * @brief Updates the current animation state. Should be called every frame.
+         * @details Decides what moves, runs the AnimationScheduler to move it, and reacts to what the
+         *          transition reached.
+         * @param frame The frame's clock, camera pose and input state, sampled once in OnUpdate.
          */
-        void Update();
+        void Update(const FrameContext& frame);
+
+        /**
+         * @brief Advances the active transition from inside the camera update hook.
+         * @details Only does anything when `settings.performance.hook_driven_animation` is enabled. The
+         *          sequence is then evaluated once per rendered frame, right before the game consumes the
+         *          camera state, using the engine's own frame delta. Update() still handles completion and
+         *          chaining, and falls back to the telemetry clock on frames where the hook did not run.
+         * @param delta_time The frame time passed to the hooked function, in seconds.
+         */
+        void AdvanceFromCameraHook(float delta_time);
 
         /**
          * @brief Starts a transition to the specified target camera position.
          * @param target The desired camera position.
+         * @return True if a move started: the transition, or the walk or stance change that must precede it.
          */
-        void MoveTo(CameraPosition target);
+        bool MoveTo(CameraPosition target);
 
         /**
          * @brief Main entry point to build and initiate a sequence of moves to a final destination.
+         * @details Queues the fastest route through the registered transitions, looked up in a table that is
+         *          rebuilt on Initialize() and whenever the transition durations change.
+         *          A request made while a transition plays redirects it at once, cross-fading from the
+         *          in-flight pose; one made during a stance animation starts as soon as that finishes.
          * @param final_destination The ultimate target position for the entire sequence.
+         * @return True if the request started a move or redirected the one in flight; false if it was
+         *         deferred behind a stance animation or left nothing new to do.
         */
-        void OnRequestMove(CameraPosition final_destination);
+        bool OnRequestMove(CameraPosition final_destination);
 
         /**
-         * @brief Adds a camera position to the back of the pending moves queue.
+         * @brief Adds a camera position to the back of the pending route.
+         * @details The leg waits for the camera to settle before it starts. Does nothing if the route is full.
          * @param target The next desired camera position in a sequence.
          */
         void QueueMove(CameraPosition target);
 
         /**
-         * @brief Clears the entire queue of pending moves.
+         * @brief Clears every pending leg of the route.
          */
         void ClearPendingMoves();
 
         /**
-         * @brief Checks if there are any moves waiting in the queue.
-         * @return true if the pending moves queue is not empty, false otherwise.
+         * @brief Checks if there are any legs of the route waiting to be played.
+         * @return true if the pending route is not empty, false otherwise.
          */
         bool HasPendingMoves();
 
         /**
          * @brief Notifies the animation controller that global settings have been updated.
+         * @details Calls are coalesced: the pose of the current position is eased toward the new values
+         *          once per frame, and the camera hook re-evaluates its azimuth state once the settings
+         *          have stopped changing for a short while.
         */
         void NotifySettingsUpdated();
 
         /**
-         * @brief Checks if an animation is currently in progress.
+         * @brief Notifies the controller that only settings feeding the azimuth profiles have changed.
+         * @details The camera hook re-evaluation is debounced like in NotifySettingsUpdated().
+         */
+        void NotifyAzimuthSettingsUpdated();
+
+        /**
+         * @brief Reloads `settings.animation_assets.file` as soon as no transition is playing.
+         * @details A configured file that does not exist yet is first written from the built-in curves.
+         *          With `settings.animation_assets.hot_reload`, edits to the file are picked up the same way.
+         */
+        void ReloadAnimationAssets();
+
+        /**
+         * @brief Called after the settings have been reloaded from the config system.
+         * @details Refreshes the settings hash that the baked transition cache is validated against. If the
+         *          cache is stale, it is rebaked on a worker thread and swapped in at the start of a later
+         *          frame; moves started before that build their sequences directly.
+         */
+        void OnSettingsReloaded();
+
+        /**
+         * @brief Checks if a transition between positions is in progress.
          * @return true if the camera is currently animating, false otherwise.
          */
         bool IsAnimating();
 
+        /**
+         * @brief Checks that neither this controller nor the StandingAnimController is moving the camera.
+         * @details The two controllers still own their own motion state; this is the one place their busy
+         *          states are joined, for every check that must wait for both.
+         */
+        bool IsCameraSettled();
+
+        /**
+         * @brief Checks whether the controller has no per-frame work left: seated in the driver position,
+         *        with no transition, queued or deferred move, pose preview or pending settings work.
+         */
+        bool IsIdle();
+
+        /**
+         * @brief Prepares the transitions out of the current position, so that the next move binds a bake
+         *        and follows a built route instead of constructing either on the keypress frame.
+         * @details Bakes both variants of every outgoing transition not yet baked for the current settings,
+         *          and rebuilds the route table if it is stale. Cheap to call every frame: it does nothing
+         *          while animating, while a rebake is outstanding, or once done for this position until a
+         *          bake, registration, asset or settings change undoes it.
+         * @return True if it prepared the position this call.
+         */
+        bool PrewarmOutgoingTransitions();
+
         /**
          * @brief Gets the current logical position of the camera.
          * @return The current CameraPosition.
          */
         CameraPosition GetCurrentPosition();
 
+        /**
+         * @brief Debug statistic: heap allocations made by sequence builders during the last second.
+         * @details Should stay at zero while walking or changing stance once the pools have warmed up.
+         */
+        uint64_t GetSequenceAllocationsPerSecond();
+
+        /**
+         * @brief Gets the transition that is currently playing.
+         * @param[out] from The position the transition started from.
+         * @param[out] to The position it is heading to.
+         * @param[out] progress The normalized progress of the transition.
+         * @return false if no transition is playing (the outputs are left untouched).
+         */
+        bool GetActiveTransition(CameraPosition *from, CameraPosition *to, float *progress);
+
         /**
          * @brief Registers an animation sequence factory for a given transition.
          * @param from The starting camera position.
          * @param to The target camera position.
-         * @param factory A function that creates a unique_ptr to an AnimationSequence,
-         *                optionally taking the initial camera state.
+         * @param factory A function that creates a unique_ptr to an AnimationSequence from the start and
+         *                target camera states. Replaces any factory registered for the same transition.
+         * @details Safe while the transition plays: its bakes are kept until it has finished and faded out,
+         *          and moves started in the meantime run the new factory directly.
          */
         void RegisterSequence(
             CameraPosition from,
             CameraPosition to,
-            std::function<std::unique_ptr<Animation::AnimationSequence>(const Animation::CurrentCameraState& start_state, const Animation::CurrentCameraState& target_state)> factory
+            Animation::SequenceFactory factory
         );
 
+        /**
+         * @brief Registers a transition that plays the one registered from `to` to `from` backwards.
+         * @details Its bakes share the keys of that transition's bake and only hold the channels the
+         *          reversal overrides, so the pair is baked, and kept in memory, about once. Otherwise
+         *          behaves like RegisterSequence().
+         * @param reversal Describes the reversal, e.g. `Animation::REVERSAL_OF<F>` where F is the factory
+         *                 registered from `to` to `from`. Must outlive the registration.
+         */
+        void RegisterReversedSequence(CameraPosition from, CameraPosition to, const Animation::Reversal& reversal);
 
         /**
          * @brief Helper function to get the target Z-coordinate for a given CameraPosition.
@@ -0,0 +1,533 @@
+#include "Animation/AnimationScheduler.hpp"
+#include "Animation/LayerStack.hpp"
+#include "Animation/StandingAnimController.hpp"
+#include "Diagnostics/Profiler.hpp"
+
+#include <cstring>
+#include <iterator>
+
+namespace SPF_CabinWalk::AnimationScheduler
+{
+    // =================================================================================================
+    // Internal State
+    // =================================================================================================
+
+    // --- Events ---
+    // Fired since the last TakeEvents().
+    static uint32_t g_events = 0;
+    // Whether the camera was at rest when last checked; Started and Settled fire when that changes.
+    static bool g_settled = true;
+
+    // --- Transition ---
+    // The playing transition. Points either into a bake set or at g_owned_sequence.
+    static Animation::AnimationSequence *g_active_sequence = nullptr;
+    // Owns the sequence of a transition that could not be baked.
+    static std::unique_ptr<Animation::AnimationSequence> g_owned_sequence = nullptr;
+    // A transition interrupted by the active one, or the previous leg of a route the active one joined. It
+    // keeps playing underneath while the active one fades in, so the camera never jumps or stops dead.
+    static Animation::AnimationSequence *g_fading_sequence = nullptr;
+    static std::unique_ptr<Animation::AnimationSequence> g_fading_owned_sequence = nullptr;
+    static uint64_t g_fade_elapsed_us = 0;
+    static uint64_t g_fade_duration_us = 0;
+    // Set by AdvanceFromCameraHook when it advanced the active sequence since the last Update().
+    static bool g_hook_advanced_sequence = false;
+    // Sub-microsecond remainder of the hook's float frame time, carried so rounding does not drift.
+    static float g_hook_time_remainder_us = 0.0f;
+
+    // --- Standing Motion ---
+    // Set between BeginStanding() and EndStanding(); the ticks only run while it is.
+    static bool g_standing = false;
+    // Stance changes are spring-driven rather than keyframed, so they can be retargeted mid-motion. The
+    // spring drives an offset from the walker's head height (the StanceOffset layer), so a crouch walks along.
+    static Animation::StanceSpring g_stance_spring;
+    // Walking is continuous rather than a chain of step sequences. It drives the Locomotion and HeadBob layers.
+    static Animation::GaitEngine g_gait;
+    static Animation::GaitParams g_gait_params = {};
+    // Where the gait may go.
+    static Animation::CabinFloor g_floor;
+    // Set by Walk() for the tick that is running.
+    static bool g_walk_requested = false;
+    static float g_walk_x = 0.0f;
+    static float g_walk_z = 0.0f;
+
+    /**
+     * @brief Fires Started or Settled if the camera has started moving, or come to rest, since the last check.
+     */
+    static void CheckSettled()
+    {
+        const bool settled = IsSettled();
+        if (settled != g_settled)
+        {
+            g_events |= EventBit(settled ? Event::Settled : Event::Started);
+            g_settled = settled;
+        }
+    }
+
+    // =================================================================================================
+    // Fixed Logic Tick
+    // =================================================================================================
+
+    // The stance spring, the gait and the standing controller's decisions advance in fixed ticks, whatever
+    // the frame rate. The layers they drive are interpolated between the last two ticks every frame, so the
+    // logic costs the same at 240 Hz as at 60 Hz and a frame-time spike is caught up in even steps instead
+    // of one large jump.
+    constexpr uint64_t LOGIC_TICK_US = 16667; // 60 Hz
+    // A longer hitch is dropped rather than caught up, so a stall never turns into a burst of ticks.
+    constexpr uint32_t MAX_TICKS_PER_FRAME = 4;
+
+    static uint64_t g_tick_accumulator_us = 0;
+
+    // A layer as the last two ticks left it.
+    struct TickLayer
+    {
+        Animation::CurrentCameraState previous = {};
+        Animation::CurrentCameraState current = {};
+        uint8_t override_channels = 0;
+        uint8_t offset_channels = 0;
+        bool is_set = false;
+    };
+
+    constexpr LayerStack::Layer TICK_LAYERS[] = {LayerStack::Layer::Locomotion, LayerStack::Layer::StanceOffset, LayerStack::Layer::HeadBob};
+    static TickLayer g_tick_layers[std::size(TICK_LAYERS)];
+
+    static TickLayer &GetTickLayer(LayerStack::Layer layer)
+    {
+        for (size_t i = 0; i < std::size(TICK_LAYERS); ++i)
+        {
+            if (TICK_LAYERS[i] == layer)
+            {
+                return g_tick_layers[i];
+            }
+        }
+        return g_tick_layers[0];
+    }
+
+    /**
+     * @brief Sets the value a layer reaches at the end of the current tick.
+     * @details A layer that was not set, or whose channels change, starts from this value instead of
+     *          interpolating from one it did not own.
+     */
+    static void SetTickLayer(LayerStack::Layer layer, const Animation::CurrentCameraState &value, uint8_t override_channels, uint8_t offset_channels = 0)
+    {
+        TickLayer &tick = GetTickLayer(layer);
+        if (!tick.is_set || tick.override_channels != override_channels || tick.offset_channels != offset_channels)
+        {
+            tick.previous = value;
+        }
+        tick.current = value;
+        tick.override_channels = override_channels;
+        tick.offset_channels = offset_channels;
+        tick.is_set = true;
+    }
+
+    /**
+     * @brief Sets a layer at once, without interpolating towards the value.
+     */
+    static void SnapTickLayer(LayerStack::Layer layer, const Animation::CurrentCameraState &value, uint8_t override_channels, uint8_t offset_channels = 0)
+    {
+        SetTickLayer(layer, value, override_channels, offset_channels);
+        GetTickLayer(layer).previous = value;
+        LayerStack::Set(layer, value, override_channels, offset_channels);
+    }
+
+    static void ClearTickLayer(LayerStack::Layer layer)
+    {
+        GetTickLayer(layer).is_set = false;
+        LayerStack::Clear(layer);
+    }
+
+    static bool AreTickLayersSettled()
+    {
+        for (const TickLayer &tick : g_tick_layers)
+        {
+            if (tick.is_set && std::memcmp(&tick.previous, &tick.current, sizeof(Animation::CurrentCameraState)) != 0)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Hands the layers to the LayerStack, `alpha` of the way from the previous tick to the last one.
+     */
+    static void PublishTickLayers(float alpha)
+    {
+        for (size_t i = 0; i < std::size(TICK_LAYERS); ++i)
+        {
+            const TickLayer &tick = g_tick_layers[i];
+            if (!tick.is_set)
+            {
+                continue;
+            }
+
+            Animation::CurrentCameraState value = tick.current;
+            value.position.x = tick.previous.position.x + (tick.current.position.x - tick.previous.position.x) * alpha;
+            value.position.y = tick.previous.position.y + (tick.current.position.y - tick.previous.position.y) * alpha;
+            value.position.z = tick.previous.position.z + (tick.current.position.z - tick.previous.position.z) * alpha;
+            value.rotation.y = tick.previous.rotation.y + (tick.current.rotation.y - tick.previous.rotation.y) * alpha;
+            LayerStack::Set(TICK_LAYERS[i], value, tick.override_channels, tick.offset_channels);
+        }
+    }
+
+    /**
+     * @brief Hands the stance spring to the StanceOffset layer.
+     * @details The pitch is levelled only while a stance changes; at rest it belongs to the player again.
+     */
+    static void PublishStance()
+    {
+        Animation::CurrentCameraState value = {};
+        value.position = {g_stance_spring.Get(Animation::SpringChannel::PositionX),
+                          g_stance_spring.Get(Animation::SpringChannel::PositionY),
+                          g_stance_spring.Get(Animation::SpringChannel::PositionZ)};
+        value.rotation.y = g_stance_spring.Get(Animation::SpringChannel::Pitch);
+        SetTickLayer(LayerStack::Layer::StanceOffset, value, g_stance_spring.IsMoving() ? LayerStack::LAYER_PITCH : 0,
+                     LayerStack::LAYER_POSITION);
+    }
+
+    /**
+     * @brief Advances the gait by one tick and hands it to the Locomotion and HeadBob layers.
+     * @param direction_x The X part of the walking direction (a unit vector), or 0 with direction_z to come to a stop.
+     * @param direction_z The Z part.
+     */
+    static void AdvanceGait(float direction_x, float direction_z, uint64_t delta_time_us)
+    {
+        if (!g_gait.IsMoving())
+        {
+            if (direction_x == 0.0f && direction_z == 0.0f)
+            {
+                return;
+            }
+            // Walk on from where the walker stands, beneath any stance offset.
+            const SPF_FVector &base = GetTickLayer(LayerStack::Layer::Locomotion).current.position;
+            g_gait.Begin(base.x, base.z, base.y, g_floor);
+        }
+
+        g_gait.Update(direction_x, direction_z, static_cast<float>(delta_time_us) / 1000000.0f, g_gait_params);
+
+        Animation::CurrentCameraState value = {};
+        value.position = {g_gait.GetX(), g_gait.GetY(), g_gait.GetZ()};
+        SetTickLayer(LayerStack::Layer::Locomotion, value, LayerStack::LAYER_POSITION);
+        value.position = {0.0f, g_gait.GetBob(), 0.0f};
+        SetTickLayer(LayerStack::Layer::HeadBob, value, 0, LayerStack::LAYER_POSITION);
+    }
+
+    /**
+     * @brief Runs one fixed tick of the standing motion.
+     * @return False if the standing controller started a move out of Standing, so no further tick should run.
+     */
+    static bool Tick(const FrameContext &frame)
+    {
+        for (TickLayer &tick : g_tick_layers)
+        {
+            tick.previous = tick.current;
+        }
+
+        // --- Advance an active stance change ---
+        uint32_t tick_events = 0;
+        if (g_stance_spring.IsMoving())
+        {
+            if (!g_stance_spring.Update(static_cast<float>(LOGIC_TICK_US) / 1000000.0f))
+            {
+                tick_events |= EventBit(Event::StanceSettled);
+            }
+            PublishStance();
+        }
+        g_events |= tick_events;
+
+        // --- Let the standing controller decide the stance and the walk ---
+        g_walk_requested = false;
+        if (!StandingAnimController::Tick(frame, LOGIC_TICK_US, tick_events) || !g_standing)
+        {
+            return false;
+        }
+
+        // --- Walk in any stance; the stance offset rides on top of the walker ---
+        if (g_walk_requested)
+        {
+            AdvanceGait(g_walk_x, g_walk_z, LOGIC_TICK_US);
+        }
+        else if (g_gait.IsMoving())
+        {
+            AdvanceGait(0.0f, 0.0f, LOGIC_TICK_US);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Runs the ticks the frame time has accumulated, then publishes their layers for this frame.
+     */
+    static void RunTicks(const FrameContext &frame)
+    {
+        g_tick_accumulator_us += frame.delta_time_us;
+        if (g_tick_accumulator_us > MAX_TICKS_PER_FRAME * LOGIC_TICK_US)
+        {
+            g_tick_accumulator_us = MAX_TICKS_PER_FRAME * LOGIC_TICK_US;
+        }
+
+        while (g_tick_accumulator_us >= LOGIC_TICK_US)
+        {
+            g_tick_accumulator_us -= LOGIC_TICK_US;
+            if (!Tick(frame))
+            {
+                return; // Left Standing; the layers were cleared for the transition.
+            }
+        }
+
+        PublishTickLayers(static_cast<float>(g_tick_accumulator_us) / static_cast<float>(LOGIC_TICK_US));
+    }
+
+    // =================================================================================================
+    // Transition
+    // =================================================================================================
+
+    /**
+     * @brief Advances the active transition and composes its pose, blended with a fading one.
+     * @details Composed right away, so whatever reads the camera later in the frame sees the new pose.
+     *          Only the active transition's events count; a fading one has handed its work over already.
+     * @return The Animation::EventBit() of each marker the step reached.
+     */
+    static uint32_t AdvanceTransition(uint64_t delta_time_us)
+    {
+        const bool is_playing = g_active_sequence->Advance(delta_time_us);
+        const uint32_t events = g_active_sequence->TakeFiredEvents();
+        Animation::CurrentCameraState state = g_active_sequence->Evaluate();
+
+        if (g_fading_sequence)
+        {
+            g_fading_sequence->Advance(delta_time_us); // Holds its last pose if it runs out first.
+            g_fade_elapsed_us += delta_time_us;
+
+            if (g_fade_elapsed_us >= g_fade_duration_us || !is_playing)
+            {
+                EndFade();
+            }
+            else
+            {
+                const float t = static_cast<float>(g_fade_elapsed_us) / static_cast<float>(g_fade_duration_us);
+                const float weight = t * t * (3.0f - 2.0f * t);
+                const Animation::CurrentCameraState old_state = g_fading_sequence->Evaluate();
+
+                state.position.x = old_state.position.x + (state.position.x - old_state.position.x) * weight;
+                state.position.y = old_state.position.y + (state.position.y - old_state.position.y) * weight;
+                state.position.z = old_state.position.z + (state.position.z - old_state.position.z) * weight;
+                state.rotation.x = Animation::WrapAngle(old_state.rotation.x + Animation::AngleDelta(old_state.rotation.x, state.rotation.x) * weight);
+                state.rotation.y = old_state.rotation.y + (state.rotation.y - old_state.rotation.y) * weight;
+            }
+        }
+
+        LayerStack::Set(LayerStack::Layer::BaseTransition, state, LayerStack::LAYER_ALL);
+        LayerStack::Compose();
+        return events;
+    }
+
+    // =================================================================================================
+    // Public Functions
+    // =================================================================================================
+
+    uint32_t TakeEvents()
+    {
+        const uint32_t events = g_events;
+        g_events = 0;
+        return events;
+    }
+
+    bool Update(const FrameContext &frame, uint32_t *fired_events)
+    {
+        SPF_CABINWALK_PROFILE_ZONE(SchedulerUpdate);
+
+        *fired_events = 0;
+
+        // The transition may already have been advanced (and even finished) by the camera hook this frame.
+        if (g_active_sequence)
+        {
+            if (g_hook_advanced_sequence)
+            {
+                // The hook owns the clock this frame; the frame delta is only used on frames it did not run.
+                g_hook_advanced_sequence = false;
+            }
+            else if (g_active_sequence->IsPlaying())
+            {
+                *fired_events = AdvanceTransition(frame.delta_time_us);
+                CheckSettled();
+                return true;
+            }
+        }
+        else if (g_standing)
+        {
+            RunTicks(frame);
+        }
+
+        CheckSettled();
+        return false;
+    }
+
+    bool AdvanceFromCameraHook(float delta_time, uint32_t *fired_events)
+    {
+        *fired_events = 0;
+        if (!g_active_sequence || !g_active_sequence->IsPlaying() || delta_time <= 0.0f)
+        {
+            return false;
+        }
+
+        const float delta_time_us = delta_time * 1000000.0f + g_hook_time_remainder_us;
+        const uint64_t whole_us = static_cast<uint64_t>(delta_time_us);
+        g_hook_time_remainder_us = delta_time_us - static_cast<float>(whole_us);
+
+        *fired_events = AdvanceTransition(whole_us);
+        g_hook_advanced_sequence = true;
+        return true;
+    }
+
+    bool IsSettled()
+    {
+        return !g_active_sequence && !IsStandingMoving();
+    }
+
+    void PlayTransition(Animation::AnimationSequence *sequence, std::unique_ptr<Animation::AnimationSequence> owned,
+                        const Animation::CurrentCameraState &initial_state)
+    {
+        g_owned_sequence = std::move(owned);
+        g_active_sequence = sequence;
+        g_active_sequence->Start(initial_state);
+        g_hook_advanced_sequence = false;
+        g_hook_time_remainder_us = 0.0f;
+        CheckSettled();
+    }
+
+    void FadeOutTransition(uint64_t duration_us)
+    {
+        g_fading_owned_sequence = std::move(g_owned_sequence);
+        g_fading_sequence = g_active_sequence;
+        g_fade_elapsed_us = 0;
+        g_fade_duration_us = duration_us;
+        g_active_sequence = nullptr;
+    }
+
+    void EndFade()
+    {
+        g_fading_sequence = nullptr;
+        g_fading_owned_sequence.reset();
+        g_fade_elapsed_us = 0;
+    }
+
+    void StopTransition()
+    {
+        g_active_sequence = nullptr;
+        g_owned_sequence.reset();
+        EndFade();
+        LayerStack::Clear(LayerStack::Layer::BaseTransition);
+        CheckSettled();
+    }
+
+    Animation::AnimationSequence *GetTransition()
+    {
+        return g_active_sequence;
+    }
+
+    const Animation::AnimationSequence *GetFadingTransition()
+    {
+        return g_fading_sequence;
+    }
+
+    bool IsTransitionPlaying()
+    {
+        return g_active_sequence && g_active_sequence->IsPlaying();
+    }
+
+    void BeginStanding()
+    {
+        g_standing = true;
+        g_gait.Halt();
+
+        g_stance_spring.Start({});
+        g_stance_spring.Stop();
+        ClearTickLayer(LayerStack::Layer::StanceOffset);
+        ClearTickLayer(LayerStack::Layer::HeadBob);
+        g_tick_accumulator_us = 0;
+
+        Animation::CurrentCameraState base = {};
+        base.position = LayerStack::Evaluate().position;
+        SnapTickLayer(LayerStack::Layer::Locomotion, base, LayerStack::LAYER_POSITION);
+    }
+
+    void EndStanding()
+    {
+        g_standing = false;
+        g_gait.Halt();
+        g_stance_spring.Stop(); // Nothing drives the stance outside Standing.
+        for (const LayerStack::Layer layer : TICK_LAYERS)
+        {
+            ClearTickLayer(layer);
+        }
+        g_tick_accumulator_us = 0;
+    }
+
+    void MoveStance(float offset_y, float pitch, float duration_s)
+    {
+        if (!g_stance_spring.IsMoving())
+        {
+            // From the offset the last change settled on; the sway has settled back to 0.
+            Animation::CurrentCameraState from = {};
+            from.position = {g_stance_spring.Get(Animation::SpringChannel::PositionX),
+                             g_stance_spring.Get(Animation::SpringChannel::PositionY),
+                             g_stance_spring.Get(Animation::SpringChannel::PositionZ)};
+            from.rotation.y = pitch;
+            g_stance_spring.Start(from);
+        }
+        g_stance_spring.SetDuration(duration_s);
+        g_stance_spring.SetTarget(Animation::SpringChannel::PositionY, offset_y);
+        g_stance_spring.SetTarget(Animation::SpringChannel::Pitch, 0.0f);
+    }
+
+    void AddStanceSway(Animation::SpringChannel channel, float peak)
+    {
+        g_stance_spring.AddSway(channel, peak);
+    }
+
+    bool IsStanceMoving()
+    {
+        return g_stance_spring.IsMoving();
+    }
+
+    float GetStanceProgress()
+    {
+        return g_stance_spring.GetProgress();
+    }
+
+    void Walk(float direction_x, float direction_z, const Animation::GaitParams &params)
+    {
+        g_walk_requested = true;
+        g_walk_x = direction_x;
+        g_walk_z = direction_z;
+        g_gait_params = params;
+        g_gait_params.floor = &g_floor;
+    }
+
+    void HaltWalk()
+    {
+        g_gait.Halt();
+    }
+
+    bool IsWalking()
+    {
+        return g_gait.IsMoving();
+    }
+
+    float GetStridePhase()
+    {
+        return g_gait.GetStridePhase();
+    }
+
+    void BuildFloor(const Animation::FloorLayout &layout)
+    {
+        g_floor.Build(layout);
+    }
+
+    bool IsStandingMoving()
+    {
+        // Until the layers have caught up with the last tick, the camera is still short of where the logic stopped.
+        return g_stance_spring.IsMoving() || g_gait.IsMoving() || !AreTickLayersSettled();
+    }
+
+} // namespace SPF_CabinWalk::AnimationScheduler
@@ -0,0 +1,183 @@
+#pragma once
+#include <cstdint>
+#include <memory> // For std::unique_ptr
+#include "Animation/AnimationSequence.hpp"
+#include "Animation/CabinFloor.hpp"   // For Animation::FloorLayout
+#include "Animation/FrameContext.hpp"
+#include "Animation/GaitEngine.hpp"   // For Animation::GaitParams
+#include "Animation/StanceSpring.hpp" // For Animation::SpringChannel
+
+// Owns every motion of the camera and advances it in one pass per frame: the transition between positions,
+// cross-faded with the one it interrupted, and in Standing the stance spring and the gait on their fixed
+// logic tick. Each feeds its layer of the LayerStack. The AnimationController and the StandingAnimController
+// only decide what moves and when; they start motion here and react to the events it fires.
+
+namespace SPF_CabinWalk::AnimationScheduler
+{
+    // =================================================================================================
+    // Events
+    // =================================================================================================
+
+    /**
+     * @brief Something the controllers react to, fired when the motion it describes happens.
+     */
+    enum class Event : uint8_t
+    {
+        StanceSettled, // The stance spring came to rest on its target.
+        Started,       // Something started moving the camera while it was at rest.
+        Settled,       // The camera came to rest: no transition, and the standing motion at rest (see IsSettled()).
+        Count
+    };
+
+    /**
+     * @brief Gets the bit of an event in the mask returned by TakeEvents().
+     */
+    constexpr uint32_t EventBit(Event event)
+    {
+        return 1u << static_cast<uint32_t>(event);
+    }
+
+    /**
+     * @brief Takes the events fired since the last call.
+     * @details A mask, not a queue: a frame in which the camera started and came to rest again reports both.
+     * @return The EventBit() of each event.
+     */
+    uint32_t TakeEvents();
+
+    // =================================================================================================
+    // Frame
+    // =================================================================================================
+
+    /**
+     * @brief Advances every motion by one frame.
+     * @details A playing transition is stepped, and composed at once, unless the camera hook already stepped
+     *          it this frame. Otherwise in Standing the stance spring and the gait run in fixed 60 Hz ticks,
+     *          each with one StandingAnimController::Tick() to decide the stance and the walk, and their
+     *          layers are interpolated between the last two ticks. Fires Started or Settled at the end of
+     *          the pass if the camera started moving or came to rest.
+     * @param frame The frame's clock, camera pose and input state.
+     * @param[out] fired_events Receives the Animation::EventBit() of each marker the transition reached.
+     * @return True if the transition was stepped.
+     */
+    bool Update(const FrameContext &frame, uint32_t *fired_events);
+
+    /**
+     * @brief Steps a playing transition by the hook's frame time and composes it, before the game reads the camera.
+     * @param delta_time The frame time passed to the hooked function, in seconds.
+     * @param[out] fired_events Receives the Animation::EventBit() of each marker the transition reached.
+     * @return True if the transition was stepped; Update() then leaves it alone for the rest of the frame.
+     */
+    bool AdvanceFromCameraHook(float delta_time, uint32_t *fired_events);
+
+    /**
+     * @brief Checks whether nothing moves the camera: no transition, and the standing motion at rest.
+     */
+    bool IsSettled();
+
+    // =================================================================================================
+    // Transition
+    // =================================================================================================
+
+    /**
+     * @brief Starts a transition from `initial_state`. A fade started by FadeOutTransition() keeps running under it.
+     * @param sequence The sequence, from a bake or `owned`.
+     * @param owned Owns `sequence` if it is a dynamic one; empty for a baked one.
+     */
+    void PlayTransition(Animation::AnimationSequence *sequence, std::unique_ptr<Animation::AnimationSequence> owned,
+                        const Animation::CurrentCameraState &initial_state);
+
+    /**
+     * @brief Keeps the active transition playing underneath the next one, fading it out over `duration_us`.
+     * @details A fade that is still running is cut short; only the most recent transition fades out.
+     */
+    void FadeOutTransition(uint64_t duration_us);
+
+    /**
+     * @brief Drops the transition that is fading out.
+     */
+    void EndFade();
+
+    /**
+     * @brief Drops the active transition and any fade, and clears the BaseTransition layer.
+     * @details Fires Settled if that leaves the camera at rest, so what waits for it starts on this frame.
+     */
+    void StopTransition();
+
+    /**
+     * @brief Gets the active transition. It stays active after it finishes, until StopTransition().
+     * @return The transition, or nullptr if none is active.
+     */
+    Animation::AnimationSequence *GetTransition();
+
+    /**
+     * @brief Gets the transition that is fading out, or nullptr.
+     */
+    const Animation::AnimationSequence *GetFadingTransition();
+
+    bool IsTransitionPlaying();
+
+    // =================================================================================================
+    // Standing Motion
+    // =================================================================================================
+
+    /**
+     * @brief Starts the standing motion at rest, in the base stance, with the walker where the layers compose to now.
+     */
+    void BeginStanding();
+
+    /**
+     * @brief Stops the standing motion and clears its layers, so a transition out of Standing owns the camera.
+     */
+    void EndStanding();
+
+    /**
+     * @brief Sends the stance spring towards a new head height offset, relative to standing.
+     * @details A spring that is still moving keeps its velocity, so this also reverses a change halfway
+     *          through. One that is at rest starts from the offset the last change settled on and the
+     *          current `pitch`, which it levels out to look straight ahead.
+     */
+    void MoveStance(float offset_y, float pitch, float duration_s);
+
+    /**
+     * @brief Leans the head out along `channel` by `peak` during the stance change, before the spring brings it back.
+     */
+    void AddStanceSway(Animation::SpringChannel channel, float peak);
+
+    bool IsStanceMoving();
+
+    /**
+     * @brief Gets how far the stance change is through its duration, in [0, 1].
+     */
+    float GetStanceProgress();
+
+    /**
+     * @brief Walks along a direction for the current tick; a tick without a call brings the walker to a stop.
+     * @param direction_x The X part of the walking direction, a unit vector.
+     * @param direction_z The Z part.
+     * @param params The tuning; its floor is replaced by the one from BuildFloor().
+     */
+    void Walk(float direction_x, float direction_z, const Animation::GaitParams &params);
+
+    /**
+     * @brief Stops walking at once.
+     */
+    void HaltWalk();
+
+    bool IsWalking();
+
+    /**
+     * @brief Gets how far through the current stride the walker is, in [0, 1).
+     */
+    float GetStridePhase();
+
+    /**
+     * @brief Rebuilds the floor the gait walks on. Only between walks; a walk keeps the floor it started on.
+     */
+    void BuildFloor(const Animation::FloorLayout &layout);
+
+    /**
+     * @brief Checks whether the stance spring or the gait is moving, or their layers have not yet caught up.
+     */
+    bool IsStandingMoving();
+
+} // namespace SPF_CabinWalk::AnimationScheduler
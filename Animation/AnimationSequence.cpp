@@ -1,26 +1,55 @@
 #include "Animation/AnimationSequence.hpp"
-#include "Animation/Easing/Easing.hpp" // For Easing functions
-#include <iostream> // For debugging, remove later
+#include "Animation/ChannelEvaluator.hpp"
+#include "Camera/CameraFacade.hpp"
 
 namespace SPF_CabinWalk::Animation
 {
     AnimationSequence::AnimationSequence()
-        : m_duration_ms(0), m_is_playing(false), m_current_elapsed_time_ms(0)
+        : m_keyframe_storage_capacity(0), m_keyframe_count(0), m_progress_column(nullptr), m_value_column(nullptr), m_coefficient_column(nullptr), m_easing_column(nullptr),
+          m_shared_channels(0), m_duration_ms(0), m_is_playing(false), m_current_elapsed_time_ms(0), m_initial_camera_state{}, m_fired_events(0)
     {
-        // Initialize position tracks
-        m_position_x_track = std::make_unique<Track<float>>();
-        m_position_y_track = std::make_unique<Track<float>>();
-        m_position_z_track = std::make_unique<Track<float>>();
-        // Initialize rotation tracks
-        m_rotation_yaw_track = std::make_unique<Track<float>>();
-        m_rotation_pitch_track = std::make_unique<Track<float>>();
-        m_rotation_roll_track = std::make_unique<Track<float>>();
+        // Tracks start out as empty views; SequenceBuilder binds them to the packed storage.
     }
 
     void AnimationSequence::Initialize(uint64_t duration_ms)
     {
         m_duration_ms = duration_ms;
-        // The tracks are already initialized in the constructor.
+    }
+
+    void AnimationSequence::UpdateSplineCoefficients()
+    {
+        if (!m_coefficient_column)
+        {
+            return;
+        }
+
+        // Shared channels hold no keys here; the sequence they view keeps its own coefficients.
+        uint32_t offset = 0;
+        for (size_t channel = 0; channel < CHANNEL_COUNT; ++channel)
+        {
+            const Track<float>& track = m_tracks[channel];
+            if (m_shared_channels & (1u << channel))
+            {
+                continue;
+            }
+            const uint32_t count = track.GetKeyframeCount();
+            ComputeSplineCoefficients(m_progress_column + offset, m_value_column + offset, m_easing_column + offset, count, m_coefficient_column + 4 * offset,
+                                      track.IsAngular());
+            offset += count;
+        }
+    }
+
+    void AnimationSequence::ShareReversedTracks(const AnimationSequence& source, uint32_t channels)
+    {
+        for (size_t channel = 0; channel < CHANNEL_COUNT; ++channel)
+        {
+            const uint32_t bit = 1u << channel;
+            if ((channels & bit) && ((m_shared_channels & bit) || m_tracks[channel].IsEmpty()))
+            {
+                m_tracks[channel] = source.m_tracks[channel].Reversed();
+                m_shared_channels |= bit;
+            }
+        }
     }
 
     void AnimationSequence::Start(const CurrentCameraState& initial_state)
@@ -28,9 +57,16 @@ namespace SPF_CabinWalk::Animation
         m_initial_camera_state = initial_state;
         m_current_elapsed_time_ms = 0;
         m_is_playing = true;
+        m_events.Rewind();
+        m_fired_events = 0;
+
+        for (auto& track : m_tracks)
+        {
+            track.ResetCursor();
+        }
     }
 
-    bool AnimationSequence::Update(uint64_t delta_time_ms, const SPF_Camera_API* camera_api)
+    bool AnimationSequence::Advance(uint64_t delta_time_ms)
     {
         if (!m_is_playing)
         {
@@ -45,56 +81,45 @@ namespace SPF_CabinWalk::Animation
             m_is_playing = false;
         }
 
-        if (!camera_api)
-        {
-            return m_is_playing;
-        }
+        m_fired_events |= m_events.Fire(GetProgress());
+        return m_is_playing;
+    }
 
-        const float current_progress = (m_duration_ms == 0)
-                                     ? 1.0f
-                                     : static_cast<float>(m_current_elapsed_time_ms) / static_cast<float>(m_duration_ms);
+    CurrentCameraState AnimationSequence::Evaluate()
+    {
+        // Start with the initial state as the default. The order matches the Channel enum.
+        float values[CHANNEL_COUNT] = {
+            m_initial_camera_state.position.x,
+            m_initial_camera_state.position.y,
+            m_initial_camera_state.position.z,
+            m_initial_camera_state.rotation.x,
+            m_initial_camera_state.rotation.y,
+            m_initial_camera_state.rotation.z,
+        };
 
-        // Start with the initial state as the default
-        SPF_FVector final_pos = m_initial_camera_state.position;
-        SPF_FVector final_rot = m_initial_camera_state.rotation;
+        // --- Absolute Tracks ---
+        // If a track for a channel has keyframes, it overrides the initial state's value.
+        // If it doesn't, the initial state's value is kept.
+        EvaluateChannels(m_tracks, GetProgress(), values);
 
-        // --- Absolute Position Tracks ---
-        // If a track for an axis exists, it overrides the initial state's value.
-        // If it doesn't exist, the initial state's value is kept.
-        if (!m_position_x_track->IsEmpty())
-        {
-            final_pos.x = m_position_x_track->Evaluate(current_progress, m_initial_camera_state.position.x);
-        }
-        if (!m_position_y_track->IsEmpty())
-        {
-            final_pos.y = m_position_y_track->Evaluate(current_progress, m_initial_camera_state.position.y);
-        }
-        if (!m_position_z_track->IsEmpty())
-        {
-            final_pos.z = m_position_z_track->Evaluate(current_progress, m_initial_camera_state.position.z);
-        }
+        return {{values[0], values[1], values[2]}, {values[3], values[4], values[5]}};
+    }
 
-        // --- Absolute Rotation Tracks ---
-        if (!m_rotation_yaw_track->IsEmpty())
-        {
-            final_rot.x = m_rotation_yaw_track->Evaluate(current_progress, m_initial_camera_state.rotation.x);
-        }
-        if (!m_rotation_pitch_track->IsEmpty())
-        {
-            final_rot.y = m_rotation_pitch_track->Evaluate(current_progress, m_initial_camera_state.rotation.y);
-        }
-        if (!m_rotation_roll_track->IsEmpty())
+    bool AnimationSequence::Update(uint64_t delta_time_ms)
+    {
+        if (!m_is_playing)
         {
-            final_rot.z = m_rotation_roll_track->Evaluate(current_progress, m_initial_camera_state.rotation.z);
+            return false;
         }
-        
-        // NOTE: Offset tracks are now IGNORED by this logic, and will be removed entirely.
+
+        const bool is_playing = Advance(delta_time_ms);
 
         // Apply the final calculated state to the camera
-        camera_api->Cam_SetInteriorSeatPos(final_pos.x, final_pos.y, final_pos.z);
-        camera_api->Cam_SetInteriorHeadRot(final_rot.x, final_rot.y);
+        const CurrentCameraState state = Evaluate();
+        CameraFacade::SetSeatPos(state.position.x, state.position.y, state.position.z);
+        CameraFacade::SetHeadRot(state.rotation.x, state.rotation.y);
 
-        return m_is_playing;
+        return is_playing;
     }
 
-} // namespace SPF_CabinWalk::Animation
\ No newline at end of file
+} // namespace SPF_CabinWalk::Animation
@@ -1,8 +1,8 @@
 #pragma once
 #include "Animation/Track.hpp"
+#include "Animation/EventTrack.hpp"
 #include <memory> // For std::unique_ptr
-#include <SPF_Camera_API.h>
-#include <vector>
+#include <cstddef> // For std::byte
 
 namespace SPF_CabinWalk::Animation
 {
@@ -15,46 +15,117 @@ namespace SPF_CabinWalk::Animation
         SPF_FVector rotation; // .x = yaw, .y = pitch, .z = roll
     };
 
+    /**
+     * @brief Identifies one of the animatable camera properties of a sequence.
+     */
+    enum class Channel : uint8_t
+    {
+        PositionX = 0,
+        PositionY,
+        PositionZ,
+        RotationYaw,
+        RotationPitch,
+        RotationRoll, // Roll might not be used, but included for completeness
+        Count
+    };
+
+    constexpr size_t CHANNEL_COUNT = static_cast<size_t>(Channel::Count);
+
+    /**
+     * @brief Checks whether a channel holds an unbounded angle that is interpolated along the shortest arc.
+     * @details Pitch is limited by the game to well within +/-90 degrees, so it stays a plain value.
+     */
+    constexpr bool IsAngularChannel(Channel channel)
+    {
+        return channel == Channel::RotationYaw || channel == Channel::RotationRoll;
+    }
+
     /**
      * @class AnimationSequence
      * @brief Manages multiple animation tracks over a shared timeline to produce a camera animation.
+     * @details All keyframes of all channels live in a single packed buffer laid out as
+     *          `progress[N] | value[N] | coefficients[4N] | easing_id[N]`, where each channel owns a
+     *          contiguous slice. The spline coefficient column only exists when a key uses
+     *          Easing::EasingId::Spline. Sequences are assembled by a SequenceBuilder.
      */
     class AnimationSequence
     {
     private:
-        // Individual tracks for each animatable property of the camera
-        std::unique_ptr<Track<float>> m_position_x_track;
-        std::unique_ptr<Track<float>> m_position_y_track;
-        std::unique_ptr<Track<float>> m_position_z_track;
-        std::unique_ptr<Track<float>> m_rotation_yaw_track;
-        std::unique_ptr<Track<float>> m_rotation_pitch_track;
-        std::unique_ptr<Track<float>> m_rotation_roll_track; // Roll might not be used, but included for completeness
+        friend class SequenceBuilder;
+
+        // Single allocation holding the keyframe columns of every channel.
+        std::unique_ptr<std::byte[]> m_keyframe_storage;
+        size_t m_keyframe_storage_capacity; // In bytes. Kept when a pooled sequence is rebuilt.
+        uint32_t m_keyframe_count;
+        float* m_progress_column;
+        float* m_value_column;
+        float* m_coefficient_column; // Null when no key is a spline key.
+        uint8_t* m_easing_column;
+
+        // Views into m_keyframe_storage, one per channel, except for the shared channels below.
+        Track<float> m_tracks[CHANNEL_COUNT];
+        // ChannelBit mask of the channels whose tracks view another sequence's keys (see ShareReversedTracks).
+        uint32_t m_shared_channels;
 
         uint64_t m_duration_ms; // Total duration of the animation sequence
 
         // State variables for the current playback
         bool m_is_playing;
         uint64_t m_current_elapsed_time_ms;
-        
+
         // Initial state of the camera when the animation started
         CurrentCameraState m_initial_camera_state;
 
+        // Event markers of the playback, and those fired since TakeFiredEvents() was last called.
+        EventTrack m_events;
+        uint32_t m_fired_events;
+
     public:
         AnimationSequence();
 
         /**
-         * @brief Initializes the animation sequence. Must be called before adding tracks.
+         * @brief Initializes the animation sequence.
          * @param duration_ms The total duration of this animation sequence in milliseconds.
          */
         void Initialize(uint64_t duration_ms);
 
-        // Specific AddTrack methods for each property type
-        void AddPositionXTrack(std::unique_ptr<Track<float>> track) { m_position_x_track = std::move(track); }
-        void AddPositionYTrack(std::unique_ptr<Track<float>> track) { m_position_y_track = std::move(track); }
-        void AddPositionZTrack(std::unique_ptr<Track<float>> track) { m_position_z_track = std::move(track); }
-        void AddRotationYawTrack(std::unique_ptr<Track<float>> track) { m_rotation_yaw_track = std::move(track); }
-        void AddRotationPitchTrack(std::unique_ptr<Track<float>> track) { m_rotation_pitch_track = std::move(track); }
-        void AddRotationRollTrack(std::unique_ptr<Track<float>> track) { m_rotation_roll_track = std::move(track); }
+        /**
+         * @brief Gets the track bound to a given channel.
+         * @param channel The channel to query.
+         * @return A view over the channel's keyframes. May be empty.
+         */
+        const Track<float>& GetTrack(Channel channel) const { return m_tracks[static_cast<size_t>(channel)]; }
+
+        /**
+         * @brief Gets the total number of keyframes across all channels.
+         */
+        uint32_t GetKeyframeCount() const { return m_keyframe_count; }
+
+        /**
+         * @brief Direct access to the packed columns. Keyframes of channel N follow those of channel N-1.
+         * @details The value column is writable so that baked sequences can be re-bound to a new
+         *          start/target state without rebuilding them.
+         */
+        const float* GetKeyframeProgress() const { return m_progress_column; }
+        const uint8_t* GetKeyframeEasingIds() const { return m_easing_column; }
+        const float* GetKeyframeValues() const { return m_value_column; }
+        float* GetKeyframeValues() { return m_value_column; }
+
+        /**
+         * @brief Recomputes the spline segments from the current keyframe values.
+         * @details Call after writing to GetKeyframeValues(). Does nothing if the sequence has no spline keys.
+         */
+        void UpdateSplineCoefficients();
+
+        /**
+         * @brief Plays some channels from the keys of another sequence, backwards in time.
+         * @details The keys are not copied: `source` must outlive this sequence's playback and not be re-bound
+         *          while it plays. Only channels that hold no keys of their own, or were shared before, are
+         *          taken; call again whenever `source` is rebuilt.
+         * @param source The sequence played the other way round.
+         * @param channels ChannelBit mask.
+         */
+        void ShareReversedTracks(const AnimationSequence& source, uint32_t channels);
 
         /**
          * @brief Starts the animation sequence from the beginning.
@@ -63,12 +134,53 @@ namespace SPF_CabinWalk::Animation
         void Start(const CurrentCameraState& initial_state);
 
         /**
-         * @brief Updates the animation state based on elapsed time.
+         * @brief Moves the playback clock forward without touching the camera.
          * @param delta_time_ms The time elapsed since the last frame in milliseconds.
-         * @param camera_api A pointer to the SPF Camera API for applying changes.
          * @return True if the animation is still playing, false if it has finished.
          */
-        bool Update(uint64_t delta_time_ms, const SPF_Camera_API* camera_api);
+        bool Advance(uint64_t delta_time_ms);
+
+        /**
+         * @brief Evaluates the pose at the current playback time. Holds the final pose once finished.
+         * @details Channels without keyframes keep the value of the state passed to Start().
+         */
+        CurrentCameraState Evaluate();
+
+        /**
+         * @brief Advances the animation and applies the evaluated pose.
+         * @details The evaluated pose is handed to CameraFacade, which writes it to the game on its next flush.
+         * @param delta_time_ms The time elapsed since the last frame in milliseconds.
+         * @return True if the animation is still playing, false if it has finished.
+         */
+        bool Update(uint64_t delta_time_ms);
+
+        /**
+         * @brief Adds an event marker that Advance() fires once playback reaches `progress`.
+         * @details Markers belong to the owner of the playback rather than the curves: BuildInto() clears them,
+         *          and a bake keeps those of its last playback, so owners set them before each Start(). A
+         *          marker at 1.0 fires on the step that finishes.
+         * @return False if the sequence already holds EventTrack::MAX_MARKERS markers.
+         */
+        bool AddEvent(float progress, SequenceEvent event) { return m_events.Add(progress, event); }
+
+        /**
+         * @brief Removes every event marker.
+         */
+        void ClearEvents()
+        {
+            m_events.Clear();
+            m_fired_events = 0;
+        }
+
+        /**
+         * @brief Gets the EventBit of every marker fired since the last call, and clears them.
+         */
+        uint32_t TakeFiredEvents()
+        {
+            const uint32_t fired = m_fired_events;
+            m_fired_events = 0;
+            return fired;
+        }
 
         /**
          * @brief Checks if the animation is currently playing.
@@ -81,6 +193,19 @@ namespace SPF_CabinWalk::Animation
          * @return The duration in milliseconds.
          */
         uint64_t GetDuration() const { return m_duration_ms; }
+
+        /**
+         * @brief Gets the playback time left until the sequence finishes.
+         */
+        uint64_t GetRemainingTime() const { return m_duration_ms - m_current_elapsed_time_ms; }
+
+        /**
+         * @brief Gets the normalized playback progress (0.0 to 1.0).
+         */
+        float GetProgress() const
+        {
+            return (m_duration_ms == 0) ? 1.0f : static_cast<float>(m_current_elapsed_time_ms) / static_cast<float>(m_duration_ms);
+        }
     };
 
-} // namespace SPF_CabinWalk::Animation
\ No newline at end of file
+} // namespace SPF_CabinWalk::Animation
@@ -0,0 +1,353 @@
+#include "Animation/BakedTransition.hpp"
+#include "Animation/SequenceBuilder.hpp"
+#include "SPF_CabinWalk.hpp" // For AppSettings
+#include <cmath>
+#include <cstring>
+
+namespace SPF_CabinWalk::Animation
+{
+    namespace
+    {
+        // Per-channel probe deltas. Distinct powers of two let a single probe reveal which channel of
+        // the start/target state a keyframe value was derived from.
+        constexpr float PROBE_DELTAS[CHANNEL_COUNT] = {1.0f, 2.0f, 4.0f, 8.0f, 16.0f, 32.0f};
+        constexpr float PROBE_TOLERANCE = 1e-3f;
+
+        CurrentCameraState MakeProbeState(bool offset)
+        {
+            CurrentCameraState state{};
+            if (offset)
+            {
+                state.position = {PROBE_DELTAS[0], PROBE_DELTAS[1], PROBE_DELTAS[2]};
+                state.rotation = {PROBE_DELTAS[3], PROBE_DELTAS[4], PROBE_DELTAS[5]};
+            }
+            return state;
+        }
+
+        void StateToChannels(const CurrentCameraState& state, float (&out)[CHANNEL_COUNT])
+        {
+            out[0] = state.position.x;
+            out[1] = state.position.y;
+            out[2] = state.position.z;
+            out[3] = state.rotation.x;
+            out[4] = state.rotation.y;
+            out[5] = state.rotation.z;
+        }
+
+        // Returns the channel whose probe delta matches `delta`, or -1 if none does.
+        int FindProbeChannel(float delta)
+        {
+            for (size_t i = 0; i < CHANNEL_COUNT; ++i)
+            {
+                if (std::fabs(delta - PROBE_DELTAS[i]) < PROBE_TOLERANCE)
+                {
+                    return static_cast<int>(i);
+                }
+            }
+            return -1;
+        }
+
+        // Checks that two probes produced the same timeline, i.e. differ only in keyframe values.
+        bool HaveSameLayout(const AnimationSequence& a, const AnimationSequence& b)
+        {
+            if (a.GetDuration() != b.GetDuration() || a.GetKeyframeCount() != b.GetKeyframeCount())
+            {
+                return false;
+            }
+
+            for (size_t channel = 0; channel < CHANNEL_COUNT; ++channel)
+            {
+                if (a.GetTrack(static_cast<Channel>(channel)).GetKeyframeCount() != b.GetTrack(static_cast<Channel>(channel)).GetKeyframeCount())
+                {
+                    return false;
+                }
+            }
+
+            const uint32_t count = a.GetKeyframeCount();
+            return count == 0 ||
+                   (std::memcmp(a.GetKeyframeProgress(), b.GetKeyframeProgress(), count * sizeof(float)) == 0 &&
+                    std::memcmp(a.GetKeyframeEasingIds(), b.GetKeyframeEasingIds(), count * sizeof(uint8_t)) == 0);
+        }
+
+        // --- FNV-1a over individual fields (never over whole structs, to stay independent of padding) ---
+        constexpr uint64_t FNV_OFFSET_BASIS = 14695981039346656037ull;
+        constexpr uint64_t FNV_PRIME = 1099511628211ull;
+
+        template <typename T>
+        void HashField(uint64_t& hash, const T& value)
+        {
+            unsigned char bytes[sizeof(T)];
+            std::memcpy(bytes, &value, sizeof(T));
+            for (unsigned char byte : bytes)
+            {
+                hash ^= byte;
+                hash *= FNV_PRIME;
+            }
+        }
+    } // namespace
+
+    // =================================================================================================
+    // BakedTransition
+    // =================================================================================================
+
+    bool BakedTransition::Bake(SequenceFactory factory, uint64_t settings_hash)
+    {
+        Reset();
+        m_settings_hash = settings_hash;
+        m_bake_attempted = true;
+
+        if (!factory)
+        {
+            return false;
+        }
+
+        const CurrentCameraState zero_state = MakeProbeState(false);
+        const CurrentCameraState offset_state = MakeProbeState(true);
+
+        // Three probes: the neutral one, one with the start state shifted and one with the target shifted.
+        std::unique_ptr<AnimationSequence> neutral = factory(zero_state, zero_state);
+        std::unique_ptr<AnimationSequence> start_probe = factory(offset_state, zero_state);
+        std::unique_ptr<AnimationSequence> target_probe = factory(zero_state, offset_state);
+
+        if (!neutral || !start_probe || !target_probe ||
+            !HaveSameLayout(*neutral, *start_probe) || !HaveSameLayout(*neutral, *target_probe))
+        {
+            return false;
+        }
+
+        const uint32_t count = neutral->GetKeyframeCount();
+        const float* neutral_values = neutral->GetKeyframeValues();
+        const float* start_values = start_probe->GetKeyframeValues();
+        const float* target_values = target_probe->GetKeyframeValues();
+
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            const float start_delta = start_values[i] - neutral_values[i];
+            const float target_delta = target_values[i] - neutral_values[i];
+            const bool depends_on_start = std::fabs(start_delta) >= PROBE_TOLERANCE;
+            const bool depends_on_target = std::fabs(target_delta) >= PROBE_TOLERANCE;
+
+            if (!depends_on_start && !depends_on_target)
+            {
+                continue; // Absolute keyframe, nothing to patch.
+            }
+
+            if (depends_on_start && depends_on_target)
+            {
+                m_patches.clear();
+                return false; // Mixes both states; cannot be expressed as a single offset.
+            }
+
+            const int channel = FindProbeChannel(depends_on_start ? start_delta : target_delta);
+            if (channel < 0)
+            {
+                m_patches.clear();
+                return false; // Scaled or non-linear dependency.
+            }
+
+            // The neutral probe used zero states, so its value is exactly the offset.
+            m_patches.push_back({i, depends_on_start ? Source::Start : Source::Target, static_cast<uint8_t>(channel), neutral_values[i]});
+        }
+
+        m_sequence = std::move(neutral);
+        return true;
+    }
+
+    bool BakedTransition::BakeReversed(BakedTransition& forward, SequenceFactory overrides, uint32_t override_channels, uint64_t settings_hash)
+    {
+        if (overrides)
+        {
+            // Bakes the overridden channels into this object like any transition; the rest stay empty.
+            if (!Bake(overrides, settings_hash))
+            {
+                return false;
+            }
+        }
+        else
+        {
+            Reset();
+            m_settings_hash = settings_hash;
+            m_bake_attempted = true;
+            m_sequence = SequenceBuilder().Build();
+        }
+
+        if (!m_sequence || !forward.IsValidFor(settings_hash) || forward.m_pinned || forward.m_forward)
+        {
+            m_sequence.reset();
+            m_patches.clear();
+            return false;
+        }
+
+        m_forward = &forward;
+        m_shared_channels = ((1u << CHANNEL_COUNT) - 1) & ~(overrides ? override_channels : 0u);
+        return true;
+    }
+
+    AnimationSequence* BakedTransition::Bind(const CurrentCameraState& start_state, const CurrentCameraState& target_state)
+    {
+        if (!m_sequence)
+        {
+            return nullptr;
+        }
+
+        if (m_forward)
+        {
+            // The shared keys are bound the way the forward plays them; the tracks are re-pointed in case
+            // the forward was baked again since.
+            const AnimationSequence* forward = m_forward->Bind(target_state, start_state);
+            if (!forward)
+            {
+                return nullptr;
+            }
+            m_sequence->Initialize(forward->GetDuration());
+            m_sequence->ShareReversedTracks(*forward, m_shared_channels);
+        }
+
+        float start_channels[CHANNEL_COUNT];
+        float target_channels[CHANNEL_COUNT];
+        StateToChannels(start_state, start_channels);
+        StateToChannels(target_state, target_channels);
+
+        float* values = m_sequence->GetKeyframeValues();
+        for (const Patch& patch : m_patches)
+        {
+            const float base = (patch.source == Source::Start) ? start_channels[patch.source_channel] : target_channels[patch.source_channel];
+            values[patch.key_index] = base + patch.offset;
+        }
+
+        // Patched keys move the spline segments around them.
+        m_sequence->UpdateSplineCoefficients();
+        return m_sequence.get();
+    }
+
+    bool BakedTransition::Load(const AnimationAssets::TransitionRecord& record, const AnimationAssets::KeyRecord* keys)
+    {
+        Reset();
+
+        for (uint8_t channel_count : record.channel_key_counts)
+        {
+            if (channel_count > TrackBuilder::MAX_KEYFRAMES)
+            {
+                return false;
+            }
+        }
+
+        SequenceBuilder builder;
+        builder.Initialize(record.duration_us);
+
+        // Keys are stored channel by channel and already sorted, so their index is their packed index.
+        uint32_t index = 0;
+        for (size_t channel = 0; channel < CHANNEL_COUNT; ++channel)
+        {
+            TrackBuilder& track = builder.GetTrack(static_cast<Channel>(channel));
+            for (uint32_t i = 0; i < record.channel_key_counts[channel]; ++i, ++index)
+            {
+                const AnimationAssets::KeyRecord& key = keys[index];
+                track.AddKeyframe(Keyframe<float>(key.progress, key.value, static_cast<Easing::EasingId>(key.easing_id)));
+                if (key.binding != AnimationAssets::Binding::Absolute)
+                {
+                    m_patches.push_back({index, key.binding == AnimationAssets::Binding::Start ? Source::Start : Source::Target, key.source_channel, key.value});
+                }
+            }
+        }
+
+        if (index == 0)
+        {
+            m_patches.clear();
+            return false;
+        }
+
+        m_sequence = builder.Build();
+        m_pinned = true;
+        return true;
+    }
+
+    bool BakedTransition::Export(AnimationAssets::TransitionRecord& record, std::vector<AnimationAssets::KeyRecord>& keys) const
+    {
+        if (!m_sequence || m_forward)
+        {
+            return false;
+        }
+
+        const uint32_t count = m_sequence->GetKeyframeCount();
+        const float* progress = m_sequence->GetKeyframeProgress();
+        const float* values = m_sequence->GetKeyframeValues();
+        const uint8_t* easing_ids = m_sequence->GetKeyframeEasingIds();
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            if (easing_ids[i] >= static_cast<uint8_t>(Easing::EasingId::BuiltInCount))
+            {
+                return false;
+            }
+        }
+
+        record.first_key = static_cast<uint32_t>(keys.size());
+        record.duration_us = m_sequence->GetDuration();
+        for (size_t channel = 0; channel < CHANNEL_COUNT; ++channel)
+        {
+            record.channel_key_counts[channel] = static_cast<uint8_t>(m_sequence->GetTrack(static_cast<Channel>(channel)).GetKeyframeCount());
+        }
+
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            keys.push_back({progress[i], values[i], easing_ids[i], AnimationAssets::Binding::Absolute, 0, 0});
+        }
+
+        // Bound keys store their offset, not the value of the last Bind().
+        for (const Patch& patch : m_patches)
+        {
+            AnimationAssets::KeyRecord& key = keys[record.first_key + patch.key_index];
+            key.value = patch.offset;
+            key.binding = (patch.source == Source::Start) ? AnimationAssets::Binding::Start : AnimationAssets::Binding::Target;
+            key.source_channel = patch.source_channel;
+        }
+        return true;
+    }
+
+    void BakedTransition::Reset()
+    {
+        m_sequence.reset();
+        m_patches.clear();
+        m_forward = nullptr;
+        m_shared_channels = 0;
+        m_settings_hash = 0;
+        m_bake_attempted = false;
+        m_pinned = false;
+    }
+
+    // =================================================================================================
+    // Settings Hash
+    // =================================================================================================
+
+    uint64_t HashTransitionSettings(const AppSettings& settings)
+    {
+        uint64_t hash = FNV_OFFSET_BASIS;
+
+        // --- General ---
+        HashField(hash, settings.general.cabin_layout);
+        HashField(hash, settings.general.height);
+
+        // Positions are left out: they only reach a baked transition through the states patched in by
+        // Bind, so moving a position (or switching truck profiles) never needs a rebake.
+
+        // --- Animation Durations ---
+        const auto& main = settings.animation_durations.main_animation_speed;
+        HashField(hash, main.driver_to_passenger);
+        HashField(hash, main.passenger_to_driver);
+        HashField(hash, main.driver_to_standing);
+        HashField(hash, main.standing_to_driver);
+        HashField(hash, main.passenger_to_standing);
+        HashField(hash, main.standing_to_passenger);
+        HashField(hash, main.standing_to_sofa);
+        HashField(hash, main.sofa_to_standing);
+
+        const auto& sofa = settings.animation_durations.sofa_animation_speed;
+        HashField(hash, sofa.sofa_sit1_to_lie);
+        HashField(hash, sofa.sofa_lie_to_sit2);
+        HashField(hash, sofa.sofa_sit2_to_sit1);
+        HashField(hash, sofa.sofa_lie_to_sit1_shortcut);
+
+        return hash;
+    }
+
+} // namespace SPF_CabinWalk::Animation
@@ -0,0 +1,168 @@
+#pragma once
+#include "Animation/AnimationSequence.hpp"
+#include "Animation/AnimationAssets.hpp"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace SPF_CabinWalk
+{
+    struct AppSettings;
+}
+
+namespace SPF_CabinWalk::Animation
+{
+    /**
+     * @brief The functions that build a transition from a start and target camera state.
+     * @details A plain function pointer, so transition tables can be constexpr and calls are direct.
+     */
+    using SequenceFactory = std::unique_ptr<AnimationSequence> (*)(const CurrentCameraState& start_state, const CurrentCameraState& target_state);
+
+    /**
+     * @class BakedTransition
+     * @brief A transition sequence that is built once and re-bound to new start/target states at play time.
+     *
+     * @details Baking runs the factory with probe states and classifies every keyframe value as
+     *          either absolute, `start.<channel> + offset` or `target.<channel> + offset`. The
+     *          absolute keys never change; starting the transition only rewrites the few bound keys
+     *          in place, so playback begins without allocating or re-running the factory.
+     *          Factories whose output cannot be expressed this way are reported as not bakeable and
+     *          the caller keeps using them directly.
+     */
+    class BakedTransition
+    {
+    public:
+        /**
+         * @brief Builds the baked form of a transition.
+         * @param factory The factory to bake.
+         * @param settings_hash The hash of the settings the factory reads (see HashTransitionSettings).
+         * @return True if the transition could be baked, false if it must stay dynamic.
+         */
+        bool Bake(SequenceFactory factory, uint64_t settings_hash);
+
+        /**
+         * @brief Makes this bake play another one backwards, sharing its keys instead of copying them.
+         * @details Only the channels in `override_channels` are baked here, from `overrides`; every other
+         *          channel views the keys of `forward` reversed. Bind() binds `forward` with the states
+         *          swapped, so the two must not play at once (see GetKeySource()). The bake stays valid only
+         *          as long as `forward` is valid and not pinned, since an asset may define that transition
+         *          without defining this one.
+         * @param forward The bake of the transition the other way round. Must outlive this bake.
+         * @param overrides Optional; builds the overridden channels and nothing else (see CreateChannelSubset).
+         * @param override_channels ChannelBit mask of the channels `overrides` builds.
+         * @param settings_hash The hash the forward bake is valid for.
+         * @return True if the reversal could be baked.
+         */
+        bool BakeReversed(BakedTransition& forward, SequenceFactory overrides, uint32_t override_channels, uint64_t settings_hash);
+
+        /**
+         * @brief Builds the transition from an animation asset record instead of a factory.
+         * @details The result is pinned: it stays valid for every settings hash until Reset(), because the
+         *          asset, not the settings, defines its curves and duration.
+         * @param record The transition record.
+         * @param keys Its keys, as returned by AnimationAssets::GetKeys.
+         * @return True if the record describes a playable sequence.
+         */
+        bool Load(const AnimationAssets::TransitionRecord& record, const AnimationAssets::KeyRecord* keys);
+
+        /**
+         * @brief Writes the baked curves in asset form.
+         * @param record Receives the timing and per-channel key counts; `from`, `to` and `variant` are left to the caller.
+         * @param keys The keys are appended here; `record.first_key` is set to where they start.
+         * @return False if nothing is baked, the bake shares the keys of another (see BakeReversed()) or a key
+         *         uses a custom easing function.
+         */
+        bool Export(AnimationAssets::TransitionRecord& record, std::vector<AnimationAssets::KeyRecord>& keys) const;
+
+        /**
+         * @brief Checks whether the curves came from an animation asset.
+         */
+        bool IsPinned() const { return m_pinned; }
+
+        /**
+         * @brief Checks whether the baked data is usable for the given settings hash.
+         */
+        bool IsValidFor(uint64_t settings_hash) const
+        {
+            return m_sequence && (m_pinned || m_settings_hash == settings_hash) && IsForwardUsable(settings_hash);
+        }
+
+        /**
+         * @brief Checks whether a bake was attempted for the given settings hash, successful or not.
+         * @details A reversal whose forward bake has since changed counts as not attempted, so it is baked again.
+         */
+        bool WasBakedFor(uint64_t settings_hash) const
+        {
+            return m_pinned || (m_bake_attempted && m_settings_hash == settings_hash && IsForwardUsable(settings_hash));
+        }
+
+        /**
+         * @brief Gets the duration of the baked sequence in microseconds, or 0 if nothing is baked.
+         */
+        uint64_t GetDuration() const
+        {
+            if (m_forward)
+            {
+                return m_forward->GetDuration();
+            }
+            return m_sequence ? m_sequence->GetDuration() : 0;
+        }
+
+        /**
+         * @brief Gets the bake whose keys this one plays: the forward bake of a reversal, this one otherwise.
+         * @details Two bakes with the same key source cannot play at once, since binding one re-binds both.
+         */
+        const BakedTransition* GetKeySource() const { return m_forward ? m_forward : this; }
+
+        /**
+         * @brief Patches the bound keyframes for a new start/target state.
+         * @param start_state The camera state the transition starts from.
+         * @param target_state The camera state the transition ends at.
+         * @return The ready-to-start sequence owned by this object, or nullptr if not baked.
+         */
+        AnimationSequence* Bind(const CurrentCameraState& start_state, const CurrentCameraState& target_state);
+
+        /**
+         * @brief Checks whether a sequence is the one this object bakes into, e.g. the playing one.
+         */
+        bool Owns(const AnimationSequence* sequence) const { return sequence && m_sequence.get() == sequence; }
+
+        /**
+         * @brief Discards the baked data.
+         */
+        void Reset();
+
+    private:
+        enum class Source : uint8_t
+        {
+            Start,
+            Target
+        };
+
+        struct Patch
+        {
+            uint32_t key_index;
+            Source source;
+            uint8_t source_channel;
+            float offset;
+        };
+
+        bool IsForwardUsable(uint64_t settings_hash) const { return !m_forward || (m_forward->IsValidFor(settings_hash) && !m_forward->m_pinned); }
+
+        std::unique_ptr<AnimationSequence> m_sequence;
+        std::vector<Patch> m_patches;
+        BakedTransition* m_forward = nullptr; // Set by BakeReversed().
+        uint32_t m_shared_channels = 0;       // Channels played from the keys of m_forward.
+        uint64_t m_settings_hash = 0;
+        bool m_bake_attempted = false;
+        bool m_pinned = false; // Loaded from an animation asset.
+    };
+
+    /**
+     * @brief Hashes the settings fields that transition factories read.
+     * @param settings The current plugin settings.
+     * @return A hash that changes whenever a baked transition could change.
+     */
+    uint64_t HashTransitionSettings(const AppSettings& settings);
+
+} // namespace SPF_CabinWalk::Animation
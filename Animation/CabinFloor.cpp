@@ -0,0 +1,98 @@
+#include <cmath>
+#include "Animation/CabinFloor.hpp"
+
+namespace SPF_CabinWalk::Animation
+{
+    /**
+     * @brief Gets the cell count along an axis: cells of about CELL_SIZE, at least one, at most MAX_CELLS.
+     */
+    static uint32_t CellCount(float extent)
+    {
+        const float cells = std::ceil(extent / CabinFloor::CELL_SIZE);
+        if (!(cells >= 1.0f))
+        {
+            return 1;
+        }
+        return cells < static_cast<float>(CabinFloor::MAX_CELLS) ? static_cast<uint32_t>(cells) : CabinFloor::MAX_CELLS;
+    }
+
+    void CabinFloor::Build(const FloorLayout &layout)
+    {
+        const float extent_x = layout.max_x > layout.min_x ? layout.max_x - layout.min_x : 0.0f;
+        const float extent_z = layout.max_z > layout.min_z ? layout.max_z - layout.min_z : 0.0f;
+
+        m_origin_x = layout.min_x;
+        m_origin_z = layout.min_z;
+        m_max_x = layout.min_x + extent_x;
+        m_max_z = layout.min_z + extent_z;
+        m_cells_x = CellCount(extent_x);
+        m_cells_z = CellCount(extent_z);
+        // A zero extent still gets one cell, wide enough that only its own edge is walkable.
+        const float cell_x = extent_x > 0.0f ? extent_x / static_cast<float>(m_cells_x) : CELL_SIZE * 0.01f;
+        const float cell_z = extent_z > 0.0f ? extent_z / static_cast<float>(m_cells_z) : CELL_SIZE * 0.01f;
+        m_inv_cell_x = 1.0f / cell_x;
+        m_inv_cell_z = 1.0f / cell_z;
+
+        // --- Heights at the cell corners ---
+        for (uint32_t iz = 0; iz <= m_cells_z; ++iz)
+        {
+            const float z = m_origin_z + static_cast<float>(iz) * cell_z;
+            const float height = (layout.step_height != 0.0f && z >= layout.step_z) ? layout.step_height : 0.0f;
+            for (uint32_t ix = 0; ix <= m_cells_x; ++ix)
+            {
+                m_heights[iz][ix] = height;
+            }
+        }
+
+        // --- Occupancy: every cell of the rectangle, unless it is too steep to climb ---
+        for (uint32_t iz = 0; iz < MAX_CELLS; ++iz)
+        {
+            m_walkable[iz] = 0;
+            if (iz >= m_cells_z)
+            {
+                continue;
+            }
+
+            for (uint32_t ix = 0; ix < m_cells_x; ++ix)
+            {
+                const float corners[] = {m_heights[iz][ix], m_heights[iz][ix + 1], m_heights[iz + 1][ix], m_heights[iz + 1][ix + 1]};
+                float lowest = corners[0];
+                float highest = corners[0];
+                for (float corner : corners)
+                {
+                    lowest = corner < lowest ? corner : lowest;
+                    highest = corner > highest ? corner : highest;
+                }
+                if (highest - lowest <= MAX_STEP_HEIGHT)
+                {
+                    m_walkable[iz] |= 1u << ix;
+                }
+            }
+        }
+    }
+
+    float CabinFloor::SampleHeight(float x, float z) const
+    {
+        float fx = (x - m_origin_x) * m_inv_cell_x;
+        float fz = (z - m_origin_z) * m_inv_cell_z;
+        fx = fx < 0.0f ? 0.0f : (fx > static_cast<float>(m_cells_x) ? static_cast<float>(m_cells_x) : fx);
+        fz = fz < 0.0f ? 0.0f : (fz > static_cast<float>(m_cells_z) ? static_cast<float>(m_cells_z) : fz);
+
+        // The far edge samples the last cell at its end, so the corner index stays in range.
+        const uint32_t ix = static_cast<uint32_t>(fx) < m_cells_x ? static_cast<uint32_t>(fx) : m_cells_x - 1;
+        const uint32_t iz = static_cast<uint32_t>(fz) < m_cells_z ? static_cast<uint32_t>(fz) : m_cells_z - 1;
+        const float tx = fx - static_cast<float>(ix);
+        const float tz = fz - static_cast<float>(iz);
+
+        const float near_row = m_heights[iz][ix] + (m_heights[iz][ix + 1] - m_heights[iz][ix]) * tx;
+        const float far_row = m_heights[iz + 1][ix] + (m_heights[iz + 1][ix + 1] - m_heights[iz + 1][ix]) * tx;
+        return near_row + (far_row - near_row) * tz;
+    }
+
+    void CabinFloor::ClampToBounds(float &x, float &z) const
+    {
+        x = x < m_origin_x ? m_origin_x : (x > m_max_x ? m_max_x : x);
+        z = z < m_origin_z ? m_origin_z : (z > m_max_z ? m_max_z : z);
+    }
+
+} // namespace SPF_CabinWalk::Animation
@@ -0,0 +1,78 @@
+#pragma once
+#include <cstdint>
+
+namespace SPF_CabinWalk::Animation
+{
+    /**
+     * @brief The walkable floor of a cabin, as set up by the walking settings of a truck.
+     */
+    struct FloorLayout
+    {
+        float min_x; // Walkable rectangle, in seat coordinates.
+        float max_x;
+        float min_z;
+        float max_z;
+        float step_z;      // The floor behind this Z (towards +Z) is raised...
+        float step_height; // ...by this much. 0 for a flat floor.
+    };
+
+    /**
+     * @class CabinFloor
+     * @brief A precomputed occupancy and height grid over the cabin floor.
+     *
+     * @details Built once per layout into fixed inline storage. Each row of cells is a bit mask, so the
+     *          walkability of a point is one multiply-add per axis and a bit test. Floor heights are stored
+     *          at the cell corners and sampled bilinearly, so a step in the floor becomes a ramp one cell
+     *          wide; a cell whose corners differ by more than MAX_STEP_HEIGHT is too steep to climb and is
+     *          not walkable, which turns a tall step into a wall. No allocations.
+     */
+    class CabinFloor
+    {
+    public:
+        static constexpr uint32_t MAX_CELLS = 32;        // Per axis.
+        static constexpr float CELL_SIZE = 0.05f;        // Target cell size; larger when the floor needs more than MAX_CELLS.
+        static constexpr float MAX_STEP_HEIGHT = 0.25f;  // Highest rise a walker climbs within one cell.
+
+        /**
+         * @brief Rebuilds the grid for a layout. An empty rectangle leaves a one-cell floor at its corner.
+         */
+        void Build(const FloorLayout &layout);
+
+        /**
+         * @brief Checks whether a point lies on a walkable cell. Points outside the grid are not walkable.
+         */
+        bool IsWalkable(float x, float z) const
+        {
+            const float fx = (x - m_origin_x) * m_inv_cell_x;
+            const float fz = (z - m_origin_z) * m_inv_cell_z;
+            if (!(fx >= 0.0f && fz >= 0.0f && fx < static_cast<float>(m_cells_x) && fz < static_cast<float>(m_cells_z)))
+            {
+                return false;
+            }
+            return (m_walkable[static_cast<uint32_t>(fz)] >> static_cast<uint32_t>(fx)) & 1u;
+        }
+
+        /**
+         * @brief Samples the floor height at a point, clamped to the edge of the grid.
+         */
+        float SampleHeight(float x, float z) const;
+
+        /**
+         * @brief Moves a point onto the walkable rectangle.
+         */
+        void ClampToBounds(float &x, float &z) const;
+
+    private:
+        float m_origin_x = 0.0f;
+        float m_origin_z = 0.0f;
+        float m_inv_cell_x = 1.0f; // Cells per metre.
+        float m_inv_cell_z = 1.0f;
+        float m_max_x = 0.0f;
+        float m_max_z = 0.0f;
+        uint32_t m_cells_x = 0;
+        uint32_t m_cells_z = 0;
+        uint32_t m_walkable[MAX_CELLS] = {};              // Bit x of row z.
+        float m_heights[MAX_CELLS + 1][MAX_CELLS + 1] = {}; // [z][x], at the cell corners.
+    };
+
+} // namespace SPF_CabinWalk::Animation
@@ -0,0 +1,111 @@
+#include "Animation/ChannelEvaluator.hpp"
+
+#if defined(SPF_CABINWALK_ENABLE_SIMD) && (defined(_M_X64) || defined(__SSE2__))
+#define SPF_CABINWALK_SIMD_EVALUATOR 1
+#include <emmintrin.h>
+#else
+#define SPF_CABINWALK_SIMD_EVALUATOR 0
+#endif
+
+namespace SPF_CabinWalk::Animation
+{
+    namespace
+    {
+        // Six channels rounded up to two SSE registers. The padding lanes hold a constant zero segment.
+        constexpr size_t LANE_COUNT = 8;
+
+        struct alignas(16) SegmentLanes
+        {
+            float start_value[LANE_COUNT] = {};
+            float end_value[LANE_COUNT] = {};
+            float start_progress[LANE_COUNT] = {};
+            float inv_duration[LANE_COUNT] = {};
+            float local_progress[LANE_COUNT] = {};
+            uint8_t easing_id[LANE_COUNT] = {};
+            const float* coefficients[LANE_COUNT] = {};
+        };
+
+        void Gather(Track<float> (&tracks)[CHANNEL_COUNT], float progress, const float (&values)[CHANNEL_COUNT], SegmentLanes& lanes)
+        {
+            for (size_t i = 0; i < CHANNEL_COUNT; ++i)
+            {
+                const Track<float>::Segment segment = tracks[i].Locate(progress, values[i]);
+                lanes.start_value[i] = segment.start_value;
+                lanes.end_value[i] = segment.end_value;
+                lanes.start_progress[i] = segment.start_progress;
+                lanes.inv_duration[i] = segment.inv_duration;
+                lanes.easing_id[i] = segment.easing_id;
+                lanes.coefficients[i] = segment.coefficients;
+            }
+        }
+
+        // The easing curve differs per channel, so it stays a scalar (inlined) switch per lane.
+        // Spline lanes lerp from 0 to 1, so their "eased" value passes through the final lerp unchanged.
+        void Ease(SegmentLanes& lanes, float (&eased)[LANE_COUNT])
+        {
+            for (size_t i = 0; i < CHANNEL_COUNT; ++i)
+            {
+                eased[i] = lanes.coefficients[i] ? EvaluateSpline(lanes.coefficients[i], lanes.local_progress[i])
+                                                 : Easing::Evaluate(lanes.easing_id[i], lanes.local_progress[i]);
+            }
+            for (size_t i = CHANNEL_COUNT; i < LANE_COUNT; ++i)
+            {
+                eased[i] = 0.0f;
+            }
+        }
+    } // namespace
+
+    bool IsSimdEvaluatorEnabled()
+    {
+        return SPF_CABINWALK_SIMD_EVALUATOR != 0;
+    }
+
+    void EvaluateChannels(Track<float> (&tracks)[CHANNEL_COUNT], float progress, float (&values)[CHANNEL_COUNT])
+    {
+        SegmentLanes lanes;
+        Gather(tracks, progress, values, lanes);
+
+        alignas(16) float eased[LANE_COUNT];
+
+#if SPF_CABINWALK_SIMD_EVALUATOR
+        const __m128 p = _mm_set1_ps(progress);
+        for (size_t i = 0; i < LANE_COUNT; i += 4)
+        {
+            const __m128 start_progress = _mm_load_ps(lanes.start_progress + i);
+            const __m128 inv_duration = _mm_load_ps(lanes.inv_duration + i);
+            _mm_store_ps(lanes.local_progress + i, _mm_mul_ps(_mm_sub_ps(p, start_progress), inv_duration));
+        }
+
+        Ease(lanes, eased);
+
+        alignas(16) float result[LANE_COUNT];
+        for (size_t i = 0; i < LANE_COUNT; i += 4)
+        {
+            const __m128 a = _mm_load_ps(lanes.start_value + i);
+            const __m128 b = _mm_load_ps(lanes.end_value + i);
+            const __m128 t = _mm_load_ps(eased + i);
+            _mm_store_ps(result + i, _mm_add_ps(a, _mm_mul_ps(_mm_sub_ps(b, a), t)));
+        }
+
+        for (size_t i = 0; i < CHANNEL_COUNT; ++i)
+        {
+            values[i] = tracks[i].IsAngular() ? WrapAngle(result[i]) : result[i];
+        }
+#else
+        for (size_t i = 0; i < CHANNEL_COUNT; ++i)
+        {
+            lanes.local_progress[i] = (progress - lanes.start_progress[i]) * lanes.inv_duration[i];
+        }
+
+        Ease(lanes, eased);
+
+        for (size_t i = 0; i < CHANNEL_COUNT; ++i)
+        {
+            const float a = lanes.start_value[i];
+            const float value = a + (lanes.end_value[i] - a) * eased[i];
+            values[i] = tracks[i].IsAngular() ? WrapAngle(value) : value;
+        }
+#endif
+    }
+
+} // namespace SPF_CabinWalk::Animation
@@ -0,0 +1,30 @@
+#pragma once
+#include "Animation/AnimationSequence.hpp"
+
+namespace SPF_CabinWalk::Animation
+{
+    /**
+     * @brief Evaluates all camera channels of a sequence at one progress point.
+     * @details Each track first locates its segment (scalar; cursor based), then the local progress
+     *          and the final lerp of all six channels are computed together. When the plugin is built
+     *          with SPF_CABINWALK_ENABLE_SIMD on an SSE2 target (always the case for MSVC x64) this is
+     *          done in SSE registers, otherwise a scalar loop is used.
+     *
+     *          Both paths perform the same single-precision operations in the same order (subtract,
+     *          multiply, ease, subtract, multiply, add) without fused multiply-add, so they produce
+     *          bit-identical results. The documented tolerance against Track::Evaluate is therefore 0,
+     *          provided the scalar path is not compiled with FP contraction (e.g. /fp:fast, -ffp-contract=fast).
+     *          Angular channels are normalized into [-PI, PI] on the way out, as Track::Evaluate does.
+     *
+     * @param tracks The tracks of the sequence, indexed by Channel.
+     * @param progress The current progress of the sequence (0.0 to 1.0).
+     * @param values In: the value held by channels whose track is empty. Out: the evaluated values.
+     */
+    void EvaluateChannels(Track<float> (&tracks)[CHANNEL_COUNT], float progress, float (&values)[CHANNEL_COUNT]);
+
+    /**
+     * @brief Checks whether EvaluateChannels was compiled with the SIMD path.
+     */
+    bool IsSimdEvaluatorEnabled();
+
+} // namespace SPF_CabinWalk::Animation
@@ -1,98 +1,109 @@
 #include "Easing.hpp"
-#include <cmath> // For std::pow
+#include <cstddef>
 
 namespace SPF_CabinWalk::Easing
 {
+    // The named functions are thin wrappers over the inline kernels. They exist so keyframes can keep
+    // referring to curves by function pointer; ToId maps them back to their built-in id.
+
     // Linear interpolation (no easing)
-    float linear(float t)
-    {
-        return t;
-    }
+    float linear(float t) { return Kernels::Linear(t); }
 
     // Quadratic easing functions (t^2)
-    float easeInQuad(float t)
-    {
-        return t * t;
-    }
-
-    float easeOutQuad(float t)
-    {
-        return 1.0f - (1.0f - t) * (1.0f - t);
-    }
-
-    float easeInOutQuad(float t)
-    {
-        return t < 0.5f ? 2.0f * t * t : 1.0f - std::pow(-2.0f * t + 2.0f, 2.0f) / 2.0f;
-    }
+    float easeInQuad(float t) { return Kernels::InQuad(t); }
+    float easeOutQuad(float t) { return Kernels::OutQuad(t); }
+    float easeInOutQuad(float t) { return Kernels::InOutQuad(t); }
 
     // Cubic easing functions (t^3)
-    float easeInCubic(float t)
-    {
-        return t * t * t;
-    }
-
-    float easeOutCubic(float t)
-    {
-        return 1.0f - std::pow(1.0f - t, 3.0f);
-    }
-
-    float easeInOutCubic(float t)
-    {
-        return t < 0.5f ? 4.0f * t * t * t : 1.0f - std::pow(-2.0f * t + 2.0f, 3.0f) / 2.0f;
-    }
+    float easeInCubic(float t) { return Kernels::InCubic(t); }
+    float easeOutCubic(float t) { return Kernels::OutCubic(t); }
+    float easeInOutCubic(float t) { return Kernels::InOutCubic(t); }
 
     // Quartic easing functions (t^4)
-    float easeInQuart(float t)
-    {
-        return t * t * t * t;
-    }
-
-    float easeOutQuart(float t)
-    {
-        return 1.0f - std::pow(1.0f - t, 4.0f);
-    }
-
-    float easeInOutQuart(float t)
-    {
-        return t < 0.5f ? 8.0f * t * t * t * t : 1.0f - std::pow(-2.0f * t + 2.0f, 4.0f) / 2.0f;
-    }
+    float easeInQuart(float t) { return Kernels::InQuart(t); }
+    float easeOutQuart(float t) { return Kernels::OutQuart(t); }
+    float easeInOutQuart(float t) { return Kernels::InOutQuart(t); }
 
     // Quintic easing functions (t^5)
-    float easeInQuint(float t)
-    {
-        return t * t * t * t * t;
-    }
-
-    float easeOutQuint(float t)
-    {
-        return 1.0f - std::pow(1.0f - t, 5.0f);
-    }
-
-    float easeInOutQuint(float t)
-    {
-        return t < 0.5f ? 16.0f * t * t * t * t * t : 1.0f - std::pow(-2.0f * t + 2.0f, 5.0f) / 2.0f;
-    }
+    float easeInQuint(float t) { return Kernels::InQuint(t); }
+    float easeOutQuint(float t) { return Kernels::OutQuint(t); }
+    float easeInOutQuint(float t) { return Kernels::InOutQuint(t); }
 
     // Exponential easing functions (2^t)
-    float easeInExpo(float t)
-    {
-        return t == 0.0f ? 0.0f : std::pow(2.0f, 10.0f * t - 10.0f);
-    }
+    float easeInExpo(float t) { return Kernels::InExpo(t); }
+    float easeOutExpo(float t) { return Kernels::OutExpo(t); }
+    float easeInOutExpo(float t) { return Kernels::InOutExpo(t); }
+
+    // =================================================================================================
+    // Id Table
+    // =================================================================================================
+
+    namespace
+    {
+        using Function = float (*)(float);
+
+        // Indexed by EasingId. Must stay in the same order as the enum.
+        const Function g_builtin_functions[] = {
+            linear,
+            easeInQuad, easeOutQuad, easeInOutQuad,
+            easeInCubic, easeOutCubic, easeInOutCubic,
+            easeInQuart, easeOutQuart, easeInOutQuart,
+            easeInQuint, easeOutQuint, easeInOutQuint,
+            easeInExpo, easeOutExpo, easeInOutExpo,
+            linear, // Spline: evaluated from per-segment coefficients, never through this table.
+        };
+        static_assert(sizeof(g_builtin_functions) / sizeof(g_builtin_functions[0]) == static_cast<size_t>(EasingId::BuiltInCount),
+                      "Easing id table is out of sync with EasingId");
+
+        Function g_custom_functions[MAX_CUSTOM_EASING_FUNCTIONS] = {};
+        uint8_t g_custom_function_count = 0;
+    } // namespace
+
+    uint8_t ToId(float (*fn)(float))
+    {
+        constexpr uint8_t builtin_count = static_cast<uint8_t>(EasingId::BuiltInCount);
+
+        for (uint8_t i = 0; i < builtin_count; ++i)
+        {
+            if (g_builtin_functions[i] == fn)
+            {
+                return i;
+            }
+        }
+
+        for (uint8_t i = 0; i < g_custom_function_count; ++i)
+        {
+            if (g_custom_functions[i] == fn)
+            {
+                return builtin_count + i;
+            }
+        }
+
+        if (!fn || g_custom_function_count >= MAX_CUSTOM_EASING_FUNCTIONS)
+        {
+            return static_cast<uint8_t>(EasingId::Linear);
+        }
+
+        g_custom_functions[g_custom_function_count] = fn;
+        return builtin_count + g_custom_function_count++;
+    }
+
+    float EvaluateCustom(uint8_t id, float t)
+    {
+        constexpr uint8_t builtin_count = static_cast<uint8_t>(EasingId::BuiltInCount);
+
+        if (id < builtin_count)
+        {
+            return Evaluate(id, t);
+        }
+
+        const uint8_t custom_index = id - builtin_count;
+        if (custom_index < g_custom_function_count)
+        {
+            return g_custom_functions[custom_index](t);
+        }
 
-    float easeOutExpo(float t)
-    {
-        return t == 1.0f ? 1.0f : 1.0f - std::pow(2.0f, -10.0f * t);
-    }
-
-    float easeInOutExpo(float t)
-    {
-        return t == 0.0f
-                   ? 0.0f
-               : t == 1.0f
-                   ? 1.0f
-               : t < 0.5f
-                   ? std::pow(2.0f, 20.0f * t - 10.0f) / 2.0f
-                   : (2.0f - std::pow(2.0f, -20.0f * t + 10.0f)) / 2.0f;
+        return t;
     }
 
 } // namespace SPF_CabinWalk::Easing
\ No newline at end of file
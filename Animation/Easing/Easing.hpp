@@ -1,7 +1,215 @@
 #pragma once
 
+#include <bit>
+#include <cstdint>
+
 namespace SPF_CabinWalk::Easing
 {
+    /**
+     * @brief Compact identifiers for the easing curves, used by the packed keyframe storage.
+     * @details The built-in functions below own the fixed ids. Any other function pointer handed to a
+     *          keyframe is assigned one of the custom slots (starting at BuiltInCount) on first use.
+     *          Spline is not a curve of its own: it marks a keyframe whose incoming segment is a cubic
+     *          Hermite spline through the neighbouring keys (see Track).
+     */
+    enum class EasingId : uint8_t
+    {
+        Linear = 0,
+        InQuad,
+        OutQuad,
+        InOutQuad,
+        InCubic,
+        OutCubic,
+        InOutCubic,
+        InQuart,
+        OutQuart,
+        InOutQuart,
+        InQuint,
+        OutQuint,
+        InOutQuint,
+        InExpo,
+        OutExpo,
+        InOutExpo,
+        Spline,
+        BuiltInCount
+    };
+
+    // Maximum number of non built-in easing functions that can be referenced by keyframes.
+    constexpr uint8_t MAX_CUSTOM_EASING_FUNCTIONS = 16;
+
+    /**
+     * @brief Gets the curve that retraces an easing backwards, `1 - f(1 - t)`: in and out swap.
+     * @details Symmetric curves (Linear, the InOut family) and Spline, whose tangents do not depend on the
+     *          direction, are their own reversal. Custom functions are kept as they are.
+     */
+    constexpr uint8_t ReverseId(uint8_t id)
+    {
+        switch (static_cast<EasingId>(id))
+        {
+        case EasingId::InQuad: return static_cast<uint8_t>(EasingId::OutQuad);
+        case EasingId::OutQuad: return static_cast<uint8_t>(EasingId::InQuad);
+        case EasingId::InCubic: return static_cast<uint8_t>(EasingId::OutCubic);
+        case EasingId::OutCubic: return static_cast<uint8_t>(EasingId::InCubic);
+        case EasingId::InQuart: return static_cast<uint8_t>(EasingId::OutQuart);
+        case EasingId::OutQuart: return static_cast<uint8_t>(EasingId::InQuart);
+        case EasingId::InQuint: return static_cast<uint8_t>(EasingId::OutQuint);
+        case EasingId::OutQuint: return static_cast<uint8_t>(EasingId::InQuint);
+        case EasingId::InExpo: return static_cast<uint8_t>(EasingId::OutExpo);
+        case EasingId::OutExpo: return static_cast<uint8_t>(EasingId::InExpo);
+        default: return id;
+        }
+    }
+
+    /**
+     * @brief Resolves an easing function pointer to its compact id.
+     * @param fn The easing function. Unknown functions are registered into a custom slot.
+     * @return The id to store in the keyframe buffer. Falls back to Linear if the custom table is full.
+     */
+    uint8_t ToId(float (*fn)(float));
+
+    /**
+     * @brief Evaluates a custom easing function registered through ToId.
+     * @param id An id at or above EasingId::BuiltInCount.
+     * @param t Local progress (0.0 to 1.0).
+     * @return The eased progress, or `t` if the id is not registered.
+     */
+    float EvaluateCustom(uint8_t id, float t);
+
+    // =================================================================================================
+    // Kernels
+    // =================================================================================================
+
+    /**
+     * @brief Inline, pow-free implementations of the built-in curves.
+     * @details Polynomials are written in terms of `u = 1 - t` so that every form is a short multiply
+     *          chain. The Expo family uses Exp2 below instead of std::pow.
+     */
+    namespace Kernels
+    {
+        /**
+         * @brief Fast 2^x for the range the Expo curves use ([-10, 0]).
+         * @details Splits x into an integer part, written straight into the float exponent, and a
+         *          fraction in [-0.5, 0.5] evaluated with a degree-6 Horner polynomial (relative error < 2e-7).
+         */
+        inline float Exp2(float x)
+        {
+            if (x < -126.0f)
+            {
+                return 0.0f;
+            }
+
+            const float rounded = static_cast<float>(static_cast<int32_t>(x + (x < 0.0f ? -0.5f : 0.5f)));
+            const float f = x - rounded;
+            const float p = 1.0f + f * (0.693147181f + f * (0.240226507f + f * (0.0555041087f + f * (0.00961812911f + f * (0.00133335581f + f * 0.000154035304f)))));
+            const uint32_t exponent_bits = static_cast<uint32_t>(static_cast<int32_t>(rounded) + 127) << 23;
+            return p * std::bit_cast<float>(exponent_bits);
+        }
+
+        constexpr float Linear(float t) { return t; }
+
+        constexpr float InQuad(float t) { return t * t; }
+        constexpr float OutQuad(float t) { return t * (2.0f - t); }
+        constexpr float InOutQuad(float t)
+        {
+            const float u = 1.0f - t;
+            return t < 0.5f ? 2.0f * t * t : 1.0f - 2.0f * u * u;
+        }
+
+        constexpr float InCubic(float t) { return t * t * t; }
+        constexpr float OutCubic(float t)
+        {
+            const float u = 1.0f - t;
+            return 1.0f - u * u * u;
+        }
+        constexpr float InOutCubic(float t)
+        {
+            const float u = 1.0f - t;
+            return t < 0.5f ? 4.0f * t * t * t : 1.0f - 4.0f * u * u * u;
+        }
+
+        constexpr float InQuart(float t)
+        {
+            const float t2 = t * t;
+            return t2 * t2;
+        }
+        constexpr float OutQuart(float t)
+        {
+            const float u = 1.0f - t;
+            const float u2 = u * u;
+            return 1.0f - u2 * u2;
+        }
+        constexpr float InOutQuart(float t)
+        {
+            const float u = 1.0f - t;
+            const float t2 = t * t;
+            const float u2 = u * u;
+            return t < 0.5f ? 8.0f * t2 * t2 : 1.0f - 8.0f * u2 * u2;
+        }
+
+        constexpr float InQuint(float t)
+        {
+            const float t2 = t * t;
+            return t2 * t2 * t;
+        }
+        constexpr float OutQuint(float t)
+        {
+            const float u = 1.0f - t;
+            const float u2 = u * u;
+            return 1.0f - u2 * u2 * u;
+        }
+        constexpr float InOutQuint(float t)
+        {
+            const float u = 1.0f - t;
+            const float t2 = t * t;
+            const float u2 = u * u;
+            return t < 0.5f ? 16.0f * t2 * t2 * t : 1.0f - 16.0f * u2 * u2 * u;
+        }
+
+        inline float InExpo(float t) { return t == 0.0f ? 0.0f : Exp2(10.0f * t - 10.0f); }
+        inline float OutExpo(float t) { return t == 1.0f ? 1.0f : 1.0f - Exp2(-10.0f * t); }
+        inline float InOutExpo(float t)
+        {
+            if (t == 0.0f || t == 1.0f)
+            {
+                return t;
+            }
+            return t < 0.5f ? 0.5f * Exp2(20.0f * t - 10.0f) : 1.0f - 0.5f * Exp2(-20.0f * t + 10.0f);
+        }
+    } // namespace Kernels
+
+    /**
+     * @brief Evaluates the easing curve identified by `id`.
+     * @details Built-in curves are dispatched through a switch so the kernels inline into the track
+     *          evaluator; only custom functions go through an indirect call.
+     * @param id A value previously returned by ToId (or an EasingId cast to uint8_t).
+     * @param t Local progress (0.0 to 1.0).
+     * @return The eased progress.
+     */
+    inline float Evaluate(uint8_t id, float t)
+    {
+        switch (static_cast<EasingId>(id))
+        {
+        case EasingId::Linear:     return Kernels::Linear(t);
+        case EasingId::InQuad:     return Kernels::InQuad(t);
+        case EasingId::OutQuad:    return Kernels::OutQuad(t);
+        case EasingId::InOutQuad:  return Kernels::InOutQuad(t);
+        case EasingId::InCubic:    return Kernels::InCubic(t);
+        case EasingId::OutCubic:   return Kernels::OutCubic(t);
+        case EasingId::InOutCubic: return Kernels::InOutCubic(t);
+        case EasingId::InQuart:    return Kernels::InQuart(t);
+        case EasingId::OutQuart:   return Kernels::OutQuart(t);
+        case EasingId::InOutQuart: return Kernels::InOutQuart(t);
+        case EasingId::InQuint:    return Kernels::InQuint(t);
+        case EasingId::OutQuint:   return Kernels::OutQuint(t);
+        case EasingId::InOutQuint: return Kernels::InOutQuint(t);
+        case EasingId::InExpo:     return Kernels::InExpo(t);
+        case EasingId::OutExpo:    return Kernels::OutExpo(t);
+        case EasingId::InOutExpo:  return Kernels::InOutExpo(t);
+        case EasingId::Spline:     return Kernels::Linear(t); // Only reached without spline coefficients.
+        default:                   return EvaluateCustom(id, t);
+        }
+    }
+
     // Linear interpolation (no easing)
     float linear(float t);
 
@@ -31,5 +239,4 @@ namespace SPF_CabinWalk::Easing
     float easeInOutExpo(float t);
 
     // TODO: Consider implementing Circ, Back, Elastic, Bounce functions.
-    // TODO: Consider implementing Bezier curves for maximum flexibility.
 } // namespace SPF_CabinWalk::Easing
\ No newline at end of file
@@ -0,0 +1,99 @@
+#pragma once
+#include <cstdint>
+
+namespace SPF_CabinWalk::Animation
+{
+    /**
+     * @brief Something the owner of a sequence reacts to at a point of its playback.
+     */
+    enum class SequenceEvent : uint8_t
+    {
+        Arrive,      // The camera is at the target; the position's follow-up work can run.
+        JoinNextLeg, // A seamless next leg of a chained move may start (see AnimationController::JoinNextLeg).
+        Count
+    };
+
+    static_assert(static_cast<uint32_t>(SequenceEvent::Count) <= 32, "Fired events are returned as a bit mask");
+
+    /**
+     * @brief Gets the bit of an event in the mask returned by EventTrack::Fire.
+     */
+    constexpr uint32_t EventBit(SequenceEvent event)
+    {
+        return 1u << static_cast<uint32_t>(event);
+    }
+
+    /**
+     * @class EventTrack
+     * @brief Event markers at progress points of a sequence, sorted by progress and fired through a cursor.
+     * @details Held inline by the sequence, so adding markers to a pooled or baked sequence never allocates.
+     *          Markers are fired in progress order, each once per playback, however large a step skips over.
+     */
+    class EventTrack
+    {
+    public:
+        static constexpr uint32_t MAX_MARKERS = 4;
+
+        /**
+         * @brief Adds a marker, keeping the track sorted. Markers at the same progress fire in the order added.
+         * @return False if the track is full.
+         */
+        bool Add(float progress, SequenceEvent event)
+        {
+            if (m_count >= MAX_MARKERS)
+            {
+                return false;
+            }
+
+            uint32_t i = m_count++;
+            while (i > 0 && m_markers[i - 1].progress > progress)
+            {
+                m_markers[i] = m_markers[i - 1];
+                --i;
+            }
+            m_markers[i] = {progress, event};
+            return true;
+        }
+
+        /**
+         * @brief Removes every marker.
+         */
+        void Clear()
+        {
+            m_count = 0;
+            m_cursor = 0;
+        }
+
+        /**
+         * @brief Moves the cursor back to the start, so every marker fires again.
+         */
+        void Rewind() { m_cursor = 0; }
+
+        /**
+         * @brief Fires the markers the playback has reached since the last call.
+         * @param progress The playback progress after the step.
+         * @return The EventBit of every marker fired.
+         */
+        uint32_t Fire(float progress)
+        {
+            uint32_t fired = 0;
+            while (m_cursor < m_count && m_markers[m_cursor].progress <= progress)
+            {
+                fired |= EventBit(m_markers[m_cursor++].event);
+            }
+            return fired;
+        }
+
+    private:
+        struct Marker
+        {
+            float progress;
+            SequenceEvent event;
+        };
+
+        Marker m_markers[MAX_MARKERS] = {};
+        uint32_t m_count = 0;
+        uint32_t m_cursor = 0;
+    };
+
+} // namespace SPF_CabinWalk::Animation
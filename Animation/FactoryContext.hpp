@@ -0,0 +1,61 @@
+#pragma once
+#include "SPF_CabinWalk.hpp"                 // For g_ctx, AppSettings
+#include "Animation/AnimationController.hpp" // For HasPendingMoves
+
+namespace SPF_CabinWalk::Animation
+{
+    /**
+     * @brief What a transition factory reads besides its start and target state.
+     * @details Factories run on the game thread for live moves and on the rebake worker for bakes. The
+     *          worker installs a context holding its own settings snapshot, so it never reads state that
+     *          the game thread is writing.
+     */
+    struct FactoryContext
+    {
+        const AppSettings *settings;
+        bool has_pending_moves;
+    };
+
+    namespace Detail
+    {
+        inline thread_local const FactoryContext *t_factory_context = nullptr;
+    }
+
+    /**
+     * @brief Gets the settings a transition factory builds from: the installed context's, else g_ctx.settings.
+     */
+    inline const AppSettings &GetFactorySettings()
+    {
+        return Detail::t_factory_context ? *Detail::t_factory_context->settings : g_ctx.settings;
+    }
+
+    /**
+     * @brief Checks whether the transition being built is followed by more moves, which some factories shape for.
+     */
+    inline bool FactoryHasPendingMoves()
+    {
+        return Detail::t_factory_context ? Detail::t_factory_context->has_pending_moves : AnimationController::HasPendingMoves();
+    }
+
+    /**
+     * @class FactoryContextScope
+     * @brief Installs a FactoryContext on the calling thread for the lifetime of the scope.
+     */
+    class FactoryContextScope
+    {
+    public:
+        explicit FactoryContextScope(const FactoryContext &context) : m_previous(Detail::t_factory_context)
+        {
+            Detail::t_factory_context = &context;
+        }
+
+        ~FactoryContextScope() { Detail::t_factory_context = m_previous; }
+
+        FactoryContextScope(const FactoryContextScope &) = delete;
+        FactoryContextScope &operator=(const FactoryContextScope &) = delete;
+
+    private:
+        const FactoryContext *m_previous;
+    };
+
+} // namespace SPF_CabinWalk::Animation
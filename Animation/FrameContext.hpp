@@ -0,0 +1,22 @@
+#pragma once
+#include <cstdint>
+#include "Animation/AnimationSequence.hpp" // For Animation::CurrentCameraState
+
+namespace SPF_CabinWalk
+{
+    /**
+     * @brief Everything the controllers read about the current frame, sampled once at the top of OnUpdate.
+     * @details Passed by const reference down through AnimationController::Update, the AnimationScheduler
+     *          and StandingAnimController::Tick, so every decision in a frame sees the same clock, pose and
+     *          input. Tools can build one by hand to drive the controllers deterministically.
+     */
+    struct FrameContext
+    {
+        uint64_t frame = 0;                  // Telemetry frame counter (PluginContext::telemetry.frame).
+        uint64_t simulation_time_us = 0;     // Simulation timestamp of this frame.
+        uint64_t delta_time_us = 0;          // Simulation time since the previous frame; 0 on the first frame or after a reset.
+        Animation::CurrentCameraState camera = {}; // Interior camera pose before any module has written to it.
+        bool walk_key_down = false;          // State of the walk toggle.
+    };
+
+} // namespace SPF_CabinWalk
@@ -0,0 +1,135 @@
+#define _USE_MATH_DEFINES
+#include <cmath>
+#include "Animation/GaitEngine.hpp"
+#include "Animation/CabinFloor.hpp"
+
+namespace SPF_CabinWalk::Animation
+{
+    // Below this speed, with no direction requested, the walker is considered at rest.
+    constexpr float REST_VELOCITY = 0.01f;
+
+    // Frame times above this (first frame, pauses) are clamped so a stall does not teleport the camera.
+    constexpr float MAX_FRAME_TIME_S = 0.1f;
+
+    /**
+     * @brief Moves `current` towards `target` as a critically damped spring with time constant `smooth_time`.
+     * @details `rate` carries the spring's derivative between calls. Uses the rational approximation of
+     *          exp(-omega * dt), which stays stable for any frame time.
+     */
+    static float SmoothDamp(float current, float target, float &rate, float smooth_time, float dt)
+    {
+        const float omega = 2.0f / (smooth_time > 0.0001f ? smooth_time : 0.0001f);
+        const float x = omega * dt;
+        const float decay = 1.0f / (1.0f + x + 0.48f * x * x + 0.235f * x * x * x);
+        const float change = current - target;
+        const float temp = (rate + omega * change) * dt;
+        rate = (rate - omega * temp) * decay;
+        return target + (change + temp) * decay;
+    }
+
+    void GaitEngine::Begin(float x, float z, float base_y, const CabinFloor &floor)
+    {
+        floor.ClampToBounds(x, z);
+        m_x = x;
+        m_z = z;
+        m_y = base_y;
+        m_floor_y = floor.SampleHeight(x, z);
+        m_base_y = base_y - m_floor_y;
+        m_velocity_x = 0.0f;
+        m_velocity_z = 0.0f;
+        m_acceleration_x = 0.0f;
+        m_acceleration_z = 0.0f;
+        m_phase = 0.0f;
+        m_bob = 0.0f;
+        m_moving = true;
+    }
+
+    void GaitEngine::Update(float direction_x, float direction_z, float dt_s, const GaitParams &params)
+    {
+        if (!m_moving)
+        {
+            return;
+        }
+
+        const float dt = (dt_s < MAX_FRAME_TIME_S) ? dt_s : MAX_FRAME_TIME_S;
+        if (dt <= 0.0f)
+        {
+            return;
+        }
+
+        // --- Velocity: follow the requested direction through the start/stop filter ---
+        m_velocity_x = SmoothDamp(m_velocity_x, direction_x * params.speed, m_acceleration_x, params.smooth_time, dt);
+        m_velocity_z = SmoothDamp(m_velocity_z, direction_z * params.speed, m_acceleration_z, params.smooth_time, dt);
+
+        // --- Position: integrate, keeping whichever axis stays on walkable floor ---
+        const CabinFloor &floor = *params.floor;
+        const float previous_x = m_x;
+        const float previous_z = m_z;
+        const float next_x = m_x + m_velocity_x * dt;
+        const float next_z = m_z + m_velocity_z * dt;
+        if (floor.IsWalkable(next_x, next_z))
+        {
+            m_x = next_x;
+            m_z = next_z;
+        }
+        else
+        {
+            // Slide along the wall: the blocked axis stops dead, the free one carries on.
+            const bool x_free = floor.IsWalkable(next_x, m_z);
+            const bool z_free = !x_free && floor.IsWalkable(m_x, next_z);
+            if (x_free)
+            {
+                m_x = next_x;
+            }
+            else
+            {
+                m_velocity_x = 0.0f;
+                m_acceleration_x = 0.0f;
+            }
+            if (z_free)
+            {
+                m_z = next_z;
+            }
+            else
+            {
+                m_velocity_z = 0.0f;
+                m_acceleration_z = 0.0f;
+            }
+        }
+
+        // --- Head bob: one rise and fall per stride, fading out with speed ---
+        if (params.stride > 0.0f)
+        {
+            const float travelled = std::hypot(m_x - previous_x, m_z - previous_z);
+            m_phase = std::fmod(m_phase + static_cast<float>(M_PI) * travelled / params.stride, 2.0f * static_cast<float>(M_PI));
+        }
+        const float speed = std::hypot(m_velocity_x, m_velocity_z);
+        const float speed_ratio = (params.speed > 0.0f) ? std::fmin(speed / params.speed, 1.0f) : 0.0f;
+        const float s = std::sin(m_phase);
+        m_floor_y = floor.SampleHeight(m_x, m_z);
+        m_y = m_base_y + m_floor_y;
+        m_bob = params.bob_amount * speed_ratio * s * s;
+
+        if (direction_x == 0.0f && direction_z == 0.0f && speed < REST_VELOCITY)
+        {
+            Halt();
+        }
+    }
+
+    void GaitEngine::Halt()
+    {
+        m_velocity_x = 0.0f;
+        m_velocity_z = 0.0f;
+        m_acceleration_x = 0.0f;
+        m_acceleration_z = 0.0f;
+        m_y = m_base_y + m_floor_y;
+        m_bob = 0.0f;
+        m_moving = false;
+    }
+
+    float GaitEngine::GetStridePhase() const
+    {
+        return std::fmod(m_phase, static_cast<float>(M_PI)) / static_cast<float>(M_PI);
+    }
+
+} // namespace SPF_CabinWalk::Animation
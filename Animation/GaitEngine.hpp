@@ -0,0 +1,95 @@
+#pragma once
+
+namespace SPF_CabinWalk::Animation
+{
+    class CabinFloor;
+
+    /**
+     * @brief Tuning for GaitEngine, derived from the walking settings each frame.
+     */
+    struct GaitParams
+    {
+        float speed;       // Cruise speed, in metres per second.
+        float stride;      // Distance covered by one step; one head bob per stride.
+        float bob_amount;  // Peak head bob height at cruise speed.
+        float smooth_time; // Time constant of the start/stop filter, in seconds.
+        const CabinFloor *floor; // Where the walker may go, and how high the floor is there.
+    };
+
+    /**
+     * @class GaitEngine
+     * @brief Continuous standing locomotion over the cabin floor.
+     *
+     * @details Replaces chains of per-step walk sequences. The position integrates a velocity that follows
+     *          the requested direction through a critically damped filter, so walking starts and stops
+     *          smoothly but without having to finish a step. A step into a cell the CabinFloor does not allow
+     *          keeps whichever axis is still free, so the walker slides along walls, and the head follows
+     *          the floor height. The head bob is an analytic oscillator whose phase advances with the
+     *          distance travelled, scaled by the current speed so it settles when the walker stops.
+     *          Constant cost per frame, no allocations.
+     */
+    class GaitEngine
+    {
+    public:
+        /**
+         * @brief Starts walking from rest at the given position, moved onto the floor if it lies outside.
+         * @param x The current X position.
+         * @param z The current Z position.
+         * @param base_y The standing height the head bob oscillates above, at this point of the floor.
+         * @param floor The floor to walk on.
+         */
+        void Begin(float x, float z, float base_y, const CabinFloor &floor);
+
+        /**
+         * @brief Advances the gait by one frame.
+         * @param direction_x The X part of the walking direction, a unit vector, or 0 with direction_z to stop.
+         * @param direction_z The Z part.
+         * @param dt_s Frame time in seconds.
+         * @param params The tuning to use.
+         */
+        void Update(float direction_x, float direction_z, float dt_s, const GaitParams &params);
+
+        /**
+         * @brief Stops at once, dropping any remaining velocity.
+         */
+        void Halt();
+
+        /**
+         * @brief Checks whether the walker is still moving (walking, or settling after a stop).
+         */
+        bool IsMoving() const { return m_moving; }
+
+        float GetX() const { return m_x; }
+        float GetZ() const { return m_z; }
+
+        /**
+         * @brief Gets the head height at the walker's point of the floor, without the head bob.
+         */
+        float GetY() const { return m_y; }
+
+        /**
+         * @brief Gets the head bob above GetY().
+         */
+        float GetBob() const { return m_bob; }
+
+        /**
+         * @brief Gets how far through the current stride the walker is, in [0, 1).
+         */
+        float GetStridePhase() const;
+
+    private:
+        float m_x = 0.0f;
+        float m_z = 0.0f;
+        float m_y = 0.0f;
+        float m_bob = 0.0f;
+        float m_base_y = 0.0f;       // Standing height above a floor height of 0.
+        float m_floor_y = 0.0f;      // Floor height under the walker.
+        float m_velocity_x = 0.0f;
+        float m_velocity_z = 0.0f;
+        float m_acceleration_x = 0.0f; // State of the critically damped velocity filters.
+        float m_acceleration_z = 0.0f;
+        float m_phase = 0.0f;        // Bob phase in radians; advances by pi per stride.
+        bool m_moving = false;
+    };
+
+} // namespace SPF_CabinWalk::Animation
@@ -20,11 +20,15 @@ namespace SPF_CabinWalk::Animation
     {
         float progress;              // Progress point for this keyframe (0.0 to 1.0).
         T value;                     // The target value at this keyframe.
-        EasingFunction easing_function; // The easing function to use when interpolating TO this keyframe from the previous one.
+        uint8_t easing_id;           // The easing curve (Easing::EasingId or a custom slot) used when interpolating TO this keyframe from the previous one.
 
-        // Constructor
-        Keyframe(float prog, T val, EasingFunction easing = Easing::linear)
-            : progress(prog), value(val), easing_function(easing) {}
+        // Constructors. Built-in curves can be named by tag directly; function pointers are resolved
+        // to their id once, at authoring time, so custom functions remain supported.
+        Keyframe(float prog, T val, Easing::EasingId easing = Easing::EasingId::Linear)
+            : progress(prog), value(val), easing_id(static_cast<uint8_t>(easing)) {}
+
+        Keyframe(float prog, T val, EasingFunction easing)
+            : progress(prog), value(val), easing_id(Easing::ToId(easing)) {}
     };
 
 } // namespace SPF_CabinWalk::Animation
\ No newline at end of file
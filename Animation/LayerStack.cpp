@@ -0,0 +1,126 @@
+#include "Animation/LayerStack.hpp"
+#include "Camera/CameraFacade.hpp"
+
+namespace SPF_CabinWalk::LayerStack
+{
+    // =================================================================================================
+    // Internal State
+    // =================================================================================================
+
+    struct LayerState
+    {
+        Animation::CurrentCameraState value = {};
+        uint8_t override_channels = 0;
+        uint8_t offset_channels = 0;
+    };
+
+    static LayerState g_layers[static_cast<size_t>(Layer::Count)];
+
+    // =================================================================================================
+    // Public Functions
+    // =================================================================================================
+
+    void Set(Layer layer, const Animation::CurrentCameraState &value, uint8_t override_channels, uint8_t offset_channels)
+    {
+        LayerState &state = g_layers[static_cast<size_t>(layer)];
+        state.value = value;
+        state.override_channels = override_channels & LAYER_ALL;
+        state.offset_channels = offset_channels & LAYER_ALL & ~override_channels;
+    }
+
+    void Clear(Layer layer)
+    {
+        LayerState &state = g_layers[static_cast<size_t>(layer)];
+        state.override_channels = 0;
+        state.offset_channels = 0;
+    }
+
+    void Reset()
+    {
+        for (LayerState &state : g_layers)
+        {
+            state = {};
+        }
+    }
+
+    bool IsSet(Layer layer)
+    {
+        const LayerState &state = g_layers[static_cast<size_t>(layer)];
+        return (state.override_channels | state.offset_channels) != 0;
+    }
+
+    const Animation::CurrentCameraState &Get(Layer layer)
+    {
+        return g_layers[static_cast<size_t>(layer)].value;
+    }
+
+    Animation::CurrentCameraState Evaluate(uint8_t *owned_channels)
+    {
+        Animation::CurrentCameraState pose = CameraFacade::GetState();
+        uint8_t owned = 0;
+
+        for (const LayerState &layer : g_layers)
+        {
+            const Animation::CurrentCameraState &v = layer.value;
+
+            if (layer.override_channels & LAYER_POSITION)
+            {
+                pose.position = v.position;
+            }
+            if (layer.override_channels & LAYER_YAW)
+            {
+                pose.rotation.x = v.rotation.x;
+            }
+            if (layer.override_channels & LAYER_PITCH)
+            {
+                pose.rotation.y = v.rotation.y;
+            }
+            owned |= layer.override_channels;
+
+            const uint8_t offsets = layer.offset_channels & owned;
+            if (offsets & LAYER_POSITION)
+            {
+                pose.position.x += v.position.x;
+                pose.position.y += v.position.y;
+                pose.position.z += v.position.z;
+            }
+            if (offsets & LAYER_YAW)
+            {
+                pose.rotation.x = Animation::WrapAngle(pose.rotation.x + v.rotation.x);
+            }
+            if (offsets & LAYER_PITCH)
+            {
+                pose.rotation.y += v.rotation.y;
+            }
+        }
+
+        if (owned_channels)
+        {
+            *owned_channels = owned;
+        }
+        return pose;
+    }
+
+    void Compose()
+    {
+        uint8_t owned = 0;
+        const Animation::CurrentCameraState pose = Evaluate(&owned);
+        if (!owned)
+        {
+            return;
+        }
+
+        const Animation::CurrentCameraState camera = CameraFacade::GetState();
+
+        if ((owned & LAYER_POSITION) &&
+            (pose.position.x != camera.position.x || pose.position.y != camera.position.y || pose.position.z != camera.position.z))
+        {
+            CameraFacade::SetSeatPos(pose.position.x, pose.position.y, pose.position.z);
+        }
+        if ((owned & (LAYER_YAW | LAYER_PITCH)) && (pose.rotation.x != camera.rotation.x || pose.rotation.y != camera.rotation.y))
+        {
+            CameraFacade::SetHeadRot(pose.rotation.x, pose.rotation.y);
+        }
+    }
+
+} // namespace SPF_CabinWalk::LayerStack
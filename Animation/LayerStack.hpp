@@ -0,0 +1,77 @@
+#pragma once
+#include <cstdint>
+#include "Animation/AnimationSequence.hpp" // For Animation::CurrentCameraState
+
+// Composes the camera pose from the layers the AnimationScheduler sets, in one pass and one camera write
+// per frame. It holds poses only; the motion that produces them belongs to the scheduler.
+
+namespace SPF_CabinWalk::LayerStack
+{
+    /**
+     * @brief The fixed layers of the camera pose, in the order they are composed, bottom first.
+     */
+    enum class Layer : uint8_t
+    {
+        BaseTransition = 0, // The playing transition between positions.
+        Locomotion,         // Where the walker stands on the cabin floor.
+        StanceOffset,       // Crouch, tiptoe and their sway, and the levelled pitch while a stance changes.
+        HeadBob,            // The rise and fall of each stride.
+        SettingsPreview,    // The pose a settings change eases towards.
+        Count
+    };
+
+    /**
+     * @brief The parts of the pose a layer sets or offsets.
+     */
+    enum LayerChannel : uint8_t
+    {
+        LAYER_POSITION = 1 << 0,
+        LAYER_YAW = 1 << 1,
+        LAYER_PITCH = 1 << 2,
+        LAYER_ALL = LAYER_POSITION | LAYER_YAW | LAYER_PITCH
+    };
+
+    /**
+     * @brief Sets the value of a layer. It is kept, and composed every frame, until it is set again or cleared.
+     * @details Channels in `override_channels` replace what the layers below produced. Channels in
+     *          `offset_channels` are added to it, but only where a layer below overrides them; a channel
+     *          nothing overrides belongs to the player (mouse look) and is never offset, so an offset
+     *          cannot pile up on the camera frame after frame.
+     * @param layer The layer.
+     * @param value The pose or offset. Roll is ignored.
+     * @param override_channels LayerChannel bits replaced by `value`.
+     * @param offset_channels LayerChannel bits offset by `value`.
+     */
+    void Set(Layer layer, const Animation::CurrentCameraState &value, uint8_t override_channels, uint8_t offset_channels = 0);
+
+    /**
+     * @brief Clears a layer, so it no longer takes part in the composition.
+     */
+    void Clear(Layer layer);
+
+    /**
+     * @brief Clears every layer.
+     */
+    void Reset();
+
+    bool IsSet(Layer layer);
+
+    /**
+     * @brief Gets the last value set on a layer.
+     */
+    const Animation::CurrentCameraState &Get(Layer layer);
+
+    /**
+     * @brief Composes every set layer over the camera pose, without writing it.
+     * @param[out] owned_channels Optional; receives the LayerChannel bits some layer overrides.
+     */
+    Animation::CurrentCameraState Evaluate(uint8_t *owned_channels = nullptr);
+
+    /**
+     * @brief Composes the layers and hands the result to the CameraFacade, once for the frame.
+     * @details Only overridden channels are set, and only if they differ from the camera, so a frame in
+     *          which nothing moves writes nothing.
+     */
+    void Compose();
+
+} // namespace SPF_CabinWalk::LayerStack
@@ -0,0 +1,110 @@
+#pragma once
+#include "Animation/BakedTransition.hpp" // For Animation::SequenceFactory
+#include "Animation/FactoryContext.hpp"
+#include "Animation/SequenceBuilder.hpp"
+#include <memory>
+
+namespace SPF_CabinWalk::Animation
+{
+    /**
+     * @brief A transition factory that plays another transition backwards.
+     * @details Builds `Forward` from the target back to the start and reverses it in time (see
+     *          BuildReversedSequence), so the way back retraces the way there over the same duration. The
+     *          forward transition is built as it plays when no move follows it: the shape some factories give
+     *          their end for a follow-up move would otherwise land on the start of the reversal.
+     *
+     *          Registered through its REVERSAL_OF descriptor, its bakes share the keys of the bake of
+     *          `Forward` instead of running this factory (see BakedTransition::BakeReversed); the factory
+     *          itself only runs where that bake is not available.
+     * @tparam Forward The transition registered the other way round.
+     * @tparam Overrides Optional; builds, from the same start and target, the channels that should not just be reversed.
+     * @tparam OverrideChannels ChannelBit mask of the channels taken from `Overrides`.
+     */
+    template <SequenceFactory Forward, SequenceFactory Overrides = nullptr, uint32_t OverrideChannels = 0>
+    std::unique_ptr<AnimationSequence> CreateReversedSequence(const CurrentCameraState& start_state, const CurrentCameraState& target_state)
+    {
+        std::unique_ptr<AnimationSequence> forward;
+        {
+            const FactoryContext context = {&GetFactorySettings(), false};
+            const FactoryContextScope scope(context);
+            forward = Forward(target_state, start_state);
+        }
+        if (!forward)
+        {
+            return nullptr;
+        }
+
+        std::unique_ptr<AnimationSequence> overrides;
+        if constexpr (Overrides != nullptr)
+        {
+            overrides = Overrides(start_state, target_state);
+        }
+        return BuildReversedSequence(*forward, overrides.get(), OverrideChannels);
+    }
+
+    /**
+     * @brief Builds a transition with only some of its channels; the others are left without keys.
+     * @tparam Factory The transition to take the channels from.
+     * @tparam Channels ChannelBit mask of the channels to keep.
+     */
+    template <SequenceFactory Factory, uint32_t Channels>
+    std::unique_ptr<AnimationSequence> CreateChannelSubset(const CurrentCameraState& start_state, const CurrentCameraState& target_state)
+    {
+        const std::unique_ptr<AnimationSequence> full = Factory(start_state, target_state);
+        if (!full)
+        {
+            return nullptr;
+        }
+
+        SequenceBuilder builder;
+        builder.Initialize(full->GetDuration());
+        uint32_t offset = 0;
+        for (size_t channel = 0; channel < CHANNEL_COUNT; ++channel)
+        {
+            const Channel id = static_cast<Channel>(channel);
+            const uint32_t count = full->GetTrack(id).GetKeyframeCount();
+            if (Channels & ChannelBit(id))
+            {
+                for (uint32_t i = offset; i < offset + count; ++i)
+                {
+                    builder.GetTrack(id).AddKeyframe(Keyframe<float>(full->GetKeyframeProgress()[i], full->GetKeyframeValues()[i],
+                                                                     static_cast<Easing::EasingId>(full->GetKeyframeEasingIds()[i])));
+                }
+            }
+            offset += count;
+        }
+        return builder.Build();
+    }
+
+    /**
+     * @brief Describes a transition registered as the reversal of the one the other way round.
+     */
+    struct Reversal
+    {
+        SequenceFactory factory;    // CreateReversedSequence<Forward, Overrides, OverrideChannels>, for when no bake is available.
+        SequenceFactory overrides;  // Builds only the overridden channels; null if there are none.
+        uint32_t override_channels; // ChannelBit mask.
+    };
+
+    template <SequenceFactory Overrides, uint32_t OverrideChannels>
+    constexpr SequenceFactory GetOverrideFactory()
+    {
+        if constexpr (Overrides == nullptr)
+        {
+            return nullptr;
+        }
+        else
+        {
+            return &CreateChannelSubset<Overrides, OverrideChannels>;
+        }
+    }
+
+    /**
+     * @brief The Reversal of `Forward`, with the channels in `OverrideChannels` taken from `Overrides`.
+     * @details Pass it to AnimationController::RegisterReversedSequence().
+     */
+    template <SequenceFactory Forward, SequenceFactory Overrides = nullptr, uint32_t OverrideChannels = 0>
+    inline constexpr Reversal REVERSAL_OF = {&CreateReversedSequence<Forward, Overrides, OverrideChannels>, GetOverrideFactory<Overrides, OverrideChannels>(),
+                                             Overrides == nullptr ? 0u : OverrideChannels};
+
+} // namespace SPF_CabinWalk::Animation
@@ -0,0 +1,198 @@
+#include "Animation/SequenceBuilder.hpp"
+#include "Animation/Easing/Easing.hpp"
+#include "SPF_CabinWalk.hpp" // For g_ctx
+#include "Diagnostics/Profiler.hpp"
+#include <atomic>
+
+namespace SPF_CabinWalk::Animation
+{
+    // Number of sequence objects and keyframe buffers allocated by builders (debug statistic). Atomic, since
+    // the transition rebake builds on a worker thread.
+    static std::atomic<uint64_t> g_allocation_count{0};
+
+    // =================================================================================================
+    // TrackBuilder
+    // =================================================================================================
+
+    void TrackBuilder::AddKeyframe(const Keyframe<float>& keyframe)
+    {
+        if (m_count >= MAX_KEYFRAMES)
+        {
+            m_overflowed = true;
+            return;
+        }
+
+        m_entries[m_count++] = {keyframe.progress, keyframe.value, keyframe.easing_id};
+    }
+
+    void TrackBuilder::Sort()
+    {
+        for (uint32_t i = 1; i < m_count; ++i)
+        {
+            const Entry entry = m_entries[i];
+            uint32_t j = i;
+            while (j > 0 && m_entries[j - 1].progress > entry.progress)
+            {
+                m_entries[j] = m_entries[j - 1];
+                --j;
+            }
+            m_entries[j] = entry;
+        }
+    }
+
+    // =================================================================================================
+    // SequenceBuilder
+    // =================================================================================================
+
+    std::unique_ptr<AnimationSequence> SequenceBuilder::Build()
+    {
+        // Profiled once, by BuildInto().
+        auto sequence = std::make_unique<AnimationSequence>();
+        ++g_allocation_count;
+        BuildInto(*sequence);
+        return sequence;
+    }
+
+    uint64_t SequenceBuilder::GetAllocationCount()
+    {
+        return g_allocation_count;
+    }
+
+    AnimationSequence* SequenceBuilder::BuildInto(AnimationSequence& target)
+    {
+        SPF_CABINWALK_PROFILE_ZONE(SequenceBuild);
+
+        AnimationSequence* sequence = &target;
+        sequence->Initialize(m_duration_ms);
+        sequence->m_is_playing = false;
+        sequence->m_current_elapsed_time_ms = 0;
+        sequence->m_keyframe_count = 0;
+        sequence->m_coefficient_column = nullptr;
+        sequence->ClearEvents();
+        for (auto& track : sequence->m_tracks)
+        {
+            track = Track<float>();
+        }
+        sequence->m_shared_channels = 0;
+
+        // --- Sort once and count ---
+        uint32_t total_keyframes = 0;
+        bool has_splines = false;
+        for (auto& track : m_tracks)
+        {
+            if (track.m_overflowed && g_ctx.loggerHandle)
+            {
+                g_ctx.loadAPI->logger->Log(g_ctx.loggerHandle, SPF_LOG_WARN, "SequenceBuilder: Track exceeded the keyframe limit; extra keyframes were dropped.");
+            }
+            track.Sort();
+            total_keyframes += track.m_count;
+            for (uint32_t i = 0; i < track.m_count; ++i)
+            {
+                has_splines |= track.m_entries[i].easing_id == static_cast<uint8_t>(Easing::EasingId::Spline);
+            }
+        }
+
+        if (total_keyframes == 0)
+        {
+            return sequence;
+        }
+
+        // --- Single allocation: progress[N] | value[N] | coefficients[4N] (splines only) | easing_id[N] ---
+        const size_t progress_bytes = total_keyframes * sizeof(float);
+        const size_t value_bytes = total_keyframes * sizeof(float);
+        const size_t coefficient_bytes = has_splines ? total_keyframes * 4 * sizeof(float) : 0;
+        const size_t easing_bytes = total_keyframes * sizeof(uint8_t);
+        const size_t required_bytes = progress_bytes + value_bytes + coefficient_bytes + easing_bytes;
+        if (sequence->m_keyframe_storage_capacity < required_bytes)
+        {
+            sequence->m_keyframe_storage = std::make_unique<std::byte[]>(required_bytes);
+            sequence->m_keyframe_storage_capacity = required_bytes;
+            ++g_allocation_count;
+        }
+
+        float* progress_column = reinterpret_cast<float*>(sequence->m_keyframe_storage.get());
+        float* value_column = reinterpret_cast<float*>(sequence->m_keyframe_storage.get() + progress_bytes);
+        float* coefficient_column = has_splines ? reinterpret_cast<float*>(sequence->m_keyframe_storage.get() + progress_bytes + value_bytes) : nullptr;
+        uint8_t* easing_column = reinterpret_cast<uint8_t*>(sequence->m_keyframe_storage.get() + progress_bytes + value_bytes + coefficient_bytes);
+        sequence->m_keyframe_count = total_keyframes;
+        sequence->m_progress_column = progress_column;
+        sequence->m_value_column = value_column;
+        sequence->m_coefficient_column = coefficient_column;
+        sequence->m_easing_column = easing_column;
+
+        // --- Pack each channel into its contiguous slice ---
+        uint32_t offset = 0;
+        for (size_t channel = 0; channel < CHANNEL_COUNT; ++channel)
+        {
+            const TrackBuilder& track = m_tracks[channel];
+            for (uint32_t i = 0; i < track.m_count; ++i)
+            {
+                progress_column[offset + i] = track.m_entries[i].progress;
+                value_column[offset + i] = track.m_entries[i].value;
+                easing_column[offset + i] = track.m_entries[i].easing_id;
+            }
+
+            if (track.m_count > 0)
+            {
+                sequence->m_tracks[channel] = Track<float>(progress_column + offset, value_column + offset, easing_column + offset, track.m_count,
+                                                           coefficient_column ? coefficient_column + 4 * offset : nullptr,
+                                                           IsAngularChannel(static_cast<Channel>(channel)));
+            }
+            offset += track.m_count;
+        }
+
+        // --- Splines are solved once here, not per sample ---
+        sequence->UpdateSplineCoefficients();
+
+        return sequence;
+    }
+
+    std::unique_ptr<AnimationSequence> BuildReversedSequence(const AnimationSequence& forward, const AnimationSequence* overrides, uint32_t override_channels)
+    {
+        SequenceBuilder builder;
+        builder.Initialize(forward.GetDuration());
+
+        uint32_t forward_offset = 0;
+        uint32_t override_offset = 0;
+        for (size_t channel = 0; channel < CHANNEL_COUNT; ++channel)
+        {
+            const Channel id = static_cast<Channel>(channel);
+            TrackBuilder& track = builder.GetTrack(id);
+            const uint32_t count = forward.GetTrack(id).GetKeyframeCount();
+
+            if (overrides && (override_channels & ChannelBit(id)))
+            {
+                const uint32_t override_count = overrides->GetTrack(id).GetKeyframeCount();
+                for (uint32_t i = 0; i < override_count; ++i)
+                {
+                    const uint32_t key = override_offset + i;
+                    track.AddKeyframe(Keyframe<float>(overrides->GetKeyframeProgress()[key], overrides->GetKeyframeValues()[key],
+                                                      static_cast<Easing::EasingId>(overrides->GetKeyframeEasingIds()[key])));
+                }
+            }
+            else
+            {
+                // Added back to front, so keys sharing a progress keep their reversed order through the stable sort.
+                for (uint32_t i = 0; i < count; ++i)
+                {
+                    const uint32_t key = forward_offset + ReversedKeyIndex(i, count);
+                    // The segment that ends at reversed key i is the one that ended at forward key count - i.
+                    // Key 0 takes the unused easing of the old first key, so reversing twice is exact.
+                    const uint32_t easing_key = forward_offset + (i == 0 ? 0 : count - i);
+                    const uint8_t easing_id = Easing::ReverseId(forward.GetKeyframeEasingIds()[easing_key]);
+                    track.AddKeyframe(Keyframe<float>(1.0f - forward.GetKeyframeProgress()[key], forward.GetKeyframeValues()[key],
+                                                      static_cast<Easing::EasingId>(easing_id)));
+                }
+            }
+
+            forward_offset += count;
+            if (overrides)
+            {
+                override_offset += overrides->GetTrack(id).GetKeyframeCount();
+            }
+        }
+
+        return builder.Build();
+    }
+
+} // namespace SPF_CabinWalk::Animation
@@ -0,0 +1,136 @@
+#pragma once
+#include "Animation/AnimationSequence.hpp"
+#include "Animation/Keyframe.hpp"
+#include <cstdint>
+#include <memory>
+
+namespace SPF_CabinWalk::Animation
+{
+    /**
+     * @class TrackBuilder
+     * @brief Collects the keyframes of one channel while a sequence is being authored.
+     * @details Keyframes are stored inline (no heap allocation) and may be added in any order;
+     *          they are sorted once when the owning SequenceBuilder packs the sequence.
+     */
+    class TrackBuilder
+    {
+    public:
+        // Maximum number of keyframes a single channel can hold.
+        static constexpr uint32_t MAX_KEYFRAMES = 16;
+
+        /**
+         * @brief Adds a keyframe to the track. Sorting is deferred until the sequence is built.
+         * @param keyframe The Keyframe object to add.
+         */
+        void AddKeyframe(const Keyframe<float>& keyframe);
+
+        /**
+         * @brief Checks if the track contains any keyframes.
+         */
+        bool IsEmpty() const { return m_count == 0; }
+
+    private:
+        friend class SequenceBuilder;
+
+        struct Entry
+        {
+            float progress;
+            float value;
+            uint8_t easing_id;
+        };
+
+        // Stable insertion sort by progress. Keyframe counts are tiny, so this beats std::sort
+        // and, unlike std::stable_sort, never allocates.
+        void Sort();
+
+        Entry m_entries[MAX_KEYFRAMES];
+        uint32_t m_count = 0;
+        bool m_overflowed = false;
+    };
+
+    /**
+     * @class SequenceBuilder
+     * @brief Assembles an AnimationSequence whose keyframes live in one packed allocation.
+     *
+     * Usage mirrors the old per-track API:
+     * @code
+     * Animation::SequenceBuilder builder;
+     * builder.Initialize(duration);
+     * {
+     *     auto& track = builder.GetTrack(Animation::Channel::PositionX);
+     *     track.AddKeyframe({0.0f, start_state.position.x, Easing::EasingId::Linear});
+     * }
+     * return builder.Build();
+     * @endcode
+     */
+    class SequenceBuilder
+    {
+    public:
+        SequenceBuilder() = default;
+
+        /**
+         * @brief Sets the total duration of the sequence being built.
+         * @param duration_ms The duration in the same time unit used by AnimationSequence::Update.
+         */
+        void Initialize(uint64_t duration_ms) { m_duration_ms = duration_ms; }
+
+        /**
+         * @brief Gets the authoring track for a channel.
+         * @param channel The camera property to animate.
+         * @return The TrackBuilder that collects keyframes for that channel.
+         */
+        TrackBuilder& GetTrack(Channel channel) { return m_tracks[static_cast<size_t>(channel)]; }
+
+        /**
+         * @brief Sorts every channel once and packs all keyframes into a single buffer.
+         * @return The finished sequence, ready to be started.
+         */
+        std::unique_ptr<AnimationSequence> Build();
+
+        /**
+         * @brief Packs the keyframes into an existing sequence, reusing its storage when it is large enough.
+         * @details A sequence rebuilt in place this way stops touching the heap once it has grown to fit.
+         * @param target The sequence to overwrite. Its playback state is reset.
+         * @return A pointer to `target`.
+         */
+        AnimationSequence* BuildInto(AnimationSequence& target);
+
+        /**
+         * @brief Gets the number of heap allocations made by all builders since startup.
+         */
+        static uint64_t GetAllocationCount();
+
+    private:
+        TrackBuilder m_tracks[CHANNEL_COUNT];
+        uint64_t m_duration_ms = 0;
+    };
+
+    /**
+     * @brief Gets the bit of a channel in a channel mask.
+     */
+    constexpr uint32_t ChannelBit(Channel channel)
+    {
+        return 1u << static_cast<uint32_t>(channel);
+    }
+
+    /**
+     * @brief Gets where key `index` of a channel lands in the time reversal of its track.
+     */
+    constexpr uint32_t ReversedKeyIndex(uint32_t index, uint32_t count)
+    {
+        return count - 1 - index;
+    }
+
+    /**
+     * @brief Builds the time reversal of a sequence: the same motion played backwards, over the same duration.
+     * @details Key N of a channel's `count` keys becomes key `count - 1 - N`, at progress `1 - p`. The easing of
+     *          every segment is reversed with it (see Easing::ReverseId) and moves to the key that now ends the
+     *          segment, so the reversed curve retraces the forward one exactly.
+     * @param forward The sequence to reverse.
+     * @param overrides Optional; the channels in `override_channels` are copied from it instead of reversed.
+     * @param override_channels ChannelBit mask.
+     */
+    std::unique_ptr<AnimationSequence> BuildReversedSequence(const AnimationSequence& forward, const AnimationSequence* overrides = nullptr,
+                                                             uint32_t override_channels = 0);
+
+} // namespace SPF_CabinWalk::Animation
@@ -1,6 +1,7 @@
 #include "PassengerToStanding.hpp"
 #include "SPF_CabinWalk.hpp"
-#include "Animation/AnimationController.hpp"
+#include "Animation/SequenceBuilder.hpp"
+#include "Animation/FactoryContext.hpp"
 
 namespace SPF_CabinWalk::AnimationSequences
 {
@@ -9,72 +10,67 @@ namespace SPF_CabinWalk::AnimationSequences
         const Animation::CurrentCameraState& target_state
     )
     {
-        auto seq = std::make_unique<Animation::AnimationSequence>();
-        seq->Initialize(g_ctx.settings.animation_durations.main_animation_speed.passenger_to_standing * 1000);
+        Animation::SequenceBuilder builder;
+        builder.Initialize(Animation::GetFactorySettings().animation_durations.main_animation_speed.passenger_to_standing * 1000);
 
         // --- Position X Track ---
         {
-            auto track = std::make_unique<Animation::Track<float>>();
-            track->AddKeyframe({0.0f, start_state.position.x, Easing::easeOutCubic});
-            track->AddKeyframe({0.35f, start_state.position.x, Easing::easeInCubic});
-            track->AddKeyframe({0.5f, start_state.position.x - 0.35f, Easing::easeOutCubic});
-            track->AddKeyframe({0.65f, target_state.position.x - 0.05f, Easing::easeInOutCubic});
-            track->AddKeyframe({1.0f, target_state.position.x, Easing::easeOutCubic});
-            seq->AddPositionXTrack(std::move(track));
+            auto& track = builder.GetTrack(Animation::Channel::PositionX);
+            track.AddKeyframe({0.0f, start_state.position.x, Easing::EasingId::OutCubic});
+            track.AddKeyframe({0.35f, start_state.position.x, Easing::EasingId::InCubic});
+            track.AddKeyframe({0.5f, start_state.position.x - 0.35f, Easing::EasingId::OutCubic});
+            track.AddKeyframe({0.65f, target_state.position.x - 0.05f, Easing::EasingId::InOutCubic});
+            track.AddKeyframe({1.0f, target_state.position.x, Easing::EasingId::OutCubic});
         }
 
         // --- Position Y Track ---
         {
-            auto track = std::make_unique<Animation::Track<float>>();
-            track->AddKeyframe({0.0f, start_state.position.y, Easing::easeInCubic});
-            track->AddKeyframe({0.30f, target_state.position.y, Easing::easeOutCubic});
-            track->AddKeyframe({0.45f, target_state.position.y + 0.01f, Easing::easeOutCubic});
-            track->AddKeyframe({0.5f, target_state.position.y, Easing::easeOutCubic});
-            track->AddKeyframe({0.75f, target_state.position.y + 0.01f, Easing::easeInOutCubic});
-            track->AddKeyframe({1.0f, target_state.position.y, Easing::easeInCubic});
-            seq->AddPositionYTrack(std::move(track));
+            auto& track = builder.GetTrack(Animation::Channel::PositionY);
+            track.AddKeyframe({0.0f, start_state.position.y, Easing::EasingId::InCubic});
+            track.AddKeyframe({0.30f, target_state.position.y, Easing::EasingId::OutCubic});
+            track.AddKeyframe({0.45f, target_state.position.y + 0.01f, Easing::EasingId::OutCubic});
+            track.AddKeyframe({0.5f, target_state.position.y, Easing::EasingId::OutCubic});
+            track.AddKeyframe({0.75f, target_state.position.y + 0.01f, Easing::EasingId::InOutCubic});
+            track.AddKeyframe({1.0f, target_state.position.y, Easing::EasingId::InCubic});
         }
 
         // --- Position Z Track ---
         {
-            auto track = std::make_unique<Animation::Track<float>>();
-            track->AddKeyframe({0.0f, start_state.position.z, Easing::easeInOutCubic});
-            track->AddKeyframe({0.15f, start_state.position.z - 0.15f, Easing::easeOutCubic});
-            track->AddKeyframe({0.65f, start_state.position.z - 0.05f, Easing::easeInOutCubic});
-            track->AddKeyframe({1.0f, target_state.position.z, Easing::easeOutCubic});
-            seq->AddPositionZTrack(std::move(track));
+            auto& track = builder.GetTrack(Animation::Channel::PositionZ);
+            track.AddKeyframe({0.0f, start_state.position.z, Easing::EasingId::InOutCubic});
+            track.AddKeyframe({0.15f, start_state.position.z - 0.15f, Easing::EasingId::OutCubic});
+            track.AddKeyframe({0.65f, start_state.position.z - 0.05f, Easing::EasingId::InOutCubic});
+            track.AddKeyframe({1.0f, target_state.position.z, Easing::EasingId::OutCubic});
         }
 
         // --- Rotation Yaw Track ---
         {
-            auto track = std::make_unique<Animation::Track<float>>();
-            const float direction_multiplier = (g_ctx.settings.general.cabin_layout == LHD) ? 1.0f : -1.0f;
-            track->AddKeyframe({0.0f, start_state.rotation.x, Easing::easeOutCubic});
-            track->AddKeyframe({0.1f, 0.0f, Easing::easeInOutCubic});
-            track->AddKeyframe({0.23f, 0.1f * direction_multiplier, Easing::easeInOutCubic});
-            track->AddKeyframe({0.73f, target_state.rotation.x + (0.75f * direction_multiplier), Easing::easeOutQuad});
+            auto& track = builder.GetTrack(Animation::Channel::RotationYaw);
+            const float direction_multiplier = (Animation::GetFactorySettings().general.cabin_layout == LHD) ? 1.0f : -1.0f;
+            track.AddKeyframe({0.0f, start_state.rotation.x, Easing::EasingId::OutCubic});
+            track.AddKeyframe({0.1f, 0.0f, Easing::EasingId::InOutCubic});
+            track.AddKeyframe({0.23f, 0.1f * direction_multiplier, Easing::EasingId::InOutCubic});
+            track.AddKeyframe({0.73f, target_state.rotation.x + (0.75f * direction_multiplier), Easing::EasingId::OutQuad});
 
             // If there's no pending move, complete the animation by returning to the target rotation.
             // Otherwise, the animation will end here, and the next sequence will pick up from this state.
-            if (!AnimationController::HasPendingMoves())
+            if (!Animation::FactoryHasPendingMoves())
             {
-                track->AddKeyframe({1.0f, target_state.rotation.x, Easing::easeOutQuad});
+                track.AddKeyframe({1.0f, target_state.rotation.x, Easing::EasingId::OutQuad});
             }
-            seq->AddRotationYawTrack(std::move(track));
         }
 
         // --- Rotation Pitch Track ---
         {
-            auto track = std::make_unique<Animation::Track<float>>();
-            track->AddKeyframe({0.0f, start_state.rotation.y, Easing::easeOutCubic});
-            track->AddKeyframe({0.1f, 0.0f, Easing::easeInOutCubic});
-            track->AddKeyframe({0.35f, -0.25f, Easing::easeInOutCubic});
-            track->AddKeyframe({0.75f, 0.05f, Easing::easeInCubic});
-            track->AddKeyframe({1.0f, target_state.rotation.y, Easing::easeOutCubic});
-            seq->AddRotationPitchTrack(std::move(track));
+            auto& track = builder.GetTrack(Animation::Channel::RotationPitch);
+            track.AddKeyframe({0.0f, start_state.rotation.y, Easing::EasingId::OutCubic});
+            track.AddKeyframe({0.1f, 0.0f, Easing::EasingId::InOutCubic});
+            track.AddKeyframe({0.35f, -0.25f, Easing::EasingId::InOutCubic});
+            track.AddKeyframe({0.75f, 0.05f, Easing::EasingId::InCubic});
+            track.AddKeyframe({1.0f, target_state.rotation.y, Easing::EasingId::OutCubic});
         }
 
-        return seq;
+        return builder.Build();
     }
 
 } // namespace SPF_CabinWalk::AnimationSequences
@@ -1,5 +1,7 @@
 #include "SofaStances.hpp"
 #include "SPF_CabinWalk.hpp"
+#include "Animation/SequenceBuilder.hpp"
+#include "Animation/FactoryContext.hpp"
 #include "Animation/Track.hpp"
 #include "Animation/Easing/Easing.hpp"
 
@@ -10,56 +12,51 @@ namespace SPF_CabinWalk::AnimationSequences
         const Animation::CurrentCameraState& target_state
     )
     {
-        auto seq = std::make_unique<Animation::AnimationSequence>();
-        seq->Initialize(g_ctx.settings.animation_durations.sofa_animation_speed.sofa_sit1_to_lie * 1000);
+        Animation::SequenceBuilder builder;
+        builder.Initialize(Animation::GetFactorySettings().animation_durations.sofa_animation_speed.sofa_sit1_to_lie * 1000);
 
         // --- Position X (Sliding along the sofa) ---
         {
-            auto track = std::make_unique<Animation::Track<float>>();
-            track->AddKeyframe({0.0f, start_state.position.x, Easing::easeOutCubic});
-            track->AddKeyframe({0.75f, start_state.position.x, Easing::easeOutCubic});
-            track->AddKeyframe({1.0f, target_state.position.x, Easing::easeInOutCubic});
-            seq->AddPositionXTrack(std::move(track));
+            auto& track = builder.GetTrack(Animation::Channel::PositionX);
+            track.AddKeyframe({0.0f, start_state.position.x, Easing::EasingId::OutCubic});
+            track.AddKeyframe({0.75f, start_state.position.x, Easing::EasingId::OutCubic});
+            track.AddKeyframe({1.0f, target_state.position.x, Easing::EasingId::InOutCubic});
         }
 
         // --- Position Y (Lowering into lying position) ---
         {
-            auto track = std::make_unique<Animation::Track<float>>();
-            //track->AddKeyframe({0.0f, start_state.position.y, Easing::easeInCubic});
-            track->AddKeyframe({0.65f, start_state.position.y, Easing::easeOutCubic}); // Dip slightly lower
-            track->AddKeyframe({1.0f, target_state.position.y, Easing::easeInCubic});
-            seq->AddPositionYTrack(std::move(track));
+            auto& track = builder.GetTrack(Animation::Channel::PositionY);
+            //track.AddKeyframe({0.0f, start_state.position.y, Easing::EasingId::InCubic});
+            track.AddKeyframe({0.65f, start_state.position.y, Easing::EasingId::OutCubic}); // Dip slightly lower
+            track.AddKeyframe({1.0f, target_state.position.y, Easing::EasingId::InCubic});
         }
 
         // --- Position Z (Stays constant) ---
         {
-            auto track = std::make_unique<Animation::Track<float>>();
-            track->AddKeyframe({0.0f, start_state.position.z, Easing::easeInCubic});
-            track->AddKeyframe({0.5f, target_state.position.z, Easing::easeInOutCubic});
-            seq->AddPositionZTrack(std::move(track));
+            auto& track = builder.GetTrack(Animation::Channel::PositionZ);
+            track.AddKeyframe({0.0f, start_state.position.z, Easing::EasingId::InCubic});
+            track.AddKeyframe({0.5f, target_state.position.z, Easing::EasingId::InOutCubic});
         }
 
         // --- Rotation Yaw (Look slightly left/right) ---
         {
-            auto track = std::make_unique<Animation::Track<float>>();
-            track->AddKeyframe({0.0f, start_state.rotation.x, Easing::easeOutCubic});
-            track->AddKeyframe({0.55f, target_state.rotation.x, Easing::easeInOutCubic}); // Small look aside
-            track->AddKeyframe({0.85f, target_state.rotation.x + 0.25f, Easing::easeInOutCubic});
-            track->AddKeyframe({1.0f, target_state.rotation.x, Easing::easeInCubic});
-            seq->AddRotationYawTrack(std::move(track));
+            auto& track = builder.GetTrack(Animation::Channel::RotationYaw);
+            track.AddKeyframe({0.0f, start_state.rotation.x, Easing::EasingId::OutCubic});
+            track.AddKeyframe({0.55f, target_state.rotation.x, Easing::EasingId::InOutCubic}); // Small look aside
+            track.AddKeyframe({0.85f, target_state.rotation.x + 0.25f, Easing::EasingId::InOutCubic});
+            track.AddKeyframe({1.0f, target_state.rotation.x, Easing::EasingId::InCubic});
         }
 
         // --- Rotation Pitch (The 'lying down' head movement) ---
         {
-            auto track = std::make_unique<Animation::Track<float>>();
-            track->AddKeyframe({0.0f, start_state.rotation.y, Easing::easeOutCubic});
-            track->AddKeyframe({0.35f, start_state.rotation.y +0.25f, Easing::easeInCubic});
-            track->AddKeyframe({0.65f, -0.05f, Easing::easeOutCubic});
-            track->AddKeyframe({1.0f, target_state.rotation.y, Easing::easeOutCubic});
-            seq->AddRotationPitchTrack(std::move(track));
+            auto& track = builder.GetTrack(Animation::Channel::RotationPitch);
+            track.AddKeyframe({0.0f, start_state.rotation.y, Easing::EasingId::OutCubic});
+            track.AddKeyframe({0.35f, start_state.rotation.y +0.25f, Easing::EasingId::InCubic});
+            track.AddKeyframe({0.65f, -0.05f, Easing::EasingId::OutCubic});
+            track.AddKeyframe({1.0f, target_state.rotation.y, Easing::EasingId::OutCubic});
         }
 
-        return seq;
+        return builder.Build();
     }
 
     std::unique_ptr<Animation::AnimationSequence> CreateSofaLieToSit2Sequence(
@@ -67,53 +64,48 @@ namespace SPF_CabinWalk::AnimationSequences
         const Animation::CurrentCameraState& target_state
     )
     {
-        auto seq = std::make_unique<Animation::AnimationSequence>();
-        seq->Initialize(g_ctx.settings.animation_durations.sofa_animation_speed.sofa_lie_to_sit2 * 1000);
+        Animation::SequenceBuilder builder;
+        builder.Initialize(Animation::GetFactorySettings().animation_durations.sofa_animation_speed.sofa_lie_to_sit2 * 1000);
 
         // --- Position X (Sliding to the new spot) ---
         {
-            auto track = std::make_unique<Animation::Track<float>>();
-            track->AddKeyframe({0.5f, start_state.position.x, Easing::easeOutCubic});
-            track->AddKeyframe({1.0f, target_state.position.x, Easing::easeInOutCubic});
-            seq->AddPositionXTrack(std::move(track));
+            auto& track = builder.GetTrack(Animation::Channel::PositionX);
+            track.AddKeyframe({0.5f, start_state.position.x, Easing::EasingId::OutCubic});
+            track.AddKeyframe({1.0f, target_state.position.x, Easing::EasingId::InOutCubic});
         }
 
         // --- Position Y (Rising to sitting height) ---
         {
-            auto track = std::make_unique<Animation::Track<float>>();
-            track->AddKeyframe({0.0f, start_state.position.y, Easing::easeInCubic});
-            track->AddKeyframe({0.5f, target_state.position.y, Easing::easeOutQuad}); // Slight delay before rising
-            track->AddKeyframe({1.0f, target_state.position.y, Easing::easeOutCubic});
-            seq->AddPositionYTrack(std::move(track));
+            auto& track = builder.GetTrack(Animation::Channel::PositionY);
+            track.AddKeyframe({0.0f, start_state.position.y, Easing::EasingId::InCubic});
+            track.AddKeyframe({0.5f, target_state.position.y, Easing::EasingId::OutQuad}); // Slight delay before rising
+            track.AddKeyframe({1.0f, target_state.position.y, Easing::EasingId::OutCubic});
         }
 
         // --- Position Z (Stays constant) ---
         {
-            auto track = std::make_unique<Animation::Track<float>>();
-            track->AddKeyframe({0.5f, start_state.position.z, Easing::linear});
-            track->AddKeyframe({1.0f, target_state.position.z, Easing::linear});
-            seq->AddPositionZTrack(std::move(track));
+            auto& track = builder.GetTrack(Animation::Channel::PositionZ);
+            track.AddKeyframe({0.5f, start_state.position.z, Easing::EasingId::Linear});
+            track.AddKeyframe({1.0f, target_state.position.z, Easing::EasingId::Linear});
         }
 
         // --- Rotation Pitch (The 'sitting up' head movement) ---
         {
-            auto track = std::make_unique<Animation::Track<float>>();
-            track->AddKeyframe({0.0f, start_state.rotation.y, Easing::easeInCubic});
-            track->AddKeyframe({0.3f, -0.4f, Easing::easeOutCubic}); // Coming from a 'lying' pitch
-            track->AddKeyframe({0.9f, 0.1f, Easing::easeInQuad}); // Overshoot slightly forward
-            track->AddKeyframe({1.0f, target_state.rotation.y, Easing::easeOutCubic});
-            seq->AddRotationPitchTrack(std::move(track));
+            auto& track = builder.GetTrack(Animation::Channel::RotationPitch);
+            track.AddKeyframe({0.0f, start_state.rotation.y, Easing::EasingId::InCubic});
+            track.AddKeyframe({0.3f, -0.4f, Easing::EasingId::OutCubic}); // Coming from a 'lying' pitch
+            track.AddKeyframe({0.9f, 0.1f, Easing::EasingId::InQuad}); // Overshoot slightly forward
+            track.AddKeyframe({1.0f, target_state.rotation.y, Easing::EasingId::OutCubic});
         }
 
         // --- Rotation Yaw (Look ahead) ---
         {
-            auto track = std::make_unique<Animation::Track<float>>();
-            track->AddKeyframe({0.0f, start_state.rotation.x, Easing::easeOutCubic});
-            track->AddKeyframe({1.0f, target_state.rotation.x, Easing::easeInCubic});
-            seq->AddRotationYawTrack(std::move(track));
+            auto& track = builder.GetTrack(Animation::Channel::RotationYaw);
+            track.AddKeyframe({0.0f, start_state.rotation.x, Easing::EasingId::OutCubic});
+            track.AddKeyframe({1.0f, target_state.rotation.x, Easing::EasingId::InCubic});
         }
 
-        return seq;
+        return builder.Build();
     }
 
     std::unique_ptr<Animation::AnimationSequence> CreateSofaSit2ToSit1Sequence(
@@ -121,52 +113,47 @@ namespace SPF_CabinWalk::AnimationSequences
         const Animation::CurrentCameraState& target_state
     )
     {
-        auto seq = std::make_unique<Animation::AnimationSequence>();
-        seq->Initialize(g_ctx.settings.animation_durations.sofa_animation_speed.sofa_sit2_to_sit1 * 1000);
+        Animation::SequenceBuilder builder;
+        builder.Initialize(Animation::GetFactorySettings().animation_durations.sofa_animation_speed.sofa_sit2_to_sit1 * 1000);
 
         // --- Position X (Sliding back to the first spot) ---
         {
-            auto track = std::make_unique<Animation::Track<float>>();
-            track->AddKeyframe({0.0f, start_state.position.x, Easing::easeOutCubic});
-            track->AddKeyframe({1.0f, target_state.position.x, Easing::easeInOutCubic});
-            seq->AddPositionXTrack(std::move(track));
+            auto& track = builder.GetTrack(Animation::Channel::PositionX);
+            track.AddKeyframe({0.0f, start_state.position.x, Easing::EasingId::OutCubic});
+            track.AddKeyframe({1.0f, target_state.position.x, Easing::EasingId::InOutCubic});
         }
 
         // --- Position Y (Slight push-up to move) ---
         {
-            auto track = std::make_unique<Animation::Track<float>>();
-            track->AddKeyframe({0.0f, start_state.position.y, Easing::easeInQuad});
-            track->AddKeyframe({0.5f, start_state.position.y + 0.05f, Easing::easeOutQuad}); // Push up
-            track->AddKeyframe({1.0f, target_state.position.y, Easing::easeInCubic}); // Settle down
-            seq->AddPositionYTrack(std::move(track));
+            auto& track = builder.GetTrack(Animation::Channel::PositionY);
+            track.AddKeyframe({0.0f, start_state.position.y, Easing::EasingId::InQuad});
+            track.AddKeyframe({0.5f, start_state.position.y + 0.05f, Easing::EasingId::OutQuad}); // Push up
+            track.AddKeyframe({1.0f, target_state.position.y, Easing::EasingId::InCubic}); // Settle down
         }
 
         // --- Position Z (Stays constant) ---
         {
-            auto track = std::make_unique<Animation::Track<float>>();
-            track->AddKeyframe({0.0f, start_state.position.z, Easing::linear});
-            track->AddKeyframe({1.0f, target_state.position.z, Easing::linear});
-            seq->AddPositionZTrack(std::move(track));
+            auto& track = builder.GetTrack(Animation::Channel::PositionZ);
+            track.AddKeyframe({0.0f, start_state.position.z, Easing::EasingId::Linear});
+            track.AddKeyframe({1.0f, target_state.position.z, Easing::EasingId::Linear});
         }
 
         // --- Rotation Yaw (Slight head turn during slide) ---
         {
-            auto track = std::make_unique<Animation::Track<float>>();
-            track->AddKeyframe({0.0f, start_state.rotation.x, Easing::easeOutCubic});
-            track->AddKeyframe({0.4f, start_state.rotation.x - 0.15f, Easing::easeOutQuad}); // Look towards destination
-            track->AddKeyframe({1.0f, target_state.rotation.x, Easing::easeInQuad});
-            seq->AddRotationYawTrack(std::move(track));
+            auto& track = builder.GetTrack(Animation::Channel::RotationYaw);
+            track.AddKeyframe({0.0f, start_state.rotation.x, Easing::EasingId::OutCubic});
+            track.AddKeyframe({0.4f, start_state.rotation.x - 0.15f, Easing::EasingId::OutQuad}); // Look towards destination
+            track.AddKeyframe({1.0f, target_state.rotation.x, Easing::EasingId::InQuad});
         }
 
         // --- Rotation Pitch (Keep it steady) ---
         {
-            auto track = std::make_unique<Animation::Track<float>>();
-            track->AddKeyframe({0.0f, start_state.rotation.y, Easing::easeOutCubic});
-            track->AddKeyframe({1.0f, target_state.rotation.y, Easing::easeInCubic});
-            seq->AddRotationPitchTrack(std::move(track));
+            auto& track = builder.GetTrack(Animation::Channel::RotationPitch);
+            track.AddKeyframe({0.0f, start_state.rotation.y, Easing::EasingId::OutCubic});
+            track.AddKeyframe({1.0f, target_state.rotation.y, Easing::EasingId::InCubic});
         }
 
-        return seq;
+        return builder.Build();
     }
     
     std::unique_ptr<Animation::AnimationSequence> CreateSofaLieToSofa1Sequence(
@@ -174,56 +161,51 @@ namespace SPF_CabinWalk::AnimationSequences
         const Animation::CurrentCameraState& target_state
     )
     {
-        auto seq = std::make_unique<Animation::AnimationSequence>();
-        seq->Initialize(g_ctx.settings.animation_durations.sofa_animation_speed.sofa_lie_to_sit1_shortcut * 1000);
+        Animation::SequenceBuilder builder;
+        builder.Initialize(Animation::GetFactorySettings().animation_durations.sofa_animation_speed.sofa_lie_to_sit1_shortcut * 1000);
         // --- Position X (Slide from lie spot to sit spot) ---
         {
-            auto track = std::make_unique<Animation::Track<float>>();
-            track->AddKeyframe({0.0f, start_state.position.x, Easing::linear});
-            track->AddKeyframe({0.15f, start_state.position.x, Easing::easeInCubic}); // Hold position while sitting up
-            track->AddKeyframe({0.75f, target_state.position.x, Easing::easeInCubic}); // Hold position while sitting up
-            track->AddKeyframe({1.0f, target_state.position.x, Easing::easeInOutCubic}); // Slide in the last part
-            seq->AddPositionXTrack(std::move(track));
+            auto& track = builder.GetTrack(Animation::Channel::PositionX);
+            track.AddKeyframe({0.0f, start_state.position.x, Easing::EasingId::Linear});
+            track.AddKeyframe({0.15f, start_state.position.x, Easing::EasingId::InCubic}); // Hold position while sitting up
+            track.AddKeyframe({0.75f, target_state.position.x, Easing::EasingId::InCubic}); // Hold position while sitting up
+            track.AddKeyframe({1.0f, target_state.position.x, Easing::EasingId::InOutCubic}); // Slide in the last part
         }
 
         // --- Position Y (Rising to sitting height) ---
         {
-            auto track = std::make_unique<Animation::Track<float>>();
-            track->AddKeyframe({0.0f, start_state.position.y, Easing::easeInCubic});
-            track->AddKeyframe({0.6f, target_state.position.y, Easing::easeOutCubic}); // Rise up first
-            track->AddKeyframe({1.0f, target_state.position.y, Easing::linear}); // Hold height while sliding
-            seq->AddPositionYTrack(std::move(track));
+            auto& track = builder.GetTrack(Animation::Channel::PositionY);
+            track.AddKeyframe({0.0f, start_state.position.y, Easing::EasingId::InCubic});
+            track.AddKeyframe({0.6f, target_state.position.y, Easing::EasingId::OutCubic}); // Rise up first
+            track.AddKeyframe({1.0f, target_state.position.y, Easing::EasingId::Linear}); // Hold height while sliding
         }
 
         // --- Position Z (Move along with X) ---
         {
-            auto track = std::make_unique<Animation::Track<float>>();
-            track->AddKeyframe({0.0f, start_state.position.z, Easing::linear});
-            track->AddKeyframe({0.85f, start_state.position.z, Easing::easeInCubic}); // Hold Z while sitting up
-            track->AddKeyframe({1.0f, target_state.position.z, Easing::easeInOutCubic}); // Move Z during the slide
-            seq->AddPositionZTrack(std::move(track));
+            auto& track = builder.GetTrack(Animation::Channel::PositionZ);
+            track.AddKeyframe({0.0f, start_state.position.z, Easing::EasingId::Linear});
+            track.AddKeyframe({0.85f, start_state.position.z, Easing::EasingId::InCubic}); // Hold Z while sitting up
+            track.AddKeyframe({1.0f, target_state.position.z, Easing::EasingId::InOutCubic}); // Move Z during the slide
         }
 
         // --- Rotation Pitch (The 'sitting up' head movement) ---
         {
-            auto track = std::make_unique<Animation::Track<float>>();
-            track->AddKeyframe({0.0f, start_state.rotation.y, Easing::easeInCubic}); // Start from lying pitch
-            track->AddKeyframe({0.5f, -0.4f, Easing::easeOutCubic});
-            track->AddKeyframe({0.9f, 0.1f, Easing::easeInQuad}); // Overshoot slightly
-            track->AddKeyframe({1.0f, target_state.rotation.y, Easing::easeOutCubic}); // Settle to final sitting pitch
-            seq->AddRotationPitchTrack(std::move(track));
+            auto& track = builder.GetTrack(Animation::Channel::RotationPitch);
+            track.AddKeyframe({0.0f, start_state.rotation.y, Easing::EasingId::InCubic}); // Start from lying pitch
+            track.AddKeyframe({0.5f, -0.4f, Easing::EasingId::OutCubic});
+            track.AddKeyframe({0.9f, 0.1f, Easing::EasingId::InQuad}); // Overshoot slightly
+            track.AddKeyframe({1.0f, target_state.rotation.y, Easing::EasingId::OutCubic}); // Settle to final sitting pitch
         }
 
         // --- Rotation Yaw (Look ahead) ---
         {
-            auto track = std::make_unique<Animation::Track<float>>();
-            track->AddKeyframe({0.0f, start_state.rotation.x, Easing::easeOutCubic});
-            track->AddKeyframe({0.6f, target_state.rotation.x - 1.0f, Easing::easeInCubic}); // Turn head while sitting up
-            track->AddKeyframe({1.0f, target_state.rotation.x, Easing::linear});
-            seq->AddRotationYawTrack(std::move(track));
+            auto& track = builder.GetTrack(Animation::Channel::RotationYaw);
+            track.AddKeyframe({0.0f, start_state.rotation.x, Easing::EasingId::OutCubic});
+            track.AddKeyframe({0.6f, target_state.rotation.x - 1.0f, Easing::EasingId::InCubic}); // Turn head while sitting up
+            track.AddKeyframe({1.0f, target_state.rotation.x, Easing::EasingId::Linear});
         }
 
-        return seq;
+        return builder.Build();
     }
 
     std::unique_ptr<Animation::AnimationSequence> CreateSofaSit1ToSit2Sequence(
@@ -231,54 +213,49 @@ namespace SPF_CabinWalk::AnimationSequences
         const Animation::CurrentCameraState& target_state
     )
     {
-        auto seq = std::make_unique<Animation::AnimationSequence>();
+        Animation::SequenceBuilder builder;
         // Using the same duration as the reverse animation for now. 
         // A dedicated setting could be added later if needed (e.g. sofa_sit1_to_sit2).
-        seq->Initialize(g_ctx.settings.animation_durations.sofa_animation_speed.sofa_sit2_to_sit1 * 1000);
+        builder.Initialize(Animation::GetFactorySettings().animation_durations.sofa_animation_speed.sofa_sit2_to_sit1 * 1000);
 
         // --- Position X (Sliding to the second spot) ---
         {
-            auto track = std::make_unique<Animation::Track<float>>();
-            track->AddKeyframe({0.0f, start_state.position.x, Easing::easeOutCubic});
-            track->AddKeyframe({1.0f, target_state.position.x, Easing::easeInOutCubic});
-            seq->AddPositionXTrack(std::move(track));
+            auto& track = builder.GetTrack(Animation::Channel::PositionX);
+            track.AddKeyframe({0.0f, start_state.position.x, Easing::EasingId::OutCubic});
+            track.AddKeyframe({1.0f, target_state.position.x, Easing::EasingId::InOutCubic});
         }
 
         // --- Position Y (Slight push-up to move) ---
         {
-            auto track = std::make_unique<Animation::Track<float>>();
-            track->AddKeyframe({0.0f, start_state.position.y, Easing::easeInQuad});
-            track->AddKeyframe({0.5f, start_state.position.y + 0.05f, Easing::easeOutQuad}); // Push up
-            track->AddKeyframe({1.0f, target_state.position.y, Easing::easeInCubic}); // Settle down
-            seq->AddPositionYTrack(std::move(track));
+            auto& track = builder.GetTrack(Animation::Channel::PositionY);
+            track.AddKeyframe({0.0f, start_state.position.y, Easing::EasingId::InQuad});
+            track.AddKeyframe({0.5f, start_state.position.y + 0.05f, Easing::EasingId::OutQuad}); // Push up
+            track.AddKeyframe({1.0f, target_state.position.y, Easing::EasingId::InCubic}); // Settle down
         }
 
         // --- Position Z (Stays constant) ---
         {
-            auto track = std::make_unique<Animation::Track<float>>();
-            track->AddKeyframe({0.0f, start_state.position.z, Easing::linear});
-            track->AddKeyframe({1.0f, target_state.position.z, Easing::linear});
-            seq->AddPositionZTrack(std::move(track));
+            auto& track = builder.GetTrack(Animation::Channel::PositionZ);
+            track.AddKeyframe({0.0f, start_state.position.z, Easing::EasingId::Linear});
+            track.AddKeyframe({1.0f, target_state.position.z, Easing::EasingId::Linear});
         }
 
         // --- Rotation Yaw (Slight head turn during slide) ---
         {
-            auto track = std::make_unique<Animation::Track<float>>();
-            track->AddKeyframe({0.0f, start_state.rotation.x, Easing::easeOutCubic});
-            track->AddKeyframe({0.4f, start_state.rotation.x + 0.15f, Easing::easeOutQuad}); // Look towards destination
-            track->AddKeyframe({1.0f, target_state.rotation.x, Easing::easeInQuad});
-            seq->AddRotationYawTrack(std::move(track));
+            auto& track = builder.GetTrack(Animation::Channel::RotationYaw);
+            track.AddKeyframe({0.0f, start_state.rotation.x, Easing::EasingId::OutCubic});
+            track.AddKeyframe({0.4f, start_state.rotation.x + 0.15f, Easing::EasingId::OutQuad}); // Look towards destination
+            track.AddKeyframe({1.0f, target_state.rotation.x, Easing::EasingId::InQuad});
         }
 
         // --- Rotation Pitch (Keep it steady) ---
         {
-            auto track = std::make_unique<Animation::Track<float>>();
-            track->AddKeyframe({0.0f, start_state.rotation.y, Easing::easeOutCubic});
-            track->AddKeyframe({1.0f, target_state.rotation.y, Easing::easeInCubic});
-            seq->AddRotationPitchTrack(std::move(track));
+            auto& track = builder.GetTrack(Animation::Channel::RotationPitch);
+            track.AddKeyframe({0.0f, start_state.rotation.y, Easing::EasingId::OutCubic});
+            track.AddKeyframe({1.0f, target_state.rotation.y, Easing::EasingId::InCubic});
         }
 
-        return seq;
+        return builder.Build();
     }
 
 } // namespace SPF_CabinWalk::AnimationSequences
\ No newline at end of file
@@ -1,5 +1,7 @@
 #include "SofaToStanding.hpp"
 #include "SPF_CabinWalk.hpp"
+#include "Animation/SequenceBuilder.hpp"
+#include "Animation/FactoryContext.hpp"
 #include "Animation/Track.hpp"
 #include "Animation/Easing/Easing.hpp"
 
@@ -10,59 +12,54 @@ namespace SPF_CabinWalk::AnimationSequences
         const Animation::CurrentCameraState& target_state
     )
     {
-        auto seq = std::make_unique<Animation::AnimationSequence>();
-        seq->Initialize(g_ctx.settings.animation_durations.main_animation_speed.sofa_to_standing * 1000);
+        Animation::SequenceBuilder builder;
+        builder.Initialize(Animation::GetFactorySettings().animation_durations.main_animation_speed.sofa_to_standing * 1000);
 
         // --- Position X Track ---
         {
-            auto track = std::make_unique<Animation::Track<float>>();
-            track->AddKeyframe({0.0f, start_state.position.x, Easing::linear});
-            track->AddKeyframe({0.5f, start_state.position.x, Easing::easeOutCubic});
-            track->AddKeyframe({1.0f, target_state.position.x, Easing::easeInQuad});
-            seq->AddPositionXTrack(std::move(track));
+            auto& track = builder.GetTrack(Animation::Channel::PositionX);
+            track.AddKeyframe({0.0f, start_state.position.x, Easing::EasingId::Linear});
+            track.AddKeyframe({0.5f, start_state.position.x, Easing::EasingId::OutCubic});
+            track.AddKeyframe({1.0f, target_state.position.x, Easing::EasingId::InQuad});
         }
 
         // --- Position Y Track (Stand Up) ---
         {
-            auto track = std::make_unique<Animation::Track<float>>();
-            track->AddKeyframe({0.0f, start_state.position.y, Easing::linear});
-            track->AddKeyframe({0.2f, start_state.position.y + 0.1f, Easing::easeOutQuad});
-            track->AddKeyframe({0.6f, target_state.position.y - 0.05f, Easing::easeInOutCubic});
-            track->AddKeyframe({1.0f, target_state.position.y, Easing::easeOutQuint});
-            seq->AddPositionYTrack(std::move(track));
+            auto& track = builder.GetTrack(Animation::Channel::PositionY);
+            track.AddKeyframe({0.0f, start_state.position.y, Easing::EasingId::Linear});
+            track.AddKeyframe({0.2f, start_state.position.y + 0.1f, Easing::EasingId::OutQuad});
+            track.AddKeyframe({0.6f, target_state.position.y - 0.05f, Easing::EasingId::InOutCubic});
+            track.AddKeyframe({1.0f, target_state.position.y, Easing::EasingId::OutQuint});
         }
 
         // --- Position Z Track ---
         {
-            auto track = std::make_unique<Animation::Track<float>>();
-            track->AddKeyframe({0.0f, start_state.position.z, Easing::linear});
-            track->AddKeyframe({0.4f, start_state.position.z - 0.05f, Easing::easeOutQuad});
-            track->AddKeyframe({1.0f, target_state.position.z, Easing::easeInCubic});
-            seq->AddPositionZTrack(std::move(track));
+            auto& track = builder.GetTrack(Animation::Channel::PositionZ);
+            track.AddKeyframe({0.0f, start_state.position.z, Easing::EasingId::Linear});
+            track.AddKeyframe({0.4f, start_state.position.z - 0.05f, Easing::EasingId::OutQuad});
+            track.AddKeyframe({1.0f, target_state.position.z, Easing::EasingId::InCubic});
         }
 
         // --- Rotation Yaw Track ---
         {
-            auto track = std::make_unique<Animation::Track<float>>();
-            track->AddKeyframe({0.0f, start_state.rotation.x, Easing::linear});
-            track->AddKeyframe({0.45f, target_state.rotation.x + 0.15f, Easing::easeOutQuad});
-            track->AddKeyframe({0.75f, target_state.rotation.x - 0.1f, Easing::easeOutQuad});
-            track->AddKeyframe({1.0f, target_state.rotation.x, Easing::easeInCubic});
-            seq->AddRotationYawTrack(std::move(track));
+            auto& track = builder.GetTrack(Animation::Channel::RotationYaw);
+            track.AddKeyframe({0.0f, start_state.rotation.x, Easing::EasingId::Linear});
+            track.AddKeyframe({0.45f, target_state.rotation.x + 0.15f, Easing::EasingId::OutQuad});
+            track.AddKeyframe({0.75f, target_state.rotation.x - 0.1f, Easing::EasingId::OutQuad});
+            track.AddKeyframe({1.0f, target_state.rotation.x, Easing::EasingId::InCubic});
         }
 
         // --- Rotation Pitch Track ---
         {
-            auto track = std::make_unique<Animation::Track<float>>();
-            track->AddKeyframe({0.0f, start_state.rotation.y, Easing::linear});
-            track->AddKeyframe({0.25f, target_state.rotation.y - 0.25f, Easing::easeOutQuad});
-            track->AddKeyframe({0.6f, target_state.rotation.y - 0.05f, Easing::easeOutQuad});
-            track->AddKeyframe({0.85f, target_state.rotation.y + 0.15f, Easing::easeOutQuad});
-            track->AddKeyframe({1.0f, target_state.rotation.y, Easing::easeInCubic});
-            seq->AddRotationPitchTrack(std::move(track));
+            auto& track = builder.GetTrack(Animation::Channel::RotationPitch);
+            track.AddKeyframe({0.0f, start_state.rotation.y, Easing::EasingId::Linear});
+            track.AddKeyframe({0.25f, target_state.rotation.y - 0.25f, Easing::EasingId::OutQuad});
+            track.AddKeyframe({0.6f, target_state.rotation.y - 0.05f, Easing::EasingId::OutQuad});
+            track.AddKeyframe({0.85f, target_state.rotation.y + 0.15f, Easing::EasingId::OutQuad});
+            track.AddKeyframe({1.0f, target_state.rotation.y, Easing::EasingId::InCubic});
         }
 
-        return seq;
+        return builder.Build();
     }
 
 } // namespace SPF_CabinWalk::AnimationSequences
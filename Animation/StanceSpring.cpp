@@ -0,0 +1,91 @@
+#include <cmath>
+#include "Animation/StanceSpring.hpp"
+
+namespace SPF_CabinWalk::Animation
+{
+    // omega * duration. A critically damped spring has (1 + 8) * e^-8, about 0.3%, of the way left at the duration.
+    constexpr float SETTLE_FACTOR = 8.0f;
+
+    // A channel closer than this to its target, and slower than SETTLE_VELOCITY, has arrived (metres or radians).
+    constexpr float SETTLE_DISTANCE = 0.001f;
+    constexpr float SETTLE_VELOCITY = 0.01f;
+
+    // Frame times above this (first frame, pauses) are clamped, as in GaitEngine.
+    constexpr float MAX_FRAME_TIME_S = 0.1f;
+
+    void StanceSpring::Start(const CurrentCameraState &state)
+    {
+        const float values[] = {state.position.x, state.position.y, state.position.z, state.rotation.y};
+        for (size_t i = 0; i < static_cast<size_t>(SpringChannel::Count); ++i)
+        {
+            m_channels[i] = {values[i], 0.0f, values[i]};
+        }
+        m_elapsed = 0.0f;
+        m_moving = true;
+    }
+
+    void StanceSpring::SetDuration(float seconds)
+    {
+        m_duration = seconds > 0.01f ? seconds : 0.01f;
+        m_omega = SETTLE_FACTOR / m_duration;
+        m_elapsed = 0.0f;
+    }
+
+    void StanceSpring::SetTarget(SpringChannel channel, float target)
+    {
+        m_channels[static_cast<size_t>(channel)].target = target;
+        m_moving = true;
+    }
+
+    void StanceSpring::AddSway(SpringChannel channel, float peak)
+    {
+        // From rest, an impulse v0 peaks at v0 / (omega * e) after 1 / omega.
+        m_channels[static_cast<size_t>(channel)].velocity += peak * m_omega * 2.71828183f;
+        m_moving = true;
+    }
+
+    bool StanceSpring::Update(float dt_s)
+    {
+        if (!m_moving)
+        {
+            return false;
+        }
+
+        if (dt_s > MAX_FRAME_TIME_S)
+        {
+            dt_s = MAX_FRAME_TIME_S;
+        }
+        m_elapsed += dt_s;
+
+        // x(t) = (x0 + (v0 + omega * x0) * t) * e^(-omega * t), relative to the target.
+        const float decay = std::exp(-m_omega * dt_s);
+        bool moving = false;
+        for (Channel &c : m_channels)
+        {
+            const float offset = c.value - c.target;
+            const float temp = (c.velocity + m_omega * offset) * dt_s;
+            c.velocity = (c.velocity - m_omega * temp) * decay;
+            c.value = c.target + (offset + temp) * decay;
+
+            if (std::fabs(c.value - c.target) < SETTLE_DISTANCE && std::fabs(c.velocity) < SETTLE_VELOCITY)
+            {
+                c.value = c.target;
+                c.velocity = 0.0f;
+            }
+            else
+            {
+                moving = true;
+            }
+        }
+
+        m_moving = moving;
+        return m_moving;
+    }
+
+    float StanceSpring::GetProgress() const
+    {
+        const float progress = m_elapsed / m_duration;
+        return progress < 1.0f ? progress : 1.0f;
+    }
+
+} // namespace SPF_CabinWalk::Animation
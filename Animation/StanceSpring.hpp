@@ -0,0 +1,87 @@
+#pragma once
+#include <cstdint>
+#include "Animation/AnimationSequence.hpp" // For Animation::CurrentCameraState
+
+namespace SPF_CabinWalk::Animation
+{
+    /**
+     * @brief The camera properties a StanceSpring drives.
+     */
+    enum class SpringChannel : uint8_t
+    {
+        PositionX = 0,
+        PositionY,
+        PositionZ,
+        Pitch,
+        Count
+    };
+
+    /**
+     * @class StanceSpring
+     * @brief A fixed set of critically damped springs for the small crouch/tiptoe adjustments of the head.
+     *
+     * @details Each channel follows its target with the exact solution of a critically damped spring, so a
+     *          frame costs a few multiplies and one exp per channel regardless of the frame time. Targets
+     *          can be changed at any time; the motion carries its velocity into the new target, which makes
+     *          every stance change interruptible. Sway is an impulse on a channel whose target does not
+     *          move: the head leans out and the spring brings it back. No allocations.
+     */
+    class StanceSpring
+    {
+    public:
+        /**
+         * @brief Starts from rest at the given camera state. Every target is set to the current value.
+         */
+        void Start(const CurrentCameraState &state);
+
+        /**
+         * @brief Sets the time in which a motion visibly settles, and restarts the progress clock.
+         * @param seconds Settle time; values below 10 ms are clamped.
+         */
+        void SetDuration(float seconds);
+
+        void SetTarget(SpringChannel channel, float target);
+
+        /**
+         * @brief Adds a velocity impulse sized so the channel swings out by `peak` before returning.
+         */
+        void AddSway(SpringChannel channel, float peak);
+
+        /**
+         * @brief Advances every channel by one frame.
+         * @return True while still moving; false once every channel has settled on its target.
+         */
+        bool Update(float dt_s);
+
+        /**
+         * @brief Stops at once, leaving every channel where it is.
+         */
+        void Stop() { m_moving = false; }
+
+        bool IsMoving() const { return m_moving; }
+
+        float Get(SpringChannel channel) const { return m_channels[static_cast<size_t>(channel)].value; }
+
+        float GetTarget(SpringChannel channel) const { return m_channels[static_cast<size_t>(channel)].target; }
+
+        /**
+         * @brief Gets the elapsed time relative to the duration, in [0, 1].
+         */
+        float GetProgress() const;
+
+    private:
+        struct Channel
+        {
+            float value = 0.0f;
+            float velocity = 0.0f;
+            float target = 0.0f;
+        };
+
+        Channel m_channels[static_cast<size_t>(SpringChannel::Count)];
+        float m_omega = 1.0f;    // Natural frequency, in 1/s.
+        float m_duration = 1.0f; // Settle time, in seconds.
+        float m_elapsed = 0.0f;
+        bool m_moving = false;
+    };
+
+} // namespace SPF_CabinWalk::Animation
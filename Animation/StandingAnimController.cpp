@@ -1,12 +1,13 @@
 #define _USE_MATH_DEFINES
 #include <cmath>
 #include "Animation/StandingAnimController.hpp"
-#include "Animation/Sequences/StandingStances.hpp"
 #include "Animation/AnimationSequence.hpp"
+#include "Animation/AnimationScheduler.hpp"
 #include "Animation/AnimationController.hpp"
 #include "SPF_CabinWalk.hpp"
-
-#include <memory>
+#include "Camera/CameraFacade.hpp"
+#include "Diagnostics/DebugOverlay.hpp"
+#include "Diagnostics/TraceProvider.hpp"
 
 namespace SPF_CabinWalk::StandingAnimController
 {
@@ -18,11 +19,17 @@ namespace SPF_CabinWalk::StandingAnimController
     static float g_target_walk_z = 0.0f;
     static AnimationController::CameraPosition g_final_destination;
     static Stance g_transition_to_stance = Stance::Standing;
-    static std::unique_ptr<Animation::AnimationSequence> g_active_sequence = nullptr;
-    static uint64_t last_simulation_time = 0;
-    static bool g_has_taken_first_step = false;
+    // The stance spring, the gait and the floor belong to the AnimationScheduler; this controller decides
+    // when they move. Set when the floor must be rebuilt from the settings of the current truck before the
+    // next walk starts.
+    static bool g_floor_stale = true;
+
+    // How far the head leans towards the gaze during each stance change, in metres.
+    constexpr float CROUCH_SWAY = 0.07f;
+    constexpr float TIPTOE_SWAY = 0.13f;
+    constexpr float STAND_DOWN_SWAY = 0.01f;
 
-    // Timers for holding camera in a trigger zone
+    // Timers for holding camera in a trigger zone, in microseconds
     static uint64_t g_time_in_crouch_zone = 0;
     static uint64_t g_time_in_tiptoe_zone = 0;
     static uint64_t g_time_in_standup_zone = 0;
@@ -53,41 +60,129 @@ namespace SPF_CabinWalk::StandingAnimController
     }
 
 
+    static Animation::GaitParams GetGaitParams()
+    {
+        const auto& walking = g_stand_ctx->settings.standing_movement.walking;
+
+        // One walk_step per stride keeps the pace of the former step sequences.
+        float step_s = static_cast<float>(g_stand_ctx->settings.walking_animation_speed.walk_step) / 1000.0f;
+        if (step_s < 0.05f)
+        {
+            step_s = 0.05f;
+        }
+
+        Animation::GaitParams params;
+        params.speed = walking.step_amount / step_s;
+        params.stride = walking.step_amount;
+        params.bob_amount = walking.bob_amount;
+        params.smooth_time = step_s * 0.25f;
+        params.floor = nullptr; // The scheduler walks on its own floor.
+        return params;
+    }
+
+    /**
+     * @brief Rebuilds the cabin floor: the Z walk zone, sideways around the standing position, with its floor step.
+     */
+    static void BuildFloor()
+    {
+        const auto& walking = g_stand_ctx->settings.standing_movement.walking;
+        const float standing_x = g_stand_ctx->settings.positions.standing.position.x;
+
+        Animation::FloorLayout layout;
+        layout.min_x = standing_x + walking.walk_zone_x.min;
+        layout.max_x = standing_x + walking.walk_zone_x.max;
+        layout.min_z = walking.walk_zone_z.min;
+        layout.max_z = walking.walk_zone_z.max;
+        layout.step_z = walking.floor_step.z;
+        layout.step_height = walking.floor_step.height;
+        AnimationScheduler::BuildFloor(layout);
+        g_floor_stale = false;
+    }
+
+    /**
+     * @brief Walks along a direction for the current tick, rebuilding the floor first if a walk starts after a change.
+     * @param direction_x The X part of the walking direction, a unit vector.
+     * @param direction_z The Z part.
+     */
+    static void RequestWalk(float direction_x, float direction_z)
+    {
+        if (g_floor_stale && !AnimationScheduler::IsWalking())
+        {
+            BuildFloor();
+        }
+        AnimationScheduler::Walk(direction_x, direction_z, GetGaitParams());
+    }
+
+    /**
+     * @brief Sends the stance spring towards a new height offset, leaning towards the gaze on the way.
+     * @details A spring that is still moving keeps its velocity, so this also reverses a change halfway through.
+     *          The pitch levels out to look straight ahead, as the keyframed stances did.
+     * @param offset_y The head height of the new stance, relative to standing.
+     */
+    static void StartStanceChange(const Animation::CurrentCameraState& current_state, Stance to, float offset_y, float sway, int32_t duration_ms)
+    {
+        AnimationScheduler::MoveStance(offset_y, current_state.rotation.y, static_cast<float>(duration_ms) / 1000.0f);
+
+        switch (GetGazeDirection(current_state.rotation.x))
+        {
+        case AnimationController::GazeDirection::Forward:
+            AnimationScheduler::AddStanceSway(Animation::SpringChannel::PositionZ, -sway);
+            break;
+        case AnimationController::GazeDirection::Backward:
+            AnimationScheduler::AddStanceSway(Animation::SpringChannel::PositionZ, sway);
+            break;
+        case AnimationController::GazeDirection::Right:
+            AnimationScheduler::AddStanceSway(Animation::SpringChannel::PositionX, sway);
+            break;
+        case AnimationController::GazeDirection::Left:
+            AnimationScheduler::AddStanceSway(Animation::SpringChannel::PositionX, -sway);
+            break;
+        }
+
+        TraceProvider::EmitMarker(TraceProvider::Marker::Stance, static_cast<uint32_t>(g_current_stance), static_cast<uint32_t>(to));
+        g_current_stance = Stance::InTransition;
+        g_transition_to_stance = to;
+    }
+
     void Initialize(PluginContext* ctx)
     {
         g_stand_ctx = ctx;
     }
 
-    void Update(const Animation::CurrentCameraState& current_state)
+    /**
+     * @brief Gets how long the pitch must hold a trigger zone, in the microseconds of the hold timers.
+     */
+    static uint64_t GetHoldTimeUs()
+    {
+        const int32_t hold_time_ms = g_stand_ctx->settings.standing_movement.stance_control.hold_time_ms;
+        return hold_time_ms > 0 ? static_cast<uint64_t>(hold_time_ms) * 1000ull : 0;
+    }
+
+    bool Tick(const FrameContext& frame, uint64_t delta_time_us, uint32_t events)
     {
         if (!g_stand_ctx || !g_stand_ctx->coreAPI)
         {
-            return;
+            return true;
         }
 
-        SPF_Timestamps timestamps;
-        g_stand_ctx->coreAPI->telemetry->Tel_GetTimestamps(g_stand_ctx->telemetryHandle, &timestamps, sizeof(SPF_Timestamps));
-        uint64_t delta_time_ms = timestamps.simulation - last_simulation_time;
-        last_simulation_time = timestamps.simulation;
+        const Animation::CurrentCameraState& current_state = frame.camera;
+        const uint64_t hold_time_us = GetHoldTimeUs();
 
-        // --- Handle active animation sequence ---
-        if (g_active_sequence && g_active_sequence->IsPlaying())
+        // --- Enter the new stance once the stance spring has settled on it ---
+        if ((events & AnimationScheduler::EventBit(AnimationScheduler::Event::StanceSettled)) && g_current_stance == Stance::InTransition)
         {
-            bool is_playing = g_active_sequence->Update(delta_time_ms, g_stand_ctx->cameraAPI);
+            g_current_stance = g_transition_to_stance;
+        }
 
-            if (!is_playing)
-            {
-                // Animation finished, transition to the new stable stance
-                g_active_sequence.reset();
-                if (g_current_stance == Stance::InTransition)
-                {
-                    g_current_stance = g_transition_to_stance;
-                }
-            }
-            return; // Exit if an animation is still playing
+        // --- Walk in any stance; the stance offset rides on top of the walker ---
+        // Continuous walking logic: walk the way the player faces for as long as the key is held.
+        // Yaw 0 faces forward (-Z), positive yaw turns left (-X). A tick without a walk brings the walker to a stop.
+        if (g_current_stance != Stance::WalkingToFinalDestination && frame.walk_key_down)
+        {
+            RequestWalk(-std::sin(current_state.rotation.x), -std::cos(current_state.rotation.x));
         }
 
-        // --- Handle stance transitions based on pitch (only if no animation is active) ---
+        // --- Handle stance transitions based on pitch (only if no stance change is running) ---
         switch (g_current_stance)
         {
             case Stance::Standing:
@@ -96,76 +191,33 @@ namespace SPF_CabinWalk::StandingAnimController
                 g_time_in_standup_zone = 0;
                 g_time_in_standdown_zone = 0;
 
-                // Continuous walking logic
-                if (SPF_CabinWalk::IsWalkKeyDown())
-                {
-                    if (!g_active_sequence || !g_active_sequence->IsPlaying()) // Ensure no other animation is playing
-                    {
-                        const bool is_walking_forward = (current_state.rotation.x >= -M_PI_2 && current_state.rotation.x <= M_PI_2);
-                        const float next_z_pos = current_state.position.z + (is_walking_forward ? -g_stand_ctx->settings.standing_movement.walking.step_amount : g_stand_ctx->settings.standing_movement.walking.step_amount);
-
-                        if (next_z_pos >= g_stand_ctx->settings.standing_movement.walking.walk_zone_z.min && next_z_pos <= g_stand_ctx->settings.standing_movement.walking.walk_zone_z.max) // Check boundaries before triggering step
-                        {
-                            if (!g_has_taken_first_step)
-                            {
-                                g_active_sequence = AnimationSequences::CreateDynamicFirstStepSequence(current_state, is_walking_forward);
-                                g_has_taken_first_step = true;
-                            }
-                            else
-                            {
-                                g_active_sequence = AnimationSequences::CreateWalkStepSequence(current_state, is_walking_forward);
-                            }
-
-                            if (g_active_sequence)
-                            {
-                                g_active_sequence->Start(current_state);
-                                return; // Block other checks until walk animation finishes
-                            }
-                        }
-                    }
-                }
-                else // Walk key is NOT down
-                {
-                    g_has_taken_first_step = false; // Reset first step flag
-                }
-
-                // If not walking, and no animation is playing, then check for other stance changes.
-                if (!g_active_sequence || !g_active_sequence->IsPlaying())
+                // If no stance change is running, check for one.
+                if (!AnimationScheduler::IsStanceMoving())
                 {
                     // Check for crouch
                     if (current_state.rotation.y < g_stand_ctx->settings.standing_movement.stance_control.crouch.activation_angle)
                     {
-                        g_time_in_crouch_zone += delta_time_ms;
+                        g_time_in_crouch_zone += delta_time_us;
                         g_time_in_tiptoe_zone = 0; // Reset other timer
-                        if (g_time_in_crouch_zone >= g_stand_ctx->settings.standing_movement.stance_control.hold_time_ms)
+                        if (g_time_in_crouch_zone >= hold_time_us)
                         {
                             g_time_in_crouch_zone = 0;
-                            AnimationController::GazeDirection current_gaze_for_stance = GetGazeDirection(current_state.rotation.x);
-                            g_active_sequence = AnimationSequences::CreateCrouchDownSequence(current_state, current_gaze_for_stance);
-                            if (g_active_sequence)
-                            {
-                                g_active_sequence->Start(current_state);
-                                g_current_stance = Stance::InTransition;
-                                g_transition_to_stance = Stance::Crouching;
-                            }
+                            StartStanceChange(current_state, Stance::Crouching,
+                                              -g_stand_ctx->settings.standing_movement.stance_control.crouch.depth,
+                                              CROUCH_SWAY, g_stand_ctx->settings.animation_durations.crouch_and_stand_animation_speed.crouch);
                         }
                     }
                     // Check for tiptoes
                     else if (current_state.rotation.y > g_stand_ctx->settings.standing_movement.stance_control.tiptoe.activation_angle)
                     {
-                        g_time_in_tiptoe_zone += delta_time_ms;
+                        g_time_in_tiptoe_zone += delta_time_us;
                         g_time_in_crouch_zone = 0; // Reset other timer
-                        if (g_time_in_tiptoe_zone >= g_stand_ctx->settings.standing_movement.stance_control.hold_time_ms)
+                        if (g_time_in_tiptoe_zone >= hold_time_us)
                         {
                             g_time_in_tiptoe_zone = 0;
-                            AnimationController::GazeDirection current_gaze_for_stance = GetGazeDirection(current_state.rotation.x);
-                            g_active_sequence = AnimationSequences::CreateTiptoeSequence(current_state, current_gaze_for_stance);
-                            if (g_active_sequence)
-                            {
-                                g_active_sequence->Start(current_state);
-                                g_current_stance = Stance::InTransition;
-                                g_transition_to_stance = Stance::Tiptoes;
-                            }
+                            StartStanceChange(current_state, Stance::Tiptoes,
+                                              g_stand_ctx->settings.standing_movement.stance_control.tiptoe.height,
+                                              TIPTOE_SWAY, g_stand_ctx->settings.animation_durations.crouch_and_stand_animation_speed.tiptoe);
                         }
                     }
                     // Not in any trigger zone
@@ -184,11 +236,11 @@ namespace SPF_CabinWalk::StandingAnimController
 
                 if (current_state.rotation.y > g_stand_ctx->settings.standing_movement.stance_control.crouch.deactivation_angle)
                 {
-                    g_time_in_standup_zone += delta_time_ms;
-                    if (g_time_in_standup_zone >= g_stand_ctx->settings.standing_movement.stance_control.hold_time_ms)
+                    g_time_in_standup_zone += delta_time_us;
+                    if (g_time_in_standup_zone >= hold_time_us)
                     {
                         g_time_in_standup_zone = 0;
-                        TriggerStandUp(); // Use the refactored function
+                        TriggerStandUp(current_state);
                     }
                 }
                 else
@@ -204,11 +256,11 @@ namespace SPF_CabinWalk::StandingAnimController
 
                 if (current_state.rotation.y < g_stand_ctx->settings.standing_movement.stance_control.tiptoe.deactivation_angle)
                 {
-                    g_time_in_standdown_zone += delta_time_ms;
-                    if (g_time_in_standdown_zone >= g_stand_ctx->settings.standing_movement.stance_control.hold_time_ms)
+                    g_time_in_standdown_zone += delta_time_us;
+                    if (g_time_in_standdown_zone >= hold_time_us)
                     {
                         g_time_in_standdown_zone = 0;
-                        TriggerStandDown(); // Use the refactored function
+                        TriggerStandDown(current_state);
                     }
                 }
                 else
@@ -217,97 +269,73 @@ namespace SPF_CabinWalk::StandingAnimController
                 }
                 break;
             }
-            case Stance::InTransition: // Should be handled by the active_sequence check above
+            case Stance::InTransition: // Advanced by the scheduler's stance spring
                 break;
             case Stance::WalkingToFinalDestination:
             {
                 // Logic for automatically walking towards g_target_walk_z
                 const float z_target = g_target_walk_z;
-const float step_amount = g_stand_ctx->settings.standing_movement.walking.step_amount;
+                const float step_amount = g_stand_ctx->settings.standing_movement.walking.step_amount;
 
                 // Determine if we are close enough to the target Z
                 if (std::fabs(current_state.position.z - z_target) <= step_amount)
                 {
-                    // Close enough to target. Transition to sitting.
+                    // Close enough to target. Transition to sitting; the sit-down starts from wherever the walk left the camera.
+                    AnimationScheduler::HaltWalk();
                     g_current_stance = Stance::Standing; // Reset stance to Standing
                     AnimationController::MoveTo(g_final_destination); // Trigger the final sit-down animation
-                    return; // New animation started, exit update
+                    return false; // New animation started, exit update
                 }
-                else // Still far from target, trigger another walk step
-                {
-                    // Determine if we need to walk forward (-Z) or backward (+Z)
-                    bool is_walking_forward = (current_state.position.z > z_target); // If current Z is greater than target Z, walk forward (-Z)
 
-                    // Trigger a walk step.
-                    TriggerWalkStepTowards(current_state, is_walking_forward);
-                    return; // A new animation might have started, exit update
-                }
+                // Still far from target: keep walking, forward (-Z) if the target lies ahead.
+                RequestWalk(0.0f, (current_state.position.z > z_target) ? -1.0f : 1.0f);
+                break;
             }
             default:
                 break;
         }
+
+        if (DebugOverlay::IsEnabled())
+        {
+            const auto &standing = g_stand_ctx->settings.standing_movement;
+            DebugOverlay::PublishStanding({current_state.position.z,
+                                           standing.walking.walk_zone_z.min,
+                                           standing.walking.walk_zone_z.max,
+                                           g_time_in_crouch_zone,
+                                           g_time_in_tiptoe_zone,
+                                           g_time_in_standup_zone,
+                                           g_time_in_standdown_zone,
+                                           standing.stance_control.hold_time_ms,
+                                           static_cast<int32_t>(g_current_stance)});
+        }
+        return true;
+    }
+
+    void NotifyFloorChanged()
+    {
+        g_floor_stale = true;
     }
 
     void OnEnterStandingState()
     {
         g_current_stance = Stance::Standing;
-        g_active_sequence.reset();
+        AnimationScheduler::BeginStanding();
     }
 
-    void TriggerWalkStepTowards(const Animation::CurrentCameraState& current_state, bool is_walking_forward)
+    void OnLeaveStandingState()
     {
-        // This function is called by AnimationController to make a step towards the home position.
-        // It bypasses the IsWalkKeyDown() check because the intent to walk is already established.
-
-        if (g_active_sequence && g_active_sequence->IsPlaying())
-        {
-            return; // Don't trigger a new step if an animation is already playing
-        }
-
-        const float next_z_pos = current_state.position.z + (is_walking_forward ? -g_stand_ctx->settings.standing_movement.walking.step_amount : g_stand_ctx->settings.standing_movement.walking.step_amount);
-
-        if (next_z_pos >= g_stand_ctx->settings.standing_movement.walking.walk_zone_z.min && next_z_pos <= g_stand_ctx->settings.standing_movement.walking.walk_zone_z.max)
-        {
-            if (!g_has_taken_first_step)
-            {
-                // This 'first step' now implies turning to face the Z-axis of the STANDING_POSITION_TARGET.
-                // The yaw component of STANDING_POSITION_TARGET should be used for rotation.
-                // CreateDynamicFirstStepSequence might need to be adapted or a new sequence created
-                // that handles turning towards STANDING_POSITION_TARGET.rotation.x (yaw).
-                g_active_sequence = AnimationSequences::CreateDynamicFirstStepSequence(current_state, is_walking_forward); // This sequence should eventually handle yaw correction
-                g_has_taken_first_step = true;
-            }
-            else
-            {
-                g_active_sequence = AnimationSequences::CreateWalkStepSequence(current_state, is_walking_forward);
-            }
+        AnimationScheduler::EndStanding();
+    }
 
-            if (g_active_sequence)
-            {
-                g_active_sequence->Start(current_state);
-            }
-        }
-        else
-        {
-            // If boundaries would be exceeded, reset first step flag as we can't walk further in this direction
-            g_has_taken_first_step = false;
-        }
+    bool IsWithinStep(float target_z, float z)
+    {
+        return std::fabs(z - target_z) <= g_stand_ctx->settings.standing_movement.walking.step_amount;
     }
 
-        bool CanSitDown(AnimationController::CameraPosition target, float target_z)
+        bool CanSitDown(AnimationController::CameraPosition target, float target_z, const Animation::CurrentCameraState& current_state)
         {
-            // Get current camera state
-            Animation::CurrentCameraState current_state;
-            g_stand_ctx->cameraAPI->Cam_GetInteriorSeatPos(&current_state.position.x, &current_state.position.y, &current_state.position.z);
-            // Rotation not strictly needed for this check, but good practice to get full state if available.
-            g_stand_ctx->cameraAPI->Cam_GetInteriorHeadRot(&current_state.rotation.x, &current_state.rotation.y);
-            current_state.rotation.z = 0.0f; // Roll is not retrieved
-    
-            const float z_current = current_state.position.z;
-            const float step_amount = g_stand_ctx->settings.standing_movement.walking.step_amount;
-    
             // Check if we are close enough to the target Z
-            if (std::fabs(z_current - target_z) <= step_amount)
+            if (IsWithinStep(target_z, current_state.position.z))
             {
                 // Close enough, can sit immediately.
                 return true;
@@ -327,53 +355,58 @@ const float step_amount = g_stand_ctx->settings.standing_movement.walking.step_a
             
                 bool IsAnimating()
                 {
-                    return g_active_sequence && g_active_sequence->IsPlaying();
+                    return AnimationScheduler::IsStandingMoving();
                 }
+
+    bool CancelWalk()
+    {
+        if (AnimationScheduler::IsStanceMoving())
+        {
+            // A stance change is running. Send it back up (or down) to standing right away; the caller still
+            // has to wait for it to settle.
+            const Animation::CurrentCameraState current_state = CameraFacade::GetState();
+            TriggerStandUp(current_state);
+            TriggerStandDown(current_state);
+            return false;
+        }
+
+        AnimationScheduler::HaltWalk();
+        if (g_current_stance == Stance::WalkingToFinalDestination)
+        {
+            g_current_stance = Stance::Standing;
+        }
+        return true;
+    }
+
+    float GetActiveProgress()
+    {
+        if (AnimationScheduler::IsStanceMoving())
+        {
+            return AnimationScheduler::GetStanceProgress();
+        }
+        return AnimationScheduler::IsWalking() ? AnimationScheduler::GetStridePhase() : -1.0f;
+    }
             
-                void TriggerStandUp()
+                void TriggerStandUp(const Animation::CurrentCameraState& current_state)
                 {
-                    if (IsAnimating() || g_current_stance != Stance::Crouching)
+                    if (g_current_stance != Stance::Crouching && !(g_current_stance == Stance::InTransition && g_transition_to_stance == Stance::Crouching))
                     {
-                        return; // Don't interrupt or trigger from wrong state
+                        return; // Wrong state; a change still heading into the stance is reversed
                     }
             
-                    // Need current state to create the animation
-                    Animation::CurrentCameraState current_state;
-                    g_stand_ctx->cameraAPI->Cam_GetInteriorSeatPos(&current_state.position.x, &current_state.position.y, &current_state.position.z);
-                    g_stand_ctx->cameraAPI->Cam_GetInteriorHeadRot(&current_state.rotation.x, &current_state.rotation.y);
-                    current_state.rotation.z = 0.0f;
-            
-                    AnimationController::GazeDirection current_gaze = GetGazeDirection(current_state.rotation.x);
-                    g_active_sequence = AnimationSequences::CreateStandUpSequence(current_state, current_gaze);
-                    if (g_active_sequence)
-                    {
-                        g_active_sequence->Start(current_state);
-                        g_current_stance = Stance::InTransition;
-                        g_transition_to_stance = Stance::Standing;
-                    }
+                    StartStanceChange(current_state, Stance::Standing, 0.0f, CROUCH_SWAY,
+                                      g_stand_ctx->settings.animation_durations.crouch_and_stand_animation_speed.crouch);
                 }
             
-                    void TriggerStandDown()
+                    void TriggerStandDown(const Animation::CurrentCameraState& current_state)
                     {
-                        if (IsAnimating() || g_current_stance != Stance::Tiptoes)
+                        if (g_current_stance != Stance::Tiptoes && !(g_current_stance == Stance::InTransition && g_transition_to_stance == Stance::Tiptoes))
                         {
-                            return; // Don't interrupt or trigger from wrong state
+                            return; // Wrong state; a change still heading into the stance is reversed
                         }
                 
-                        // Need current state to create the animation
-                        Animation::CurrentCameraState current_state;
-                        g_stand_ctx->cameraAPI->Cam_GetInteriorSeatPos(&current_state.position.x, &current_state.position.y, &current_state.position.z);
-                        g_stand_ctx->cameraAPI->Cam_GetInteriorHeadRot(&current_state.rotation.x, &current_state.rotation.y);
-                        current_state.rotation.z = 0.0f;
-                
-                        AnimationController::GazeDirection current_gaze = GetGazeDirection(current_state.rotation.x);
-                        g_active_sequence = AnimationSequences::CreateStandDownSequence(current_state, current_gaze);
-                        if (g_active_sequence)
-                        {
-                            g_active_sequence->Start(current_state);
-                            g_current_stance = Stance::InTransition;
-                            g_transition_to_stance = Stance::Standing;
-                        }
+                        StartStanceChange(current_state, Stance::Standing, 0.0f, STAND_DOWN_SWAY,
+                                          g_stand_ctx->settings.animation_durations.crouch_and_stand_animation_speed.tiptoe);
                     }
                 
                     void StartWalkingToZ(float target_z, AnimationController::CameraPosition final_destination)
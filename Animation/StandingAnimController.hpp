@@ -3,6 +3,7 @@
 #include "SPF_TelemetryData.h"
 #include "Animation/AnimationSequence.hpp"
 #include "Animation/AnimationController.hpp" // For CameraPosition enum
+#include "Animation/FrameContext.hpp"
 
 // Forward declare PluginContext
 struct PluginContext;
@@ -37,30 +38,45 @@ namespace SPF_CabinWalk
         void StartWalkingToZ(float target_z, AnimationController::CameraPosition final_destination);
 
     /**
-     * @brief Updates the standing animation state based on the current camera view.
-     * @param current_state The current state (position and rotation) of the camera.
+     * @brief Runs one fixed tick of the stance and walking logic: the hold timers, the stance to change to
+     *        and the way to walk. Called by AnimationScheduler::Update(), which moves the camera accordingly.
+     * @param frame The frame's clock, camera pose and input state.
+     * @param delta_time_us The tick length, in microseconds.
+     * @param events The AnimationScheduler::EventBit() of each event the tick fired before it, e.g. StanceSettled.
+     * @return False if the tick started a move out of Standing, so no further tick should run this frame.
      */
-    void Update(const Animation::CurrentCameraState& current_state);
+    bool Tick(const FrameContext& frame, uint64_t delta_time_us, uint32_t events);
 
     /**
      * @brief Resets the standing animation state, typically called when entering the standing position.
+     * @details The walker starts from the pose the layers compose to right now.
      */
     void OnEnterStandingState();
 
     /**
-     * @brief Triggers a single walk step towards or away from the home position.
-     * @param current_state The current state of the camera.
-     * @param is_walking_forward True if walking forward (negative Z), false if walking backward (positive Z).
+     * @brief Stops walking and clears the standing layers, so a transition out of Standing owns the camera.
      */
-    void TriggerWalkStepTowards(const Animation::CurrentCameraState& current_state, bool is_walking_forward);
+    void OnLeaveStandingState();
+
+    /**
+     * @brief Marks the cabin floor for a rebuild from the walking settings and the standing position.
+     * @details Cheap; the grid is rebuilt when the next walk starts.
+     */
+    void NotifyFloorChanged();
+
+    /**
+     * @brief Checks whether `z` is within one walking step of `target_z`, so a sit-down needs no walk first.
+     */
+    bool IsWithinStep(float target_z, float z);
 
     /**
      * @brief Checks if the player can immediately sit down, or initiates a walk back to a target Z.
      * @param target The CameraPosition to sit down into (Driver or Passenger).
      * @param target_z The target Z-coordinate to be at before sitting down.
+     * @param current_state The current camera state.
      * @return True if the player is close enough to sit down immediately, false otherwise (a walk back was initiated).
      */
-    bool CanSitDown(AnimationController::CameraPosition target, float target_z);
+    bool CanSitDown(AnimationController::CameraPosition target, float target_z, const Animation::CurrentCameraState& current_state);
 
     /**
      * @brief Gets the current vertical stance of the camera.
@@ -69,20 +85,37 @@ namespace SPF_CabinWalk
     Stance GetCurrentStance();
 
     /**
-     * @brief Checks if the controller is currently playing a stance-related animation.
-     * @return True if an animation is active, false otherwise.
+     * @brief Checks if the controller is currently playing a stance-related animation or walking.
+     * @return True if an animation is active or the walker has not yet come to rest, false otherwise.
      */
     bool IsAnimating();
 
+    /**
+     * @brief Stops walking at once, including an automatic walk towards a seat.
+     * @return True if nothing but walking was in progress, false if a stance change is running. That change
+     *         is sent back towards standing at once, but has to settle before another move can start.
+     */
+    bool CancelWalk();
+
+    /**
+     * @brief Gets the normalized progress of the playing stance animation, or the stride phase while walking.
+     * @return The progress, or a negative value if none is playing.
+     */
+    float GetActiveProgress();
+
     /**
      * @brief Triggers an animation to stand up from a crouching position.
+     * @details Also reverses a change that is still heading into that stance.
+     * @param current_state The camera state the animation starts from.
      */
-    void TriggerStandUp();
+    void TriggerStandUp(const Animation::CurrentCameraState& current_state);
 
     /**
      * @brief Triggers an animation to stand down from a tiptoeing position.
+     * @details Also reverses a change that is still heading into that stance.
+     * @param current_state The camera state the animation starts from.
      */
-    void TriggerStandDown();
+    void TriggerStandDown(const Animation::CurrentCameraState& current_state);
 
 }
 } // namespace SPF_CabinWalk
@@ -1,37 +1,163 @@
 #pragma once
 #include "Animation/Keyframe.hpp"
 #include <SPF_TelemetryData.h> // For SPF_FVector
-#include <vector>
-#include <algorithm> // For std::sort
+#include <algorithm> // For std::upper_bound, std::min
+#include <cmath>
+#include <cstdint>
 
 namespace SPF_CabinWalk::Animation
 {
+    constexpr float ANGLE_PI = 3.14159265f;
+    constexpr float ANGLE_TWO_PI = 6.28318531f;
+
+    /**
+     * @brief Normalizes an angle into [-PI, PI]. A single compare when it already is.
+     */
+    inline float WrapAngle(float radians)
+    {
+        if (radians > ANGLE_PI || radians < -ANGLE_PI)
+        {
+            return std::remainder(radians, ANGLE_TWO_PI);
+        }
+        return radians;
+    }
+
+    /**
+     * @brief Gets the shortest signed rotation from one angle to another, in [-PI, PI].
+     */
+    inline float AngleDelta(float from, float to)
+    {
+        return WrapAngle(to - from);
+    }
+
+    /**
+     * @brief Evaluates one spline segment `c0 + t * (c1 + t * (c2 + t * c3))` at local progress `t`.
+     */
+    inline float EvaluateSpline(const float* coefficients, float t)
+    {
+        return coefficients[0] + t * (coefficients[1] + t * (coefficients[2] + t * coefficients[3]));
+    }
+
+    /**
+     * @brief Fills the spline coefficient rows of one track from its keyframes.
+     * @details Every keyframe eased with Easing::EasingId::Spline gets the cubic Hermite polynomial of the
+     *          segment that ends at it, in local progress. A key's tangent is the Catmull-Rom slope when
+     *          both of its segments are spline segments, limited so a monotonic run never overshoots
+     *          (Fritsch-Carlson); it is zero at the ends of the track, next to eased segments and at a local
+     *          extremum. Spline runs are therefore C1 and join eased keys the way an ease-in/out would.
+     *          Rows of other keyframes are zeroed.
+     * @param progress The `count` sorted progress values of the track.
+     * @param values The `count` keyframe values.
+     * @param easing_ids The `count` easing ids.
+     * @param coefficients Receives `4 * count` floats.
+     * @param angular Whether the values are angles; every key-to-key step then takes the shortest arc.
+     */
+    inline void ComputeSplineCoefficients(const float* progress, const float* values, const uint8_t* easing_ids, uint32_t count, float* coefficients,
+                                          bool angular = false)
+    {
+        constexpr uint8_t spline_id = static_cast<uint8_t>(Easing::EasingId::Spline);
+
+        // Change of value from key i - 1 to key i.
+        auto step = [&](uint32_t i) -> float
+        {
+            return angular ? AngleDelta(values[i - 1], values[i]) : values[i] - values[i - 1];
+        };
+
+        // Slope of the value per unit of sequence progress at key i.
+        auto tangent = [&](uint32_t i) -> float
+        {
+            if (i == 0 || i + 1 >= count || easing_ids[i] != spline_id || easing_ids[i + 1] != spline_id)
+            {
+                return 0.0f;
+            }
+
+            const float h0 = progress[i] - progress[i - 1];
+            const float h1 = progress[i + 1] - progress[i];
+            const float d0 = step(i);
+            const float d1 = step(i + 1);
+            if (h0 <= 0.0f || h1 <= 0.0f || d0 * d1 <= 0.0f)
+            {
+                return 0.0f;
+            }
+
+            // Both slopes share a sign here, so the limit can be taken on magnitudes.
+            const float slope = (d0 + d1) / (h0 + h1);
+            const float limit = 3.0f * std::min(std::fabs(d0 / h0), std::fabs(d1 / h1));
+            return std::fabs(slope) > limit ? std::copysign(limit, slope) : slope;
+        };
+
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            float* row = coefficients + 4 * i;
+            if (i == 0 || easing_ids[i] != spline_id)
+            {
+                row[0] = row[1] = row[2] = row[3] = 0.0f;
+                continue;
+            }
+
+            // Tangents scaled from sequence progress to the segment's local [0, 1].
+            const float h = progress[i] - progress[i - 1];
+            const float d = step(i);
+            const float m0 = tangent(i - 1) * h;
+            const float m1 = tangent(i) * h;
+            row[0] = values[i - 1];
+            row[1] = m0;
+            row[2] = 3.0f * d - 2.0f * m0 - m1;
+            row[3] = -2.0f * d + m0 + m1;
+        }
+    }
+
     /**
      * @class Track
-     * @brief Manages a sequence of Keyframes for a single animatable property.
+     * @brief A view over the keyframes of a single animatable property, with its own playback cursor.
+     * @details Tracks do not own their keyframes. The progress, value and easing-id columns live in
+     *          one contiguous buffer owned by the AnimationSequence (see SequenceBuilder), and a Track
+     *          only points at its slice of each column. Keyframes are guaranteed to be sorted by progress.
+     *
+     *          A keyframe eased with Easing::EasingId::Spline ends a cubic Hermite segment instead of an
+     *          eased lerp. Its polynomial is stored in an optional coefficient column (four floats per
+     *          keyframe, row N describing the segment that ends at keyframe N), computed once when the
+     *          sequence is built or re-bound (see ComputeSplineCoefficients), so a sample is one Horner chain.
+     *
+     *          Angular tracks (yaw, roll) interpolate every segment along the shortest arc and return
+     *          values normalized into [-PI, PI], so a turn across the +/-180 degree seam never goes the
+     *          long way round and the result never needs wrapping afterwards.
      * @tparam T The type of the value being animated (e.g., float, SPF_FVector).
      */
     template <typename T>
     class Track
     {
     private:
-        std::vector<Keyframe<T>> m_keyframes;
+        const float* m_progress = nullptr;
+        const T* m_values = nullptr;
+        const uint8_t* m_easing_ids = nullptr;
+        const float* m_coefficients = nullptr; // Null when no keyframe of the track is a spline key.
+        uint32_t m_count = 0;
+        bool m_angular = false;
+        bool m_reversed = false; // Plays the keys backwards in time; see Reversed().
+
+        // Playback cursor: index of the keyframe that starts the segment evaluated last, plus
+        // the cached 1/duration of that segment. Progress normally moves one way, so the cursor
+        // just steps to the neighbouring segment when a keyframe is crossed.
+        uint32_t m_cursor = 0;
+        float m_inv_segment_duration = 0.0f;
+        bool m_cursor_valid = false;
 
     public:
         Track() = default;
 
         /**
-         * @brief Adds a keyframe to the track, maintaining sorted order by progress.
-         * @param keyframe The Keyframe object to add.
+         * @brief Creates a view over already sorted keyframe columns.
+         * @param progress Pointer to `count` progress values.
+         * @param values Pointer to `count` keyframe values.
+         * @param easing_ids Pointer to `count` easing ids (see Easing::ToId).
+         * @param count The number of keyframes in the track.
+         * @param coefficients Pointer to `4 * count` spline coefficients, or nullptr if the track has no spline keys.
+         * @param angular True if the values are angles in radians (see the class description).
          */
-        void AddKeyframe(const Keyframe<T>& keyframe)
-        {
-            m_keyframes.push_back(keyframe);
-            std::sort(m_keyframes.begin(), m_keyframes.end(),
-                      [](const Keyframe<T>& a, const Keyframe<T>& b) {
-                          return a.progress < b.progress;
-                      });
-        }
+        Track(const float* progress, const T* values, const uint8_t* easing_ids, uint32_t count, const float* coefficients = nullptr,
+              bool angular = false)
+            : m_progress(progress), m_values(values), m_easing_ids(easing_ids), m_coefficients(coefficients), m_count(count), m_angular(angular) {}
 
         /**
          * @brief Checks if the track contains any keyframes.
@@ -39,7 +165,84 @@ namespace SPF_CabinWalk::Animation
          */
         bool IsEmpty() const
         {
-            return m_keyframes.empty();
+            return m_count == 0;
+        }
+
+        /**
+         * @brief Gets the number of keyframes in the track.
+         */
+        uint32_t GetKeyframeCount() const
+        {
+            return m_count;
+        }
+
+        /**
+         * @brief Checks whether the track interpolates angles along the shortest arc.
+         */
+        bool IsAngular() const
+        {
+            return m_angular;
+        }
+
+        /**
+         * @brief Gets a view over the same keys that plays them backwards: progress `p` samples the keys at `1 - p`.
+         * @details The keys are not copied, so a re-bind of their owner moves both views.
+         */
+        Track Reversed() const
+        {
+            Track track = *this;
+            track.m_reversed = !m_reversed;
+            track.ResetCursor();
+            return track;
+        }
+
+        /**
+         * @brief Rewinds the playback cursor. Call when the owning sequence restarts.
+         */
+        void ResetCursor()
+        {
+            m_cursor = 0;
+            m_cursor_valid = false;
+        }
+
+        /**
+         * @brief The keyframe pair that brackets a progress point, ready to be interpolated.
+         * @details Evaluation is `lerp(start_value, end_value, ease((progress - start_progress) * inv_duration))`.
+         *          Clamped results (empty track, before the first or after the last keyframe) are encoded
+         *          as a zero-length linear segment whose start and end values are equal, so every case
+         *          goes through the same arithmetic. This lets several tracks be finished in one batch.
+         *          Spline segments are encoded as a lerp from 0 to 1 whose "eased" progress is the spline
+         *          value itself, evaluated from `coefficients`.
+         */
+        struct Segment
+        {
+            T start_value;
+            T end_value;
+            float start_progress;
+            float inv_duration;
+            uint8_t easing_id;
+            const float* coefficients; // The spline polynomial, or nullptr for an eased segment.
+        };
+
+        /**
+         * @brief Finds the segment that contains a progress point, advancing the playback cursor.
+         * @details Amortized O(1) for monotonic progress in either direction: the cursor only steps when
+         *          progress crosses a keyframe. The first evaluation after a restart is a binary search.
+         *          A reversed track returns the segment in the caller's progress, running the other way.
+         * @param current_progress The current progress of the animation sequence (0.0 to 1.0).
+         * @param default_value The value to hold if the track is empty.
+         */
+        Segment Locate(float current_progress, const T& default_value)
+        {
+            if (!m_reversed)
+            {
+                return LocateKeys(current_progress, default_value);
+            }
+
+            Segment segment = LocateKeys(1.0f - current_progress, default_value);
+            segment.start_progress = 1.0f - segment.start_progress;
+            segment.inv_duration = -segment.inv_duration;
+            return segment;
         }
 
         /**
@@ -48,50 +251,97 @@ namespace SPF_CabinWalk::Animation
          * @param default_value A default value to return if the track is empty.
          * @return The interpolated value at the given progress point.
          */
-        T Evaluate(float current_progress, T default_value) const
+        T Evaluate(float current_progress, T default_value)
         {
-            if (m_keyframes.empty())
+            const Segment segment = Locate(current_progress, default_value);
+
+            // Calculate progress between the two keyframes (local progress)
+            float local_progress = (current_progress - segment.start_progress) * segment.inv_duration;
+            float eased_progress = segment.coefficients ? EvaluateSpline(segment.coefficients, local_progress)
+                                                        : Easing::Evaluate(segment.easing_id, local_progress);
+
+            // Interpolate the value
+            const T value = lerp(segment.start_value, segment.end_value, eased_progress);
+            return m_angular ? WrapAngle(value) : value;
+        }
+
+    private:
+        // Locate() in the progress of the keys themselves.
+        Segment LocateKeys(float current_progress, const T& default_value)
+        {
+            if (m_count == 0)
             {
-                return default_value;
+                return Hold(default_value, current_progress);
             }
 
-            // If progress is before the first keyframe, return the first keyframe's value
-            if (current_progress <= m_keyframes.front().progress)
+            // If progress is before the first keyframe, hold the first keyframe's value
+            if (current_progress <= m_progress[0])
             {
-                return m_keyframes.front().value;
+                return Hold(m_values[0], current_progress);
             }
 
-            // If progress is after the last keyframe, return the last keyframe's value
-            if (current_progress >= m_keyframes.back().progress)
+            // If progress is after the last keyframe, hold the last keyframe's value
+            if (current_progress >= m_progress[m_count - 1])
             {
-                return m_keyframes.back().value;
+                return Hold(m_values[m_count - 1], current_progress);
             }
 
-            // Find the two keyframes to interpolate between
-            auto it_end = std::upper_bound(m_keyframes.begin(), m_keyframes.end(), current_progress,
-                                          [](float prog, const Keyframe<T>& kf) {
-                                              return prog < kf.progress;
-                                          });
-            auto it_start = std::prev(it_end);
-
-            const Keyframe<T>& start_kf = *it_start;
-            const Keyframe<T>& end_kf = *it_end;
+            // From here on m_progress[0] < current_progress < m_progress[m_count - 1], so a segment
+            // [m_cursor, m_cursor + 1) containing current_progress always exists.
+            if (!m_cursor_valid)
+            {
+                Seek(current_progress);
+            }
+            else if (current_progress < m_progress[m_cursor])
+            {
+                // Lands on the last key at or before the progress, so the segment never has zero length.
+                do
+                {
+                    --m_cursor;
+                } while (current_progress < m_progress[m_cursor]);
+                CacheSegment();
+            }
+            else if (current_progress >= m_progress[m_cursor + 1])
+            {
+                do
+                {
+                    ++m_cursor;
+                } while (current_progress >= m_progress[m_cursor + 1]);
+                CacheSegment();
+            }
 
-            // Calculate progress between the two keyframes (local progress)
-            float duration_between_keyframes = end_kf.progress - start_kf.progress;
-            if (duration_between_keyframes == 0.0f)
+            const uint32_t start_index = m_cursor;
+            const uint32_t end_index = m_cursor + 1;
+            if (m_coefficients && m_easing_ids[end_index] == static_cast<uint8_t>(Easing::EasingId::Spline))
             {
-                return start_kf.value;
+                return {T(0), T(1), m_progress[start_index], m_inv_segment_duration, m_easing_ids[end_index], m_coefficients + 4 * end_index};
             }
+            const T end_value = m_angular ? m_values[start_index] + AngleDelta(m_values[start_index], m_values[end_index]) : m_values[end_index];
+            return {m_values[start_index], end_value, m_progress[start_index], m_inv_segment_duration, m_easing_ids[end_index], nullptr};
+        }
+
+        // Binary search used for the first evaluation after a restart.
+        void Seek(float current_progress)
+        {
+            const float* it_end = std::upper_bound(m_progress, m_progress + m_count, current_progress);
+            m_cursor = static_cast<uint32_t>(it_end - m_progress) - 1;
+            CacheSegment();
+        }
 
-            float local_progress = (current_progress - start_kf.progress) / duration_between_keyframes;
-            float eased_progress = end_kf.easing_function(local_progress);
+        // A constant segment: local progress is always 0 and start == end, so the lerp returns `value` exactly.
+        static Segment Hold(const T& value, float current_progress)
+        {
+            return {value, value, current_progress, 0.0f, static_cast<uint8_t>(Easing::EasingId::Linear), nullptr};
+        }
 
-            // Interpolate the value
-            return lerp(start_kf.value, end_kf.value, eased_progress);
+        void CacheSegment()
+        {
+            // Segments reached by the cursor always have a non-zero duration, because the cursor skips
+            // keyframes that share a progress value.
+            m_inv_segment_duration = 1.0f / (m_progress[m_cursor + 1] - m_progress[m_cursor]);
+            m_cursor_valid = true;
         }
 
-    private:
         // Generic linear interpolation function (needs to be specialized for custom types like SPF_FVector)
         T lerp(const T& a, const T& b, float t) const
         {
@@ -117,4 +367,4 @@ namespace SPF_CabinWalk::Animation
         return a + (b - a) * t;
     }
 
-} // namespace SPF_CabinWalk::Animation
\ No newline at end of file
+} // namespace SPF_CabinWalk::Animation
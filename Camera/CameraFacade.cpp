@@ -0,0 +1,228 @@
+#include "Camera/CameraFacade.hpp"
+#include "SPF_CabinWalk.hpp" // For g_ctx
+#include "Diagnostics/Latency.hpp"
+
+namespace SPF_CabinWalk::CameraFacade
+{
+    // =================================================================================================
+    // Internal State
+    // =================================================================================================
+
+    // Bits used for both the valid (read) and the dirty (written) property sets.
+    enum Property : uint8_t
+    {
+        PROPERTY_SEAT_POS = 1 << 0,
+        PROPERTY_HEAD_ROT = 1 << 1,
+    };
+
+    static SPF_FVector g_seat_pos = {};
+    static float g_yaw = 0.0f;
+    static float g_pitch = 0.0f;
+
+    static uint8_t g_valid = 0;
+    static uint8_t g_dirty = 0;
+    static bool g_wrap_yaw = false;
+
+    // =================================================================================================
+    // Internal Helpers
+    // =================================================================================================
+
+    static void OnHeadRotRead()
+    {
+        // Mouse look may have carried the yaw past the seam since the last read. Wrapping it here,
+        // in the read every frame makes anyway, keeps it clear of the free-look limits without a
+        // separate read-modify-write round trip.
+        if (g_wrap_yaw)
+        {
+            const float wrapped = Animation::WrapAngle(g_yaw);
+            if (wrapped != g_yaw)
+            {
+                g_yaw = wrapped;
+                g_dirty |= PROPERTY_HEAD_ROT;
+            }
+        }
+    }
+
+#ifdef SPF_CABINWALK_BULK_CAMERA_API
+    static_assert(uint32_t(PROPERTY_SEAT_POS) == uint32_t(SPF_INTERIOR_STATE_SEAT_POS) && uint32_t(PROPERTY_HEAD_ROT) == uint32_t(SPF_INTERIOR_STATE_HEAD_ROT),
+                  "Property bits are passed to the bulk calls as SPF_InteriorStateField flags");
+
+    /**
+     * @brief Reads every property not yet valid in one call, as a frame that needs one nearly always needs both.
+     * @return False if the framework has no bulk call or it failed; the single getters are used then.
+     */
+    static bool ReadMissingBulk()
+    {
+        if (!g_ctx.cameraAPI || !g_ctx.cameraAPI->Cam_GetInteriorState)
+        {
+            return false;
+        }
+
+        const uint8_t missing = (PROPERTY_SEAT_POS | PROPERTY_HEAD_ROT) & ~g_valid;
+        SPF_InteriorCameraState_t state = {};
+        if (!g_ctx.cameraAPI->Cam_GetInteriorState(missing, &state))
+        {
+            return false;
+        }
+
+        g_valid |= missing;
+        if (missing & PROPERTY_SEAT_POS)
+        {
+            g_seat_pos = {state.seat_x, state.seat_y, state.seat_z};
+        }
+        if (missing & PROPERTY_HEAD_ROT)
+        {
+            g_yaw = state.yaw;
+            g_pitch = state.pitch;
+            OnHeadRotRead();
+        }
+        return true;
+    }
+#endif
+
+    static void EnsureSeatPos()
+    {
+        if (g_valid & PROPERTY_SEAT_POS)
+        {
+            return;
+        }
+
+#ifdef SPF_CABINWALK_BULK_CAMERA_API
+        if (ReadMissingBulk())
+        {
+            return;
+        }
+#endif
+        if (g_ctx.cameraAPI)
+        {
+            g_ctx.cameraAPI->Cam_GetInteriorSeatPos(&g_seat_pos.x, &g_seat_pos.y, &g_seat_pos.z);
+        }
+        g_valid |= PROPERTY_SEAT_POS;
+    }
+
+    static void EnsureHeadRot()
+    {
+        if (g_valid & PROPERTY_HEAD_ROT)
+        {
+            return;
+        }
+
+#ifdef SPF_CABINWALK_BULK_CAMERA_API
+        if (ReadMissingBulk())
+        {
+            return;
+        }
+#endif
+        if (g_ctx.cameraAPI)
+        {
+            g_ctx.cameraAPI->Cam_GetInteriorHeadRot(&g_yaw, &g_pitch);
+        }
+        g_valid |= PROPERTY_HEAD_ROT;
+        OnHeadRotRead();
+    }
+
+    // =================================================================================================
+    // Public Functions
+    // =================================================================================================
+
+    void BeginFrame()
+    {
+        Invalidate();
+    }
+
+    void Invalidate()
+    {
+        Flush();
+        g_valid = 0;
+    }
+
+    void Flush()
+    {
+        if (!g_dirty)
+        {
+            return;
+        }
+
+        if ((g_dirty & PROPERTY_HEAD_ROT) && g_wrap_yaw)
+        {
+            g_yaw = Animation::WrapAngle(g_yaw);
+        }
+
+        if (g_ctx.cameraAPI)
+        {
+#ifdef SPF_CABINWALK_BULK_CAMERA_API
+            if (g_ctx.cameraAPI->Cam_SetInteriorState)
+            {
+                SPF_InteriorCameraState_t state{};
+                state.seat_x = g_seat_pos.x;
+                state.seat_y = g_seat_pos.y;
+                state.seat_z = g_seat_pos.z;
+                state.yaw = g_yaw;
+                state.pitch = g_pitch;
+                g_ctx.cameraAPI->Cam_SetInteriorState(g_dirty, &state);
+                if (g_dirty & PROPERTY_SEAT_POS)
+                {
+                    Latency::OnSeatPosWritten();
+                }
+                g_dirty = 0;
+                return;
+            }
+#endif
+            if (g_dirty & PROPERTY_SEAT_POS)
+            {
+                g_ctx.cameraAPI->Cam_SetInteriorSeatPos(g_seat_pos.x, g_seat_pos.y, g_seat_pos.z);
+                Latency::OnSeatPosWritten();
+            }
+            if (g_dirty & PROPERTY_HEAD_ROT)
+            {
+                g_ctx.cameraAPI->Cam_SetInteriorHeadRot(g_yaw, g_pitch);
+            }
+        }
+
+        // The cache now mirrors what was written, so it stays valid for the rest of the frame.
+        g_dirty = 0;
+    }
+
+    SPF_FVector GetSeatPos()
+    {
+        EnsureSeatPos();
+        return g_seat_pos;
+    }
+
+    void GetHeadRot(float *yaw, float *pitch)
+    {
+        EnsureHeadRot();
+        *yaw = g_yaw;
+        *pitch = g_pitch;
+    }
+
+    Animation::CurrentCameraState GetState()
+    {
+        Animation::CurrentCameraState state;
+        state.position = GetSeatPos();
+        GetHeadRot(&state.rotation.x, &state.rotation.y);
+        state.rotation.z = 0.0f; // Roll is not retrieved
+        return state;
+    }
+
+    void SetSeatPos(float x, float y, float z)
+    {
+        g_seat_pos = {x, y, z};
+        g_valid |= PROPERTY_SEAT_POS;
+        g_dirty |= PROPERTY_SEAT_POS;
+    }
+
+    void SetHeadRot(float yaw, float pitch)
+    {
+        g_yaw = yaw;
+        g_pitch = pitch;
+        g_valid |= PROPERTY_HEAD_ROT;
+        g_dirty |= PROPERTY_HEAD_ROT;
+    }
+
+    void SetYawWrapEnabled(bool enabled)
+    {
+        g_wrap_yaw = enabled;
+    }
+
+} // namespace SPF_CabinWalk::CameraFacade
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <SPF_TelemetryData.h> // For SPF_FVector
+#include "Animation/AnimationSequence.hpp" // For CurrentCameraState
+
+namespace SPF_CabinWalk::CameraFacade
+{
+    /**
+     * @brief Starts a new frame: pending writes are flushed and cached reads are dropped.
+     * @details Called at the top of OnUpdate. Within a frame, the interior seat position and head
+     *          rotation are read from the framework at most once, however many modules ask for them.
+     */
+    void BeginFrame();
+
+    /**
+     * @brief Drops cached reads after something outside the plugin may have moved the camera.
+     * @details Pending writes are flushed first, so no value set by the plugin is lost. The camera
+     *          hook calls this after the game's own camera update has consumed mouse input.
+     */
+    void Invalidate();
+
+    /**
+     * @brief Writes the final value of every property set since the last flush, once each.
+     */
+    void Flush();
+
+    /**
+     * @brief Gets the interior seat position (cached for the rest of the frame).
+     */
+    SPF_FVector GetSeatPos();
+
+    /**
+     * @brief Gets the interior head rotation (cached for the rest of the frame).
+     * @param[out] yaw The head yaw in radians.
+     * @param[out] pitch The head pitch in radians.
+     */
+    void GetHeadRot(float *yaw, float *pitch);
+
+    /**
+     * @brief Gets the full camera state. Roll is always 0, as the framework does not expose it.
+     */
+    Animation::CurrentCameraState GetState();
+
+    /**
+     * @brief Sets the interior seat position. The value is written on the next flush.
+     */
+    void SetSeatPos(float x, float y, float z);
+
+    /**
+     * @brief Sets the interior head rotation. The value is written on the next flush.
+     */
+    void SetHeadRot(float yaw, float pitch);
+
+    /**
+     * @brief Enables or disables wrapping of the yaw into [-PI, PI] for free-look positions.
+     * @details When enabled, the yaw is wrapped as it is read and as it is flushed, instead of in a
+     *          separate read-modify-write round trip through the framework. A read that had to wrap
+     *          schedules the wrapped value for the next flush.
+     */
+    void SetYawWrapEnabled(bool enabled);
+
+} // namespace SPF_CabinWalk::CameraFacade
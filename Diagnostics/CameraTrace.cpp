@@ -0,0 +1,392 @@
+#include "Diagnostics/CameraTrace.hpp"
+#include "SPF_CabinWalk.hpp" // For g_ctx
+#include "Camera/CameraFacade.hpp"
+#include "Animation/AnimationController.hpp"
+#include "Animation/StandingAnimController.hpp"
+#include <cstring>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h> // For CreateFileMappingW and MapViewOfFile
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace SPF_CabinWalk::CameraTrace
+{
+    // =================================================================================================
+    // Internal State
+    // =================================================================================================
+
+    static const char G_TRACE_MAGIC[8] = "CWTRACE";
+    constexpr uint32_t G_TRACE_VERSION = 1;
+    constexpr size_t G_MAX_PATH = 260;
+
+    /**
+     * @brief A file mapped into memory in its entirety.
+     */
+    struct MappedFile
+    {
+        uint8_t *data = nullptr;
+        size_t size = 0;
+#ifdef _WIN32
+        HANDLE file = INVALID_HANDLE_VALUE;
+        HANDLE mapping = nullptr;
+#else
+        int fd = -1;
+#endif
+    };
+
+    static Mode g_mode = Mode::Off;
+    static char g_path[G_MAX_PATH] = {};
+    static uint32_t g_capacity = 0;
+    static MappedFile g_file;
+
+    // --- Replay cursor ---
+    static uint64_t g_replay_index = 0;   // Position in the chronological order of the ring.
+    static uint64_t g_replay_count = 0;   // Number of samples available.
+    static uint64_t g_replay_start_us = 0; // Simulation time at which playback started (0 = not started).
+
+    // =================================================================================================
+    // Internal Helpers
+    // =================================================================================================
+
+    static void Log(SPF_LogLevel level, const char *message)
+    {
+        if (g_ctx.loggerHandle)
+        {
+            g_ctx.loadAPI->logger->Log(g_ctx.loggerHandle, level, message);
+        }
+    }
+
+    static TraceHeader *Header()
+    {
+        return reinterpret_cast<TraceHeader *>(g_file.data);
+    }
+
+    static TraceSample *Samples()
+    {
+        return reinterpret_cast<TraceSample *>(g_file.data + sizeof(TraceHeader));
+    }
+
+    /**
+     * @brief Maps a file. For writing it is created (or truncated) with the given size; for reading the
+     *        existing size is used.
+     */
+    static bool Map(const char *path, bool writable, size_t size, MappedFile &out)
+    {
+#ifdef _WIN32
+        out.file = CreateFileA(path, writable ? (GENERIC_READ | GENERIC_WRITE) : GENERIC_READ, FILE_SHARE_READ, nullptr,
+                               writable ? CREATE_ALWAYS : OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (out.file == INVALID_HANDLE_VALUE)
+        {
+            return false;
+        }
+
+        if (!writable)
+        {
+            LARGE_INTEGER file_size;
+            if (!GetFileSizeEx(out.file, &file_size))
+            {
+                CloseHandle(out.file);
+                out.file = INVALID_HANDLE_VALUE;
+                return false;
+            }
+            size = static_cast<size_t>(file_size.QuadPart);
+        }
+
+        const uint64_t size64 = size;
+        out.mapping = CreateFileMappingW(out.file, nullptr, writable ? PAGE_READWRITE : PAGE_READONLY,
+                                         static_cast<DWORD>(size64 >> 32), static_cast<DWORD>(size64 & 0xFFFFFFFFu), nullptr);
+        if (!out.mapping)
+        {
+            CloseHandle(out.file);
+            out.file = INVALID_HANDLE_VALUE;
+            return false;
+        }
+
+        out.data = static_cast<uint8_t *>(MapViewOfFile(out.mapping, writable ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, size));
+        if (!out.data)
+        {
+            CloseHandle(out.mapping);
+            CloseHandle(out.file);
+            out.mapping = nullptr;
+            out.file = INVALID_HANDLE_VALUE;
+            return false;
+        }
+#else
+        out.fd = open(path, writable ? (O_RDWR | O_CREAT | O_TRUNC) : O_RDONLY, 0644);
+        if (out.fd < 0)
+        {
+            return false;
+        }
+
+        if (writable)
+        {
+            if (ftruncate(out.fd, static_cast<off_t>(size)) != 0)
+            {
+                close(out.fd);
+                out.fd = -1;
+                return false;
+            }
+        }
+        else
+        {
+            struct stat st;
+            if (fstat(out.fd, &st) != 0)
+            {
+                close(out.fd);
+                out.fd = -1;
+                return false;
+            }
+            size = static_cast<size_t>(st.st_size);
+        }
+
+        void *data = mmap(nullptr, size, writable ? (PROT_READ | PROT_WRITE) : PROT_READ, MAP_SHARED, out.fd, 0);
+        if (data == MAP_FAILED)
+        {
+            close(out.fd);
+            out.fd = -1;
+            return false;
+        }
+        out.data = static_cast<uint8_t *>(data);
+#endif
+        out.size = size;
+        return true;
+    }
+
+    static void Unmap(MappedFile &file)
+    {
+#ifdef _WIN32
+        if (file.data)
+        {
+            UnmapViewOfFile(file.data);
+        }
+        if (file.mapping)
+        {
+            CloseHandle(file.mapping);
+        }
+        if (file.file != INVALID_HANDLE_VALUE)
+        {
+            CloseHandle(file.file);
+        }
+#else
+        if (file.data)
+        {
+            munmap(file.data, file.size);
+        }
+        if (file.fd >= 0)
+        {
+            close(file.fd);
+        }
+#endif
+        file = MappedFile{};
+    }
+
+    static bool OpenForRecording(const char *path, uint32_t capacity)
+    {
+        if (capacity == 0 || !Map(path, true, sizeof(TraceHeader) + static_cast<size_t>(capacity) * sizeof(TraceSample), g_file))
+        {
+            return false;
+        }
+
+        TraceHeader *header = Header();
+        std::memcpy(header->magic, G_TRACE_MAGIC, sizeof(header->magic));
+        header->version = G_TRACE_VERSION;
+        header->sample_size = sizeof(TraceSample);
+        header->capacity = capacity;
+        header->reserved = 0;
+        header->write_count = 0;
+        return true;
+    }
+
+    static bool OpenForReplay(const char *path)
+    {
+        if (!Map(path, false, 0, g_file))
+        {
+            return false;
+        }
+
+        const TraceHeader *header = Header();
+        const bool valid = g_file.size >= sizeof(TraceHeader) &&
+                           std::memcmp(header->magic, G_TRACE_MAGIC, sizeof(header->magic)) == 0 &&
+                           header->version == G_TRACE_VERSION && header->sample_size == sizeof(TraceSample) &&
+                           header->capacity > 0 &&
+                           g_file.size >= sizeof(TraceHeader) + static_cast<size_t>(header->capacity) * sizeof(TraceSample);
+        if (!valid)
+        {
+            Unmap(g_file);
+            return false;
+        }
+
+        g_replay_count = (header->write_count < header->capacity) ? header->write_count : header->capacity;
+        g_replay_index = 0;
+        g_replay_start_us = 0;
+        return true;
+    }
+
+    // Returns the i-th oldest sample still held by the ring.
+    static const TraceSample &ReplaySample(uint64_t i)
+    {
+        const TraceHeader *header = Header();
+        const uint64_t oldest = (header->write_count > header->capacity) ? header->write_count - header->capacity : 0;
+        return Samples()[(oldest + i) % header->capacity];
+    }
+
+    static void RecordFrame(uint64_t timestamp_us)
+    {
+        TraceSample sample = {};
+        sample.timestamp_us = timestamp_us;
+
+        const SPF_FVector seat = CameraFacade::GetSeatPos();
+        sample.seat_pos[0] = seat.x;
+        sample.seat_pos[1] = seat.y;
+        sample.seat_pos[2] = seat.z;
+        CameraFacade::GetHeadRot(&sample.head_rot[0], &sample.head_rot[1]);
+
+        sample.position = static_cast<uint8_t>(AnimationController::GetCurrentPosition());
+        sample.stance = static_cast<uint8_t>(StandingAnimController::GetCurrentStance());
+
+        AnimationController::CameraPosition from = AnimationController::CameraPosition::None;
+        AnimationController::CameraPosition to = AnimationController::CameraPosition::None;
+        float progress = StandingAnimController::GetActiveProgress();
+        if (!AnimationController::GetActiveTransition(&from, &to, &progress) && progress >= 0.0f)
+        {
+            from = to = AnimationController::CameraPosition::Standing; // A stance or walk animation.
+        }
+        sample.sequence_from = static_cast<uint8_t>(from);
+        sample.sequence_to = static_cast<uint8_t>(to);
+        sample.sequence_progress = progress;
+
+        // A plain store into the mapping; the OS writes the pages back lazily, so the frame never waits on I/O.
+        TraceHeader *header = Header();
+        Samples()[header->write_count % header->capacity] = sample;
+        header->write_count = header->write_count + 1;
+    }
+
+    static void ReplayFrame(uint64_t timestamp_us)
+    {
+        if (g_replay_count == 0)
+        {
+            Log(SPF_LOG_INFO, "[CameraTrace] The trace holds no samples; nothing to replay.");
+            Stop();
+            return;
+        }
+
+        // Keep the recorded pacing: show the newest sample due at the current time. A frame faster than
+        // the recording shows the same sample again rather than running ahead of it.
+        if (g_replay_start_us == 0)
+        {
+            g_replay_start_us = timestamp_us;
+        }
+        const uint64_t due = ReplaySample(0).timestamp_us + (timestamp_us - g_replay_start_us);
+        while (g_replay_index + 1 < g_replay_count && ReplaySample(g_replay_index + 1).timestamp_us <= due)
+        {
+            ++g_replay_index;
+        }
+
+        const TraceSample &sample = ReplaySample(g_replay_index);
+        CameraFacade::SetSeatPos(sample.seat_pos[0], sample.seat_pos[1], sample.seat_pos[2]);
+        CameraFacade::SetHeadRot(sample.head_rot[0], sample.head_rot[1]);
+
+        if (g_replay_index + 1 >= g_replay_count)
+        {
+            Log(SPF_LOG_INFO, "[CameraTrace] Replay finished.");
+            Stop();
+        }
+    }
+
+    // =================================================================================================
+    // Public Functions
+    // =================================================================================================
+
+    void Configure(Mode mode, const char *path, uint32_t capacity)
+    {
+        if (!path)
+        {
+            path = "";
+        }
+
+        if (mode != Mode::Off && mode != Mode::Record && mode != Mode::Replay)
+        {
+            if (g_ctx.loggerHandle && g_ctx.formattingAPI)
+            {
+                char log_buffer[128];
+                g_ctx.formattingAPI->Fmt_Format(log_buffer, sizeof(log_buffer), "[CameraTrace] Ignoring unknown trace mode %d.", static_cast<int>(mode));
+                Log(SPF_LOG_ERROR, log_buffer);
+            }
+            return;
+        }
+
+        if (mode == g_mode && capacity == g_capacity && std::strncmp(path, g_path, G_MAX_PATH) == 0)
+        {
+            return;
+        }
+
+        Stop();
+        std::strncpy(g_path, path, G_MAX_PATH - 1);
+        g_path[G_MAX_PATH - 1] = '\0';
+        g_capacity = capacity;
+
+        if (mode == Mode::Off)
+        {
+            return;
+        }
+
+        const bool opened = (mode == Mode::Record) ? OpenForRecording(g_path, capacity) : OpenForReplay(g_path);
+        if (!opened)
+        {
+            if (g_ctx.loggerHandle && g_ctx.formattingAPI)
+            {
+                char log_buffer[512];
+                g_ctx.formattingAPI->Fmt_Format(log_buffer, sizeof(log_buffer), "[CameraTrace] Could not open '%s' for %s.", g_path, mode == Mode::Record ? "recording" : "replay");
+                Log(SPF_LOG_ERROR, log_buffer);
+            }
+            return;
+        }
+
+        g_mode = mode;
+        if (g_ctx.loggerHandle && g_ctx.formattingAPI)
+        {
+            char log_buffer[512];
+            g_ctx.formattingAPI->Fmt_Format(log_buffer, sizeof(log_buffer), "[CameraTrace] %s '%s'.", mode == Mode::Record ? "Recording to" : "Replaying", g_path);
+            Log(SPF_LOG_INFO, log_buffer);
+        }
+    }
+
+    void OnFrame(uint64_t timestamp_us)
+    {
+        switch (g_mode)
+        {
+        case Mode::Record:
+            RecordFrame(timestamp_us);
+            break;
+        case Mode::Replay:
+            ReplayFrame(timestamp_us);
+            break;
+        case Mode::Off:
+        default:
+            break;
+        }
+    }
+
+    void Stop()
+    {
+        Unmap(g_file);
+        g_mode = Mode::Off;
+        g_replay_index = 0;
+        g_replay_count = 0;
+        g_replay_start_us = 0;
+    }
+
+    Mode GetMode()
+    {
+        return g_mode;
+    }
+
+} // namespace SPF_CabinWalk::CameraTrace
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstdint>
+
+namespace SPF_CabinWalk::CameraTrace
+{
+    /**
+     * @brief What the trace module does each frame. Matches `settings.diagnostics.trace_mode`.
+     */
+    enum class Mode : int32_t
+    {
+        Off = 0,
+        Record = 1, // Append one sample per frame to the ring file.
+        Replay = 2  // Play a recorded ring file back through the camera facade.
+    };
+
+    /**
+     * @brief The header at the start of a trace file.
+     * @details The samples follow directly after it. The file is a ring: it holds the last
+     *          min(write_count, capacity) samples, the oldest at index write_count % capacity.
+     */
+    struct TraceHeader
+    {
+        char magic[8];        // "CWTRACE"
+        uint32_t version;
+        uint32_t sample_size; // sizeof(TraceSample) of the writer
+        uint32_t capacity;    // Number of sample slots in the file.
+        uint32_t reserved;
+        uint64_t write_count; // Total number of samples ever written.
+    };
+
+    /**
+     * @brief One frame of camera state.
+     */
+    struct TraceSample
+    {
+        uint64_t timestamp_us;   // Simulation timestamp.
+        float seat_pos[3];       // Applied interior seat position.
+        float head_rot[2];       // Applied head yaw and pitch.
+        float sequence_progress; // Progress of the playing sequence, or negative if none.
+        uint8_t position;        // AnimationController::CameraPosition
+        uint8_t stance;          // StandingAnimController::Stance
+        uint8_t sequence_from;   // Transition start position; equal to `sequence_to` for stance/walk animations.
+        uint8_t sequence_to;     // Transition target position; CameraPosition::None if nothing plays.
+        uint32_t reserved;
+    };
+
+    /**
+     * @brief Switches to a mode, (re)opening the trace file if the mode, path or capacity changed.
+     * @param mode The mode to run in.
+     * @param path The trace file.
+     * @param capacity The number of samples the ring holds when recording.
+     */
+    void Configure(Mode mode, const char *path, uint32_t capacity);
+
+    /**
+     * @brief Records or replays one frame. Called from OnUpdate after the animation controllers have run
+     *        and before the camera facade is flushed.
+     * @param timestamp_us The current simulation timestamp.
+     */
+    void OnFrame(uint64_t timestamp_us);
+
+    /**
+     * @brief Closes the trace file. Samples already written stay in it.
+     */
+    void Stop();
+
+    /**
+     * @brief Gets the mode that is currently active (Off if opening the file failed).
+     */
+    Mode GetMode();
+
+} // namespace SPF_CabinWalk::CameraTrace
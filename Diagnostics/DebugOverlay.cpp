@@ -0,0 +1,305 @@
+#include "Diagnostics/DebugOverlay.hpp"
+#include "SPF_CabinWalk.hpp" // For g_ctx.formattingAPI
+#include <cstring>
+
+namespace SPF_CabinWalk::DebugOverlay
+{
+    namespace Detail
+    {
+        std::atomic<bool> g_enabled{false};
+    }
+
+    namespace
+    {
+        /**
+         * @brief Everything the overlay draws, handed from the game thread to the UI in one piece.
+         */
+        struct Snapshot
+        {
+            // --- Transition ---
+            bool has_transition = false;
+            int32_t from = 0;
+            int32_t to = 0;
+            float progress = 0.0f;
+            uint64_t duration_us = 0;
+            bool channel_used[Animation::CHANNEL_COUNT] = {};
+            float curve_min[Animation::CHANNEL_COUNT] = {};
+            float curve_max[Animation::CHANNEL_COUNT] = {};
+            float curve[Animation::CHANNEL_COUNT][CURVE_SAMPLES] = {};
+
+            // --- Standing ---
+            bool has_standing = false;
+            StandingState standing = {};
+        };
+
+        const char *const CHANNEL_NAMES[] = {"pos x", "pos y", "pos z", "yaw", "pitch", "roll"};
+        static_assert(sizeof(CHANNEL_NAMES) / sizeof(CHANNEL_NAMES[0]) == Animation::CHANNEL_COUNT, "Every channel needs a name");
+
+        const char *const POSITION_NAMES[] = {"Driver", "Passenger", "Standing", "Bed", "SofaSit1", "SofaLie", "SofaSit2", "None"};
+
+        const char *const STANCE_NAMES[] = {"Standing", "Crouching", "Tiptoes", "InTransition", "WalkingToFinalDestination"};
+
+        // --- Writer side (game thread) ---
+        Snapshot g_staging;
+        const Animation::AnimationSequence *g_curve_source = nullptr; // Sequence the staged curves belong to.
+        float g_curve_source_progress = 0.0f;
+
+        // --- Seqlock: odd while the writer is copying into g_shared ---
+        std::atomic<uint32_t> g_sequence{0};
+        Snapshot g_shared;
+
+        // --- Reader side (UI) ---
+        Snapshot g_view;
+
+        const char *NameOf(const char *const *names, size_t count, int32_t index)
+        {
+            return (index >= 0 && static_cast<size_t>(index) < count) ? names[index] : "?";
+        }
+
+        void SampleCurves(const Animation::AnimationSequence &sequence)
+        {
+            for (size_t channel = 0; channel < Animation::CHANNEL_COUNT; ++channel)
+            {
+                // Copy the view, so sampling does not move the playing track's cursor.
+                Animation::Track<float> track = sequence.GetTrack(static_cast<Animation::Channel>(channel));
+                g_staging.channel_used[channel] = !track.IsEmpty();
+                if (track.IsEmpty())
+                {
+                    continue;
+                }
+
+                float lo = 0.0f;
+                float hi = 0.0f;
+                for (uint32_t i = 0; i < CURVE_SAMPLES; ++i)
+                {
+                    const float value = track.Evaluate(static_cast<float>(i) / static_cast<float>(CURVE_SAMPLES - 1), 0.0f);
+                    g_staging.curve[channel][i] = value;
+                    lo = (i == 0 || value < lo) ? value : lo;
+                    hi = (i == 0 || value > hi) ? value : hi;
+                }
+                g_staging.curve_min[channel] = lo;
+                g_staging.curve_max[channel] = hi;
+            }
+        }
+
+        // Copies the latest consistent snapshot into g_view. Keeps the previous view if the writer was busy.
+        void ReadSnapshot()
+        {
+            for (int attempt = 0; attempt < 4; ++attempt)
+            {
+                const uint32_t before = g_sequence.load(std::memory_order_acquire);
+                if (before & 1u)
+                {
+                    continue;
+                }
+
+                Snapshot copy;
+                std::memcpy(&copy, &g_shared, sizeof(Snapshot));
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (g_sequence.load(std::memory_order_relaxed) == before)
+                {
+                    g_view = copy;
+                    return;
+                }
+            }
+        }
+
+        void DrawCurves(SPF_UI_API *ui, SPF_DrawList_Handle draw_list, float width)
+        {
+            constexpr float ROW_HEIGHT = 28.0f;
+            constexpr float LABEL_WIDTH = 48.0f;
+            const float height = ROW_HEIGHT * Animation::CHANNEL_COUNT;
+
+            float x0, y0;
+            ui->UI_GetCursorScreenPos(&x0, &y0);
+            ui->UI_InvisibleButton("##curves", width, height);
+
+            const uint32_t frame_color = ui->UI_ColorConvertFloat4ToU32(0.4f, 0.4f, 0.4f, 1.0f);
+            const uint32_t curve_color = ui->UI_ColorConvertFloat4ToU32(0.3f, 0.8f, 1.0f, 1.0f);
+            const uint32_t cursor_color = ui->UI_ColorConvertFloat4ToU32(1.0f, 0.8f, 0.2f, 1.0f);
+            const uint32_t text_color = ui->UI_ColorConvertFloat4ToU32(0.8f, 0.8f, 0.8f, 1.0f);
+
+            const float plot_x = x0 + LABEL_WIDTH;
+            const float plot_w = width - LABEL_WIDTH;
+            float points_x[CURVE_SAMPLES];
+            float points_y[CURVE_SAMPLES];
+
+            for (size_t channel = 0; channel < Animation::CHANNEL_COUNT; ++channel)
+            {
+                const float top = y0 + ROW_HEIGHT * static_cast<float>(channel);
+                const float bottom = top + ROW_HEIGHT - 4.0f;
+                ui->UI_DrawList_AddText(draw_list, x0, top + 6.0f, text_color, CHANNEL_NAMES[channel]);
+                ui->UI_DrawList_AddRect(draw_list, plot_x, top, plot_x + plot_w, bottom, frame_color, 0.0f, 1.0f);
+                if (!g_view.channel_used[channel])
+                {
+                    continue;
+                }
+
+                // Each channel is scaled to its own range; a flat channel is drawn through the middle.
+                const float range = g_view.curve_max[channel] - g_view.curve_min[channel];
+                for (uint32_t i = 0; i < CURVE_SAMPLES; ++i)
+                {
+                    const float t = range > 1e-6f ? (g_view.curve[channel][i] - g_view.curve_min[channel]) / range : 0.5f;
+                    points_x[i] = plot_x + plot_w * static_cast<float>(i) / static_cast<float>(CURVE_SAMPLES - 1);
+                    points_y[i] = bottom - 2.0f - t * (bottom - top - 4.0f);
+                }
+                ui->UI_DrawList_AddPolyline(draw_list, points_x, points_y, static_cast<int>(CURVE_SAMPLES), curve_color, false, 1.5f);
+            }
+
+            const float cursor_x = plot_x + plot_w * g_view.progress;
+            ui->UI_DrawList_AddLine(draw_list, cursor_x, y0, cursor_x, y0 + height, cursor_color, 1.0f);
+        }
+
+        void DrawWalkZone(SPF_UI_API *ui, SPF_DrawList_Handle draw_list, float width)
+        {
+            constexpr float BAR_HEIGHT = 18.0f;
+            const StandingState &s = g_view.standing;
+
+            float x0, y0;
+            ui->UI_GetCursorScreenPos(&x0, &y0);
+            ui->UI_InvisibleButton("##walk_zone", width, BAR_HEIGHT);
+
+            // Scale to the zone plus a margin, widened to include the current Z.
+            float lo = s.walk_zone_min < s.z ? s.walk_zone_min : s.z;
+            float hi = s.walk_zone_max > s.z ? s.walk_zone_max : s.z;
+            lo -= 0.1f;
+            hi += 0.1f;
+            const float scale = width / (hi - lo);
+
+            const uint32_t frame_color = ui->UI_ColorConvertFloat4ToU32(0.4f, 0.4f, 0.4f, 1.0f);
+            const uint32_t zone_color = ui->UI_ColorConvertFloat4ToU32(0.2f, 0.6f, 0.2f, 0.6f);
+            const uint32_t marker_color = ui->UI_ColorConvertFloat4ToU32(1.0f, 0.8f, 0.2f, 1.0f);
+
+            ui->UI_DrawList_AddRect(draw_list, x0, y0, x0 + width, y0 + BAR_HEIGHT, frame_color, 0.0f, 1.0f);
+            ui->UI_DrawList_AddRectFilled(draw_list, x0 + (s.walk_zone_min - lo) * scale, y0 + 2.0f,
+                                          x0 + (s.walk_zone_max - lo) * scale, y0 + BAR_HEIGHT - 2.0f, zone_color, 0.0f);
+            ui->UI_DrawList_AddCircleFilled(draw_list, x0 + (s.z - lo) * scale, y0 + BAR_HEIGHT * 0.5f, 5.0f, marker_color, 12);
+        }
+
+        void DrawTimer(SPF_UI_API *ui, const char *name, uint64_t elapsed_us, int32_t hold_time_ms, float width)
+        {
+            // Same comparison as the stance trigger, so a full bar is the frame the stance changes.
+            const float fraction = hold_time_ms > 0 ? static_cast<float>(elapsed_us) / (static_cast<float>(hold_time_ms) * 1000.0f) : 1.0f;
+
+            char label[64];
+            g_ctx.formattingAPI->Fmt_Format(label, sizeof(label), "%s %3.0f%%", name, (fraction < 1.0f ? fraction : 1.0f) * 100.0);
+            ui->UI_ProgressBar(fraction < 1.0f ? fraction : 1.0f, width, 0.0f, label);
+        }
+    } // namespace
+
+    void SetEnabled(bool enabled)
+    {
+        if (!enabled)
+        {
+            g_curve_source = nullptr; // Resample when the overlay opens again.
+        }
+        Detail::g_enabled.store(enabled, std::memory_order_relaxed);
+    }
+
+    void PublishTransition(const Animation::AnimationSequence *sequence, int32_t from, int32_t to)
+    {
+        if (!sequence)
+        {
+            g_staging.has_transition = false;
+            g_curve_source = nullptr;
+            return;
+        }
+
+        const float progress = sequence->GetProgress();
+
+        // Baked sequences are reused for every play, so a restart shows up as progress going back.
+        if (sequence != g_curve_source || progress < g_curve_source_progress)
+        {
+            SampleCurves(*sequence);
+            g_curve_source = sequence;
+        }
+        g_curve_source_progress = progress;
+
+        g_staging.has_transition = true;
+        g_staging.from = from;
+        g_staging.to = to;
+        g_staging.progress = progress;
+        g_staging.duration_us = sequence->GetDuration();
+    }
+
+    void PublishStanding(const StandingState &state)
+    {
+        g_staging.has_standing = true;
+        g_staging.standing = state;
+    }
+
+    void EndFrame()
+    {
+        if (!IsEnabled())
+        {
+            return;
+        }
+
+        const uint32_t sequence = g_sequence.load(std::memory_order_relaxed);
+        g_sequence.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        std::memcpy(&g_shared, &g_staging, sizeof(Snapshot));
+        g_sequence.store(sequence + 2, std::memory_order_release);
+
+        // Every frame publishes afresh; what is not published again is no longer active.
+        g_staging.has_transition = false;
+        g_staging.has_standing = false;
+    }
+
+    void Draw(SPF_UI_API *ui)
+    {
+        if (!ui || !g_ctx.formattingAPI)
+        {
+            return;
+        }
+
+        ReadSnapshot();
+
+        float width, height;
+        ui->UI_GetContentRegionAvail(&width, &height);
+        SPF_DrawList_Handle draw_list = ui->UI_GetWindowDrawList();
+        char line[160];
+
+        // --- Transition ---
+        if (g_view.has_transition)
+        {
+            g_ctx.formattingAPI->Fmt_Format(line, sizeof(line), "%s -> %s   %3.0f%% of %.2f s",
+                NameOf(POSITION_NAMES, sizeof(POSITION_NAMES) / sizeof(POSITION_NAMES[0]), g_view.from),
+                NameOf(POSITION_NAMES, sizeof(POSITION_NAMES) / sizeof(POSITION_NAMES[0]), g_view.to),
+                g_view.progress * 100.0, g_view.duration_us / 1000000.0);
+            ui->UI_Text(line);
+        }
+        else
+        {
+            ui->UI_TextDisabled("No transition playing (curves of the last one)");
+        }
+        if (draw_list)
+        {
+            DrawCurves(ui, draw_list, width);
+        }
+
+        ui->UI_Separator();
+
+        // --- Standing ---
+        if (!g_view.has_standing)
+        {
+            ui->UI_TextDisabled("Not standing");
+            return;
+        }
+
+        const StandingState &s = g_view.standing;
+        g_ctx.formattingAPI->Fmt_Format(line, sizeof(line), "Stance: %s   Z %.3f   walk zone [%.2f, %.2f]",
+            NameOf(STANCE_NAMES, sizeof(STANCE_NAMES) / sizeof(STANCE_NAMES[0]), s.stance), s.z, s.walk_zone_min, s.walk_zone_max);
+        ui->UI_Text(line);
+        if (draw_list)
+        {
+            DrawWalkZone(ui, draw_list, width);
+        }
+
+        DrawTimer(ui, "crouch", s.crouch_time_us, s.hold_time_ms, width);
+        DrawTimer(ui, "tiptoe", s.tiptoe_time_us, s.hold_time_ms, width);
+        DrawTimer(ui, "stand up", s.standup_time_us, s.hold_time_ms, width);
+        DrawTimer(ui, "stand down", s.standdown_time_us, s.hold_time_ms, width);
+    }
+
+} // namespace SPF_CabinWalk::DebugOverlay
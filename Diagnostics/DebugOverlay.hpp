@@ -0,0 +1,73 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <SPF_UI_API.h>
+#include "Animation/AnimationSequence.hpp" // For AnimationSequence, CHANNEL_COUNT
+
+namespace SPF_CabinWalk::DebugOverlay
+{
+    // Points per plotted channel curve.
+    constexpr uint32_t CURVE_SAMPLES = 64;
+
+    /**
+     * @brief The standing controller's state, as published by StandingAnimController::Tick.
+     */
+    struct StandingState
+    {
+        float z;                 // Current seat Z.
+        float walk_zone_min;     // settings.standing_movement.walking.walk_zone_z.min
+        float walk_zone_max;     // settings.standing_movement.walking.walk_zone_z.max
+        uint64_t crouch_time_us; // Time the pitch has held the crouch zone; the stance changes at hold_time_ms.
+        uint64_t tiptoe_time_us;
+        uint64_t standup_time_us;
+        uint64_t standdown_time_us;
+        int32_t hold_time_ms;    // settings.standing_movement.stance_control.hold_time_ms
+        int32_t stance;          // StandingAnimController::Stance
+    };
+
+    /**
+     * @brief Enables or disables publishing. While disabled, every publish site costs a single relaxed load.
+     * @details Called once per frame with the visibility of the overlay window.
+     */
+    void SetEnabled(bool enabled);
+
+    /**
+     * @brief Checks whether publishing is enabled.
+     */
+    inline bool IsEnabled();
+
+    /**
+     * @brief Publishes the playing transition for this frame, or nullptr if none is playing.
+     * @details The channel curves are sampled only when a new sequence starts, not every frame.
+     */
+    void PublishTransition(const Animation::AnimationSequence *sequence, int32_t from, int32_t to);
+
+    /**
+     * @brief Publishes the standing controller's state for this frame.
+     */
+    void PublishStanding(const StandingState &state);
+
+    /**
+     * @brief Makes everything published this frame visible to the overlay. Called once at the end of OnUpdate.
+     * @details The snapshot is handed over through a seqlock, so the writer never waits for the reader.
+     */
+    void EndFrame();
+
+    /**
+     * @brief Draws the curves, playback cursor, walk zone and stance timers into the current window.
+     */
+    void Draw(SPF_UI_API *ui);
+
+    // Defined inline so that the disabled check at every publish site is just a load.
+    namespace Detail
+    {
+        extern std::atomic<bool> g_enabled;
+    }
+
+    inline bool IsEnabled()
+    {
+        return Detail::g_enabled.load(std::memory_order_relaxed);
+    }
+
+} // namespace SPF_CabinWalk::DebugOverlay
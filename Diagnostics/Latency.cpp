@@ -0,0 +1,180 @@
+#include "Diagnostics/Latency.hpp"
+#include "Input/InputQueue.hpp" // For NowMicroseconds
+#include "SPF_CabinWalk.hpp"    // For g_ctx
+#include <algorithm>
+
+namespace SPF_CabinWalk::Latency
+{
+    namespace Detail
+    {
+        std::atomic<uint32_t> g_armed{0};
+    }
+
+    namespace
+    {
+        constexpr size_t METRIC_COUNT = static_cast<size_t>(Metric::Count);
+
+        struct MetricData
+        {
+            std::atomic<uint64_t> start_us{0};
+            std::atomic<uint64_t> total{0};      // Samples since the last reset; also the next window slot.
+            std::atomic<uint64_t> logged{0};     // `total` when last logged.
+            std::atomic<uint32_t> last_us{0};
+            std::atomic<uint32_t> window[WINDOW] = {};
+        };
+
+        MetricData g_metrics[METRIC_COUNT];
+
+        const char *const METRIC_NAMES[] = {
+            "Passenger seat",
+            "Driver seat",
+            "Standing",
+            "Sofa",
+            "Walk",
+            "Chain gap",
+        };
+        static_assert(sizeof(METRIC_NAMES) / sizeof(METRIC_NAMES[0]) == METRIC_COUNT, "Every metric needs a name");
+
+        void Record(MetricData &data, uint64_t elapsed_us)
+        {
+            const uint32_t sample = elapsed_us < UINT32_MAX ? static_cast<uint32_t>(elapsed_us) : UINT32_MAX;
+            const uint64_t index = data.total.load(std::memory_order_relaxed);
+            data.window[index % WINDOW].store(sample, std::memory_order_relaxed);
+            data.last_us.store(sample, std::memory_order_relaxed);
+            data.total.store(index + 1, std::memory_order_release);
+        }
+
+        uint32_t Percentile(const uint32_t *sorted, uint32_t count, uint32_t percent)
+        {
+            // Nearest rank.
+            const uint32_t rank = (count * percent + 99) / 100;
+            return sorted[rank > 0 ? rank - 1 : 0];
+        }
+    } // namespace
+
+    void Detail::Finish()
+    {
+        const uint32_t armed = g_armed.exchange(0, std::memory_order_acq_rel);
+        if (armed == 0)
+        {
+            return;
+        }
+
+        const uint64_t now = InputQueue::NowMicroseconds();
+        for (size_t i = 0; i < METRIC_COUNT; ++i)
+        {
+            if (armed & (1u << i))
+            {
+                MetricData &data = g_metrics[i];
+                const uint64_t start = data.start_us.load(std::memory_order_relaxed);
+                Record(data, now > start ? now - start : 0);
+            }
+        }
+    }
+
+    void Arm(Metric metric, uint64_t start_us)
+    {
+        g_metrics[static_cast<size_t>(metric)].start_us.store(start_us, std::memory_order_relaxed);
+        Detail::g_armed.fetch_or(1u << static_cast<uint32_t>(metric), std::memory_order_release);
+    }
+
+    Stats GetStats(Metric metric)
+    {
+        const MetricData &data = g_metrics[static_cast<size_t>(metric)];
+
+        Stats stats = {};
+        stats.total = data.total.load(std::memory_order_acquire);
+        stats.samples = stats.total < WINDOW ? static_cast<uint32_t>(stats.total) : WINDOW;
+        if (stats.samples == 0)
+        {
+            return stats;
+        }
+
+        uint32_t sorted[WINDOW];
+        for (uint32_t i = 0; i < stats.samples; ++i)
+        {
+            sorted[i] = data.window[i].load(std::memory_order_relaxed);
+        }
+        std::sort(sorted, sorted + stats.samples);
+
+        stats.last_us = data.last_us.load(std::memory_order_relaxed);
+        stats.p50_us = Percentile(sorted, stats.samples, 50);
+        stats.p90_us = Percentile(sorted, stats.samples, 90);
+        stats.p99_us = Percentile(sorted, stats.samples, 99);
+        stats.max_us = sorted[stats.samples - 1];
+        return stats;
+    }
+
+    void LogNewSamples()
+    {
+        for (size_t i = 0; i < METRIC_COUNT; ++i)
+        {
+            MetricData &data = g_metrics[i];
+            const uint64_t total = data.total.load(std::memory_order_acquire);
+            if (total == data.logged.load(std::memory_order_relaxed))
+            {
+                continue;
+            }
+            data.logged.store(total, std::memory_order_relaxed);
+
+            if (!g_ctx.loggerHandle || !g_ctx.formattingAPI)
+            {
+                continue;
+            }
+
+            const Stats stats = GetStats(static_cast<Metric>(i));
+            char log_buffer[192];
+            g_ctx.formattingAPI->Fmt_Format(log_buffer, sizeof(log_buffer),
+                "[Latency] %s: %.1f ms (p50 %.1f, p90 %.1f, p99 %.1f, max %.1f ms over %u)", METRIC_NAMES[i],
+                stats.last_us / 1000.0, stats.p50_us / 1000.0, stats.p90_us / 1000.0, stats.p99_us / 1000.0,
+                stats.max_us / 1000.0, stats.samples);
+            g_ctx.loadAPI->logger->Log(g_ctx.loggerHandle, SPF_LOG_INFO, log_buffer);
+        }
+    }
+
+    void Reset()
+    {
+        Detail::g_armed.store(0, std::memory_order_relaxed);
+        for (MetricData &data : g_metrics)
+        {
+            data.total.store(0, std::memory_order_relaxed);
+            data.logged.store(0, std::memory_order_relaxed);
+            data.last_us.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    void Draw(SPF_UI_API *ui)
+    {
+        if (!ui || !g_ctx.formattingAPI)
+        {
+            return;
+        }
+
+        ui->UI_Text("latency (to first seat write)    samples   last ms    p50 ms    p90 ms    p99 ms    max ms");
+        ui->UI_Separator();
+
+        char line[192];
+        for (size_t i = 0; i < METRIC_COUNT; ++i)
+        {
+            const Stats stats = GetStats(static_cast<Metric>(i));
+            if (stats.samples == 0)
+            {
+                g_ctx.formattingAPI->Fmt_Format(line, sizeof(line), "%-32s %7s", METRIC_NAMES[i], "-");
+                ui->UI_TextDisabled(line);
+                continue;
+            }
+
+            g_ctx.formattingAPI->Fmt_Format(line, sizeof(line), "%-32s %7u %9.1f %9.1f %9.1f %9.1f %9.1f",
+                METRIC_NAMES[i], stats.samples, stats.last_us / 1000.0, stats.p50_us / 1000.0,
+                stats.p90_us / 1000.0, stats.p99_us / 1000.0, stats.max_us / 1000.0);
+            ui->UI_Text(line);
+        }
+
+        ui->UI_Separator();
+        if (ui->UI_SmallButton("Reset latency"))
+        {
+            Reset();
+        }
+    }
+
+} // namespace SPF_CabinWalk::Latency
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <SPF_UI_API.h>
+
+namespace SPF_CabinWalk::Latency
+{
+    /**
+     * @brief The measured waits. All but ChainGap run from a keybind to the first seat write of the motion it starts.
+     */
+    enum class Metric : uint8_t
+    {
+        PassengerSeat,
+        DriverSeat,
+        Standing,
+        Sofa,
+        Walk,     // Walk toggle to the first step.
+        ChainGap, // End of one leg of a route to the first seat write of the next.
+        Count
+    };
+
+    // Percentiles are taken over this many most recent samples per metric.
+    constexpr uint32_t WINDOW = 128;
+
+    /**
+     * @brief Rolling statistics of one metric over its window.
+     */
+    struct Stats
+    {
+        uint32_t samples;  // In the window.
+        uint64_t total;    // Since the last reset.
+        uint32_t last_us;
+        uint32_t p50_us;
+        uint32_t p90_us;
+        uint32_t p99_us;
+        uint32_t max_us;
+    };
+
+    /**
+     * @brief Starts a measurement; the next seat write ends it.
+     * @param metric What is measured. A later Arm() of the same metric replaces an unfinished one.
+     * @param start_us When the wait began, on the InputQueue::NowMicroseconds() clock.
+     */
+    void Arm(Metric metric, uint64_t start_us);
+
+    /**
+     * @brief Ends every armed measurement. Called by CameraFacade right after Cam_SetInteriorSeatPos.
+     */
+    inline void OnSeatPosWritten();
+
+    /**
+     * @brief Logs the statistics of every metric that has new samples. Called once per frame from OnUpdate.
+     */
+    void LogNewSamples();
+
+    /**
+     * @brief Computes a metric's statistics.
+     */
+    Stats GetStats(Metric metric);
+
+    /**
+     * @brief Clears every metric.
+     */
+    void Reset();
+
+    /**
+     * @brief Draws the latency table into the current window, below the profiler zones.
+     */
+    void Draw(SPF_UI_API *ui);
+
+    namespace Detail
+    {
+        extern std::atomic<uint32_t> g_armed; // One bit per Metric.
+        void Finish();
+    }
+
+    // Defined inline so that a seat write with nothing armed costs one load.
+    inline void OnSeatPosWritten()
+    {
+        if (Detail::g_armed.load(std::memory_order_relaxed) != 0)
+        {
+            Detail::Finish();
+        }
+    }
+
+} // namespace SPF_CabinWalk::Latency
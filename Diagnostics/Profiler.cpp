@@ -0,0 +1,215 @@
+#include "Diagnostics/Profiler.hpp"
+#include "SPF_CabinWalk.hpp" // For g_ctx.formattingAPI
+#include <bit>
+
+namespace SPF_CabinWalk::Profiler
+{
+    namespace Detail
+    {
+        std::atomic<bool> g_enabled{false};
+    }
+
+    namespace
+    {
+        // Log-linear histogram: four buckets per power of two, up to 2^36 ns (about 68 s).
+        constexpr uint32_t MAX_OCTAVE = 36;
+        constexpr uint32_t BUCKET_COUNT = (MAX_OCTAVE + 1) * 4;
+
+        struct ZoneData
+        {
+            std::atomic<uint64_t> calls{0};
+            std::atomic<uint64_t> total_ns{0};
+            std::atomic<uint64_t> min_ns{UINT64_MAX};
+            std::atomic<uint64_t> max_ns{0};
+            std::atomic<uint32_t> calls_this_frame{0};
+            std::atomic<uint32_t> calls_last_frame{0};
+            std::atomic<uint32_t> max_calls_per_frame{0};
+            std::atomic<uint32_t> buckets[BUCKET_COUNT] = {};
+        };
+
+        ZoneData g_zones[static_cast<size_t>(Zone::Count)];
+
+        const char *const ZONE_NAMES[] = {
+            "OnUpdate",
+            "AnimationController::Update",
+            "AnimationScheduler::Update",
+            "Detour_UpdateCameraFromInput",
+            "AcquireTransitionSequence",
+            "SequenceBuilder::Build",
+        };
+        static_assert(sizeof(ZONE_NAMES) / sizeof(ZONE_NAMES[0]) == static_cast<size_t>(Zone::Count), "Every zone needs a name");
+
+        uint32_t BucketIndex(uint64_t ns)
+        {
+            if (ns < 4)
+            {
+                return static_cast<uint32_t>(ns);
+            }
+
+            uint32_t octave = 63 - static_cast<uint32_t>(std::countl_zero(ns));
+            if (octave > MAX_OCTAVE)
+            {
+                return BUCKET_COUNT - 1;
+            }
+            const uint32_t sub = static_cast<uint32_t>(ns >> (octave - 2)) & 3;
+            return octave * 4 + sub;
+        }
+
+        uint64_t BucketUpperBound(uint32_t index)
+        {
+            if (index < 4)
+            {
+                return index;
+            }
+
+            const uint32_t octave = index / 4;
+            const uint32_t sub = index % 4;
+            return ((static_cast<uint64_t>(4 + sub + 1)) << (octave - 2)) - 1;
+        }
+
+        template <typename T>
+        void AtomicMin(std::atomic<T> &target, T value)
+        {
+            T current = target.load(std::memory_order_relaxed);
+            while (value < current && !target.compare_exchange_weak(current, value, std::memory_order_relaxed))
+            {
+            }
+        }
+
+        template <typename T>
+        void AtomicMax(std::atomic<T> &target, T value)
+        {
+            T current = target.load(std::memory_order_relaxed);
+            while (value > current && !target.compare_exchange_weak(current, value, std::memory_order_relaxed))
+            {
+            }
+        }
+    } // namespace
+
+    void SetEnabled(bool enabled)
+    {
+        Detail::g_enabled.store(enabled, std::memory_order_relaxed);
+    }
+
+    void Record(Zone zone, uint64_t duration_ns)
+    {
+        ZoneData &data = g_zones[static_cast<size_t>(zone)];
+        data.calls.fetch_add(1, std::memory_order_relaxed);
+        data.total_ns.fetch_add(duration_ns, std::memory_order_relaxed);
+        data.calls_this_frame.fetch_add(1, std::memory_order_relaxed);
+        data.buckets[BucketIndex(duration_ns)].fetch_add(1, std::memory_order_relaxed);
+        AtomicMin(data.min_ns, duration_ns);
+        AtomicMax(data.max_ns, duration_ns);
+    }
+
+    void EndFrame()
+    {
+        if (!IsEnabled())
+        {
+            return;
+        }
+
+        for (ZoneData &data : g_zones)
+        {
+            const uint32_t calls = data.calls_this_frame.exchange(0, std::memory_order_relaxed);
+            data.calls_last_frame.store(calls, std::memory_order_relaxed);
+            AtomicMax(data.max_calls_per_frame, calls);
+        }
+    }
+
+    void Reset()
+    {
+        for (ZoneData &data : g_zones)
+        {
+            data.calls.store(0, std::memory_order_relaxed);
+            data.total_ns.store(0, std::memory_order_relaxed);
+            data.min_ns.store(UINT64_MAX, std::memory_order_relaxed);
+            data.max_ns.store(0, std::memory_order_relaxed);
+            data.calls_this_frame.store(0, std::memory_order_relaxed);
+            data.calls_last_frame.store(0, std::memory_order_relaxed);
+            data.max_calls_per_frame.store(0, std::memory_order_relaxed);
+            for (auto &bucket : data.buckets)
+            {
+                bucket.store(0, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    ZoneStats GetStats(Zone zone)
+    {
+        const ZoneData &data = g_zones[static_cast<size_t>(zone)];
+
+        ZoneStats stats = {};
+        stats.calls = data.calls.load(std::memory_order_relaxed);
+        stats.calls_last_frame = data.calls_last_frame.load(std::memory_order_relaxed);
+        stats.max_calls_per_frame = data.max_calls_per_frame.load(std::memory_order_relaxed);
+        if (stats.calls == 0)
+        {
+            return stats;
+        }
+
+        stats.min_ns = data.min_ns.load(std::memory_order_relaxed);
+        stats.max_ns = data.max_ns.load(std::memory_order_relaxed);
+        stats.avg_ns = data.total_ns.load(std::memory_order_relaxed) / stats.calls;
+
+        // Walk the histogram up to the 99th percentile. The buckets are read without a lock, so their sum
+        // can briefly disagree with `calls`; the target is clamped to what the buckets actually hold.
+        uint64_t bucket_total = 0;
+        for (const auto &bucket : data.buckets)
+        {
+            bucket_total += bucket.load(std::memory_order_relaxed);
+        }
+
+        const uint64_t target = (bucket_total * 99 + 99) / 100;
+        uint64_t seen = 0;
+        for (uint32_t i = 0; i < BUCKET_COUNT; ++i)
+        {
+            seen += data.buckets[i].load(std::memory_order_relaxed);
+            if (seen >= target)
+            {
+                stats.p99_ns = BucketUpperBound(i);
+                break;
+            }
+        }
+        if (stats.p99_ns > stats.max_ns)
+        {
+            stats.p99_ns = stats.max_ns;
+        }
+        return stats;
+    }
+
+    void Draw(SPF_UI_API *ui)
+    {
+        if (!ui || !g_ctx.formattingAPI)
+        {
+            return;
+        }
+
+        ui->UI_Text("zone                             calls/frame   min us    avg us    p99 us    max us");
+        ui->UI_Separator();
+
+        char line[192];
+        for (size_t i = 0; i < static_cast<size_t>(Zone::Count); ++i)
+        {
+            const ZoneStats stats = GetStats(static_cast<Zone>(i));
+            if (stats.calls == 0)
+            {
+                g_ctx.formattingAPI->Fmt_Format(line, sizeof(line), "%-32s %5s", ZONE_NAMES[i], "-");
+                ui->UI_TextDisabled(line);
+                continue;
+            }
+
+            g_ctx.formattingAPI->Fmt_Format(line, sizeof(line), "%-32s %3u (%3u) %9.2f %9.2f %9.2f %9.2f",
+                ZONE_NAMES[i], stats.calls_last_frame, stats.max_calls_per_frame,
+                stats.min_ns / 1000.0, stats.avg_ns / 1000.0, stats.p99_ns / 1000.0, stats.max_ns / 1000.0);
+            ui->UI_Text(line);
+        }
+
+        ui->UI_Separator();
+        if (ui->UI_SmallButton("Reset"))
+        {
+            Reset();
+        }
+    }
+
+} // namespace SPF_CabinWalk::Profiler
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <SPF_UI_API.h>
+#include "Diagnostics/TraceProvider.hpp"
+
+namespace SPF_CabinWalk::Profiler
+{
+    /**
+     * @brief The instrumented hot paths.
+     */
+    enum class Zone : uint8_t
+    {
+        OnUpdate,
+        AnimationControllerUpdate,
+        SchedulerUpdate,
+        CameraHook,
+        TransitionAcquire,
+        SequenceBuild,
+        Count
+    };
+
+    /**
+     * @brief Summary of one zone's timings since the last reset.
+     */
+    struct ZoneStats
+    {
+        uint64_t calls;
+        uint64_t min_ns;
+        uint64_t max_ns;
+        uint64_t avg_ns;
+        uint64_t p99_ns;           // Upper bound of the histogram bucket holding the 99th percentile.
+        uint32_t calls_last_frame;
+        uint32_t max_calls_per_frame;
+    };
+
+    /**
+     * @brief Enables or disables recording. While disabled, a zone costs a single relaxed atomic load.
+     */
+    void SetEnabled(bool enabled);
+
+    /**
+     * @brief Checks whether recording is enabled.
+     */
+    inline bool IsEnabled();
+
+    /**
+     * @brief Adds one timing sample to a zone. Lock-free; safe to call from the game and hook threads.
+     */
+    void Record(Zone zone, uint64_t duration_ns);
+
+    /**
+     * @brief Closes the current frame, latching the per-frame call counts. Called once at the end of OnUpdate.
+     */
+    void EndFrame();
+
+    /**
+     * @brief Clears all statistics.
+     */
+    void Reset();
+
+    /**
+     * @brief Computes a zone's current statistics.
+     */
+    ZoneStats GetStats(Zone zone);
+
+    /**
+     * @brief Draws the statistics table into the current window.
+     */
+    void Draw(SPF_UI_API *ui);
+
+    /**
+     * @class ScopedTimer
+     * @brief Times the enclosing scope and records it into a zone when recording is enabled.
+     */
+    class ScopedTimer
+    {
+    public:
+        explicit ScopedTimer(Zone zone) : m_zone(zone), m_active(IsEnabled())
+        {
+            if (m_active)
+            {
+                m_start = std::chrono::steady_clock::now();
+            }
+        }
+
+        ~ScopedTimer()
+        {
+            if (m_active)
+            {
+                const auto elapsed = std::chrono::steady_clock::now() - m_start;
+                Record(m_zone, static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+            }
+        }
+
+        ScopedTimer(const ScopedTimer &) = delete;
+        ScopedTimer &operator=(const ScopedTimer &) = delete;
+
+    private:
+        Zone m_zone;
+        bool m_active;
+        std::chrono::steady_clock::time_point m_start;
+    };
+
+    // Defined inline so that the disabled check at every zone is just a load.
+    namespace Detail
+    {
+        extern std::atomic<bool> g_enabled;
+    }
+
+    inline bool IsEnabled()
+    {
+        return Detail::g_enabled.load(std::memory_order_relaxed);
+    }
+
+} // namespace SPF_CabinWalk::Profiler
+
+// Times the rest of the enclosing scope, and traces it as a zone of the same name when a trace backend is
+// built in. Compiles to nothing unless the profiler or a trace backend is built in.
+#if defined(SPF_CABINWALK_ENABLE_PROFILER)
+#define SPF_CABINWALK_PROFILE_ZONE(zone)                                                                                    \
+    ::SPF_CabinWalk::Profiler::ScopedTimer spf_cabinwalk_profile_zone(::SPF_CabinWalk::Profiler::Zone::zone); \
+    SPF_CABINWALK_TRACE_ZONE(#zone)
+#else
+#define SPF_CABINWALK_PROFILE_ZONE(zone) SPF_CABINWALK_TRACE_ZONE(#zone)
+#endif
@@ -0,0 +1,188 @@
+#include "Diagnostics/StateExport.hpp"
+
+#if defined(SPF_CABINWALK_ENABLE_STATE_EXPORT)
+#include "SPF_CabinWalk.hpp" // For g_ctx
+#include "Camera/CameraFacade.hpp"
+#include "Animation/AnimationController.hpp"
+#include "Animation/StandingAnimController.hpp"
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h> // For CreateFileMappingW and MapViewOfFile
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace SPF_CabinWalk::StateExport
+{
+    // =================================================================================================
+    // Internal State
+    // =================================================================================================
+
+    static SharedState *g_state = nullptr;
+#ifdef _WIN32
+    static HANDLE g_mapping = nullptr;
+#else
+    static int g_fd = -1;
+#endif
+    static uint64_t g_frame = 0;
+
+    // =================================================================================================
+    // Internal Helpers
+    // =================================================================================================
+
+    static void Log(SPF_LogLevel level, const char *message)
+    {
+        if (g_ctx.loggerHandle)
+        {
+            g_ctx.loadAPI->logger->Log(g_ctx.loggerHandle, level, message);
+        }
+    }
+
+    /**
+     * @brief Creates the named section, or opens it if a consumer (or the plugin before a reload) still holds it.
+     */
+    static SharedState *MapSection()
+    {
+#ifdef _WIN32
+        g_mapping = CreateFileMappingW(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, 0, static_cast<DWORD>(sizeof(SharedState)), SECTION_NAME);
+        if (!g_mapping)
+        {
+            return nullptr;
+        }
+
+        void *data = MapViewOfFile(g_mapping, FILE_MAP_WRITE, 0, 0, sizeof(SharedState));
+        if (!data)
+        {
+            CloseHandle(g_mapping);
+            g_mapping = nullptr;
+            return nullptr;
+        }
+        return static_cast<SharedState *>(data);
+#else
+        g_fd = shm_open(SECTION_NAME, O_RDWR | O_CREAT, 0644);
+        if (g_fd < 0)
+        {
+            return nullptr;
+        }
+
+        void *data = MAP_FAILED;
+        if (ftruncate(g_fd, static_cast<off_t>(sizeof(SharedState))) == 0)
+        {
+            data = mmap(nullptr, sizeof(SharedState), PROT_READ | PROT_WRITE, MAP_SHARED, g_fd, 0);
+        }
+        if (data == MAP_FAILED)
+        {
+            close(g_fd);
+            g_fd = -1;
+            return nullptr;
+        }
+        return static_cast<SharedState *>(data);
+#endif
+    }
+
+    static StatePayload Sample(uint64_t timestamp_us)
+    {
+        StatePayload payload = {};
+        payload.frame = ++g_frame;
+        payload.timestamp_us = timestamp_us;
+
+        const SPF_FVector seat = CameraFacade::GetSeatPos();
+        payload.seat_pos[0] = seat.x;
+        payload.seat_pos[1] = seat.y;
+        payload.seat_pos[2] = seat.z;
+        CameraFacade::GetHeadRot(&payload.head_rot[0], &payload.head_rot[1]);
+
+        payload.position = static_cast<uint8_t>(AnimationController::GetCurrentPosition());
+        payload.stance = static_cast<uint8_t>(StandingAnimController::GetCurrentStance());
+
+        // Reported as the camera trace does, so the two agree on what "playing" means.
+        AnimationController::CameraPosition from = AnimationController::CameraPosition::None;
+        AnimationController::CameraPosition to = AnimationController::CameraPosition::None;
+        float progress = StandingAnimController::GetActiveProgress();
+        if (!AnimationController::GetActiveTransition(&from, &to, &progress) && progress >= 0.0f)
+        {
+            from = to = AnimationController::CameraPosition::Standing; // A stance or walk animation.
+        }
+        payload.transition_from = static_cast<uint8_t>(from);
+        payload.transition_to = static_cast<uint8_t>(to);
+        payload.transition_progress = progress;
+        return payload;
+    }
+
+    // =================================================================================================
+    // Public Functions
+    // =================================================================================================
+
+    void Open()
+    {
+        if (g_state)
+        {
+            return;
+        }
+
+        g_state = MapSection();
+        if (!g_state)
+        {
+            Log(SPF_LOG_WARN, "[StateExport] Could not create the shared state section; external tools will not see the cabin state.");
+            return;
+        }
+
+        // A section left by an earlier load keeps its sequence, so a consumer polling across the reload
+        // never sees it go back; one left mid-write is closed off here.
+        std::atomic_ref<uint32_t> sequence(g_state->sequence);
+        const uint32_t current = sequence.load(std::memory_order_relaxed);
+        sequence.store(current + (current & 1u), std::memory_order_relaxed);
+
+        std::memcpy(g_state->magic, STATE_MAGIC, sizeof(g_state->magic));
+        g_state->version = STATE_VERSION;
+        g_state->size = sizeof(SharedState);
+        g_frame = 0;
+
+        Log(SPF_LOG_INFO, "[StateExport] Publishing the cabin state in shared memory.");
+    }
+
+    void Publish(uint64_t timestamp_us)
+    {
+        if (!g_state)
+        {
+            return;
+        }
+
+        // Sampled before the write opens, so the odd window covers one copy and nothing else.
+        const StatePayload payload = Sample(timestamp_us);
+
+        std::atomic_ref<uint32_t> sequence(g_state->sequence);
+        const uint32_t even = sequence.load(std::memory_order_relaxed);
+        sequence.store(even + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        std::memcpy(&g_state->payload, &payload, sizeof(payload));
+        sequence.store(even + 2, std::memory_order_release);
+    }
+
+    void Close()
+    {
+        if (!g_state)
+        {
+            return;
+        }
+
+#ifdef _WIN32
+        UnmapViewOfFile(g_state);
+        CloseHandle(g_mapping);
+        g_mapping = nullptr;
+#else
+        munmap(g_state, sizeof(SharedState));
+        close(g_fd);
+        g_fd = -1;
+#endif
+        g_state = nullptr;
+    }
+
+} // namespace SPF_CabinWalk::StateExport
+
+#endif
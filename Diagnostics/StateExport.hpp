@@ -0,0 +1,119 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+// Publishes the cabin state once per frame in a named shared-memory section, for stream overlays,
+// head-tracker bridges and telemetry dashboards. The section holds one SharedState; a consumer opens it
+// read-only by name (OpenFileMappingW with FILE_MAP_READ, or shm_open off Windows) and reads it with
+// ReadSnapshot() below, without locks and without the plugin ever waiting on it.
+//
+// The layout is fixed: fields are only ever appended, with `version` raised and `size` grown, so an
+// older consumer keeps reading the prefix it knows.
+//
+// With SPF_CABINWALK_ENABLE_STATE_EXPORT undefined, the plugin-side functions compile to nothing.
+
+namespace SPF_CabinWalk::StateExport
+{
+    // "Local\" keeps the section in the game's session, where desktop overlays and bridges run.
+#ifdef _WIN32
+    inline constexpr wchar_t SECTION_NAME[] = L"Local\\SPF_CabinWalk_State";
+#else
+    inline constexpr char SECTION_NAME[] = "/SPF_CabinWalk_State";
+#endif
+
+    inline constexpr char STATE_MAGIC[8] = "CWSTATE";
+    inline constexpr uint32_t STATE_VERSION = 1;
+
+    /**
+     * @brief One frame of cabin state.
+     */
+    struct StatePayload
+    {
+        uint64_t frame;              // Frames published since the plugin loaded; a heartbeat that rises every game frame.
+        uint64_t timestamp_us;       // Simulation timestamp of the frame.
+        float seat_pos[3];           // Applied interior seat position.
+        float head_rot[2];           // Head yaw and pitch, as applied or, where nothing animates, as mouse look left them.
+        float transition_progress;   // Progress of the playing transition or stance animation, 0..1; negative if none.
+        uint8_t position;            // AnimationController::CameraPosition
+        uint8_t stance;              // StandingAnimController::Stance
+        uint8_t transition_from;     // Transition start position; equal to `transition_to` for stance/walk animations.
+        uint8_t transition_to;       // Transition target position; CameraPosition::None if nothing plays.
+        uint8_t reserved[4];
+    };
+
+    /**
+     * @brief The whole shared section.
+     * @details `sequence` is a seqlock: odd while the plugin writes `payload`, raised by two per frame.
+     *          It sits on its own cache line so a polling consumer does not share one with the header.
+     */
+    struct SharedState
+    {
+        char magic[8];      // STATE_MAGIC
+        uint32_t version;   // STATE_VERSION of the writer.
+        uint32_t size;      // sizeof(SharedState) of the writer.
+        alignas(64) uint32_t sequence;
+        uint32_t reserved;
+        StatePayload payload;
+    };
+
+    static_assert(std::is_standard_layout_v<SharedState> && std::is_trivially_copyable_v<StatePayload>, "Shared with other processes");
+    static_assert(offsetof(SharedState, sequence) == 64 && offsetof(SharedState, payload) == 72, "The layout is part of the contract");
+    static_assert(sizeof(StatePayload) == 48, "The layout is part of the contract");
+    static_assert(std::atomic_ref<uint32_t>::is_always_lock_free, "The seqlock must be lock-free to work across processes");
+
+    /**
+     * @brief Reads a consistent snapshot of the payload, as a consumer does.
+     * @param state The mapped section.
+     * @param[out] out Receives the payload of one whole frame.
+     * @param attempts How often to retry while the plugin is writing.
+     * @return False if the plugin was mid-write on every attempt; try again on the next poll.
+     */
+    inline bool ReadSnapshot(const SharedState &state, StatePayload &out, uint32_t attempts = 16)
+    {
+        std::atomic_ref<uint32_t> sequence(const_cast<uint32_t &>(state.sequence));
+        for (uint32_t i = 0; i < attempts; ++i)
+        {
+            const uint32_t before = sequence.load(std::memory_order_acquire);
+            if (before & 1u)
+            {
+                continue;
+            }
+            std::memcpy(&out, &state.payload, sizeof(out));
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (sequence.load(std::memory_order_relaxed) == before)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+#if defined(SPF_CABINWALK_ENABLE_STATE_EXPORT)
+    /**
+     * @brief Creates the shared section. Called once on load; logs and leaves the export off on failure.
+     */
+    void Open();
+
+    /**
+     * @brief Publishes this frame's state. Called from OnUpdate on every frame, idle ones included: after
+     *        the camera pose is settled and before the camera facade is flushed.
+     * @details Never blocks: the seqlock only orders the plugin's own stores.
+     * @param timestamp_us The current simulation timestamp.
+     */
+    void Publish(uint64_t timestamp_us);
+
+    /**
+     * @brief Unmaps the section. Consumers still holding it keep the last frame.
+     */
+    void Close();
+#else
+    inline void Open() {}
+    inline void Publish(uint64_t) {}
+    inline void Close() {}
+#endif
+
+} // namespace SPF_CabinWalk::StateExport
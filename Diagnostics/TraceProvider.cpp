@@ -0,0 +1,125 @@
+#include "Diagnostics/TraceProvider.hpp"
+
+#if defined(SPF_CABINWALK_TRACE_ETW)
+#include <Windows.h>
+#include <TraceLoggingProvider.h>
+#include <chrono>
+#elif defined(SPF_CABINWALK_TRACE_TRACY)
+#include <cstdio>
+#endif
+
+namespace SPF_CabinWalk::TraceProvider
+{
+#if defined(SPF_CABINWALK_TRACE_ETW)
+    // =================================================================================================
+    // ETW
+    // =================================================================================================
+
+    // The GUID is the EventSource hash of the name, so sessions can enable the provider as "*TrackAndTruck.CabinWalk".
+    // {6902880e-13d2-5317-3c4b-25773fc5cf2c}
+    TRACELOGGING_DEFINE_PROVIDER(g_provider, "TrackAndTruck.CabinWalk",
+                                 (0x6902880e, 0x13d2, 0x5317, 0x3c, 0x4b, 0x25, 0x77, 0x3f, 0xc5, 0xcf, 0x2c));
+
+    static uint64_t g_frame_index = 0;
+
+    void Register()
+    {
+        TraceLoggingRegister(g_provider);
+    }
+
+    void Unregister()
+    {
+        TraceLoggingUnregister(g_provider);
+    }
+
+    bool IsListening()
+    {
+        return TraceLoggingProviderEnabled(g_provider, 0, 0);
+    }
+
+    uint64_t GetTimestampNs()
+    {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    // The events carry their own nanosecond timestamps; the ETW timestamp of an event is only as fine as the session's clock.
+    void EmitZoneBegin(const char *name, uint64_t start_ns)
+    {
+        TraceLoggingWrite(g_provider, "Zone",
+                          TraceLoggingOpcode(WINEVENT_OPCODE_START),
+                          TraceLoggingString(name, "Name"),
+                          TraceLoggingUInt64(start_ns, "TimestampNs"));
+    }
+
+    void EmitZoneEnd(const char *name, uint64_t start_ns, uint64_t end_ns)
+    {
+        TraceLoggingWrite(g_provider, "Zone",
+                          TraceLoggingOpcode(WINEVENT_OPCODE_STOP),
+                          TraceLoggingString(name, "Name"),
+                          TraceLoggingUInt64(end_ns, "TimestampNs"),
+                          TraceLoggingUInt64(end_ns - start_ns, "DurationNs"));
+    }
+
+    void EmitMarker(Marker marker, uint32_t from, uint32_t to)
+    {
+        if (!IsListening())
+        {
+            return;
+        }
+
+        // TraceLogging event names must be literals.
+        const uint64_t now_ns = GetTimestampNs();
+        switch (marker)
+        {
+        case Marker::Position:
+            TraceLoggingWrite(g_provider, "PositionChanged",
+                              TraceLoggingUInt32(from, "From"),
+                              TraceLoggingUInt32(to, "To"),
+                              TraceLoggingUInt64(now_ns, "TimestampNs"));
+            break;
+        case Marker::Stance:
+            TraceLoggingWrite(g_provider, "StanceChanged",
+                              TraceLoggingUInt32(from, "From"),
+                              TraceLoggingUInt32(to, "To"),
+                              TraceLoggingUInt64(now_ns, "TimestampNs"));
+            break;
+        }
+    }
+
+    void EmitFrame()
+    {
+        ++g_frame_index;
+        if (IsListening())
+        {
+            TraceLoggingWrite(g_provider, "Frame",
+                              TraceLoggingUInt64(g_frame_index, "FrameIndex"),
+                              TraceLoggingUInt64(GetTimestampNs(), "TimestampNs"));
+        }
+    }
+
+#elif defined(SPF_CABINWALK_TRACE_TRACY)
+    // =================================================================================================
+    // Tracy
+    // =================================================================================================
+
+    // The Tracy client starts with the DLL and stops with it; zones are emitted by ZoneScopedN directly.
+    void Register() {}
+    void Unregister() {}
+
+    void EmitMarker(Marker marker, uint32_t from, uint32_t to)
+    {
+        char text[48];
+        const int length = std::snprintf(text, sizeof(text), "%s %u -> %u", marker == Marker::Position ? "Position" : "Stance", from, to);
+        if (length > 0)
+        {
+            TracyMessage(text, static_cast<size_t>(length));
+        }
+    }
+
+    void EmitFrame()
+    {
+        FrameMark;
+    }
+#endif
+
+} // namespace SPF_CabinWalk::TraceProvider
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <cstdint>
+
+// Zones and markers for whole-frame analysis in external profilers, selected at compile time:
+//
+//   SPF_CABINWALK_TRACE_ETW    TraceLogging events from the "TrackAndTruck.CabinWalk" provider, for
+//                              Windows Performance Analyzer (e.g. `wpr -start` with a profile that
+//                              enables "*TrackAndTruck.CabinWalk").
+//   SPF_CABINWALK_TRACE_TRACY  Tracy zones, messages and frame marks.
+//
+// With neither defined, every macro below compiles to nothing.
+
+#if defined(SPF_CABINWALK_TRACE_ETW) && defined(SPF_CABINWALK_TRACE_TRACY)
+#error "Select at most one trace backend"
+#endif
+
+#if defined(SPF_CABINWALK_TRACE_TRACY)
+#include <tracy/Tracy.hpp>
+#endif
+
+namespace SPF_CabinWalk::TraceProvider
+{
+    /**
+     * @brief The state changes a marker reports.
+     */
+    enum class Marker : uint8_t
+    {
+        Position, // AnimationController::CameraPosition, from -> to
+        Stance    // StandingAnimController::Stance, from -> to
+    };
+
+#if defined(SPF_CABINWALK_TRACE_ETW) || defined(SPF_CABINWALK_TRACE_TRACY)
+    /**
+     * @brief Registers the trace provider. Called once on load, before any zone.
+     */
+    void Register();
+
+    /**
+     * @brief Unregisters the trace provider. Called once on unload, after the last zone.
+     */
+    void Unregister();
+
+    /**
+     * @brief Emits a state change marker.
+     */
+    void EmitMarker(Marker marker, uint32_t from, uint32_t to);
+
+    /**
+     * @brief Marks the boundary between two game frames. Called first thing in OnUpdate, idle frames
+     *        included, so the zones and markers that follow it belong to the frame it opens.
+     */
+    void EmitFrame();
+#else
+    inline void Register() {}
+    inline void Unregister() {}
+    inline void EmitMarker(Marker, uint32_t, uint32_t) {}
+    inline void EmitFrame() {}
+#endif
+
+#if defined(SPF_CABINWALK_TRACE_ETW)
+    /**
+     * @brief Checks whether a trace session listens to the provider. Zones cost only this check otherwise.
+     */
+    bool IsListening();
+
+    /**
+     * @brief Gets the steady clock in nanoseconds, the time base of the zone events.
+     */
+    uint64_t GetTimestampNs();
+
+    void EmitZoneBegin(const char *name, uint64_t start_ns);
+    void EmitZoneEnd(const char *name, uint64_t start_ns, uint64_t end_ns);
+
+    /**
+     * @class ScopedZone
+     * @brief Emits a begin and an end event around the enclosing scope while a session is listening.
+     */
+    class ScopedZone
+    {
+    public:
+        explicit ScopedZone(const char *name) : m_name(name), m_start_ns(IsListening() ? GetTimestampNs() : 0)
+        {
+            if (m_start_ns)
+            {
+                EmitZoneBegin(m_name, m_start_ns);
+            }
+        }
+
+        ~ScopedZone()
+        {
+            if (m_start_ns)
+            {
+                EmitZoneEnd(m_name, m_start_ns, GetTimestampNs());
+            }
+        }
+
+        ScopedZone(const ScopedZone &) = delete;
+        ScopedZone &operator=(const ScopedZone &) = delete;
+
+    private:
+        const char *m_name;
+        uint64_t m_start_ns; // 0 while nobody listens.
+    };
+#endif
+
+} // namespace SPF_CabinWalk::TraceProvider
+
+// Traces the rest of the enclosing scope as a zone. `name` must be a string literal.
+#if defined(SPF_CABINWALK_TRACE_ETW)
+#define SPF_CABINWALK_TRACE_ZONE(name) ::SPF_CabinWalk::TraceProvider::ScopedZone spf_cabinwalk_trace_zone(name)
+#elif defined(SPF_CABINWALK_TRACE_TRACY)
+#define SPF_CABINWALK_TRACE_ZONE(name) ZoneScopedN(name)
+#else
+#define SPF_CABINWALK_TRACE_ZONE(name) ((void)0)
+#endif
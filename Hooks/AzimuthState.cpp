@@ -0,0 +1,447 @@
+#include "Hooks/AzimuthState.hpp"
+#include "Hooks/Offsets.hpp"
+#include "Diagnostics/TraceProvider.hpp"
+#include <cstring>
+#include <iterator>
+
+namespace SPF_CabinWalk::AzimuthState
+{
+    namespace
+    {
+        using CacheExteriorSoundAngleRange_t = void (*)(long long camera_object);
+
+        // Wide free-look limits used while standing.
+        constexpr float STANDING_YAW_LIMIT = 231.0f;
+        constexpr float STANDING_PITCH_DOWN_LIMIT = -80.0f;
+
+        uint32_t ClampAzimuthCount(long long azimuth_count)
+        {
+            return (azimuth_count < 0) ? 0 : (azimuth_count < MAX_AZIMUTHS) ? (uint32_t)azimuth_count : MAX_AZIMUTHS;
+        }
+
+        // =============================================================================================
+        // Azimuth Blocks
+        // =============================================================================================
+
+        // The fields of an azimuth_range struct lie within a few dozen bytes (0x10 to 0x54), so each struct
+        // is read into a local block with one copy, and written back with one copy if anything changed.
+        constexpr uint32_t MAX_BLOCK_SIZE = 128;
+
+        struct BlockLayout
+        {
+            uint32_t base; // Struct offset of the first byte of the block.
+            uint32_t size; // 0 if the fields are too far apart to copy, and are accessed in place.
+        };
+
+        BlockLayout GetBlockLayout()
+        {
+            const Offsets::Offsets &o = Offsets::g_offsets;
+            const uint32_t begins[] = {o.start_azimuth_offset, o.end_azimuth_offset, o.azimuth_outside_flag_offset,
+                                       o.start_head_offset_x_offset, o.end_head_offset_x_offset};
+            const uint32_t ends[] = {o.start_azimuth_offset + (uint32_t)sizeof(float), o.end_azimuth_offset + (uint32_t)sizeof(float),
+                                     o.azimuth_outside_flag_offset + 1, o.start_head_offset_x_offset + (uint32_t)sizeof(SPF_FVector),
+                                     o.end_head_offset_x_offset + (uint32_t)sizeof(SPF_FVector)};
+
+            BlockLayout layout = {begins[0], 0};
+            uint32_t end = ends[0];
+            for (size_t i = 1; i < std::size(begins); ++i)
+            {
+                layout.base = (begins[i] < layout.base) ? begins[i] : layout.base;
+                end = (ends[i] > end) ? ends[i] : end;
+            }
+            layout.size = end - layout.base;
+            if (layout.size > MAX_BLOCK_SIZE)
+            {
+                layout = {0, 0};
+            }
+            return layout;
+        }
+
+        // Returns the bytes to decode or edit the fields of an azimuth struct in: `block`, filled from the
+        // struct, or the struct itself if the layout cannot be copied.
+        char *LoadBlock(long long azimuth_struct_ptr, const BlockLayout &layout, char *block)
+        {
+            if (layout.size == 0)
+            {
+                return (char *)azimuth_struct_ptr;
+            }
+            std::memcpy(block, (char *)azimuth_struct_ptr + layout.base, layout.size);
+            return block;
+        }
+
+        template <typename T>
+        T *Field(char *fields, const BlockLayout &layout, uint32_t offset)
+        {
+            return (T *)(fields + (offset - layout.base));
+        }
+
+        // =============================================================================================
+        // Camera View
+        // =============================================================================================
+
+        // The addresses of everything the plugin touches in the camera object, resolved when a new object
+        // is seen, so a call only rereads the azimuth array pointer and count to revalidate them.
+        struct CameraView
+        {
+            long long camera_object = 0;
+            float *pivot = nullptr;
+            long long **azimuth_array_slot = nullptr;
+            long long *azimuth_count_slot = nullptr;
+            long long *azimuth_array = nullptr; // As last read from the slot
+            uint32_t azimuth_count = 0;         // Clamped to MAX_AZIMUTHS
+            BlockLayout layout = {};
+        };
+
+        CameraView g_view;
+
+        // Returns true if the object, or the azimuth array it holds, differs from the one last bound.
+        bool BindView(long long camera_object)
+        {
+            if (camera_object == g_view.camera_object)
+            {
+                long long *azimuth_array = *g_view.azimuth_array_slot;
+                const uint32_t azimuth_count = ClampAzimuthCount(*g_view.azimuth_count_slot);
+                if (azimuth_array == g_view.azimuth_array && azimuth_count == g_view.azimuth_count)
+                {
+                    return false;
+                }
+                g_view.azimuth_array = azimuth_array;
+                g_view.azimuth_count = azimuth_count;
+                return true;
+            }
+
+            char *base = (char *)camera_object;
+            g_view.camera_object = camera_object;
+            g_view.pivot = (float *)(base + Offsets::g_offsets.camera_pivot_offset);
+            g_view.azimuth_array_slot = (long long **)(base + Offsets::g_offsets.azimuth_array_offset);
+            g_view.azimuth_count_slot = (long long *)(base + Offsets::g_offsets.azimuth_count_offset);
+            g_view.azimuth_array = *g_view.azimuth_array_slot;
+            g_view.azimuth_count = ClampAzimuthCount(*g_view.azimuth_count_slot);
+            g_view.layout = GetBlockLayout();
+            return true;
+        }
+
+        // Bitwise comparison, so that -0.0f and NaN payloads are written back exactly.
+        template <typename T>
+        void WriteIfChanged(T *destination, const T &value, uint32_t &written)
+        {
+            if (std::memcmp(destination, &value, sizeof(T)) != 0)
+            {
+                *destination = value;
+                ++written;
+            }
+        }
+
+        void WriteVectorIfChanged(float *destination, const SPF_FVector &value, uint32_t &written)
+        {
+            WriteIfChanged(&destination[0], value.x, written);
+            WriteIfChanged(&destination[1], value.y, written);
+            WriteIfChanged(&destination[2], value.z, written);
+        }
+
+        void MirrorForPassenger(AzimuthBackup &azimuth)
+        {
+            const AzimuthBackup original = azimuth;
+
+            // Invert the angles, keeping start <= end.
+            azimuth.start = original.start * -1.0f;
+            azimuth.end = original.end * -1.0f;
+            const bool angles_were_swapped = azimuth.start > azimuth.end;
+            if (angles_were_swapped)
+            {
+                const float temp = azimuth.start;
+                azimuth.start = azimuth.end;
+                azimuth.end = temp;
+            }
+
+            // Mirror the head offsets on X, swapping them along with the angles.
+            const SPF_FVector &start_source = angles_were_swapped ? original.end_head_offset : original.start_head_offset;
+            const SPF_FVector &end_source = angles_were_swapped ? original.start_head_offset : original.end_head_offset;
+            azimuth.start_head_offset = {start_source.x * -1.0f, start_source.y, start_source.z};
+            azimuth.end_head_offset = {end_source.x * -1.0f, end_source.y, end_source.z};
+        }
+
+        template <typename T>
+        bool SameBits(const T &a, const T &b)
+        {
+            return std::memcmp(&a, &b, sizeof(T)) == 0;
+        }
+
+        bool SameVector(const SPF_FVector &a, const SPF_FVector &b)
+        {
+            return SameBits(a.x, b.x) && SameBits(a.y, b.y) && SameBits(a.z, b.z);
+        }
+
+        // Field-by-field, so that struct padding never causes a spurious mismatch.
+        bool SameState(const Snapshot &a, const Snapshot &b)
+        {
+            if (!SameVector(a.camera_pivot, b.camera_pivot) || a.has_limits != b.has_limits ||
+                !SameBits(a.limits.left, b.limits.left) || !SameBits(a.limits.right, b.limits.right) ||
+                !SameBits(a.limits.up, b.limits.up) || !SameBits(a.limits.down, b.limits.down) ||
+                a.azimuths.Size() != b.azimuths.Size())
+            {
+                return false;
+            }
+
+            for (uint32_t i = 0; i < a.azimuths.Size(); ++i)
+            {
+                const AzimuthBackup &x = a.azimuths[i].values;
+                const AzimuthBackup &y = b.azimuths[i].values;
+                if (a.azimuths[i].present != b.azimuths[i].present || !SameBits(x.start, y.start) || !SameBits(x.end, y.end) ||
+                    x.outside_flag != y.outside_flag || !SameVector(x.start_head_offset, y.start_head_offset) ||
+                    !SameVector(x.end_head_offset, y.end_head_offset))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        // =============================================================================================
+        // Profile Table
+        // =============================================================================================
+
+        // Positions that share a state share a profile: all sofa positions use the same limits.
+        enum class Profile : uint8_t
+        {
+            Driver,
+            Passenger,
+            Standing,
+            Sofa,
+            Count
+        };
+
+        Profile ProfileFor(AnimationController::CameraPosition position)
+        {
+            switch (position)
+            {
+                case AnimationController::CameraPosition::Passenger: return Profile::Passenger;
+                case AnimationController::CameraPosition::Standing: return Profile::Standing;
+                case AnimationController::CameraPosition::SofaSit1:
+                case AnimationController::CameraPosition::SofaLie:
+                case AnimationController::CameraPosition::SofaSit2: return Profile::Sofa;
+                default: return Profile::Driver;
+            }
+        }
+
+        // A representative position for building each profile.
+        constexpr AnimationController::CameraPosition PROFILE_POSITIONS[] = {
+            AnimationController::CameraPosition::Driver,
+            AnimationController::CameraPosition::Passenger,
+            AnimationController::CameraPosition::Standing,
+            AnimationController::CameraPosition::SofaSit1,
+        };
+
+        Snapshot g_profiles[static_cast<size_t>(Profile::Count)] = {};
+        bool g_has_original = false;
+        bool g_derived_valid = false;
+    } // namespace
+
+    bool BindCameraObject(long long camera_object)
+    {
+        return BindView(camera_object);
+    }
+
+    void Capture(long long camera_object, Snapshot &out)
+    {
+        BindView(camera_object);
+        const float *pivot = g_view.pivot;
+        out.camera_pivot = {pivot[0], pivot[1], pivot[2]};
+
+        out.has_limits = g_ctx.cameraAPI != nullptr;
+        out.limits = {};
+        if (out.has_limits)
+        {
+            g_ctx.cameraAPI->Cam_GetInteriorRotationLimits(&out.limits.left, &out.limits.right, &out.limits.up, &out.limits.down);
+        }
+
+        const uint32_t azimuth_count = g_view.azimuth_count;
+        long long *azimuth_array = g_view.azimuth_array;
+        out.azimuths.Resize(azimuth_count);
+
+        const BlockLayout &layout = g_view.layout;
+        char block[MAX_BLOCK_SIZE];
+        for (uint32_t i = 0; i < azimuth_count; ++i)
+        {
+            const long long azimuth_struct_ptr = azimuth_array[i];
+            AzimuthEntry &entry = out.azimuths[i];
+            entry.present = azimuth_struct_ptr != 0;
+            entry.values = {};
+            if (!azimuth_struct_ptr)
+            {
+                continue;
+            }
+
+            char *fields = LoadBlock(azimuth_struct_ptr, layout, block);
+            AzimuthBackup &azimuth = entry.values;
+            azimuth.start = *Field<float>(fields, layout, Offsets::g_offsets.start_azimuth_offset);
+            azimuth.end = *Field<float>(fields, layout, Offsets::g_offsets.end_azimuth_offset);
+            azimuth.outside_flag = *Field<char>(fields, layout, Offsets::g_offsets.azimuth_outside_flag_offset);
+
+            const float *p_start_offset_vec = Field<float>(fields, layout, Offsets::g_offsets.start_head_offset_x_offset);
+            const float *p_end_offset_vec = Field<float>(fields, layout, Offsets::g_offsets.end_head_offset_x_offset);
+            azimuth.start_head_offset = {p_start_offset_vec[0], p_start_offset_vec[1], p_start_offset_vec[2]};
+            azimuth.end_head_offset = {p_end_offset_vec[0], p_end_offset_vec[1], p_end_offset_vec[2]};
+        }
+    }
+
+    void BuildTarget(AnimationController::CameraPosition position, const Snapshot &original, Snapshot &out)
+    {
+        out = original;
+
+        switch (position)
+        {
+            case AnimationController::CameraPosition::Passenger:
+                // Move the rotation pivot to the passenger seat and mirror everything left-to-right.
+                out.camera_pivot = g_ctx.settings.positions.passenger_seat.position;
+                out.limits.left = original.limits.right * -1.0f;
+                out.limits.right = original.limits.left * -1.0f;
+                for (uint32_t i = 0; i < out.azimuths.Size(); ++i)
+                {
+                    if (out.azimuths[i].present)
+                    {
+                        MirrorForPassenger(out.azimuths[i].values);
+                    }
+                }
+                break;
+
+            case AnimationController::CameraPosition::Standing:
+            case AnimationController::CameraPosition::SofaSit1:
+            case AnimationController::CameraPosition::SofaLie:
+            case AnimationController::CameraPosition::SofaSit2:
+                // Free look: no head-offset zones at all. The pivot is left alone, as the animation
+                // controller sets the position directly.
+                if (position == AnimationController::CameraPosition::Standing)
+                {
+                    out.limits = {STANDING_YAW_LIMIT, -STANDING_YAW_LIMIT, original.limits.up, STANDING_PITCH_DOWN_LIMIT};
+                }
+                else
+                {
+                    out.limits = {g_ctx.settings.sofa_limits.yaw_left, g_ctx.settings.sofa_limits.yaw_right,
+                                  g_ctx.settings.sofa_limits.pitch_up, g_ctx.settings.sofa_limits.pitch_down};
+                }
+                for (uint32_t i = 0; i < out.azimuths.Size(); ++i)
+                {
+                    if (out.azimuths[i].present)
+                    {
+                        out.azimuths[i].values = {};
+                    }
+                }
+                break;
+
+            case AnimationController::CameraPosition::Driver:
+            default:
+                // The game's own values.
+                break;
+        }
+    }
+
+    bool UpdateOriginal(long long camera_object)
+    {
+        Snapshot live;
+        Capture(camera_object, live);
+
+        Snapshot &original = g_profiles[static_cast<size_t>(Profile::Driver)];
+        if (g_has_original && SameState(live, original))
+        {
+            return false;
+        }
+
+        original = live;
+        g_has_original = true;
+        g_derived_valid = false;
+        return true;
+    }
+
+    const Snapshot *GetProfile(AnimationController::CameraPosition position)
+    {
+        if (!g_has_original)
+        {
+            return nullptr;
+        }
+
+        if (!g_derived_valid)
+        {
+            const Snapshot &original = g_profiles[static_cast<size_t>(Profile::Driver)];
+            for (size_t i = static_cast<size_t>(Profile::Passenger); i < static_cast<size_t>(Profile::Count); ++i)
+            {
+                BuildTarget(PROFILE_POSITIONS[i], original, g_profiles[i]);
+            }
+            g_derived_valid = true;
+        }
+
+        return &g_profiles[static_cast<size_t>(ProfileFor(position))];
+    }
+
+    bool AreProfilesBuilt()
+    {
+        return g_has_original && g_derived_valid;
+    }
+
+    void InvalidateDerivedProfiles()
+    {
+        g_derived_valid = false;
+    }
+
+    uint32_t Apply(long long camera_object, const Snapshot &target)
+    {
+        SPF_CABINWALK_TRACE_ZONE("AzimuthState::Apply");
+        uint32_t written = 0;
+        BindView(camera_object);
+
+        // 1. Camera Pivot
+        WriteVectorIfChanged(g_view.pivot, target.camera_pivot, written);
+
+        // 2. Mouse Limits via API
+        if (target.has_limits && g_ctx.cameraAPI)
+        {
+            RotationLimits live = {};
+            g_ctx.cameraAPI->Cam_GetInteriorRotationLimits(&live.left, &live.right, &live.up, &live.down);
+            if (std::memcmp(&live, &target.limits, sizeof(RotationLimits)) != 0)
+            {
+                g_ctx.cameraAPI->Cam_SetInteriorRotationLimits(target.limits.left, target.limits.right, target.limits.up, target.limits.down);
+                ++written;
+            }
+        }
+
+        // 3. Azimuth Ranges
+        const uint32_t live_count = g_view.azimuth_count;
+        long long *azimuth_array = g_view.azimuth_array;
+        const uint32_t count = (live_count < target.azimuths.Size()) ? live_count : target.azimuths.Size();
+        const BlockLayout &layout = g_view.layout;
+        char block[MAX_BLOCK_SIZE];
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            const long long azimuth_struct_ptr = azimuth_array[i];
+            if (!azimuth_struct_ptr || !target.azimuths[i].present)
+            {
+                continue;
+            }
+
+            // The fields are edited in the local block, which is copied back only if one of them changed.
+            char *fields = LoadBlock(azimuth_struct_ptr, layout, block);
+            const uint32_t written_before = written;
+            const AzimuthBackup &azimuth = target.azimuths[i].values;
+            WriteIfChanged(Field<float>(fields, layout, Offsets::g_offsets.start_azimuth_offset), azimuth.start, written);
+            WriteIfChanged(Field<float>(fields, layout, Offsets::g_offsets.end_azimuth_offset), azimuth.end, written);
+            WriteIfChanged(Field<char>(fields, layout, Offsets::g_offsets.azimuth_outside_flag_offset), azimuth.outside_flag, written);
+            WriteVectorIfChanged(Field<float>(fields, layout, Offsets::g_offsets.start_head_offset_x_offset), azimuth.start_head_offset, written);
+            WriteVectorIfChanged(Field<float>(fields, layout, Offsets::g_offsets.end_head_offset_x_offset), azimuth.end_head_offset, written);
+
+            if (layout.size != 0 && written != written_before)
+            {
+                std::memcpy((char *)azimuth_struct_ptr + layout.base, block, layout.size);
+            }
+        }
+
+        // 4. Recalculate the outside sound cache once, and only if something actually changed.
+        if (written > 0 && Offsets::g_offsets.pfnCacheExteriorSoundAngleRange)
+        {
+            CacheExteriorSoundAngleRange_t pfnCache = (CacheExteriorSoundAngleRange_t)Offsets::g_offsets.pfnCacheExteriorSoundAngleRange;
+            pfnCache(camera_object);
+        }
+
+        return written;
+    }
+
+} // namespace SPF_CabinWalk::AzimuthState
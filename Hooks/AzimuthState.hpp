@@ -0,0 +1,146 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "SPF_CabinWalk.hpp" // For AzimuthBackup
+#include "Animation/AnimationController.hpp" // For CameraPosition enum
+
+namespace SPF_CabinWalk::AzimuthState
+{
+    // Upper bound on the azimuth count read from the camera object, so a bad offset cannot make a snapshot
+    // of gigabytes. Real cabins have a handful.
+    constexpr uint32_t MAX_AZIMUTHS = 1024;
+
+    /**
+     * @brief The saved values of one azimuth_range struct.
+     */
+    struct AzimuthEntry
+    {
+        bool present; // false for null azimuth_range pointers
+        AzimuthBackup values;
+    };
+
+    /**
+     * @class AzimuthList
+     * @brief The azimuths of a snapshot: held inline up to INLINE_CAPACITY, on the heap only beyond it.
+     * @details Copying a list of the usual size copies the inline block and never allocates.
+     */
+    class AzimuthList
+    {
+    public:
+        static constexpr uint32_t INLINE_CAPACITY = 20;
+
+        /**
+         * @brief Sets the number of entries. Their values are unspecified until written.
+         */
+        void Resize(uint32_t count)
+        {
+            m_count = count;
+            if (count > INLINE_CAPACITY)
+            {
+                m_spill.resize(count);
+            }
+            else
+            {
+                m_spill.clear(); // Keeps the capacity for the next large cabin.
+            }
+        }
+
+        uint32_t Size() const { return m_count; }
+
+        AzimuthEntry &operator[](uint32_t i) { return Data()[i]; }
+        const AzimuthEntry &operator[](uint32_t i) const { return Data()[i]; }
+
+    private:
+        AzimuthEntry *Data() { return m_count > INLINE_CAPACITY ? m_spill.data() : m_inline; }
+        const AzimuthEntry *Data() const { return m_count > INLINE_CAPACITY ? m_spill.data() : m_inline; }
+
+        AzimuthEntry m_inline[INLINE_CAPACITY] = {};
+        std::vector<AzimuthEntry> m_spill;
+        uint32_t m_count = 0;
+    };
+
+    /**
+     * @brief The interior mouse rotation limits, as exposed by the camera API.
+     */
+    struct RotationLimits
+    {
+        float left;
+        float right;
+        float up;
+        float down;
+    };
+
+    /**
+     * @brief Every camera-object value the plugin modifies for a position.
+     * @details One snapshot of the game's own (driver) values is captured; the state of every other
+     *          position is derived from it and applied as a diff against live memory.
+     */
+    struct Snapshot
+    {
+        SPF_FVector camera_pivot;
+        RotationLimits limits;
+        bool has_limits; // false if the camera API was unavailable at capture time
+        AzimuthList azimuths;
+    };
+
+    /**
+     * @brief Resolves the addresses of the fields the plugin touches in a camera object, or revalidates
+     *        those resolved for it by rereading its azimuth array pointer and count.
+     * @details Capture and Apply bind the object they are given too; calling this first, once per camera
+     *          hook call, is what reports the change.
+     * @return true if the object, or the azimuth array it holds, differs from the one bound before, as after
+     *         a truck swap. Its values are then the game's own.
+     */
+    bool BindCameraObject(long long camera_object);
+
+    /**
+     * @brief Reads the current values from the camera object and the camera API.
+     */
+    void Capture(long long camera_object, Snapshot &out);
+
+    /**
+     * @brief Computes the state a position needs, starting from the game's own driver state.
+     * @param position The logical camera position.
+     * @param original The snapshot captured while no modification was applied.
+     * @param[out] out The target state.
+     */
+    void BuildTarget(AnimationController::CameraPosition position, const Snapshot &original, Snapshot &out);
+
+    /**
+     * @brief Records the game's own state for the current vehicle and rebuilds the position profiles if it changed.
+     * @details Must only be called while the camera object is unmodified (i.e. in the driver state).
+     *          The live values are compared field by field against the stored driver profile, so a new
+     *          truck, a changed azimuth count or edited values rebuild the table; otherwise it is kept.
+     * @return true if the profiles were rebuilt.
+     */
+    bool UpdateOriginal(long long camera_object);
+
+    /**
+     * @brief Gets the precomputed state of a position for the current vehicle.
+     * @details Derived profiles are built lazily from the driver profile the first time they are needed
+     *          after UpdateOriginal or InvalidateDerivedProfiles.
+     * @return The profile, or nullptr if UpdateOriginal has not been called yet.
+     */
+    const Snapshot *GetProfile(AnimationController::CameraPosition position);
+
+    /**
+     * @brief Checks whether the driver profile is recorded and the derived profiles are built, so GetProfile
+     *        returns without building anything.
+     */
+    bool AreProfilesBuilt();
+
+    /**
+     * @brief Discards the derived profiles (passenger, standing, sofa) after the settings they use changed.
+     */
+    void InvalidateDerivedProfiles();
+
+    /**
+     * @brief Writes only the values that differ between `target` and live memory.
+     * @details If any azimuth or pivot value was written, the game's exterior sound angle cache is
+     *          rebuilt exactly once.
+     * @return The number of fields written.
+     */
+    uint32_t Apply(long long camera_object, const Snapshot &target);
+
+} // namespace SPF_CabinWalk::AzimuthState
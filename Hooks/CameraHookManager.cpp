@@ -1,11 +1,12 @@
-#define _USE_MATH_DEFINES // For M_PI on MSVC
-#include <cmath>          // For M_PI
 #include "Hooks/CameraHookManager.hpp"
 #include "Hooks/Offsets.hpp" // Added to resolve 'Offsets' and 'g_offsets'
-#include "Animation/AnimationController.hpp" // Added to resolve IsAnimating()
-#include "Animation/StandingAnimController.hpp" // Added to resolve IsAnimating()
+#include "Hooks/AzimuthState.hpp" // For the per-position azimuth, pivot and limit state
+#include "Animation/AnimationController.hpp" // For IsCameraSettled()
 #include "Animation/Positions/CameraPositions.hpp" // For accessing predefined camera positions
 #include "SPF_CabinWalk.hpp" // For g_ctx, PluginContext
+#include "Camera/CameraFacade.hpp" // For the per-frame camera state cache
+#include "Diagnostics/Profiler.hpp" // For the hot-path profiler overlay
+#include "Diagnostics/TraceProvider.hpp" // For position change markers
 
 namespace SPF_CabinWalk::CameraHookManager
 {
@@ -17,30 +18,26 @@ namespace SPF_CabinWalk::CameraHookManager
     using UpdateCameraFromInput_t = void (*)(long long camera_object, float delta_time);
     static UpdateCameraFromInput_t o_UpdateCameraFromInput = nullptr;
 
-    // Define the function pointer type for CacheExteriorSoundAngleRange
-    using CacheExteriorSoundAngleRange_t = void (*)(long long camera_object);
-
     // --- State Variables ---
     static AnimationController::CameraPosition g_current_camera_pos = AnimationController::CameraPosition::Driver;
     static AnimationController::CameraPosition g_previous_camera_pos = AnimationController::CameraPosition::Driver;
 
     // --- Backup Storage ---
-    static AzimuthBackup g_original_azimuth_values[20];
-    static uint32_t g_azimuth_backup_count = 0;
-    static SPF_FVector g_original_camera_pivot = {0};
-    static float g_original_mouse_left_limit = 0.0f;
-    static float g_original_mouse_right_limit = 0.0f;
-    static float g_original_mouse_up_limit = 0.0f;
-    static float g_original_mouse_down_limit = 0.0f;
+    // true while the camera object holds the game's own values; the per-vehicle profiles are kept in AzimuthState.
+    static bool g_live_is_original = true;
+
+    // Set while the plugin is idle in the driver seat; the detour then only forwards to the game.
+    static bool g_idle = false;
+
+    // Set when the next detour call should build the position profiles ahead of a position change.
+    static bool g_prewarm_requested = false;
 
     // =================================================================================================
     // Forward Declarations for Internal Functions
     // =================================================================================================
 
     static void Detour_UpdateCameraFromInput(long long camera_object, float delta_time);
-    static void BackupAndModifyAzimuths(long long camera_object);
-    static void RestoreAzimuths(long long camera_object);
-    static void ZeroAzimuths(long long camera_object);
+    static void ApplyPositionState(long long camera_object, AnimationController::CameraPosition position);
 
     // =================================================================================================
     // Public Functions
@@ -65,345 +62,137 @@ namespace SPF_CabinWalk::CameraHookManager
 
     void SetCurrentCameraPosition(AnimationController::CameraPosition new_pos)
     {
+        if (new_pos != g_current_camera_pos)
+        {
+            TraceProvider::EmitMarker(TraceProvider::Marker::Position, static_cast<uint32_t>(g_current_camera_pos), static_cast<uint32_t>(new_pos));
+        }
         g_current_camera_pos = new_pos;
     }
 
+    bool IsSettled()
+    {
+        return g_current_camera_pos == g_previous_camera_pos;
+    }
+
+    void SetIdle(bool idle)
+    {
+        g_idle = idle;
+    }
+
+    void RequestProfilePrewarm()
+    {
+        if (!AzimuthState::AreProfilesBuilt())
+        {
+            g_prewarm_requested = true;
+        }
+    }
+
     // =================================================================================================
     // Internal Hook Implementation
     // =================================================================================================
 
     static void Detour_UpdateCameraFromInput(long long camera_object, float delta_time)
     {
-
-        // If the logical camera position has not changed, just run the original function and 360-wrap logic.
-        if (g_current_camera_pos == g_previous_camera_pos)
+        // A new camera object, or a new azimuth array in it, holds the game's own values for the vehicle:
+        // record them, and put the current position's state back on top.
+        if (AzimuthState::BindCameraObject(camera_object) && !g_live_is_original)
         {
-            if (o_UpdateCameraFromInput) {
-                o_UpdateCameraFromInput(camera_object, delta_time);
-            }
+            g_live_is_original = true;
+            g_previous_camera_pos = AnimationController::CameraPosition::None;
         }
-        else // A position change has occurred
-        {
-            // First, always restore to a clean slate if the previous state was not the default driver state.
-            // This prevents modifications from stacking (e.g., passenger inverted limits + zeroed azimuths).
-            if (g_previous_camera_pos != AnimationController::CameraPosition::Driver)
-            {
-                RestoreAzimuths(camera_object);
-            }
-            
-            // Now, apply the new state's modifications from the clean, default state.
-            switch (g_current_camera_pos)
-            {
-                case AnimationController::CameraPosition::Passenger:
-                    BackupAndModifyAzimuths(camera_object);
-                    break;
-
-                case AnimationController::CameraPosition::Standing:
-                case AnimationController::CameraPosition::SofaSit1:
-                case AnimationController::CameraPosition::SofaLie:
-                case AnimationController::CameraPosition::SofaSit2:
-                    ZeroAzimuths(camera_object); // The switch inside this handles different limits
-                    break;
-
-                case AnimationController::CameraPosition::Driver:
-                default:
-                    // Do nothing, we are already restored to default.
-                    break;
-            }
-
-            // Update the previous position for the next frame's comparison.
-            g_previous_camera_pos = g_current_camera_pos;
 
-            // Call the original function after our modifications.
-            if (o_UpdateCameraFromInput)
+        // Recording the driver profile reads the camera object, so it can only be done in here. The live
+        // values are only the game's own while nothing is modified.
+        if (g_prewarm_requested)
+        {
+            g_prewarm_requested = false;
+            if (g_live_is_original)
             {
-                o_UpdateCameraFromInput(camera_object, delta_time);
+                AzimuthState::UpdateOriginal(camera_object);
             }
+            AzimuthState::GetProfile(g_current_camera_pos);
         }
 
-        // Handle 360-degree rotation wrapping for any free-look position
-        if ((g_current_camera_pos == AnimationController::CameraPosition::Standing ||
-             g_current_camera_pos == AnimationController::CameraPosition::SofaSit1 ||
-             g_current_camera_pos == AnimationController::CameraPosition::SofaLie ||
-             g_current_camera_pos == AnimationController::CameraPosition::SofaSit2) 
-             && g_ctx.cameraAPI)
+        // Idle in the driver seat: the camera object already holds the game's own state and nothing is pending.
+        if (g_idle)
         {
-            float yaw, pitch;
-            g_ctx.cameraAPI->Cam_GetInteriorHeadRot(&yaw, &pitch);
-
-            const float wrap_threshold = M_PI; // 180 degrees in radians
-            const float wrap_value = 2 * M_PI; // 360 degrees in radians
-
-            if (yaw > wrap_threshold)
-            {
-                g_ctx.cameraAPI->Cam_SetInteriorHeadRot(yaw - wrap_value, pitch);
-            }
-            else if (yaw < -wrap_threshold)
+            if (o_UpdateCameraFromInput)
             {
-                g_ctx.cameraAPI->Cam_SetInteriorHeadRot(yaw + wrap_value, pitch);
+                o_UpdateCameraFromInput(camera_object, delta_time);
             }
+            return;
         }
-    }
-
-    static void BackupAndModifyAzimuths(long long camera_object)
-    {
-        // 1. Handle Camera Pivot
-        float *p_camera_pivot_x = (float *)((char *)camera_object + Offsets::g_offsets.camera_pivot_offset);
-        float *p_camera_pivot_y = (float *)((char *)camera_object + Offsets::g_offsets.camera_pivot_offset + 4);
-        float *p_camera_pivot_z = (float *)((char *)camera_object + Offsets::g_offsets.camera_pivot_offset + 8);
-
-        g_original_camera_pivot.x = *p_camera_pivot_x;
-        g_original_camera_pivot.y = *p_camera_pivot_y;
-        g_original_camera_pivot.z = *p_camera_pivot_z;
-
-        *p_camera_pivot_x = g_ctx.settings.positions.passenger_seat.position.x;
-        *p_camera_pivot_y = g_ctx.settings.positions.passenger_seat.position.y;
-        *p_camera_pivot_z = g_ctx.settings.positions.passenger_seat.position.z;
 
-        // 2. Handle Mouse Limits via API
-        if (g_ctx.cameraAPI)
-        {
-            g_ctx.cameraAPI->Cam_GetInteriorRotationLimits(
-                &g_original_mouse_left_limit,
-                &g_original_mouse_right_limit,
-                &g_original_mouse_up_limit,
-                &g_original_mouse_down_limit);
-
-            float new_left_limit = g_original_mouse_right_limit * -1.0f;
-            float new_right_limit = g_original_mouse_left_limit * -1.0f;
+        SPF_CABINWALK_PROFILE_ZONE(CameraHook);
 
-            g_ctx.cameraAPI->Cam_SetInteriorRotationLimits(
-                new_left_limit,
-                new_right_limit,
-                g_original_mouse_up_limit,
-                g_original_mouse_down_limit);
-        }
+        // Free-look positions keep the yaw wrapped into [-PI, PI]; the facade applies this to every head rotation read and write.
+        const bool is_free_look = g_current_camera_pos == AnimationController::CameraPosition::Standing ||
+                                  g_current_camera_pos == AnimationController::CameraPosition::SofaSit1 ||
+                                  g_current_camera_pos == AnimationController::CameraPosition::SofaLie ||
+                                  g_current_camera_pos == AnimationController::CameraPosition::SofaSit2;
+        CameraFacade::SetYawWrapEnabled(is_free_look);
 
-        // 3. Handle Azimuth Ranges
-        long long **azimuth_array_ptr = (long long **)((char *)camera_object + Offsets::g_offsets.azimuth_array_offset);
-        long long azimuth_count = *(long long *)((char *)camera_object + Offsets::g_offsets.azimuth_count_offset);
-        g_azimuth_backup_count = (azimuth_count < 20) ? (uint32_t)azimuth_count : 20;
+        // In hook-driven mode, apply this frame's transition pose right before the game evaluates the camera.
+        AnimationController::AdvanceFromCameraHook(delta_time);
+        CameraFacade::Flush();
 
-        for (uint32_t i = 0; i < g_azimuth_backup_count; ++i)
+        // If the logical camera position has not changed, just run the original function.
+        if (g_current_camera_pos == g_previous_camera_pos)
         {
-            long long azimuth_struct_ptr = (*azimuth_array_ptr)[i];
-            if (azimuth_struct_ptr)
-            {
-                // --- Backup original values FIRST ---
-                float *p_start_azimuth = (float *)((char *)azimuth_struct_ptr + Offsets::g_offsets.start_azimuth_offset);
-                float *p_end_azimuth = (float *)((char *)azimuth_struct_ptr + Offsets::g_offsets.end_azimuth_offset);
-                g_original_azimuth_values[i].start = *p_start_azimuth;
-                g_original_azimuth_values[i].end = *p_end_azimuth;
-
-                char *p_outside_flag = (char *)((char *)azimuth_struct_ptr + Offsets::g_offsets.azimuth_outside_flag_offset);
-                g_original_azimuth_values[i].outside_flag = *p_outside_flag;
-
-                float *p_start_offset_vec = (float *)((char *)azimuth_struct_ptr + Offsets::g_offsets.start_head_offset_x_offset);
-                float *p_end_offset_vec = (float *)((char *)azimuth_struct_ptr + Offsets::g_offsets.end_head_offset_x_offset);
-                g_original_azimuth_values[i].start_head_offset = {p_start_offset_vec[0], p_start_offset_vec[1], p_start_offset_vec[2]};
-                g_original_azimuth_values[i].end_head_offset = {p_end_offset_vec[0], p_end_offset_vec[1], p_end_offset_vec[2]};
-
-                // --- Now, perform modifications ---
-                // 1. Invert and check if angles need to be swapped
-                *p_start_azimuth *= -1.0f;
-                *p_end_azimuth *= -1.0f;
-                bool angles_were_swapped = false;
-                if (*p_start_azimuth > *p_end_azimuth)
-                {
-                    float temp = *p_start_azimuth;
-                    *p_start_azimuth = *p_end_azimuth;
-                    *p_end_azimuth = temp;
-                    angles_were_swapped = true;
-                }
-
-                // 2. Conditionally swap head offsets based on angle swap
-                if (angles_were_swapped)
-                {
-                    // SWAP head offsets
-                    p_start_offset_vec[0] = g_original_azimuth_values[i].end_head_offset.x * -1.0f;
-                    p_start_offset_vec[1] = g_original_azimuth_values[i].end_head_offset.y;
-                    p_start_offset_vec[2] = g_original_azimuth_values[i].end_head_offset.z;
-
-                    p_end_offset_vec[0] = g_original_azimuth_values[i].start_head_offset.x * -1.0f;
-                    p_end_offset_vec[1] = g_original_azimuth_values[i].start_head_offset.y;
-                    p_end_offset_vec[2] = g_original_azimuth_values[i].start_head_offset.z;
-                }
-                else
-                {
-                    // DO NOT SWAP head offsets
-                    p_start_offset_vec[0] = g_original_azimuth_values[i].start_head_offset.x * -1.0f;
-                    p_start_offset_vec[1] = g_original_azimuth_values[i].start_head_offset.y;
-                    p_start_offset_vec[2] = g_original_azimuth_values[i].start_head_offset.z;
-
-                    p_end_offset_vec[0] = g_original_azimuth_values[i].end_head_offset.x * -1.0f;
-                    p_end_offset_vec[1] = g_original_azimuth_values[i].end_head_offset.y;
-                    p_end_offset_vec[2] = g_original_azimuth_values[i].end_head_offset.z;
-                }
+            if (o_UpdateCameraFromInput) {
+                o_UpdateCameraFromInput(camera_object, delta_time);
             }
         }
-
-        // 4. Recalculate outside sound cache
-        if (Offsets::g_offsets.pfnCacheExteriorSoundAngleRange)
+        else // A position change has occurred
         {
-            CacheExteriorSoundAngleRange_t pfnCache = (CacheExteriorSoundAngleRange_t)Offsets::g_offsets.pfnCacheExteriorSoundAngleRange;
-            pfnCache(camera_object);
-        }
-    }
-
-    static void RestoreAzimuths(long long camera_object)
-    {
-        // 1. Restore Camera Pivot
-        float *p_camera_pivot_x = (float *)((char *)camera_object + Offsets::g_offsets.camera_pivot_offset);
-        float *p_camera_pivot_y = (float *)((char *)camera_object + Offsets::g_offsets.camera_pivot_offset + 4);
-        float *p_camera_pivot_z = (float *)((char *)camera_object + Offsets::g_offsets.camera_pivot_offset + 8);
-        *p_camera_pivot_x = g_original_camera_pivot.x;
-        *p_camera_pivot_y = g_original_camera_pivot.y;
-        *p_camera_pivot_z = g_original_camera_pivot.z;
+            // Move the camera object straight to the new position's state, writing only what differs.
+            ApplyPositionState(camera_object, g_current_camera_pos);
 
-        // 2. Restore Mouse Limits via API
-        if (g_ctx.cameraAPI)
-        {
-            g_ctx.cameraAPI->Cam_SetInteriorRotationLimits(
-                g_original_mouse_left_limit,
-                g_original_mouse_right_limit,
-                g_original_mouse_up_limit,
-                g_original_mouse_down_limit);
-        }
+            // Update the previous position for the next frame's comparison.
+            g_previous_camera_pos = g_current_camera_pos;
 
-        // 3. Restore Azimuth Ranges
-        long long **azimuth_array_ptr = (long long **)((char *)camera_object + Offsets::g_offsets.azimuth_array_offset);
-        for (uint32_t i = 0; i < g_azimuth_backup_count; ++i)
-        {
-            long long azimuth_struct_ptr = (*azimuth_array_ptr)[i];
-            if (azimuth_struct_ptr)
+            // Call the original function after our modifications.
+            if (o_UpdateCameraFromInput)
             {
-                // Restore angles
-                float *p_start_azimuth = (float *)((char *)azimuth_struct_ptr + Offsets::g_offsets.start_azimuth_offset);
-                float *p_end_azimuth = (float *)((char *)azimuth_struct_ptr + Offsets::g_offsets.end_azimuth_offset);
-                *p_start_azimuth = g_original_azimuth_values[i].start;
-                *p_end_azimuth = g_original_azimuth_values[i].end;
-
-                // Restore outside flag
-                char *p_outside_flag = (char *)((char *)azimuth_struct_ptr + Offsets::g_offsets.azimuth_outside_flag_offset);
-                *p_outside_flag = g_original_azimuth_values[i].outside_flag;
-
-                // Restore full head offset vectors
-                float *p_start_offset_vec = (float *)((char *)azimuth_struct_ptr + Offsets::g_offsets.start_head_offset_x_offset);
-                p_start_offset_vec[0] = g_original_azimuth_values[i].start_head_offset.x;
-                p_start_offset_vec[1] = g_original_azimuth_values[i].start_head_offset.y;
-                p_start_offset_vec[2] = g_original_azimuth_values[i].start_head_offset.z;
-
-                float *p_end_offset_vec = (float *)((char *)azimuth_struct_ptr + Offsets::g_offsets.end_head_offset_x_offset);
-                p_end_offset_vec[0] = g_original_azimuth_values[i].end_head_offset.x;
-                p_end_offset_vec[1] = g_original_azimuth_values[i].end_head_offset.y;
-                p_end_offset_vec[2] = g_original_azimuth_values[i].end_head_offset.z;
+                o_UpdateCameraFromInput(camera_object, delta_time);
             }
         }
 
-        // 4. Recalculate outside sound cache
-        if (Offsets::g_offsets.pfnCacheExteriorSoundAngleRange)
-        {
-            CacheExteriorSoundAngleRange_t pfnCache = (CacheExteriorSoundAngleRange_t)Offsets::g_offsets.pfnCacheExteriorSoundAngleRange;
-            pfnCache(camera_object);
-        }
+        // The original function has applied mouse input, so the cached camera state is stale. Any
+        // 360-degree wrap this needs happens on the next read, which the next frame makes anyway.
+        CameraFacade::Invalidate();
     }
 
-    static void ZeroAzimuths(long long camera_object)
+    static void ApplyPositionState(long long camera_object, AnimationController::CameraPosition position)
     {
-        // 1. Handle Base Head Offset
-        // No change needed for base head offset as animation controller directly sets position
-
-        // 2. Handle Mouse Limits via API
-        if (g_ctx.cameraAPI)
+        // While nothing is modified the live values are the game's own. Checking them here rebuilds the
+        // profiles whenever the vehicle (or its interior camera definition) has changed.
+        if (g_live_is_original)
         {
-            g_ctx.cameraAPI->Cam_GetInteriorRotationLimits(
-                &g_original_mouse_left_limit,
-                &g_original_mouse_right_limit,
-                &g_original_mouse_up_limit,
-                &g_original_mouse_down_limit);
-
-            switch (g_current_camera_pos)
-            {
-                case AnimationController::CameraPosition::Standing:
-                    // Set wide limits for free look in standing mode
-                    g_ctx.cameraAPI->Cam_SetInteriorRotationLimits(231.0f, -231.0f, g_original_mouse_up_limit, -80.0f);
-                    break;
-                
-                case AnimationController::CameraPosition::SofaSit1:
-                case AnimationController::CameraPosition::SofaLie:
-                case AnimationController::CameraPosition::SofaSit2:
-                    // Set custom limits for sofa positions
-                    g_ctx.cameraAPI->Cam_SetInteriorRotationLimits(
-                        g_ctx.settings.sofa_limits.yaw_left,
-                        g_ctx.settings.sofa_limits.yaw_right,
-                        g_ctx.settings.sofa_limits.pitch_up,
-                        g_ctx.settings.sofa_limits.pitch_down
-                    );
-                    break;
-                
-                default:
-                    // Fallback, should not happen if logic is correct
-                    break;
-            }
+            AzimuthState::UpdateOriginal(camera_object);
         }
 
-        // 3. Handle Azimuth Ranges - Zero them out
-        long long **azimuth_array_ptr = (long long **)((char *)camera_object + Offsets::g_offsets.azimuth_array_offset);
-        long long azimuth_count = *(long long *)((char *)camera_object + Offsets::g_offsets.azimuth_count_offset);
-        g_azimuth_backup_count = (azimuth_count < 20) ? (uint32_t)azimuth_count : 20;
-
-        for (uint32_t i = 0; i < g_azimuth_backup_count; ++i)
+        // Every profile is derived from the game's own state, so modifications can never stack.
+        const AzimuthState::Snapshot *target = AzimuthState::GetProfile(position);
+        if (target)
         {
-            long long azimuth_struct_ptr = (*azimuth_array_ptr)[i];
-            if (azimuth_struct_ptr)
-            {
-                // Backup original values before zeroing
-                float *p_start_azimuth = (float *)((char *)azimuth_struct_ptr + Offsets::g_offsets.start_azimuth_offset);
-                float *p_end_azimuth = (float *)((char *)azimuth_struct_ptr + Offsets::g_offsets.end_azimuth_offset);
-                g_original_azimuth_values[i].start = *p_start_azimuth;
-                g_original_azimuth_values[i].end = *p_end_azimuth;
-
-                char *p_outside_flag = (char *)((char *)azimuth_struct_ptr + Offsets::g_offsets.azimuth_outside_flag_offset);
-                g_original_azimuth_values[i].outside_flag = *p_outside_flag;
-
-                float *p_start_offset_vec = (float *)((char *)azimuth_struct_ptr + Offsets::g_offsets.start_head_offset_x_offset);
-                float *p_end_offset_vec = (float *)((char *)azimuth_struct_ptr + Offsets::g_offsets.end_head_offset_x_offset);
-                g_original_azimuth_values[i].start_head_offset = {p_start_offset_vec[0], p_start_offset_vec[1], p_start_offset_vec[2]};
-                g_original_azimuth_values[i].end_head_offset = {p_end_offset_vec[0], p_end_offset_vec[1], p_end_offset_vec[2]};
-
-                // Zero out the azimuths, head offsets and outside flag
-                *p_start_azimuth = 0.0f;
-                *p_end_azimuth = 0.0f;
-                *p_outside_flag = 0;
-
-                float *p_start_offset_vec_current = p_start_offset_vec;
-                float *p_end_offset_vec_current = p_end_offset_vec;
-
-                p_start_offset_vec[0] = 0.0f;
-                p_start_offset_vec[1] = 0.0f;
-                p_start_offset_vec[2] = 0.0f;
-                p_end_offset_vec[0] = 0.0f;
-                p_end_offset_vec[1] = 0.0f;
-                p_end_offset_vec[2] = 0.0f;
-            }
+            AzimuthState::Apply(camera_object, *target);
         }
 
-        // 4. Recalculate outside sound cache
-        if (Offsets::g_offsets.pfnCacheExteriorSoundAngleRange)
-        {
-            CacheExteriorSoundAngleRange_t pfnCache = (CacheExteriorSoundAngleRange_t)Offsets::g_offsets.pfnCacheExteriorSoundAngleRange;
-            pfnCache(camera_object);
-        }
+        g_live_is_original = (position == AnimationController::CameraPosition::Driver ||
+                              position == AnimationController::CameraPosition::None);
     }
 
 void NotifySettingsUpdated()
     {
+        // Passenger pivot and sofa limits come from the settings, so those profiles must be rebuilt.
+        AzimuthState::InvalidateDerivedProfiles();
+
         // Only force re-evaluation if we are not actively animating a major sequence,
         // as the animation itself will handle position updates.
         // Also, ensure there's a current valid position to re-evaluate.
         if (g_current_camera_pos != AnimationController::CameraPosition::None &&
-            !SPF_CabinWalk::AnimationController::IsAnimating() &&
-            !SPF_CabinWalk::StandingAnimController::IsAnimating())
+            SPF_CabinWalk::AnimationController::IsCameraSettled())
         {
             g_previous_camera_pos = AnimationController::CameraPosition::None; // Force re-evaluation on next update
         }
@@ -21,6 +21,25 @@ namespace SPF_CabinWalk::CameraHookManager
      */
     void SetCurrentCameraPosition(AnimationController::CameraPosition new_pos);
 
+    /**
+     * @brief Checks whether the hook has applied the state of the current position.
+     */
+    bool IsSettled();
+
+    /**
+     * @brief Switches the detour to a plain pass-through while the plugin is idle in the driver seat.
+     * @details Only valid once IsSettled() holds there: the idle detour calls the original function and
+     *          nothing else.
+     */
+    void SetIdle(bool idle);
+
+    /**
+     * @brief Has the next detour call build the position profiles if they are not built, so the first
+     *        position change after it writes the camera object without building anything.
+     * @details Cheap to call every frame; it only arms the detour while the profiles are missing.
+     */
+    void RequestProfilePrewarm();
+
         /**
          * @brief Notifies the camera hook manager that settings have been updated.
          *        This will force a re-application of current camera position settings on the next update.
@@ -1,117 +1,501 @@
 #include "Hooks/Offsets.hpp"
+#include "Hooks/PatternScanner.hpp"
 #include "SPF_CabinWalk.hpp" // For g_ctx to log errors
+#include "Diagnostics/TraceProvider.hpp" // For the offset scan zone
+#include <atomic>
+#include <thread>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h> // For GetModuleHandleW and the PE header structures
+#endif
 
 namespace SPF_CabinWalk::Offsets
 {
     // The single, global instance of the plugin's offsets.
     Offsets g_offsets;
 
-    bool Find(const SPF_Hooks_API* hooks_api)
+    // =================================================================================================
+    // Internal Types
+    // =================================================================================================
+
+    /**
+     * @brief The address of every pattern hit that the offsets are read from.
+     * @details These are what the cache stores (as RVAs), so that a cached entry is re-validated against
+     *          exactly the bytes the offsets are extracted from.
+     */
+    struct PatternAddresses
     {
-        if (!hooks_api)
+        uintptr_t update_camera_from_input;
+        uintptr_t azimuth_array_and_count;
+        uintptr_t update_interior_camera;
+        uintptr_t start_azimuth;
+        uintptr_t end_azimuth;
+        uintptr_t azimuth_outside_flag;
+        uintptr_t head_offsets;
+        uintptr_t camera_pivot;
+        uintptr_t cache_exterior_sound_angle_range;
+    };
+
+    /**
+     * @brief Binds a pattern hit to its signature and its key in the persistent cache.
+     */
+    struct CachedPattern
+    {
+        uintptr_t PatternAddresses::*address;
+        const char *signature;
+        const char *config_key;
+    };
+
+    static const CachedPattern g_cached_patterns[] = {
+        {&PatternAddresses::update_camera_from_input, G_UPDATE_CAMERA_FROM_INPUT_SIGNATURE, "settings.offset_cache.update_camera_from_input"},
+        {&PatternAddresses::azimuth_array_and_count, G_AZIMUTH_ARRAY_AND_COUNT_PATTERN, "settings.offset_cache.azimuth_array_and_count"},
+        {&PatternAddresses::update_interior_camera, G_UPDATE_INTERIOR_CAMERA_SIGNATURE, "settings.offset_cache.update_interior_camera"},
+        {&PatternAddresses::start_azimuth, G_START_AZIMUTH_SIGNATURE, "settings.offset_cache.start_azimuth"},
+        {&PatternAddresses::end_azimuth, G_END_AZIMUTH_SIGNATURE, "settings.offset_cache.end_azimuth"},
+        {&PatternAddresses::azimuth_outside_flag, G_AZIMUTH_OUTSIDE_FLAG_SIGNATURE, "settings.offset_cache.azimuth_outside_flag"},
+        {&PatternAddresses::head_offsets, G_HEAD_OFFSETS_SIGNATURE, "settings.offset_cache.head_offsets"},
+        {&PatternAddresses::camera_pivot, G_CAMERA_PIVOT_SIGNATURE, "settings.offset_cache.camera_pivot"},
+        {&PatternAddresses::cache_exterior_sound_angle_range, G_CACHE_EXTERIOR_SOUND_ANGLE_RANGE_SIGNATURE, "settings.offset_cache.cache_exterior_sound_angle_range"},
+    };
+
+    static const char *const G_CACHE_BUILD_KEY = "settings.offset_cache.build_key";
+
+    // =================================================================================================
+    // Internal Helpers
+    // =================================================================================================
+
+    static void LogError(const char *message)
+    {
+        if (g_ctx.loggerHandle)
+        {
+            g_ctx.loadAPI->logger->Log(g_ctx.loggerHandle, SPF_LOG_ERROR, message);
+        }
+    }
+
+    /**
+     * @brief Compares memory against a signature. Wildcards match any byte.
+     * @param available The number of readable bytes at `address`.
+     */
+    static bool MatchesAt(uintptr_t address, const char *signature, size_t available)
+    {
+        PatternScanner::Pattern pattern;
+        return PatternScanner::Compile(signature, pattern) && PatternScanner::MatchesAt(pattern, address, available);
+    }
+
+    /**
+     * @brief Identifies the loaded game executable.
+     * @param[out] module_base The base address of the game module.
+     * @param[out] module_size The size of the mapped image.
+     * @return A key that changes with every game build (PE timestamp and image size), or 0 if unavailable.
+     */
+    static uint64_t GetBuildKey(uintptr_t *module_base, size_t *module_size)
+    {
+        *module_base = 0;
+        *module_size = 0;
+
+#ifdef _WIN32
+        const uintptr_t base = reinterpret_cast<uintptr_t>(GetModuleHandleW(nullptr));
+        if (!base)
+        {
+            return 0;
+        }
+
+        const auto *dos_header = reinterpret_cast<const IMAGE_DOS_HEADER *>(base);
+        if (dos_header->e_magic != IMAGE_DOS_SIGNATURE)
+        {
+            return 0;
+        }
+
+        const auto *nt_headers = reinterpret_cast<const IMAGE_NT_HEADERS *>(base + dos_header->e_lfanew);
+        if (nt_headers->Signature != IMAGE_NT_SIGNATURE)
+        {
+            return 0;
+        }
+
+        *module_base = base;
+        *module_size = nt_headers->OptionalHeader.SizeOfImage;
+        return (static_cast<uint64_t>(nt_headers->FileHeader.TimeDateStamp) << 32) | nt_headers->OptionalHeader.SizeOfImage;
+#else
+        return 0;
+#endif
+    }
+
+    /**
+     * @brief Loads the cached pattern addresses and confirms each one still matches its signature.
+     * @return true if every cached address is valid for the running game build.
+     */
+    static bool LoadCachedAddresses(uint64_t build_key, uintptr_t module_base, size_t module_size, PatternAddresses &addresses)
+    {
+        if (!build_key || !g_ctx.configAPI || !g_ctx.configHandle)
         {
-            if (g_ctx.loggerHandle)
-            {
-                g_ctx.loadAPI->logger->Log(g_ctx.loggerHandle, SPF_LOG_ERROR, "[Offsets] Hooks API is null, cannot find offsets.");
-            }
             return false;
         }
 
-        // Part A: Find offsets in UpdateCameraFromInput
-        uintptr_t update_cam_fn_address = hooks_api->Hook_FindPattern(G_UPDATE_CAMERA_FROM_INPUT_SIGNATURE);
-        if (!update_cam_fn_address)
+        const uint64_t cached_key = static_cast<uint64_t>(g_ctx.configAPI->Cfg_GetInt(g_ctx.configHandle, G_CACHE_BUILD_KEY, 0));
+        if (cached_key != build_key)
         {
-            if (g_ctx.loggerHandle)
-            {
-                g_ctx.loadAPI->logger->Log(g_ctx.loggerHandle, SPF_LOG_ERROR, "[Offsets] Could not find G_UPDATE_CAMERA_FROM_INPUT_SIGNATURE.");
-            }
             return false;
         }
 
-        uintptr_t array_pattern_address = hooks_api->Hook_FindPatternFrom(G_AZIMUTH_ARRAY_AND_COUNT_PATTERN, update_cam_fn_address, 2048);
-        if (!array_pattern_address)
+        for (const CachedPattern &pattern : g_cached_patterns)
         {
-            if (g_ctx.loggerHandle)
+            const uint64_t rva = static_cast<uint64_t>(g_ctx.configAPI->Cfg_GetInt(g_ctx.configHandle, pattern.config_key, 0));
+            if (rva == 0 || rva >= module_size)
             {
-                g_ctx.loadAPI->logger->Log(g_ctx.loggerHandle, SPF_LOG_ERROR, "[Offsets] Could not find G_AZIMUTH_ARRAY_AND_COUNT_PATTERN.");
+                return false;
             }
-            return false;
+
+            const uintptr_t address = module_base + static_cast<uintptr_t>(rva);
+            if (!MatchesAt(address, pattern.signature, module_size - static_cast<size_t>(rva)))
+            {
+                return false;
+            }
+            addresses.*pattern.address = address;
+        }
+        return true;
+    }
+
+    static void StoreCachedAddresses(uint64_t build_key, uintptr_t module_base, const PatternAddresses &addresses)
+    {
+        if (!build_key || !g_ctx.configAPI || !g_ctx.configHandle)
+        {
+            return;
         }
-        
-        g_offsets.azimuth_array_offset = *(uint32_t *)(array_pattern_address + 7);
-        g_offsets.azimuth_count_offset = *(uint32_t *)(array_pattern_address + 14);
 
-        // Part B: Find offsets in UpdateInteriorCamera using a chained search
-        uintptr_t interior_cam_fn_address = hooks_api->Hook_FindPattern(G_UPDATE_INTERIOR_CAMERA_SIGNATURE);
-        if (!interior_cam_fn_address)
+        for (const CachedPattern &pattern : g_cached_patterns)
+        {
+            const uintptr_t rva = addresses.*pattern.address - module_base;
+            g_ctx.configAPI->Cfg_SetInt(g_ctx.configHandle, pattern.config_key, static_cast<int64_t>(rva));
+        }
+
+        // Written last, so an interrupted store never leaves a key pointing at partial data.
+        g_ctx.configAPI->Cfg_SetInt(g_ctx.configHandle, G_CACHE_BUILD_KEY, static_cast<int64_t>(build_key));
+    }
+
+    /**
+     * @brief The signatures that are searched for in the whole module (the others are searched near them).
+     */
+    static const char *const g_root_signatures[] = {
+        G_UPDATE_CAMERA_FROM_INPUT_SIGNATURE,
+        G_UPDATE_INTERIOR_CAMERA_SIGNATURE,
+        G_CACHE_EXTERIOR_SOUND_ANGLE_RANGE_SIGNATURE,
+    };
+    static const char *const g_root_signature_names[] = {
+        "G_UPDATE_CAMERA_FROM_INPUT_SIGNATURE",
+        "G_UPDATE_INTERIOR_CAMERA_SIGNATURE",
+        "G_CACHE_EXTERIOR_SOUND_ANGLE_RANGE_SIGNATURE",
+    };
+    constexpr size_t ROOT_SIGNATURE_COUNT = sizeof(g_root_signatures) / sizeof(g_root_signatures[0]);
+
+    /**
+     * @brief What a scan found, kept so it can be logged from the game thread.
+     */
+    struct ScanReport
+    {
+        const char *error;                        // The first pattern that was not found, or nullptr.
+        bool single_pass;                         // true if the root signatures were found in one module pass.
+        uint32_t root_hits[ROOT_SIGNATURE_COUNT]; // Hit counts of the root signatures (single pass only).
+    };
+
+    /**
+     * @brief Finds the root signatures in one pass over the module's executable sections.
+     * @details The first hit of each is used, like Hook_FindPattern does. Falls back to one
+     *          Hook_FindPattern call per signature if the module cannot be walked directly.
+     */
+    static void FindRootAddresses(const SPF_Hooks_API *hooks_api, uintptr_t (&roots)[ROOT_SIGNATURE_COUNT], ScanReport &report)
+    {
+        PatternScanner::Pattern patterns[ROOT_SIGNATURE_COUNT];
+        PatternScanner::Result results[ROOT_SIGNATURE_COUNT];
+
+        bool compiled = true;
+        for (size_t i = 0; i < ROOT_SIGNATURE_COUNT; ++i)
         {
-            if (g_ctx.loggerHandle)
+            compiled = PatternScanner::Compile(g_root_signatures[i], patterns[i]) && compiled;
+        }
+
+        report.single_pass = compiled && PatternScanner::ScanModule(patterns, results, ROOT_SIGNATURE_COUNT);
+        for (size_t i = 0; i < ROOT_SIGNATURE_COUNT; ++i)
+        {
+            if (report.single_pass)
             {
-                g_ctx.loadAPI->logger->Log(g_ctx.loggerHandle, SPF_LOG_ERROR, "[Offsets] Could not find G_UPDATE_INTERIOR_CAMERA_SIGNATURE.");
+                report.root_hits[i] = results[i].count;
+                roots[i] = results[i].count ? results[i].hits[0] : 0;
+            }
+            else
+            {
+                report.root_hits[i] = 0;
+                roots[i] = hooks_api->Hook_FindPattern(g_root_signatures[i]);
             }
-            return false;
         }
+    }
+
+    /**
+     * @brief Locates every pattern by signature scanning.
+     * @details Does not log, so that it can run on the discovery worker thread.
+     * @param[out] report The outcome of the scan; `error` names the first pattern that was not found.
+     * @return true if all patterns were found, false otherwise.
+     */
+    static bool ScanAddresses(const SPF_Hooks_API *hooks_api, PatternAddresses &addresses, ScanReport &report)
+    {
+        SPF_CABINWALK_TRACE_ZONE("Offsets::ScanAddresses");
+        report.error = nullptr;
+        const char **error = &report.error;
+
+        uintptr_t roots[ROOT_SIGNATURE_COUNT];
+        FindRootAddresses(hooks_api, roots, report);
+
+        // Part A: Find offsets in UpdateCameraFromInput
+        addresses.update_camera_from_input = roots[0];
+        if (!addresses.update_camera_from_input) { *error = "[Offsets] Could not find G_UPDATE_CAMERA_FROM_INPUT_SIGNATURE."; return false; }
+
+        addresses.azimuth_array_and_count = hooks_api->Hook_FindPatternFrom(G_AZIMUTH_ARRAY_AND_COUNT_PATTERN, addresses.update_camera_from_input, 2048);
+        if (!addresses.azimuth_array_and_count) { *error = "[Offsets] Could not find G_AZIMUTH_ARRAY_AND_COUNT_PATTERN."; return false; }
+
+        // Part B: Find offsets in UpdateInteriorCamera using a chained search
+        addresses.update_interior_camera = roots[1];
+        if (!addresses.update_interior_camera) { *error = "[Offsets] Could not find G_UPDATE_INTERIOR_CAMERA_SIGNATURE."; return false; }
+
+        // --- start_azimuth_offset (0x10) ---
+        addresses.start_azimuth = hooks_api->Hook_FindPatternFrom(G_START_AZIMUTH_SIGNATURE, addresses.update_interior_camera, 200);
+        if (!addresses.start_azimuth) { *error = "[Offsets] Could not find G_START_AZIMUTH_SIGNATURE."; return false; }
+
+        // --- end_azimuth_offset (0x14) ---
+        addresses.end_azimuth = hooks_api->Hook_FindPatternFrom(G_END_AZIMUTH_SIGNATURE, addresses.start_azimuth, 50);
+        if (!addresses.end_azimuth) { *error = "[Offsets] Could not find G_END_AZIMUTH_SIGNATURE."; return false; }
+
+        // --- azimuth_outside_flag_offset (0x18) ---
+        addresses.azimuth_outside_flag = hooks_api->Hook_FindPatternFrom(G_AZIMUTH_OUTSIDE_FLAG_SIGNATURE, addresses.update_interior_camera, 200);
+        if (!addresses.azimuth_outside_flag) { *error = "[Offsets] Could not find G_AZIMUTH_OUTSIDE_FLAG_SIGNATURE."; return false; }
 
-        uintptr_t last_pattern_addr = interior_cam_fn_address;
+        // --- head_offsets (0x3C and 0x48) ---
+        addresses.head_offsets = hooks_api->Hook_FindPatternFrom(G_HEAD_OFFSETS_SIGNATURE, addresses.end_azimuth, 100);
+        if (!addresses.head_offsets) { *error = "[Offsets] Could not find G_HEAD_OFFSETS_SIGNATURE."; return false; }
 
-        // --- Find start_azimuth_offset (0x10) ---
-        last_pattern_addr = hooks_api->Hook_FindPatternFrom(G_START_AZIMUTH_SIGNATURE, last_pattern_addr, 200);
-        if (!last_pattern_addr) { g_ctx.loadAPI->logger->Log(g_ctx.loggerHandle, SPF_LOG_ERROR, "[Offsets] Could not find G_START_AZIMUTH_SIGNATURE."); return false; }
-        g_offsets.start_azimuth_offset = *(uint8_t*)(last_pattern_addr + 7);
+        // --- camera_pivot_offset (0x494) ---
+        addresses.camera_pivot = hooks_api->Hook_FindPatternFrom(G_CAMERA_PIVOT_SIGNATURE, addresses.update_interior_camera, 1024);
+        if (!addresses.camera_pivot) { *error = "[Offsets] Could not find G_BASE_HEAD_OFFSET_SIGNATURE."; return false; }
 
-        // --- Find end_azimuth_offset (0x14) ---
-        last_pattern_addr = hooks_api->Hook_FindPatternFrom(G_END_AZIMUTH_SIGNATURE, last_pattern_addr, 50);
-        if (!last_pattern_addr) { g_ctx.loadAPI->logger->Log(g_ctx.loggerHandle, SPF_LOG_ERROR, "[Offsets] Could not find G_END_AZIMUTH_SIGNATURE."); return false; }
-        g_offsets.end_azimuth_offset = *(uint8_t*)(last_pattern_addr + 7);
+        // --- CacheExteriorSoundAngleRange function pointer ---
+        addresses.cache_exterior_sound_angle_range = roots[2];
+        if (!addresses.cache_exterior_sound_angle_range) { *error = "[Offsets] Could not find G_CACHE_EXTERIOR_SOUND_ANGLE_RANGE_SIGNATURE."; return false; }
 
-        // --- Find azimuth_outside_flag_offset (0x18) ---
-        uintptr_t outside_flag_addr = hooks_api->Hook_FindPatternFrom(G_AZIMUTH_OUTSIDE_FLAG_SIGNATURE, interior_cam_fn_address, 200);
-        if (!outside_flag_addr) { g_ctx.loadAPI->logger->Log(g_ctx.loggerHandle, SPF_LOG_ERROR, "[Offsets] Could not find G_AZIMUTH_OUTSIDE_FLAG_SIGNATURE."); return false; }
-        g_offsets.azimuth_outside_flag_offset = *(uint8_t*)(outside_flag_addr + 10);
+        return true;
+    }
 
-        // --- Find head_offsets (0x3C and 0x48) ---
-        uintptr_t pattern_addr = hooks_api->Hook_FindPatternFrom(G_HEAD_OFFSETS_SIGNATURE, last_pattern_addr, 100);
-        if (!pattern_addr) { g_ctx.loadAPI->logger->Log(g_ctx.loggerHandle, SPF_LOG_ERROR, "[Offsets] Could not find G_HEAD_OFFSETS_SIGNATURE."); return false; }
-        g_offsets.start_head_offset_x_offset = *(uint8_t*)(pattern_addr + 11);
-        g_offsets.end_head_offset_x_offset = *(uint8_t*)(pattern_addr + 28);
+    /**
+     * @brief Logs the scan outcome. Several hits for a root signature usually mean a game patch made it ambiguous.
+     */
+    static void LogScanReport(const ScanReport &report)
+    {
+        if (report.error)
+        {
+            LogError(report.error);
+        }
 
-        // --- Find camera_pivot_offset (0x494) ---
-        pattern_addr = hooks_api->Hook_FindPatternFrom(G_CAMERA_PIVOT_SIGNATURE, interior_cam_fn_address, 1024);
-        if (!pattern_addr) { g_ctx.loadAPI->logger->Log(g_ctx.loggerHandle, SPF_LOG_ERROR, "[Offsets] Could not find G_BASE_HEAD_OFFSET_SIGNATURE."); return false; }
-        g_offsets.camera_pivot_offset = *(uint32_t*)(pattern_addr + 4);
+        if (!g_ctx.loggerHandle || !report.single_pass)
+        {
+            return;
+        }
 
-        // --- Find CacheExteriorSoundAngleRange function pointer ---
-        g_offsets.pfnCacheExteriorSoundAngleRange = hooks_api->Hook_FindPattern(G_CACHE_EXTERIOR_SOUND_ANGLE_RANGE_SIGNATURE);
-        if (!g_offsets.pfnCacheExteriorSoundAngleRange)
+        for (size_t i = 0; i < ROOT_SIGNATURE_COUNT; ++i)
         {
-            if (g_ctx.loggerHandle)
+            if (report.root_hits[i] > 1)
             {
-                g_ctx.loadAPI->logger->Log(g_ctx.loggerHandle, SPF_LOG_ERROR, "[Offsets] Could not find G_CACHE_EXTERIOR_SOUND_ANGLE_RANGE_SIGNATURE.");
+                char log_buffer[256];
+                g_ctx.formattingAPI->Fmt_Format(log_buffer, sizeof(log_buffer),
+                    "[Offsets] %s matched %u times; using the first match.", g_root_signature_names[i], report.root_hits[i]);
+                g_ctx.loadAPI->logger->Log(g_ctx.loggerHandle, SPF_LOG_WARN, log_buffer);
             }
-            return false;
         }
+    }
+
+    /**
+     * @brief Reads the offsets out of the instructions at the located pattern addresses.
+     */
+    static void ExtractOffsets(const PatternAddresses &addresses)
+    {
+        g_offsets.azimuth_array_offset = *(uint32_t *)(addresses.azimuth_array_and_count + 7);
+        g_offsets.azimuth_count_offset = *(uint32_t *)(addresses.azimuth_array_and_count + 14);
+        g_offsets.start_azimuth_offset = *(uint8_t *)(addresses.start_azimuth + 7);
+        g_offsets.end_azimuth_offset = *(uint8_t *)(addresses.end_azimuth + 7);
+        g_offsets.azimuth_outside_flag_offset = *(uint8_t *)(addresses.azimuth_outside_flag + 10);
+        g_offsets.start_head_offset_x_offset = *(uint8_t *)(addresses.head_offsets + 11);
+        g_offsets.end_head_offset_x_offset = *(uint8_t *)(addresses.head_offsets + 28);
+        g_offsets.camera_pivot_offset = *(uint32_t *)(addresses.camera_pivot + 4);
+        g_offsets.pfnCacheExteriorSoundAngleRange = addresses.cache_exterior_sound_angle_range;
+    }
+
+    /**
+     * @brief Applies located addresses: fills g_offsets and logs the result.
+     */
+    static void Publish(const PatternAddresses &addresses, bool from_cache)
+    {
+        ExtractOffsets(addresses);
 
         // All patterns found, now log the results.
         if (g_ctx.loggerHandle)
         {
             char log_buffer[512];
-            g_ctx.formattingAPI->Fmt_Format(log_buffer, sizeof(log_buffer), 
-                "[Offsets] All offsets found dynamically. "
+            g_ctx.formattingAPI->Fmt_Format(log_buffer, sizeof(log_buffer),
+                "[Offsets] All offsets %s. "
                 "start_azimuth: 0x%X, end_azimuth: 0x%X, azimuth_outside_flag: 0x%X, "
                 "azimuth_array: 0x%X, azimuth_count: 0x%X, "
                 "start_head_x: 0x%X, end_head_x: 0x%X, "
                 "pivot: 0x%X, "
                 "CacheExtSoundFn: 0x%llX",
+                from_cache ? "restored from cache" : "found dynamically",
                 g_offsets.start_azimuth_offset, g_offsets.end_azimuth_offset, g_offsets.azimuth_outside_flag_offset,
                 g_offsets.azimuth_array_offset, g_offsets.azimuth_count_offset,
                 g_offsets.start_head_offset_x_offset, g_offsets.end_head_offset_x_offset,
-                g_offsets.camera_pivot_offset, 
+                g_offsets.camera_pivot_offset,
                 g_offsets.pfnCacheExteriorSoundAngleRange
             );
             g_ctx.loadAPI->logger->Log(g_ctx.loggerHandle, SPF_LOG_INFO, log_buffer);
         }
+    }
+
+    // =================================================================================================
+    // Asynchronous Discovery State
+    // =================================================================================================
+
+    static std::atomic<DiscoveryState> g_discovery_state{DiscoveryState::Idle};
+    static std::atomic<bool> g_worker_finished{false};
+    static std::thread g_worker;
+
+    // Written by the worker before g_worker_finished is released; read by the game thread after acquiring it.
+    static PatternAddresses g_worker_addresses = {};
+    static ScanReport g_worker_report = {};
+    static bool g_worker_succeeded = false;
+
+    // The module identity captured when the scan was started, used to store the cache on completion.
+    static uint64_t g_scan_build_key = 0;
+    static uintptr_t g_scan_module_base = 0;
+
+    // =================================================================================================
+    // Public Functions
+    // =================================================================================================
 
+    bool Find(const SPF_Hooks_API* hooks_api)
+    {
+        if (!hooks_api)
+        {
+            LogError("[Offsets] Hooks API is null, cannot find offsets.");
+            return false;
+        }
+
+        uintptr_t module_base = 0;
+        size_t module_size = 0;
+        const uint64_t build_key = GetBuildKey(&module_base, &module_size);
+
+        // Try the persistent cache first; only rescan if it is missing, from another build or no longer matches.
+        PatternAddresses addresses = {};
+        const bool from_cache = LoadCachedAddresses(build_key, module_base, module_size, addresses);
+        if (!from_cache)
+        {
+            ScanReport report;
+            const bool found = ScanAddresses(hooks_api, addresses, report);
+            LogScanReport(report);
+            if (!found)
+            {
+                return false;
+            }
+            StoreCachedAddresses(build_key, module_base, addresses);
+        }
+
+        Publish(addresses, from_cache);
         return true;
     }
-}
 
+    bool BeginDiscovery(const SPF_Hooks_API *hooks_api)
+    {
+        if (!hooks_api)
+        {
+            LogError("[Offsets] Hooks API is null, cannot find offsets.");
+            return false;
+        }
+
+        if (g_discovery_state.load() == DiscoveryState::Scanning)
+        {
+            return true; // Already running; its result will be published by PollDiscovery.
+        }
+
+        uintptr_t module_base = 0;
+        size_t module_size = 0;
+        const uint64_t build_key = GetBuildKey(&module_base, &module_size);
+
+        // The cache check is a handful of byte compares, so it stays on the calling thread.
+        PatternAddresses addresses = {};
+        if (LoadCachedAddresses(build_key, module_base, module_size, addresses))
+        {
+            Publish(addresses, true);
+            g_discovery_state.store(DiscoveryState::Ready);
+            return true;
+        }
+
+        if (g_worker.joinable())
+        {
+            g_worker.join();
+        }
+
+        g_scan_build_key = build_key;
+        g_scan_module_base = module_base;
+        g_worker_finished.store(false);
+        g_discovery_state.store(DiscoveryState::Scanning);
+
+        g_worker = std::thread([hooks_api]()
+        {
+            PatternAddresses found = {};
+            ScanReport report;
+            g_worker_succeeded = ScanAddresses(hooks_api, found, report);
+            g_worker_addresses = found;
+            g_worker_report = report;
+            g_worker_finished.store(true, std::memory_order_release);
+        });
+
+        if (g_ctx.loggerHandle)
+        {
+            g_ctx.loadAPI->logger->Log(g_ctx.loggerHandle, SPF_LOG_INFO, "[Offsets] No valid offset cache for this game build; scanning in the background.");
+        }
+        return true;
+    }
+
+    DiscoveryState PollDiscovery()
+    {
+        if (g_discovery_state.load() != DiscoveryState::Scanning || !g_worker_finished.load(std::memory_order_acquire))
+        {
+            return g_discovery_state.load();
+        }
+
+        g_worker.join();
+        LogScanReport(g_worker_report);
+
+        if (!g_worker_succeeded)
+        {
+            g_discovery_state.store(DiscoveryState::Failed);
+            return DiscoveryState::Failed;
+        }
+
+        // Config and logging are only touched here, on the game thread.
+        StoreCachedAddresses(g_scan_build_key, g_scan_module_base, g_worker_addresses);
+        Publish(g_worker_addresses, false);
+        g_discovery_state.store(DiscoveryState::Ready);
+        return DiscoveryState::Ready;
+    }
+
+    bool IsDiscoveryPending()
+    {
+        return g_discovery_state.load() == DiscoveryState::Scanning;
+    }
+
+    void Shutdown()
+    {
+        if (g_worker.joinable())
+        {
+            g_worker.join();
+        }
+        g_discovery_state.store(DiscoveryState::Idle);
+    }
+}
@@ -81,9 +81,50 @@ namespace SPF_CabinWalk::Offsets
 
     /**
      * @brief Finds all necessary memory offsets using signature scanning.
+     * @details The addresses of the pattern hits are persisted in `settings.offset_cache`, keyed by the
+     *          game executable's build (PE timestamp and image size). On later loads the cached addresses
+     *          are only byte-compared against their signatures; a full rescan happens on any mismatch.
      * @param hooks_api A pointer to the SPF Hooks API.
      * @return true if all offsets were found successfully, false otherwise.
      */
     bool Find(const SPF_Hooks_API *hooks_api);
 
+    /**
+     * @brief The progress of an asynchronous offset discovery.
+     */
+    enum class DiscoveryState : uint8_t
+    {
+        Idle,     // No discovery has been started.
+        Scanning, // A worker thread is scanning; g_offsets must not be used yet.
+        Ready,    // g_offsets holds valid values.
+        Failed    // At least one pattern could not be found (already logged).
+    };
+
+    /**
+     * @brief Starts finding the offsets without blocking the game thread.
+     * @details A valid persistent cache is applied immediately, so the state is Ready on return. Otherwise
+     *          the signature scan runs on a worker thread and the results are published by PollDiscovery().
+     *          Does nothing if a scan is already running.
+     * @param hooks_api A pointer to the SPF Hooks API.
+     * @return false if discovery could not be started (e.g. the API is null).
+     */
+    bool BeginDiscovery(const SPF_Hooks_API *hooks_api);
+
+    /**
+     * @brief Publishes the worker's results once it has finished. Must be called from the game thread.
+     * @details When the scan completes, this fills g_offsets, stores the offset cache and logs the outcome.
+     * @return The current discovery state.
+     */
+    DiscoveryState PollDiscovery();
+
+    /**
+     * @brief Checks whether a scan is still running. Safe to call from any thread.
+     */
+    bool IsDiscoveryPending();
+
+    /**
+     * @brief Waits for a running worker, if any. Call before the plugin is unloaded.
+     */
+    void Shutdown();
+
 } // namespace SPF_CabinWalk::Offsets
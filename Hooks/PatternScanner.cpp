@@ -0,0 +1,217 @@
+#include "Hooks/PatternScanner.hpp"
+#include <bit>
+
+#if defined(SPF_CABINWALK_ENABLE_SIMD) && (defined(_M_X64) || defined(__SSE2__))
+#define SPF_CABINWALK_SIMD_SCANNER 1
+#include <emmintrin.h>
+#else
+#define SPF_CABINWALK_SIMD_SCANNER 0
+#endif
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h> // For GetModuleHandleW and the PE header structures
+#endif
+
+namespace SPF_CabinWalk::PatternScanner
+{
+    namespace
+    {
+        int HexDigit(char c)
+        {
+            if (c >= '0' && c <= '9') return c - '0';
+            if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+            if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+            return -1;
+        }
+
+        // Rough frequency of a byte in x64 code; the anchor is the fixed byte that scores lowest, so the
+        // first-byte filter produces as few candidates as possible.
+        int Commonness(uint8_t byte)
+        {
+            switch (byte)
+            {
+            case 0x00: case 0xCC: case 0xFF: return 4;
+            case 0x48: case 0x8B: case 0x89: return 3;
+            case 0x0F: case 0x4C: case 0x44: case 0x24: case 0x8D: return 2;
+            case 0x41: case 0x83: case 0xE8: case 0xF3: case 0x10: return 1;
+            default: return 0;
+            }
+        }
+
+        bool VerifyAt(const Pattern &pattern, const uint8_t *bytes)
+        {
+            for (uint32_t i = 0; i < pattern.length; ++i)
+            {
+                if (pattern.fixed[i] && bytes[i] != pattern.bytes[i])
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        void Record(Result &result, uintptr_t address)
+        {
+            if (result.count < MAX_RECORDED_HITS)
+            {
+                result.hits[result.count] = address;
+            }
+            ++result.count;
+        }
+
+        // Verifies the candidate at `anchor_pos` (the position of the pattern's anchor byte in the range).
+        void TryCandidate(const Pattern &pattern, Result &result, const uint8_t *data, size_t length, size_t anchor_pos)
+        {
+            if (anchor_pos < pattern.anchor)
+            {
+                return;
+            }
+
+            const size_t start = anchor_pos - pattern.anchor;
+            if (start + pattern.length <= length && VerifyAt(pattern, data + start))
+            {
+                Record(result, reinterpret_cast<uintptr_t>(data + start));
+            }
+        }
+    } // namespace
+
+    bool Compile(const char *signature, Pattern &out)
+    {
+        out.length = 0;
+        out.anchor = 0;
+        bool has_fixed = false;
+
+        for (const char *p = signature; p && *p;)
+        {
+            if (*p == ' ')
+            {
+                ++p;
+                continue;
+            }
+
+            if (out.length >= MAX_PATTERN_LENGTH)
+            {
+                return false;
+            }
+
+            if (*p == '?')
+            {
+                while (*p == '?') ++p;
+                out.bytes[out.length] = 0;
+                out.fixed[out.length] = false;
+            }
+            else
+            {
+                const int high = HexDigit(p[0]);
+                const int low = high >= 0 ? HexDigit(p[1]) : -1;
+                if (low < 0)
+                {
+                    return false;
+                }
+
+                const uint8_t byte = static_cast<uint8_t>((high << 4) | low);
+                out.bytes[out.length] = byte;
+                out.fixed[out.length] = true;
+
+                if (!has_fixed || Commonness(byte) < Commonness(out.bytes[out.anchor]))
+                {
+                    out.anchor = out.length;
+                }
+                has_fixed = true;
+                p += 2;
+            }
+            ++out.length;
+        }
+
+        return has_fixed;
+    }
+
+    bool MatchesAt(const Pattern &pattern, uintptr_t address, size_t available)
+    {
+        return pattern.length <= available && VerifyAt(pattern, reinterpret_cast<const uint8_t *>(address));
+    }
+
+    void Scan(const Pattern *patterns, Result *results, size_t count, uintptr_t begin, size_t length)
+    {
+        const uint8_t *data = reinterpret_cast<const uint8_t *>(begin);
+        size_t pos = 0;
+
+#if SPF_CABINWALK_SIMD_SCANNER
+        for (; pos + 16 <= length; pos += 16)
+        {
+            const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + pos));
+            for (size_t i = 0; i < count; ++i)
+            {
+                const __m128i anchor = _mm_set1_epi8(static_cast<char>(patterns[i].bytes[patterns[i].anchor]));
+                unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, anchor)));
+                while (mask)
+                {
+                    TryCandidate(patterns[i], results[i], data, length, pos + std::countr_zero(mask));
+                    mask &= mask - 1;
+                }
+            }
+        }
+#endif
+
+        // Scalar tail (or the whole range when the SIMD scanner is disabled).
+        for (; pos < length; ++pos)
+        {
+            for (size_t i = 0; i < count; ++i)
+            {
+                if (data[pos] == patterns[i].bytes[patterns[i].anchor])
+                {
+                    TryCandidate(patterns[i], results[i], data, length, pos);
+                }
+            }
+        }
+    }
+
+    bool ScanModule(const Pattern *patterns, Result *results, size_t count)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            results[i].count = 0;
+        }
+
+#ifdef _WIN32
+        const uintptr_t base = reinterpret_cast<uintptr_t>(GetModuleHandleW(nullptr));
+        if (!base)
+        {
+            return false;
+        }
+
+        const auto *dos_header = reinterpret_cast<const IMAGE_DOS_HEADER *>(base);
+        if (dos_header->e_magic != IMAGE_DOS_SIGNATURE)
+        {
+            return false;
+        }
+
+        const auto *nt_headers = reinterpret_cast<const IMAGE_NT_HEADERS *>(base + dos_header->e_lfanew);
+        if (nt_headers->Signature != IMAGE_NT_SIGNATURE)
+        {
+            return false;
+        }
+
+        bool scanned_any = false;
+        const IMAGE_SECTION_HEADER *section = IMAGE_FIRST_SECTION(nt_headers);
+        for (WORD i = 0; i < nt_headers->FileHeader.NumberOfSections; ++i, ++section)
+        {
+            if (!(section->Characteristics & IMAGE_SCN_MEM_EXECUTE) || section->Misc.VirtualSize == 0)
+            {
+                continue;
+            }
+
+            Scan(patterns, results, count, base + section->VirtualAddress, section->Misc.VirtualSize);
+            scanned_any = true;
+        }
+        return scanned_any;
+#else
+        (void)patterns;
+        return false;
+#endif
+    }
+
+} // namespace SPF_CabinWalk::PatternScanner
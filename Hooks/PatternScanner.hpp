@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace SPF_CabinWalk::PatternScanner
+{
+    // Longest signature, in bytes, that can be compiled.
+    constexpr size_t MAX_PATTERN_LENGTH = 64;
+
+    // Number of hit addresses recorded per pattern. Further hits are only counted.
+    constexpr uint32_t MAX_RECORDED_HITS = 4;
+
+    /**
+     * @brief An IDA-style signature ("48 8B ? ?? C4") compiled into bytes and a wildcard mask.
+     */
+    struct Pattern
+    {
+        uint8_t bytes[MAX_PATTERN_LENGTH];
+        bool fixed[MAX_PATTERN_LENGTH]; // false for wildcard positions
+        uint32_t length;
+        uint32_t anchor; // Index of the fixed byte the first-byte filter searches for.
+    };
+
+    /**
+     * @brief The hits of one pattern, in ascending address order.
+     */
+    struct Result
+    {
+        uintptr_t hits[MAX_RECORDED_HITS];
+        uint32_t count; // Total number of hits, which may exceed MAX_RECORDED_HITS.
+    };
+
+    /**
+     * @brief Compiles a signature string.
+     * @return false if the signature is empty, malformed, fully wildcarded or longer than MAX_PATTERN_LENGTH.
+     */
+    bool Compile(const char *signature, Pattern &out);
+
+    /**
+     * @brief Checks whether a compiled pattern matches at an address.
+     * @param available The number of readable bytes at `address`.
+     */
+    bool MatchesAt(const Pattern &pattern, uintptr_t address, size_t available);
+
+    /**
+     * @brief Searches a memory range for several patterns in a single pass.
+     * @details Candidate positions are found by an SSE2 compare against each pattern's anchor byte,
+     *          16 bytes at a time, and only those are verified against the full pattern.
+     *          `results` is not cleared, so several ranges can be accumulated into it.
+     * @param patterns The compiled patterns.
+     * @param results One result per pattern.
+     * @param count The number of patterns.
+     * @param begin The start of the range.
+     * @param length The size of the range; a pattern must lie entirely inside it to match.
+     */
+    void Scan(const Pattern *patterns, Result *results, size_t count, uintptr_t begin, size_t length);
+
+    /**
+     * @brief Searches every executable section of the game module for several patterns in a single pass.
+     * @details Results are cleared first.
+     * @return false if the module's sections could not be enumerated (e.g. not running on Windows).
+     */
+    bool ScanModule(const Pattern *patterns, Result *results, size_t count);
+
+} // namespace SPF_CabinWalk::PatternScanner
@@ -0,0 +1,51 @@
+#include "Input/InputQueue.hpp"
+#include "Input/SpscQueue.hpp"
+#include <atomic>
+#include <chrono>
+
+namespace SPF_CabinWalk::InputQueue
+{
+    // =================================================================================================
+    // Internal State
+    // =================================================================================================
+
+    static SpscQueue<Command, CAPACITY> g_queue;
+    static std::atomic<uint32_t> g_dropped{0};
+
+    // =================================================================================================
+    // Public Functions
+    // =================================================================================================
+
+    uint64_t NowMicroseconds()
+    {
+        const auto now = std::chrono::steady_clock::now().time_since_epoch();
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(now).count());
+    }
+
+    bool Push(CommandType type)
+    {
+        if (g_queue.Push({type, NowMicroseconds()}))
+        {
+            return true;
+        }
+
+        g_dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    bool Pop(Command &out)
+    {
+        return g_queue.Pop(out);
+    }
+
+    bool HasPending()
+    {
+        return !g_queue.IsEmpty();
+    }
+
+    uint32_t TakeDroppedCount()
+    {
+        return g_dropped.exchange(0, std::memory_order_relaxed);
+    }
+
+} // namespace SPF_CabinWalk::InputQueue
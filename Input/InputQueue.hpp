@@ -0,0 +1,57 @@
+#pragma once
+#include <cstdint>
+
+namespace SPF_CabinWalk::InputQueue
+{
+    /**
+     * @brief The actions the keybind callbacks hand to the update loop.
+     */
+    enum class CommandType : uint8_t
+    {
+        MoveToPassengerSeat,
+        MoveToDriverSeat,
+        MoveToStandingPosition, // Also toggles walking while standing.
+        CycleSofaPositions,
+        CapturePose
+    };
+
+    /**
+     * @brief One queued action.
+     */
+    struct Command
+    {
+        CommandType type;
+        uint64_t timestamp_us; // Steady clock when the keybind fired, for input-to-motion latency.
+    };
+
+    // Queued actions beyond this are dropped; a frame never sees more than a few.
+    constexpr uint32_t CAPACITY = 32;
+
+    /**
+     * @brief Queues an action. Called from the keybind callbacks; never blocks and never allocates.
+     * @return False if the queue was full and the action was dropped.
+     */
+    bool Push(CommandType type);
+
+    /**
+     * @brief Takes the oldest queued action. Called only from the update loop.
+     * @return False if nothing is queued.
+     */
+    bool Pop(Command &out);
+
+    /**
+     * @brief Checks whether any action is waiting. Safe to call from the update loop while idle.
+     */
+    bool HasPending();
+
+    /**
+     * @brief Gets and resets the number of actions dropped because the queue was full.
+     */
+    uint32_t TakeDroppedCount();
+
+    /**
+     * @brief Gets the steady clock in microseconds, the time base of Command::timestamp_us.
+     */
+    uint64_t NowMicroseconds();
+
+} // namespace SPF_CabinWalk::InputQueue
@@ -0,0 +1,78 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace SPF_CabinWalk
+{
+    /**
+     * @class SpscQueue
+     * @brief A bounded, lock-free queue for exactly one producer thread and one consumer thread.
+     *
+     * @details The producer only writes `m_tail` and the consumer only writes `m_head`; each reads the
+     *          other's index with acquire semantics, so a slot is never read before it is written or
+     *          overwritten before it is read. The indices live on separate cache lines so the two
+     *          sides do not invalidate each other on every operation. One slot is kept free to tell a
+     *          full queue from an empty one. No allocations.
+     *
+     * @tparam T A trivially copyable element type.
+     * @tparam Capacity The number of slots; must be a power of two. Holds Capacity - 1 elements.
+     */
+    template <typename T, size_t Capacity>
+    class SpscQueue
+    {
+        static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+    public:
+        /**
+         * @brief Appends an element. Producer side only.
+         * @return False if the queue is full; the element is dropped.
+         */
+        bool Push(const T &value)
+        {
+            const size_t tail = m_tail.load(std::memory_order_relaxed);
+            const size_t next = (tail + 1) & MASK;
+            if (next == m_head.load(std::memory_order_acquire))
+            {
+                return false;
+            }
+
+            m_slots[tail] = value;
+            m_tail.store(next, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * @brief Removes the oldest element. Consumer side only.
+         * @return False if the queue is empty.
+         */
+        bool Pop(T &out)
+        {
+            const size_t head = m_head.load(std::memory_order_relaxed);
+            if (head == m_tail.load(std::memory_order_acquire))
+            {
+                return false;
+            }
+
+            out = m_slots[head];
+            m_head.store((head + 1) & MASK, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * @brief Checks whether the queue is empty. Exact on the consumer side, a hint anywhere else.
+         */
+        bool IsEmpty() const
+        {
+            return m_head.load(std::memory_order_acquire) == m_tail.load(std::memory_order_acquire);
+        }
+
+    private:
+        static constexpr size_t MASK = Capacity - 1;
+
+        alignas(64) std::atomic<size_t> m_head{0}; // Next slot to read; written by the consumer.
+        alignas(64) std::atomic<size_t> m_tail{0}; // Next slot to write; written by the producer.
+        T m_slots[Capacity];
+    };
+
+} // namespace SPF_CabinWalk
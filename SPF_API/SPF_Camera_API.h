@@ -206,6 +206,43 @@ typedef bool (*SPF_Camera_GetInteriorRotationDefaults_t)(float* lr, float* ud);
  */
 typedef void (*SPF_Camera_SetInteriorRotationDefaults_t)(float lr, float ud);
 
+/**
+ * @enum SPF_InteriorStateField
+ * @brief Selects the parts of an SPF_InteriorCameraState_t that a bulk call reads or writes.
+ */
+typedef enum {
+    SPF_INTERIOR_STATE_SEAT_POS = 1 << 0,
+    SPF_INTERIOR_STATE_HEAD_ROT = 1 << 1,
+    SPF_INTERIOR_STATE_ROTATION_LIMITS = 1 << 2,
+    SPF_INTERIOR_STATE_FOV = 1 << 3,
+} SPF_InteriorStateField;
+
+/**
+ * @struct SPF_InteriorCameraState_t
+ * @brief The interior camera values that the bulk calls get and set together.
+ */
+typedef struct {
+    float seat_x, seat_y, seat_z; // As for Cam_GetInteriorSeatPos
+    float yaw, pitch;             // As for Cam_GetInteriorHeadRot, in RADIANS
+    float limit_left, limit_right, limit_up, limit_down; // As for Cam_GetInteriorRotationLimits
+    float fov;                    // The base FOV, as for Cam_GetInteriorFov
+} SPF_InteriorCameraState_t;
+
+/**
+ * @brief Gets several interior camera values in one call.
+ * @param fields A combination of SPF_InteriorStateField flags. Fields not selected are left untouched.
+ * @param[out] out_state Receives the selected values.
+ * @return True on success, false otherwise (nothing is written to `out_state` then).
+ */
+typedef bool (*SPF_Camera_GetInteriorState_t)(uint32_t fields, SPF_InteriorCameraState_t* out_state);
+
+/**
+ * @brief Sets several interior camera values in one call, as the matching single setters would.
+ * @param fields A combination of SPF_InteriorStateField flags. Fields not selected are not changed.
+ * @param state The values to set.
+ */
+typedef void (*SPF_Camera_SetInteriorState_t)(uint32_t fields, const SPF_InteriorCameraState_t* state);
+
 
 
 // --- Behind Camera Specific Functions ---
@@ -1296,6 +1333,14 @@ typedef struct SPF_Camera_API {
     /** @brief Checks if the animation is playing in reverse. See `SPF_Anim_IsReversed_t`. */
     SPF_Anim_IsReversed_t Cam_Anim_IsReversed;
 
+    // --- Interior Camera (bulk) ---
+    // Appended at the end to keep the layout of the fields above. Plugins must check them for NULL and fall
+    // back to the single getters and setters, and must only read them on frameworks whose struct has them.
+    /** @brief Gets several interior camera values at once. See `SPF_Camera_GetInteriorState_t`. */
+    SPF_Camera_GetInteriorState_t Cam_GetInteriorState;
+    /** @brief Sets several interior camera values at once. See `SPF_Camera_SetInteriorState_t`. */
+    SPF_Camera_SetInteriorState_t Cam_SetInteriorState;
+
 
 } SPF_Camera_API;
 
@@ -11,15 +11,30 @@
 #include "Hooks/CameraHookManager.hpp"          // For camera hooking logic
 #include "Animation/AnimationController.hpp"    // For managing camera animations
 #include "Animation/StandingAnimController.hpp" // For handling walking logic
+#include "Animation/LayerStack.hpp"             // For composing the camera pose
+#include "Camera/CameraFacade.hpp"          // For the per-frame camera state cache
+#include "Diagnostics/Profiler.hpp"         // For the hot-path profiler overlay
+#include "Diagnostics/DebugOverlay.hpp"     // For the animation debug overlay
+#include "Diagnostics/Latency.hpp"          // For input-to-motion latency
+#include "Diagnostics/CameraTrace.hpp"      // For recording and replaying camera traces
+#include "Diagnostics/TraceProvider.hpp"    // For ETW / Tracy frame markers
+#include "Diagnostics/StateExport.hpp"      // For the shared-memory cabin state export
+#include "Settings/SettingsFields.hpp"      // For per-field settings loading and the settings manifest
+#include "Settings/ConfigBatch.hpp"         // For batched config writes
+#include "Input/InputQueue.hpp"             // For the keybind command queue
+#include "Settings/TruckProfiles.hpp"       // For the per-truck profiles
+#include "UI/UIResources.hpp"               // For the retained warning window resources
 
 #include <cmath>   // For math functions like fabsf
 #include <cstring> // For C-style string manipulation functions like strncpy_s.
-#include <string>  // For std::string and std::to_string
 
 namespace SPF_CabinWalk
 {
     // Forward Declarations
     bool IsSafeToLeaveDriverSeat();
+    static void PollOffsetDiscovery();
+    static bool IsCameraHookPending();
+    static void WakeUp();
 
     // =================================================================================================
     // 1. Constants & Global State
@@ -43,6 +58,23 @@ namespace SPF_CabinWalk
      */
     static bool g_is_walk_key_down = false;
 
+    /**
+     * @brief Set while offset discovery runs in the background and the camera hook is not installed yet.
+     */
+    static bool g_camera_hook_pending = false;
+
+    /**
+     * @brief Simulation timestamp of the previous frame, for FrameContext::delta_time_us.
+     */
+    static uint64_t g_last_frame_time_us = 0;
+
+    /**
+     * @brief Set while seated in the driver position with nothing to do; OnUpdate then returns at once.
+     * @details Cleared by WakeUp() from every event that can start work: keybinds, settings changes
+     *          and the start of offset discovery.
+     */
+    static bool g_is_idle = false;
+
     // =================================================================================================
     // 2. Manifest Implementation
     // =================================================================================================
@@ -82,80 +114,9 @@ namespace SPF_CabinWalk
         }
 
         // --- 2.3. Custom Settings Defaults (settingsJson) ---
-        // A JSON string literal that defines the default values for your plugin's custom settings.
-        // These will be inserted under a top-level key named "settings" in settings.json.
-        api->Settings_SetJson(h, R"json(
-            {
-                "general": {
-                    "warning_duration_ms": 3000,
-                    "cabin_layout": 0,
-                    "height": 0.25
-                },
-                "positions": {
-                    "passenger_seat": { "enabled": true, "position": { "x": 0.95, "y": 0.0, "z": -0.03 }, "rotation": { "x": 0.03, "y": 0.03 } },
-                    "standing":       { "enabled": true, "position": { "x": 0.5, "y": 0.2, "z": 0.25 }, "rotation": { "x": -0.17, "y": -0.3 } },
-                    "sofa_sit1":      { "enabled": true, "position": { "x": 0.5, "y": 0.0, "z": 0.8 }, "rotation": { "x": 0.0, "y": 0.0 } },
-                    "sofa_lie":       { "enabled": true, "position": { "x": -0.15, "y": -0.25, "z": 1.25 }, "rotation": { "x": -1.65, "y": 0.35 } },
-                    "sofa_sit2":      { "enabled": true, "position": { "x": 0.65, "y": 0.0, "z": 1.0 }, "rotation": { "x": -1.0, "y": -0.10 } }
-                },
-                "animation_durations": {
-                    "main_animation_speed": {
-                        "driver_to_passenger": 4000,
-                        "passenger_to_driver": 3000,
-                        "driver_to_standing": 3600,
-                        "standing_to_driver": 4300,
-                        "passenger_to_standing": 3300,
-                        "standing_to_passenger": 4500,
-                        "standing_to_sofa": 2900,
-                        "sofa_to_standing": 1700
-                    },
-                    "sofa_animation_speed": {
-                        "sofa_sit1_to_lie": 4000,
-                        "sofa_lie_to_sit2": 2500,
-                        "sofa_sit2_to_sit1": 1200,
-                        "sofa_lie_to_sit1_shortcut": 1700
-                    },
-                    "crouch_and_stand_animation_speed": {
-                        "crouch": 1250,
-                        "tiptoe": 1100
-                    }                    
-                },
-                "walking_animation_speed": {
-                        "walk_step": 450,
-                        "walk_first_step_base": 250000,
-                        "walk_first_step_turn_extra": 1000000
-                },
-                "standing_movement": {
-                    "walking": {
-                        "step_amount": 0.35,
-                        "bob_amount": 0.02,
-                        "walk_zone_z": {
-                            "min": -0.55,
-                            "max": 0.65
-                        }
-                    },
-                    "stance_control": {
-                        "hold_time_ms": 1000,
-                        "crouch": {
-                            "depth": 0.5,
-                            "activation_angle": -0.7,
-                            "deactivation_angle": 0.3
-                        },
-                        "tiptoe": {
-                            "height": 0.17,
-                            "activation_angle": 0.5,
-                            "deactivation_angle": -0.3
-                        }
-                    }
-                },
-                "sofa_limits": {
-                    "yaw_left": 180.0,
-                    "yaw_right": -180.0,
-                    "pitch_up": 90.0,
-                    "pitch_down": -65.0
-                }
-            }
-        )json");
+        // The default values of the plugin's custom settings, inserted under a top-level key named
+        // "settings" in settings.json. Generated from the same field table LoadSettings reads.
+        SettingsFields::SetManifestDefaults(h, api);
 
         // --- 2.4. System Defaults ---
 
@@ -171,11 +132,18 @@ namespace SPF_CabinWalk
             api->Defaults_AddKeybind(h, "SPF_CabinWalk.Movement", "moveToDriverSeat", "keyboard", "KEY_NUMPAD5", "short", 0, "always", "toggle");
             api->Defaults_AddKeybind(h, "SPF_CabinWalk.Movement", "moveToStandingPosition", "keyboard", "KEY_NUMPAD2", "short", 0, "always", "hold");
             api->Defaults_AddKeybind(h, "SPF_CabinWalk.Movement", "cycleSofaPositions", "keyboard", "KEY_NUMPAD1", "short", 0, "always", "toggle");
+            api->Defaults_AddKeybind(h, "SPF_CabinWalk.Calibration", "capturePose", "keyboard", "KEY_NUMPAD0", "long", 1000, "always", "press");
         }
 
         // UI Windows
         {
             api->Defaults_AddWindow(h, "WarningWindow", false, false, 0, 0, 400, 100, false, false);
+#if defined(SPF_CABINWALK_ENABLE_PROFILER)
+            api->Defaults_AddWindow(h, "ProfilerWindow", false, true, 20, 20, 640, 220, false, false);
+#endif
+#if defined(SPF_CABINWALK_ENABLE_DEBUG_OVERLAY)
+            api->Defaults_AddWindow(h, "DebugOverlayWindow", false, true, 20, 260, 520, 360, false, false);
+#endif
         }
 
         // =============================================================================================
@@ -188,161 +156,102 @@ namespace SPF_CabinWalk
             api->Meta_AddKeybind(h, "SPF_CabinWalk.Movement", "moveToDriverSeat", "keybinds.moveToDriverSeat.title", "keybinds.moveToDriverSeat.desc");
             api->Meta_AddKeybind(h, "SPF_CabinWalk.Movement", "moveToStandingPosition", "keybinds.moveToStandingPosition.title", "keybinds.moveToStandingPosition.desc");
             api->Meta_AddKeybind(h, "SPF_CabinWalk.Movement", "cycleSofaPositions", "keybinds.cycleSofaPositions.title", "keybinds.cycleSofaPositions.desc");
+            api->Meta_AddKeybind(h, "SPF_CabinWalk.Calibration", "capturePose", "keybinds.capturePose.title", "keybinds.capturePose.desc");
         }
 
         // --- Custom Settings Metadata ---
-        
-        // Helper wrappers for Meta_AddCustomSetting. 
-        // We build the JSON string for widget parameters here to keep the loop logic clean.
-        auto AddSliderMeta = [&](const char *key, const char *title, const char *desc, float min, float max, const char *format)
-        {
-            // Use string concatenation to build parameters JSON without precision loss.
-            std::string params = "{ \"min\": " + std::to_string(min) + 
-                                 ", \"max\": " + std::to_string(max) + 
-                                 ", \"format\": \"" + format + "\" }";
-            api->Meta_AddCustomSetting(h, key, title, desc, "slider", params.c_str(), false);
-        };
-
-        auto AddDragMeta = [&](const char *key, const char *title, const char *desc, float speed, float min, float max, const char *format)
-        {
-            std::string params = "{ \"speed\": " + std::to_string(speed) + 
-                                 ", \"min\": " + std::to_string(min) + 
-                                 ", \"max\": " + std::to_string(max) + 
-                                 ", \"format\": \"" + format + "\" }";
-            api->Meta_AddCustomSetting(h, key, title, desc, "drag", params.c_str(), false);
-        };
-
-        // Specialized helpers for positions
-        auto AddPositionCoordMeta = [&](const char *base_key_path, const char *axis_name)
-        {
-            std::string key_path = std::string("positions.") + base_key_path + ".position." + axis_name;
-            std::string title_key = std::string("settings.positions.") + base_key_path + ".position." + axis_name + ".title";
-            AddDragMeta(key_path.c_str(), title_key.c_str(), "settings.positions.coord.desc", 0.01f, -5.0f, 5.0f, "%.2f m");
-        };
+        // Titles, descriptions and widgets of every settings group and field, from the field table.
+        SettingsFields::AddManifestMetadata(h, api);
 
-        auto AddPositionRotationMeta = [&](const char *base_key_path, const char *axis_name)
-        {
-            std::string key_path = std::string("positions.") + base_key_path + ".rotation." + axis_name;
-            std::string title_key = std::string("settings.positions.") + base_key_path + ".rotation." + axis_name + ".title";
-            AddDragMeta(key_path.c_str(), title_key.c_str(), "settings.positions.rot.desc", 0.01f, -3.14159f, 3.14159f, "%.2f rad");
-        };
+        // Window Description
+        api->Meta_AddWindow(h, "WarningWindow", "Warning", "Displayed when it is not safe to leave the driver's seat.");
+#if defined(SPF_CABINWALK_ENABLE_PROFILER)
+        api->Meta_AddWindow(h, "ProfilerWindow", "Profiler", "Per-frame cost of the plugin's hot paths. Timing is only recorded while this window is open.");
+#endif
+#if defined(SPF_CABINWALK_ENABLE_DEBUG_OVERLAY)
+        api->Meta_AddWindow(h, "DebugOverlayWindow", "Animation Debug", "Curves of the playing transition, the walk zone and the stance timers. Only sampled while this window is open.");
+#endif
+    }
 
-        api->Meta_AddCustomSetting(h, "general", "settings.general.title", "", nullptr, nullptr, false);
-        api->Meta_AddCustomSetting(h, "positions", "settings.positions.title", "", nullptr, nullptr, false);
-        api->Meta_AddCustomSetting(h, "animation_durations", "settings.animation_durations.title", "", nullptr, nullptr, false);
-        api->Meta_AddCustomSetting(h, "standing_movement", "settings.standing_movement.title", "", nullptr, nullptr, false);
-        api->Meta_AddCustomSetting(h, "standing_movement.walking", "settings.standing_movement.walking.title", "", nullptr, nullptr, false);
-        api->Meta_AddCustomSetting(h, "standing_movement.walking.walk_zone_z", "settings.standing_movement.walking.walk_zone_z.title", "", nullptr, nullptr, false);
-        api->Meta_AddCustomSetting(h, "standing_movement.stance_control", "settings.standing_movement.stance_control.title", "", nullptr, nullptr, false);
-        api->Meta_AddCustomSetting(h, "standing_movement.stance_control.crouch", "settings.standing_movement.stance_control.crouch.title", "", nullptr, nullptr, false);
-        api->Meta_AddCustomSetting(h, "standing_movement.stance_control.tiptoe", "settings.standing_movement.stance_control.tiptoe.title", "", nullptr, nullptr, false);
+    // =================================================================================================
+    // 3. Plugin Lifecycle Implementations
+    // =================================================================================================
+    // The following functions are the core lifecycle events for the plugin.
 
-        AddSliderMeta("general.warning_duration_ms", "settings.general.warning_duration_ms.title", "settings.general.warning_duration_ms.desc", 0.0f, 30000.0f, "%d ms");
-        AddSliderMeta("general.height", "settings.general.height.title", "settings.general.height.desc", 0.0f, 1.0f, "%.2f m");
+    /**
+     * @brief Starts, stops or switches the camera trace to match the diagnostics settings.
+     */
+    static void ApplyTraceSettings()
+    {
+        const auto& diagnostics = g_ctx.settings.diagnostics;
+        CameraTrace::Configure(static_cast<CameraTrace::Mode>(diagnostics.trace_mode),
+                               diagnostics.trace_file,
+                               diagnostics.trace_capacity > 0 ? static_cast<uint32_t>(diagnostics.trace_capacity) : 0);
+    }
 
-        const char *cabin_layout_options = R"json({ "options": [
-            { "value": 0, "labelKey": "settings.general.cabin_layout.lhd" },
-            { "value": 1, "labelKey": "settings.general.cabin_layout.rhd" }
-        ]})json";
-        api->Meta_AddCustomSetting(h, "general.cabin_layout", "settings.general.cabin_layout.title", "settings.general.cabin_layout.desc", "radio", cabin_layout_options, false);
+    /**
+     * @brief Rebuilds only the caches that the changed settings feed.
+     * @param dirty SettingsFields::DirtyFlags of the fields that changed.
+     */
+    static void ApplySettingsChanges(uint32_t dirty)
+    {
+        WakeUp();
 
-        // --- Positions ---
-        const char *pos_names[] = {"passenger_seat", "standing", "sofa_sit1", "sofa_lie", "sofa_sit2"};
-        for (const char *name : pos_names)
+        if (dirty & SettingsFields::DIRTY_TRANSITIONS)
         {
-            // Add title for the position group itself
-            std::string group_key = std::string("positions.") + name;
-            std::string group_title_key = std::string("settings.positions.") + name + ".title";
-            api->Meta_AddCustomSetting(h, group_key.c_str(), group_title_key.c_str(), "", nullptr, nullptr, false);
-
-            std::string enabled_key = group_key + ".enabled";
-            std::string enabled_title_key = std::string("settings.positions.") + name + ".enabled.title";
-            api->Meta_AddCustomSetting(h, enabled_key.c_str(), enabled_title_key.c_str(), "settings.positions.enabled.desc", "checkbox", nullptr, false);
-
-            // Add titles for the subgroups
-            std::string pos_subgroup_key = group_key + ".position";
-            api->Meta_AddCustomSetting(h, pos_subgroup_key.c_str(), "settings.positions.position_group.title", "", nullptr, nullptr, false);
-
-            AddPositionCoordMeta(name, "x");
-            AddPositionCoordMeta(name, "y");
-            AddPositionCoordMeta(name, "z");
-
-            std::string rot_subgroup_key = group_key + ".rotation";
-            api->Meta_AddCustomSetting(h, rot_subgroup_key.c_str(), "settings.positions.rotation_group.title", "", nullptr, nullptr, false);
-
-            AddPositionRotationMeta(name, "x");
-            AddPositionRotationMeta(name, "y");
+            AnimationController::OnSettingsReloaded();
         }
 
-        api->Meta_AddCustomSetting(h, "animation_durations.main_animation_speed", "settings.animation_durations.main_animation_speed.title", "", nullptr, nullptr, false);
-        api->Meta_AddCustomSetting(h, "animation_durations.sofa_animation_speed", "settings.animation_durations.sofa_animation_speed.title", "", nullptr, nullptr, false);
-        api->Meta_AddCustomSetting(h, "animation_durations.crouch_and_stand_animation_speed", "settings.animation_durations.crouch_and_stand_animation_speed.title", "", nullptr, nullptr, false);
-
-        // --- Animation Durations ---
-        const char *main_anim_names[] = {
-            "driver_to_passenger", "passenger_to_driver", "driver_to_standing", "standing_to_driver",
-            "passenger_to_standing", "standing_to_passenger", "standing_to_sofa", "sofa_to_standing"};
-        for (const char *name : main_anim_names)
+        if (dirty & (SettingsFields::DIRTY_CAMERA_POSE | SettingsFields::DIRTY_WALK_ZONE))
         {
-            std::string key = std::string("animation_durations.main_animation_speed.") + name;
-            std::string title = std::string("settings.animation_durations.main_animation_speed.") + name + ".title";
-            std::string desc = std::string("settings.animation_durations.main_animation_speed.") + name + ".desc";
-            AddSliderMeta(key.c_str(), title.c_str(), desc.c_str(), 100.0f, 10000.0f, "%d ms");
+            // Eases the camera to the pose of the current position (e.g. a moved position) and, once the
+            // settings have settled, lets the hook manager rebuild the azimuth profiles.
+            AnimationController::NotifySettingsUpdated();
+            // The floor grid follows the walk zone and the standing position of the truck.
+            StandingAnimController::NotifyFloorChanged();
         }
-
-        const char *sofa_anim_names[] = {"sofa_sit1_to_lie", "sofa_lie_to_sit2", "sofa_sit2_to_sit1", "sofa_lie_to_sit1_shortcut"};
-        for (const char *name : sofa_anim_names)
+        else if (dirty & SettingsFields::DIRTY_AZIMUTH_PROFILES)
         {
-            std::string key = std::string("animation_durations.sofa_animation_speed.") + name;
-            std::string title = std::string("settings.animation_durations.sofa_animation_speed.") + name + ".title";
-            std::string desc = std::string("settings.animation_durations.sofa_animation_speed.") + name + ".desc";
-            AddSliderMeta(key.c_str(), title.c_str(), desc.c_str(), 100.0f, 10000.0f, "%d ms");
+            AnimationController::NotifyAzimuthSettingsUpdated();
         }
 
-        const char *crouch_anim_names[] = {"crouch", "tiptoe"};
-        for (const char *name : crouch_anim_names)
+        if (dirty & SettingsFields::DIRTY_TRACE)
         {
-            std::string key = std::string("animation_durations.crouch_and_stand_animation_speed.") + name;
-            std::string title = std::string("settings.animation_durations.crouch_and_stand_animation_speed.") + name + ".title";
-            std::string desc = std::string("settings.animation_durations.crouch_and_stand_animation_speed.") + name + ".desc";
-            AddSliderMeta(key.c_str(), title.c_str(), desc.c_str(), 100.0f, 10000.0f, "%d ms");
+            ApplyTraceSettings();
         }
 
-        // --- Standing Movement ---
-        // Walking
-        AddSliderMeta("standing_movement.walking.step_amount", "settings.standing_movement.walking.step_amount.title", "settings.standing_movement.walking.step_amount.desc", 0.01f, 1.0f, "%.2f m");
-        AddSliderMeta("standing_movement.walking.bob_amount", "settings.standing_movement.walking.bob_amount.title", "settings.standing_movement.walking.bob_amount.desc", 0.0f, 0.2f, "%.3f m");
-        AddSliderMeta("standing_movement.walking.walk_zone_z.min", "settings.standing_movement.walking.walk_zone_z.min.title", "settings.standing_movement.walking.walk_zone_z.desc", -2.0f, 2.0f, "%.2f m");
-        AddSliderMeta("standing_movement.walking.walk_zone_z.max", "settings.standing_movement.walking.walk_zone_z.max.title", "settings.standing_movement.walking.walk_zone_z.desc", -2.0f, 2.0f, "%.2f m");
-
-        // Stance Control
-        AddSliderMeta("standing_movement.stance_control.hold_time_ms", "settings.standing_movement.stance_control.hold_time_ms.title", "settings.standing_movement.stance_control.hold_time_ms.desc", 100.0f, 5000.0f, "%d ms");
+        if (dirty & SettingsFields::DIRTY_ANIMATION_ASSETS)
+        {
+            AnimationController::ReloadAnimationAssets();
+        }
 
-        // Crouch
-        AddSliderMeta("standing_movement.stance_control.crouch.depth", "settings.standing_movement.stance_control.crouch.depth.title", "settings.standing_movement.stance_control.crouch.depth.desc", 0.1f, 1.0f, "%.2f m");
-        AddSliderMeta("standing_movement.stance_control.crouch.activation_angle", "settings.standing_movement.stance_control.crouch.activation_angle.title", "settings.standing_movement.stance_control.activation_angle.desc", -1.57f, 0.0f, "%.2f rad");
-        AddSliderMeta("standing_movement.stance_control.crouch.deactivation_angle", "settings.standing_movement.stance_control.crouch.deactivation_angle.title", "settings.standing_movement.stance_control.deactivation_angle.desc", 0.0f, 1.57f, "%.2f rad");
+        if (dirty & SettingsFields::DIRTY_TRUCK_PROFILE)
+        {
+            TruckProfiles::StoreActive(g_ctx.settings);
+        }
+    }
 
-        // Tiptoe
-        AddSliderMeta("standing_movement.stance_control.tiptoe.height", "settings.standing_movement.stance_control.tiptoe.height.title", "settings.standing_movement.stance_control.tiptoe.height.desc", 0.05f, 0.5f, "%.2f m");
-        AddSliderMeta("standing_movement.stance_control.tiptoe.activation_angle", "settings.standing_movement.stance_control.tiptoe.activation_angle.title", "settings.standing_movement.stance_control.activation_angle.desc", 0.0f, 1.57f, "%.2f rad");
-        AddSliderMeta("standing_movement.stance_control.tiptoe.deactivation_angle", "settings.standing_movement.stance_control.tiptoe.deactivation_angle.title", "settings.standing_movement.stance_control.deactivation_angle.desc", -1.57f, 0.0f, "%.2f rad");
+    /**
+     * @brief Swaps in the profile of the player's truck when the truck changes.
+     */
+    static void SwitchTruckProfile(const char *brand_id, const char *model_id)
+    {
+        if (!TruckProfiles::Activate(brand_id, model_id, g_ctx.settings))
+        {
+            return;
+        }
 
-        // Sofa Limits
-        api->Meta_AddCustomSetting(h, "sofa_limits", nullptr, nullptr, nullptr, nullptr, true);
-        
-        // walking animation speed
-        api->Meta_AddCustomSetting(h, "walking_animation_speed", nullptr, nullptr, nullptr, nullptr, true);
+        if (g_ctx.loggerHandle && g_ctx.formattingAPI)
+        {
+            char log_buffer[256];
+            g_ctx.formattingAPI->Fmt_Format(log_buffer, sizeof(log_buffer), "[TruckProfiles] Using the profile of '%s'.", TruckProfiles::GetActiveKey());
+            g_ctx.loadAPI->logger->Log(g_ctx.loggerHandle, SPF_LOG_INFO, log_buffer);
+        }
 
-        // Window Description
-        api->Meta_AddWindow(h, "WarningWindow", "Warning", "Displayed when it is not safe to leave the driver's seat.");
+        // The poses, azimuth profiles and walk bounds follow the profile; baked transitions stay valid.
+        ApplySettingsChanges(SettingsFields::DIRTY_CAMERA_POSE | SettingsFields::DIRTY_AZIMUTH_PROFILES | SettingsFields::DIRTY_WALK_ZONE);
     }
 
-    // =================================================================================================
-    // 3. Plugin Lifecycle Implementations
-    // =================================================================================================
-    // The following functions are the core lifecycle events for the plugin.
-
     void LoadSettings(const SPF_Config_API *configAPI, SPF_Config_Handle *configHandle)
     {
         if (!configAPI || !configHandle)
@@ -352,110 +261,43 @@ namespace SPF_CabinWalk
             return;
         }
 
-        // A helper for logging
-        auto log = [&](const char *msg)
-        {
-            if (g_ctx.loggerHandle)
-                g_ctx.loadAPI->logger->Log(g_ctx.loggerHandle, SPF_LOG_INFO, msg);
-        };
-        log("[LoadSettings] Starting to load settings...");
+        SettingsFields::LoadAll(configAPI, configHandle, g_ctx.settings);
+        ApplyTraceSettings();
+        WakeUp();
 
-        // Helper lambdas to simplify getting values
-        auto get_int = [&](const char *key, int32_t def)
-        {
-            return configAPI->Cfg_GetInt32(configHandle, key, def);
-        };
-        auto get_float = [&](const char *key, float def)
-        {
-            return (float)configAPI->Cfg_GetFloat(configHandle, key, (double)def);
-        };
-        auto get_bool = [&](const char *key, bool def)
+        if (g_ctx.loggerHandle)
+            g_ctx.loadAPI->logger->Log(g_ctx.loggerHandle, SPF_LOG_INFO, "[LoadSettings] All settings reloaded successfully.");
+    }
+    void OnSettingChanged(SPF_Config_Handle *config_handle, const char *keyPath)
+    {
+        if (!g_ctx.configAPI || !keyPath)
         {
-            return configAPI->Cfg_GetBool(configHandle, key, def);
-        };
-
-        // General
-        g_ctx.settings.general.warning_duration_ms = get_int("settings.general.warning_duration_ms", 5000);
-        g_ctx.settings.general.cabin_layout = get_int("settings.general.cabin_layout", 0);
-        g_ctx.settings.general.height = get_float("settings.general.height", 0.25f);
-
-        // Animation Durations
-        g_ctx.settings.animation_durations.main_animation_speed.driver_to_passenger = get_int("settings.animation_durations.main_animation_speed.driver_to_passenger", 3000);
-        g_ctx.settings.animation_durations.main_animation_speed.passenger_to_driver = get_int("settings.animation_durations.main_animation_speed.passenger_to_driver", 3000);
-        g_ctx.settings.animation_durations.main_animation_speed.driver_to_standing = get_int("settings.animation_durations.main_animation_speed.driver_to_standing", 2500);
-        g_ctx.settings.animation_durations.main_animation_speed.standing_to_driver = get_int("settings.animation_durations.main_animation_speed.standing_to_driver", 2000);
-        g_ctx.settings.animation_durations.main_animation_speed.passenger_to_standing = get_int("settings.animation_durations.main_animation_speed.passenger_to_standing", 2500);
-        g_ctx.settings.animation_durations.main_animation_speed.standing_to_passenger = get_int("settings.animation_durations.main_animation_speed.standing_to_passenger", 2000);
-        g_ctx.settings.animation_durations.main_animation_speed.standing_to_sofa = get_int("settings.animation_durations.main_animation_speed.standing_to_sofa", 1500);
-        g_ctx.settings.animation_durations.main_animation_speed.sofa_to_standing = get_int("settings.animation_durations.main_animation_speed.sofa_to_standing", 1800);
-
-        g_ctx.settings.animation_durations.sofa_animation_speed.sofa_sit1_to_lie = get_int("settings.animation_durations.sofa_animation_speed.sofa_sit1_to_lie", 5000);
-        g_ctx.settings.animation_durations.sofa_animation_speed.sofa_lie_to_sit2 = get_int("settings.animation_durations.sofa_animation_speed.sofa_lie_to_sit2", 2500);
-        g_ctx.settings.animation_durations.sofa_animation_speed.sofa_sit2_to_sit1 = get_int("settings.animation_durations.sofa_animation_speed.sofa_sit2_to_sit1", 1200);
-        g_ctx.settings.animation_durations.sofa_animation_speed.sofa_lie_to_sit1_shortcut = get_int("settings.animation_durations.sofa_animation_speed.sofa_lie_to_sit1_shortcut", 2800);
-
-        g_ctx.settings.animation_durations.crouch_and_stand_animation_speed.crouch = get_int("settings.animation_durations.crouch_and_stand_animation_speed.crouch", 1250);
-        g_ctx.settings.animation_durations.crouch_and_stand_animation_speed.tiptoe = get_int("settings.animation_durations.crouch_and_stand_animation_speed.tiptoe", 1100);
-
-        g_ctx.settings.walking_animation_speed.walk_step = get_int("settings.walking_animation_speed.walk_step", 450);
-        g_ctx.settings.walking_animation_speed.walk_first_step_base = get_int("settings.walking_animation_speed.walk_first_step_base", 250);
-        g_ctx.settings.walking_animation_speed.walk_first_step_turn_extra = get_int("settings.walking_animation_speed.walk_first_step_turn_extra", 1000);
-
-        // Standing Movement
-        g_ctx.settings.standing_movement.walking.step_amount = get_float("settings.standing_movement.walking.step_amount", 0.35f);
-        g_ctx.settings.standing_movement.walking.bob_amount = get_float("settings.standing_movement.walking.bob_amount", 0.02f);
-        g_ctx.settings.standing_movement.walking.walk_zone_z.min = get_float("settings.standing_movement.walking.walk_zone_z.min", -0.55f);
-        g_ctx.settings.standing_movement.walking.walk_zone_z.max = get_float("settings.standing_movement.walking.walk_zone_z.max", 0.65f);
-
-        g_ctx.settings.standing_movement.stance_control.hold_time_ms = get_int("settings.standing_movement.stance_control.hold_time_ms", 1000);
-
-        g_ctx.settings.standing_movement.stance_control.crouch.depth = get_float("settings.standing_movement.stance_control.crouch.depth", 0.5f);
-        g_ctx.settings.standing_movement.stance_control.crouch.activation_angle = get_float("settings.standing_movement.stance_control.crouch.activation_angle", -0.7f);
-        g_ctx.settings.standing_movement.stance_control.crouch.deactivation_angle = get_float("settings.standing_movement.stance_control.crouch.deactivation_angle", 0.3f);
-
-        g_ctx.settings.standing_movement.stance_control.tiptoe.height = get_float("settings.standing_movement.stance_control.tiptoe.height", 0.17f);
-        g_ctx.settings.standing_movement.stance_control.tiptoe.activation_angle = get_float("settings.standing_movement.stance_control.tiptoe.activation_angle", 0.5f);
-        g_ctx.settings.standing_movement.stance_control.tiptoe.deactivation_angle = get_float("settings.standing_movement.stance_control.tiptoe.deactivation_angle", -0.3f);
-
-        // Sofa Limits
-        g_ctx.settings.sofa_limits.yaw_left = get_float("settings.sofa_limits.yaw_left", 180.0f);
-        g_ctx.settings.sofa_limits.yaw_right = get_float("settings.sofa_limits.yaw_right", -180.0f);
-        g_ctx.settings.sofa_limits.pitch_up = get_float("settings.sofa_limits.pitch_up", 90.0f);
-        g_ctx.settings.sofa_limits.pitch_down = get_float("settings.sofa_limits.pitch_down", -65.0f);
+            return;
+        }
 
-        // Positions
-        auto load_pos = [&](const char *name, AppSettings::PositionSetting &pos_setting, const AppSettings::PositionSetting &default_pos)
+        // A batch flush reloads the keys it wrote once it is done, and a truck profile is applied as a whole
+        // by SwitchTruckProfile.
+        if (ConfigBatch::IsFlushing() || TruckProfiles::IsApplying())
         {
-            std::string base_path = std::string("settings.positions.") + name;
-
-            pos_setting.enabled = get_bool((base_path + ".enabled").c_str(), default_pos.enabled);
-
-            pos_setting.position.x = get_float((base_path + ".position.x").c_str(), default_pos.position.x);
-            pos_setting.position.y = get_float((base_path + ".position.y").c_str(), default_pos.position.y);
-            pos_setting.position.z = get_float((base_path + ".position.z").c_str(), default_pos.position.z);
-
-            pos_setting.rotation.x = get_float((base_path + ".rotation.x").c_str(), default_pos.rotation.x);
-            pos_setting.rotation.y = get_float((base_path + ".rotation.y").c_str(), default_pos.rotation.y);
-        };
-
-        load_pos("passenger_seat", g_ctx.settings.positions.passenger_seat, {true, {0.95f, 0.0f, -0.03f}, {0.03f, 0.03f, 0.0f}});
-        load_pos("standing", g_ctx.settings.positions.standing, {true, {0.5f, 0.2f, 0.25f}, {-0.17f, -0.3f, 0.0f}});
-        load_pos("sofa_sit1", g_ctx.settings.positions.sofa_sit1, {true, {0.5f, 0.0f, 0.8f}, {0.0f, 0.0f, 0.0f}});
-        load_pos("sofa_lie", g_ctx.settings.positions.sofa_lie, {true, {-0.15f, -0.25f, 1.25f}, {-1.65f, 0.35f, 0.0f}});
-        load_pos("sofa_sit2", g_ctx.settings.positions.sofa_sit2, {true, {0.2f, 0.0f, 0.8f}, {0.0f, 0.0f, 0.0f}});
+            return;
+        }
 
-        log("[LoadSettings] All settings reloaded successfully.");
-    }
-    void OnSettingChanged(SPF_Config_Handle *config_handle, const char *keyPath)
-    {
-        // For simplicity, we can just reload all settings.
-        LoadSettings(g_ctx.configAPI, config_handle);
+        // Re-read only the changed field, and rebuild only what depends on it.
+        bool known = false;
+        const uint32_t dirty = SettingsFields::LoadKey(g_ctx.configAPI, config_handle, keyPath, g_ctx.settings, &known);
+        if (known)
+        {
+            ApplySettingsChanges(dirty);
+            return;
+        }
 
-        // ONLY notify the animation controller if a setting that affects position has changed.
-        if (strstr(keyPath, "settings.positions") != NULL || strstr(keyPath, "settings.standing_movement") != NULL)
+        // The offset cache and the truck profiles are written by the plugin itself, and nothing else under
+        // "settings." should be missing from the field table; reload everything for anything unexpected, as before.
+        if (strncmp(keyPath, "settings.", 9) == 0 && strncmp(keyPath, "settings.offset_cache.", 22) != 0 &&
+            strncmp(keyPath, TruckProfiles::CONFIG_PREFIX, strlen(TruckProfiles::CONFIG_PREFIX)) != 0)
         {
-            // Notify the animation controller that settings have changed, so it can react (e.g., snap camera to new position).
-            AnimationController::NotifySettingsUpdated();
+            LoadSettings(g_ctx.configAPI, config_handle);
+            ApplySettingsChanges(SettingsFields::DIRTY_TRANSITIONS | SettingsFields::DIRTY_CAMERA_POSE | SettingsFields::DIRTY_TRUCK_PROFILE);
         }
     }
 
@@ -475,6 +317,7 @@ namespace SPF_CabinWalk
         {
             if (g_ctx.coreAPI->localization->Loc_SetLanguage(h, langCode))
             {
+                UIResources::InvalidateText();
                 g_ctx.loadAPI->logger->Log(g_ctx.loggerHandle, SPF_LOG_INFO, "Plugin language synchronized with framework.");
             }
         }
@@ -482,6 +325,8 @@ namespace SPF_CabinWalk
 
     void OnLoad(const SPF_Load_API *load_api)
     {
+        TraceProvider::Register();
+
         // Cache the provided API pointers in our global context.
         g_ctx.loadAPI = load_api;
 
@@ -517,6 +362,9 @@ namespace SPF_CabinWalk
                 }
             }
         }
+
+        // Created before the first frame, so a consumer started with the game finds the section at once.
+        StateExport::Open();
     }
 
     AnimationController::CameraPosition GetNextEnabledSofaPos(AnimationController::CameraPosition current_pos)
@@ -585,24 +433,103 @@ namespace SPF_CabinWalk
         return AnimationController::CameraPosition::None; // No other spots are enabled, so stay put.
     }
 
-    void OnCycleSofaPositions()
+    static bool HandleCycleSofaPositions()
     {
         if (!IsSafeToLeaveDriverSeat())
         {
-            return;
+            return false;
         }
 
         if (AnimationController::IsAnimating() || AnimationController::HasPendingMoves())
         {
-            return; // Don't do anything if an animation is already playing or pending
+            return false; // Don't do anything if an animation is already playing or pending
+        }
+
+        if (IsCameraHookPending())
+        {
+            return false;
         }
 
         AnimationController::CameraPosition current_pos = AnimationController::GetCurrentPosition();
         AnimationController::CameraPosition next_pos = GetNextEnabledSofaPos(current_pos);
 
-        if (next_pos != AnimationController::CameraPosition::None)
+        return next_pos != AnimationController::CameraPosition::None && AnimationController::OnRequestMove(next_pos);
+    }
+
+    /**
+     * @brief Gets the "settings.positions" group of a position, or nullptr for one without settings.
+     */
+    static const char *GetPositionSettingsName(AnimationController::CameraPosition pos)
+    {
+        switch (pos)
+        {
+        case AnimationController::CameraPosition::Passenger:
+            return "passenger_seat";
+        case AnimationController::CameraPosition::Standing:
+            return "standing";
+        case AnimationController::CameraPosition::SofaSit1:
+            return "sofa_sit1";
+        case AnimationController::CameraPosition::SofaLie:
+            return "sofa_lie";
+        case AnimationController::CameraPosition::SofaSit2:
+            return "sofa_sit2";
+        default:
+            return nullptr; // The driver's seat is the game's own.
+        }
+    }
+
+    static void HandleCapturePose()
+    {
+        if (!AnimationController::IsCameraSettled() || AnimationController::HasPendingMoves())
+        {
+            return; // Only a settled pose is worth keeping
+        }
+
+        const char *name = GetPositionSettingsName(AnimationController::GetCurrentPosition());
+        if (!name || !g_ctx.formattingAPI)
+        {
+            return;
+        }
+
+        // Staged, not written: the five keys are flushed together after the frame and reloaded once.
+        const Animation::CurrentCameraState state = CameraFacade::GetState();
+        const struct
+        {
+            const char *field;
+            float value;
+        } values[] = {
+            {"position.x", state.position.x},
+            {"position.y", state.position.y},
+            {"position.z", state.position.z},
+            {"rotation.x", state.rotation.x},
+            {"rotation.y", state.rotation.y},
+        };
+
+        char key[128];
+        uint32_t refused = 0;
+        for (const auto &value : values)
+        {
+            g_ctx.formattingAPI->Fmt_Format(key, sizeof(key), "settings.positions.%s.%s", name, value.field);
+            if (!ConfigBatch::StageFloat(key, value.value))
+            {
+                ++refused;
+            }
+        }
+
+        if (g_ctx.loggerHandle)
         {
-            AnimationController::OnRequestMove(next_pos);
+            char log_buffer[256];
+            if (refused > 0)
+            {
+                g_ctx.formattingAPI->Fmt_Format(log_buffer, sizeof(log_buffer), "[Calibration] The pose of '%s' was only partly captured: %u of its values did not fit in the pending config batch. Capture it again after this frame.",
+                                                name, refused);
+                g_ctx.loadAPI->logger->Log(g_ctx.loggerHandle, SPF_LOG_WARN, log_buffer);
+            }
+            else
+            {
+                g_ctx.formattingAPI->Fmt_Format(log_buffer, sizeof(log_buffer), "[Calibration] Captured the current pose as '%s'.", name);
+                g_ctx.loadAPI->logger->Log(g_ctx.loggerHandle, SPF_LOG_INFO, log_buffer);
+            }
         }
     }
 
@@ -647,12 +574,20 @@ namespace SPF_CabinWalk
                     g_ctx.coreAPI->keybinds->Kbind_Register(g_ctx.keybindsHandle, "SPF_CabinWalk.Movement.moveToDriverSeat", OnMoveToDriverSeat);
                     g_ctx.coreAPI->keybinds->Kbind_Register(g_ctx.keybindsHandle, "SPF_CabinWalk.Movement.moveToStandingPosition", OnMoveToStandingPosition);
                     g_ctx.coreAPI->keybinds->Kbind_Register(g_ctx.keybindsHandle, "SPF_CabinWalk.Movement.cycleSofaPositions", OnCycleSofaPositions);
+                    g_ctx.coreAPI->keybinds->Kbind_Register(g_ctx.keybindsHandle, "SPF_CabinWalk.Calibration.capturePose", OnCapturePose);
                 }
             }
 
             if (g_ctx.coreAPI->telemetry)
             {
                 g_ctx.telemetryHandle = g_ctx.coreAPI->telemetry->Tel_GetContext(PLUGIN_NAME);
+                if (g_ctx.telemetryHandle)
+                {
+                    // The subscriptions are released together with the telemetry handle.
+                    g_ctx.timestampsSubscription = g_ctx.coreAPI->telemetry->Tel_RegisterForTimestamps(g_ctx.telemetryHandle, OnTimestamps, &g_ctx);
+                    g_ctx.truckDataSubscription = g_ctx.coreAPI->telemetry->Tel_RegisterForTruckData(g_ctx.telemetryHandle, OnTruckData, &g_ctx);
+                    g_ctx.truckConstantsSubscription = g_ctx.coreAPI->telemetry->Tel_RegisterForTruckConstants(g_ctx.telemetryHandle, OnTruckConstants, &g_ctx);
+                }
             }
 
             g_ctx.uiAPI = g_ctx.coreAPI->ui;
@@ -663,20 +598,269 @@ namespace SPF_CabinWalk
         // Initialize controller modules
         AnimationController::Initialize(&g_ctx);
     }
+    static void UpdateFrame();
+    static bool HandleMoveToPassengerSeat();
+    static bool HandleMoveToDriverSeat();
+    static bool HandleMoveToStandingPosition();
+
+    /**
+     * @brief Resumes per-frame work after an idle period.
+     */
+    static void WakeUp()
+    {
+        if (!g_is_idle)
+        {
+            return;
+        }
+
+        g_is_idle = false;
+        CameraHookManager::SetIdle(false);
+
+        // The idle detour no longer invalidated the cache after mouse look, so the cached pose is stale.
+        CameraFacade::Invalidate();
+    }
+
+    /**
+     * @brief Enters the idle mode once the plugin has nothing left to do in the driver seat.
+     * @details Nothing the plugin does per frame matters there: no transition, preview, queued move,
+     *          debounce, stance change, warning, trace or hook installation is pending, and the hook has
+     *          applied the driver state. Hot reloading of the animation asset also waits for the next wake.
+     */
+    static void TryEnterIdle()
+    {
+        if (g_camera_hook_pending || InputQueue::HasPending() || g_ctx.is_warning_active || CameraTrace::GetMode() != CameraTrace::Mode::Off ||
+            !AnimationController::IsIdle() || !CameraHookManager::IsSettled())
+        {
+            return;
+        }
+
+        g_is_idle = true;
+        CameraHookManager::SetIdle(true);
+
+        // The first frame after waking starts a new delta instead of spanning the whole idle period.
+        g_last_frame_time_us = 0;
+    }
+
+    /**
+     * @brief Samples the clock, the interior camera pose and the input state for this frame.
+     */
+    static FrameContext BuildFrameContext()
+    {
+        FrameContext frame;
+        frame.frame = g_ctx.telemetry.frame;
+        frame.simulation_time_us = g_ctx.telemetry.simulation_time;
+        // A clock that jumped backwards (e.g. a loaded save) restarts the delta rather than wrapping it.
+        frame.delta_time_us = (g_last_frame_time_us != 0 && frame.simulation_time_us >= g_last_frame_time_us)
+                                  ? frame.simulation_time_us - g_last_frame_time_us
+                                  : 0;
+        g_last_frame_time_us = frame.simulation_time_us;
+
+        if (g_ctx.cameraAPI)
+        {
+            frame.camera = CameraFacade::GetState();
+        }
+        frame.walk_key_down = g_is_walk_key_down;
+        return frame;
+    }
+
+    /**
+     * @brief Starts timing the wait for the motion a keybind action started, if it started one.
+     * @param was_walking The walk toggle before the action ran.
+     * @param started_move Whether the action's handler started a move or redirected the one in flight.
+     */
+    static void ArmInputLatency(const InputQueue::Command &command, bool was_walking, bool started_move)
+    {
+        Latency::Metric metric;
+        switch (command.type)
+        {
+        case InputQueue::CommandType::MoveToPassengerSeat:
+            metric = Latency::Metric::PassengerSeat;
+            break;
+        case InputQueue::CommandType::MoveToDriverSeat:
+            metric = Latency::Metric::DriverSeat;
+            break;
+        case InputQueue::CommandType::MoveToStandingPosition:
+            if (g_is_walk_key_down != was_walking)
+            {
+                if (g_is_walk_key_down)
+                {
+                    Latency::Arm(Latency::Metric::Walk, command.timestamp_us);
+                }
+                return;
+            }
+            metric = Latency::Metric::Standing;
+            break;
+        case InputQueue::CommandType::CycleSofaPositions:
+            metric = Latency::Metric::Sofa;
+            break;
+        default:
+            return;
+        }
+
+        // A refused move (unsafe to leave the seat, position disabled, busy) starts nothing to wait for.
+        if (started_move)
+        {
+            Latency::Arm(metric, command.timestamp_us);
+        }
+    }
+
+    /**
+     * @brief Carries out the keybind actions queued since the last frame, oldest first.
+     */
+    static void ProcessInput()
+    {
+        InputQueue::Command command;
+        while (InputQueue::Pop(command))
+        {
+            const bool was_walking = g_is_walk_key_down;
+            bool started_move = false;
+            switch (command.type)
+            {
+            case InputQueue::CommandType::MoveToPassengerSeat:
+                started_move = HandleMoveToPassengerSeat();
+                break;
+            case InputQueue::CommandType::MoveToDriverSeat:
+                started_move = HandleMoveToDriverSeat();
+                break;
+            case InputQueue::CommandType::MoveToStandingPosition:
+                started_move = HandleMoveToStandingPosition();
+                break;
+            case InputQueue::CommandType::CycleSofaPositions:
+                started_move = HandleCycleSofaPositions();
+                break;
+            case InputQueue::CommandType::CapturePose:
+                HandleCapturePose();
+                break;
+            }
+            ArmInputLatency(command, was_walking, started_move);
+        }
+
+        const uint32_t dropped = InputQueue::TakeDroppedCount();
+        if (dropped > 0 && g_ctx.loggerHandle && g_ctx.formattingAPI)
+        {
+            char log_buffer[128];
+            g_ctx.formattingAPI->Fmt_Format(log_buffer, sizeof(log_buffer), "[Keybind] %u actions dropped; the input queue was full.", dropped);
+            g_ctx.loadAPI->logger->Log(g_ctx.loggerHandle, SPF_LOG_WARN, log_buffer);
+        }
+    }
+
+    /**
+     * @brief Checks the condition for leaving the driver seat: the truck is stationary with the parking brake on.
+     */
+    static bool IsParked()
+    {
+        return g_ctx.telemetry.has_truck_data && fabsf(g_ctx.telemetry.speed) < 0.1f && g_ctx.telemetry.parking_brake;
+    }
+
+    /**
+     * @brief Prepares the moves out of the current position, idle frames included, so the frame of the
+     *        next keypress binds a bake and the frame of arrival writes a ready position profile.
+     * @details In the driver seat this waits until the truck is parked, since no move can start before
+     *          that; the next action is then almost always a move to Standing or the passenger seat.
+     *          Both calls return at once once their work is done.
+     */
+    static void PrewarmNextMove()
+    {
+        if (AnimationController::GetCurrentPosition() == AnimationController::CameraPosition::Driver && !IsParked())
+        {
+            return;
+        }
+
+        AnimationController::PrewarmOutgoingTransitions();
+        CameraHookManager::RequestProfilePrewarm();
+    }
+
     void OnUpdate()
+    {
+        // OnUpdate runs once per game frame, so idle frames are marked too.
+        TraceProvider::EmitFrame();
+
+        PrewarmNextMove();
+
+        if (g_is_idle)
+        {
+            // The keybinds only queue their actions, so the first queued one ends the idle period here.
+            if (!InputQueue::HasPending())
+            {
+                // Still published while idle: mouse look turns the head, and consumers tell a live plugin
+                // from a hung one by the frame count. Nothing is written, so the facade needs no flush.
+                CameraFacade::BeginFrame();
+                StateExport::Publish(g_ctx.telemetry.simulation_time);
+                return;
+            }
+            WakeUp();
+        }
+
+#if defined(SPF_CABINWALK_ENABLE_PROFILER)
+        // Only record while the overlay is open, so a hidden overlay costs one load per zone.
+        Profiler::SetEnabled(g_ctx.uiAPI && g_ctx.profilerWindowHandle && g_ctx.uiAPI->UI_IsVisible(g_ctx.profilerWindowHandle));
+#endif
+#if defined(SPF_CABINWALK_ENABLE_DEBUG_OVERLAY)
+        DebugOverlay::SetEnabled(g_ctx.uiAPI && g_ctx.debugOverlayWindowHandle && g_ctx.uiAPI->UI_IsVisible(g_ctx.debugOverlayWindowHandle));
+#endif
+
+        {
+            SPF_CABINWALK_PROFILE_ZONE(OnUpdate);
+            UpdateFrame();
+        }
+
+        Latency::LogNewSamples();
+
+        // Config writes staged during the frame go out together, after the frame is done.
+        if (ConfigBatch::HasPending())
+        {
+            ApplySettingsChanges(ConfigBatch::Flush(g_ctx.configAPI, g_ctx.configHandle, g_ctx.settings));
+        }
+
+#if defined(SPF_CABINWALK_ENABLE_PROFILER)
+        Profiler::EndFrame();
+#endif
+#if defined(SPF_CABINWALK_ENABLE_DEBUG_OVERLAY)
+        DebugOverlay::EndFrame();
+#endif
+    }
+
+    static void UpdateFrame()
     {
         // This function is called every frame while the plugin is active.
         // Avoid performing heavy or blocking operations here, as it will directly impact game performance.
 
+        // Install the camera hook once the background offset scan has published its results.
+        if (g_camera_hook_pending)
+        {
+            PollOffsetDiscovery();
+        }
+
+        // Camera reads are cached for the frame; all writes are flushed once, after every module has run.
+        CameraFacade::BeginFrame();
+
+        // Keybind actions run here, so they see this frame's pose and their moves start in this frame.
+        ProcessInput();
+
+        // Sample the frame once; every controller reads this instead of querying the framework itself.
+        const FrameContext frame = BuildFrameContext();
+
         // Update our modules
-        AnimationController::Update();
+        AnimationController::Update(frame);
+
+        // Every layer the modules set this frame makes one pose, and one camera write on the flush.
+        LayerStack::Compose();
+
+        // Record this frame's camera state, or overwrite it with the trace being replayed.
+        if (CameraTrace::GetMode() != CameraTrace::Mode::Off)
+        {
+            CameraTrace::OnFrame(frame.simulation_time_us);
+        }
+
+        // Publish the pose that is about to be written, a replayed one included.
+        StateExport::Publish(frame.simulation_time_us);
+
+        CameraFacade::Flush();
 
         // --- Warning Window Timer ---
-        if (g_ctx.is_warning_active && g_ctx.coreAPI && g_ctx.coreAPI->telemetry && g_ctx.telemetryHandle)
+        if (g_ctx.is_warning_active)
         {
-            SPF_Timestamps timestamps;
-            g_ctx.coreAPI->telemetry->Tel_GetTimestamps(g_ctx.telemetryHandle, &timestamps, sizeof(SPF_Timestamps));
-            if ((timestamps.simulation - g_ctx.warning_start_time) > g_ctx.settings.general.warning_duration_ms * 1000)
+            if ((frame.simulation_time_us - g_ctx.warning_start_time) > g_ctx.settings.general.warning_duration_ms * 1000)
             {
                 g_ctx.is_warning_active = false;
                 if (g_ctx.uiAPI && g_ctx.warningWindowHandle)
@@ -685,6 +869,8 @@ namespace SPF_CabinWalk
                 }
             }
         }
+
+        TryEnterIdle();
     }
 
     void OnUnload()
@@ -699,6 +885,31 @@ namespace SPF_CabinWalk
             g_ctx.loadAPI->logger->Log(g_ctx.loggerHandle, SPF_LOG_INFO, log_buffer);
         }
 
+        // Make sure a background offset scan is not still running when the module goes away.
+        Offsets::Shutdown();
+        g_camera_hook_pending = false;
+
+        // Likewise a transition rebake.
+        AnimationController::Shutdown();
+
+        // Events written after this are dropped.
+        TraceProvider::Unregister();
+
+        // Unmap the trace file; the samples recorded so far stay on disk.
+        CameraTrace::Stop();
+
+        // Consumers still mapping the section keep the last published frame.
+        StateExport::Close();
+
+        // Release the retained UI styles while the UI API is still valid.
+        UIResources::Shutdown();
+
+        // Writes still staged would go to a config that is going away.
+        ConfigBatch::Clear();
+
+        // The profiles are already in the config; only the in-memory cache goes.
+        TruckProfiles::Reset();
+
         // Nullify all cached API pointers and handles.
         g_ctx.coreAPI = nullptr;
         g_ctx.loadAPI = nullptr;
@@ -711,7 +922,13 @@ namespace SPF_CabinWalk
         g_ctx.keybindsHandle = nullptr;
         g_ctx.uiAPI = nullptr;
         g_ctx.warningWindowHandle = nullptr;
+        g_ctx.profilerWindowHandle = nullptr;
+        g_ctx.debugOverlayWindowHandle = nullptr;
         g_ctx.telemetryHandle = nullptr;
+        g_ctx.timestampsSubscription = nullptr;
+        g_ctx.truckDataSubscription = nullptr;
+        g_ctx.truckConstantsSubscription = nullptr;
+        g_ctx.telemetry = {};
         g_ctx.hooksAPI = nullptr;
         g_ctx.cameraAPI = nullptr;
     }
@@ -728,8 +945,20 @@ namespace SPF_CabinWalk
         // Get the handle for our warning window
         g_ctx.warningWindowHandle = g_ctx.uiAPI->UI_GetWindowHandle(PLUGIN_NAME, "WarningWindow");
 
+        // Styles, text and layout of our windows are created once and reused by the draw callbacks.
+        UIResources::Initialize(g_ctx.uiAPI, PLUGIN_NAME);
+
         // Register the drawing callback for our warning window
         g_ctx.uiAPI->UI_RegisterDrawCallback(PLUGIN_NAME, "WarningWindow", DrawWarningWindow, &g_ctx);
+
+#if defined(SPF_CABINWALK_ENABLE_PROFILER)
+        g_ctx.profilerWindowHandle = g_ctx.uiAPI->UI_GetWindowHandle(PLUGIN_NAME, "ProfilerWindow");
+        g_ctx.uiAPI->UI_RegisterDrawCallback(PLUGIN_NAME, "ProfilerWindow", DrawProfilerWindow, &g_ctx);
+#endif
+#if defined(SPF_CABINWALK_ENABLE_DEBUG_OVERLAY)
+        g_ctx.debugOverlayWindowHandle = g_ctx.uiAPI->UI_GetWindowHandle(PLUGIN_NAME, "DebugOverlayWindow");
+        g_ctx.uiAPI->UI_RegisterDrawCallback(PLUGIN_NAME, "DebugOverlayWindow", DrawDebugOverlayWindow, &g_ctx);
+#endif
     }
 
     void DrawWarningWindow(SPF_UI_API *ui, void *user_data)
@@ -738,51 +967,45 @@ namespace SPF_CabinWalk
             return;
 
         // --- Dynamic Positioning ---
-        // On every frame this window is drawn, calculate its desired position and
-        // update the configuration values that the UI framework reads from.
+        // The window stays centered near the bottom of the viewport. The configuration values the UI
+        // framework reads its placement from are only rewritten when the viewport size changes.
         float viewport_w, viewport_h;
         ui->UI_GetViewportSize(&viewport_w, &viewport_h);
 
-        const float window_w = 400; // Using the width from the manifest
-        const float window_h = 100; // Using a smaller, more reasonable height
-        const float offset_from_bottom = 100.0f;
-
-        int new_pos_x = static_cast<int>((viewport_w / 2.0f) - (window_w / 2.0f));
-        int new_pos_y = static_cast<int>(viewport_h - window_h - offset_from_bottom);
-
-        // Update the config values that the UI system reads from for positioning.
-        g_ctx.configAPI->Cfg_SetInt32(g_ctx.configHandle, "ui.windows.WarningWindow.pos_x", new_pos_x);
-        g_ctx.configAPI->Cfg_SetInt32(g_ctx.configHandle, "ui.windows.WarningWindow.pos_y", new_pos_y);
-        g_ctx.configAPI->Cfg_SetInt32(g_ctx.configHandle, "ui.windows.WarningWindow.size_w", static_cast<int>(window_w));
-        g_ctx.configAPI->Cfg_SetInt32(g_ctx.configHandle, "ui.windows.WarningWindow.size_h", static_cast<int>(window_h));
+        UIResources::WarningLayout layout;
+        if (UIResources::UpdateWarningLayout(viewport_w, viewport_h, &layout))
+        {
+            g_ctx.configAPI->Cfg_SetInt32(g_ctx.configHandle, "ui.windows.WarningWindow.pos_x", layout.pos_x);
+            g_ctx.configAPI->Cfg_SetInt32(g_ctx.configHandle, "ui.windows.WarningWindow.pos_y", layout.pos_y);
+            g_ctx.configAPI->Cfg_SetInt32(g_ctx.configHandle, "ui.windows.WarningWindow.size_w", layout.size_w);
+            g_ctx.configAPI->Cfg_SetInt32(g_ctx.configHandle, "ui.windows.WarningWindow.size_h", layout.size_h);
+        }
 
         PluginContext *ctx = static_cast<PluginContext *>(user_data);
         if (ctx->is_warning_active)
         {
-            // Get the warning message
-            char warning_message[512];
-            g_ctx.loadAPI->localization->Loc_GetString(
-                g_ctx.loadAPI->localization->Loc_GetContext(PLUGIN_NAME),
-                "messages.warning_not_safe_to_move",
-                warning_message, sizeof(warning_message));
-
-            // Create a style for the warning message
-            SPF_TextStyle_Handle warning_style = ui->UI_Style_Create();
+            // The style and the message are retained, so drawing the warning allocates nothing.
+            SPF_TextStyle_Handle warning_style = UIResources::GetWarningStyle();
             if (warning_style)
             {
-                ui->UI_Style_SetFont(warning_style, SPF_FONT_H1);             // Make it a header
-                ui->UI_Style_SetAlign(warning_style, SPF_TEXT_ALIGN_CENTER);  // Center it
-                ui->UI_Style_SetColor(warning_style, 1.0f, 0.0f, 0.0f, 1.0f); // Keep it red
-
-                // Render the styled text
-                ui->UI_TextStyled(warning_style, warning_message);
-
-                // Clean up the style object
-                ui->UI_Style_Destroy(warning_style);
+                ui->UI_TextStyled(warning_style, UIResources::GetWarningMessage());
             }
         }
     }
 
+    void DrawProfilerWindow(SPF_UI_API *ui, void *user_data)
+    {
+        (void)user_data;
+        Profiler::Draw(ui);
+        Latency::Draw(ui);
+    }
+
+    void DrawDebugOverlayWindow(SPF_UI_API *ui, void *user_data)
+    {
+        (void)user_data;
+        DebugOverlay::Draw(ui);
+    }
+
     bool IsSafeToLeaveDriverSeat()
     {
         // This check only applies if we are currently in the driver's seat.
@@ -791,16 +1014,12 @@ namespace SPF_CabinWalk
             return true; // It's always safe to move if not in the driver's seat.
         }
 
-        if (!g_ctx.coreAPI || !g_ctx.coreAPI->telemetry || !g_ctx.telemetryHandle)
+        if (!g_ctx.telemetry.has_truck_data)
         {
             return false; // Not ready, prevent movement just in case.
         }
 
-        SPF_TruckData truckData;
-        g_ctx.coreAPI->telemetry->Tel_GetTruckData(g_ctx.telemetryHandle, &truckData, sizeof(SPF_TruckData));
-
-        const bool isStationary = fabsf(truckData.speed) < 0.1f;
-        if (isStationary && truckData.parking_brake)
+        if (IsParked())
         {
             return true; // Conditions are met.
         }
@@ -809,9 +1028,7 @@ namespace SPF_CabinWalk
             // Conditions are not met. Show the warning window.
             if (g_ctx.uiAPI && g_ctx.warningWindowHandle && !g_ctx.is_warning_active)
             {
-                SPF_Timestamps timestamps;
-                g_ctx.coreAPI->telemetry->Tel_GetTimestamps(g_ctx.telemetryHandle, &timestamps, sizeof(SPF_Timestamps));
-                g_ctx.warning_start_time = timestamps.simulation;
+                g_ctx.warning_start_time = g_ctx.telemetry.simulation_time;
                 g_ctx.is_warning_active = true;
                 g_ctx.uiAPI->UI_SetVisibility(g_ctx.warningWindowHandle, true);
             }
@@ -819,48 +1036,57 @@ namespace SPF_CabinWalk
         }
     }
 
-    void OnMoveToPassengerSeat()
+    static bool HandleMoveToPassengerSeat()
     {
         if (g_ctx.loggerHandle)
             g_ctx.loadAPI->logger->Log(g_ctx.loggerHandle, SPF_LOG_INFO, "[Keybind] OnMoveToPassengerSeat triggered.");
+        if (IsCameraHookPending())
+        {
+            return false;
+        }
         if (!IsSafeToLeaveDriverSeat())
         {
             if (g_ctx.loggerHandle)
                 g_ctx.loadAPI->logger->Log(g_ctx.loggerHandle, SPF_LOG_WARN, "[Keybind] OnMoveToPassengerSeat aborted: not safe to leave driver seat.");
-            return;
+            return false;
         }
 
-        if (g_ctx.settings.positions.passenger_seat.enabled)
-        {
-            AnimationController::OnRequestMove(AnimationController::CameraPosition::Passenger);
-        }
+        return g_ctx.settings.positions.passenger_seat.enabled && AnimationController::OnRequestMove(AnimationController::CameraPosition::Passenger);
     }
-    void OnMoveToDriverSeat()
+    static bool HandleMoveToDriverSeat()
     {
+        if (IsCameraHookPending())
+        {
+            return false;
+        }
+
         // OnRequestMove now handles all pathfinding logic internally.
-        AnimationController::OnRequestMove(AnimationController::CameraPosition::Driver);
+        return AnimationController::OnRequestMove(AnimationController::CameraPosition::Driver);
     }
 
-    void OnMoveToStandingPosition()
+    static bool HandleMoveToStandingPosition()
     {
+        if (IsCameraHookPending())
+        {
+            return false;
+        }
+
         if (!IsSafeToLeaveDriverSeat())
         {
-            return;
+            return false;
         }
 
         // If we are already standing, this key toggles the walking state.
-        if (AnimationController::GetCurrentPosition() == AnimationController::CameraPosition::Standing)
+        // While a transition plays it is a move request instead, which redirects the transition.
+        if (AnimationController::GetCurrentPosition() == AnimationController::CameraPosition::Standing && !AnimationController::IsAnimating())
         {
             g_is_walk_key_down = !g_is_walk_key_down;
-            return;
+            return false; // Not a move; ArmInputLatency() times the walk from the toggle.
         }
 
         // Otherwise, request a move to the standing position if it's enabled.
-        if (g_ctx.settings.positions.standing.enabled)
-        {
-            // OnRequestMove will handle getting there from any other state (sofa, seats).
-            AnimationController::OnRequestMove(AnimationController::CameraPosition::Standing);
-        }
+        // OnRequestMove will handle getting there from any other state (sofa, seats).
+        return g_ctx.settings.positions.standing.enabled && AnimationController::OnRequestMove(AnimationController::CameraPosition::Standing);
     }
 
     bool IsWalkKeyDown()
@@ -868,27 +1094,147 @@ namespace SPF_CabinWalk
         return g_is_walk_key_down;
     }
 
+    // --- Keybind callbacks: they only queue the action; UpdateFrame carries it out ---
+
+    void OnMoveToPassengerSeat()
+    {
+        InputQueue::Push(InputQueue::CommandType::MoveToPassengerSeat);
+    }
+
+    void OnMoveToDriverSeat()
+    {
+        InputQueue::Push(InputQueue::CommandType::MoveToDriverSeat);
+    }
+
+    void OnMoveToStandingPosition()
+    {
+        InputQueue::Push(InputQueue::CommandType::MoveToStandingPosition);
+    }
+
+    void OnCycleSofaPositions()
+    {
+        InputQueue::Push(InputQueue::CommandType::CycleSofaPositions);
+    }
+
+    void OnCapturePose()
+    {
+        InputQueue::Push(InputQueue::CommandType::CapturePose);
+    }
+
+    /**
+     * @brief Installs the camera hook once the offsets are known.
+     */
+    static void InitializeCameraHook()
+    {
+        if (CameraHookManager::Initialize(g_ctx.hooksAPI, PLUGIN_NAME))
+        {
+            g_ctx.loadAPI->logger->Log(g_ctx.loggerHandle, SPF_LOG_INFO, "[OnGameWorldReady] Camera hook initialized successfully.");
+        }
+        else
+        {
+            g_ctx.loadAPI->logger->Log(g_ctx.loggerHandle, SPF_LOG_ERROR, "[OnGameWorldReady] Failed to initialize camera hook.");
+        }
+    }
+
+    /**
+     * @brief Checks the background offset scan and installs the camera hook when it has finished.
+     */
+    static void PollOffsetDiscovery()
+    {
+        switch (Offsets::PollDiscovery())
+        {
+        case Offsets::DiscoveryState::Ready:
+            g_camera_hook_pending = false;
+            InitializeCameraHook();
+            break;
+        case Offsets::DiscoveryState::Failed:
+        case Offsets::DiscoveryState::Idle:
+            // The failure is already logged by the Offsets module.
+            g_camera_hook_pending = false;
+            break;
+        case Offsets::DiscoveryState::Scanning:
+            break;
+        }
+    }
+
+    /**
+     * @brief Checks whether movement keys must be ignored because the camera hook is not installed yet.
+     */
+    static bool IsCameraHookPending()
+    {
+        if (!g_camera_hook_pending)
+        {
+            return false;
+        }
+
+        if (g_ctx.loggerHandle)
+            g_ctx.loadAPI->logger->Log(g_ctx.loggerHandle, SPF_LOG_DEBUG, "[Keybind] Ignored: camera offsets are still being discovered.");
+        return true;
+    }
+
     void OnGameWorldReady()
     {
+        // Pick up the truck the world was loaded with; later truck changes arrive through OnTruckConstants.
+        if (g_ctx.coreAPI && g_ctx.coreAPI->telemetry && g_ctx.telemetryHandle)
+        {
+            SPF_TruckConstants truck = {};
+            g_ctx.coreAPI->telemetry->Tel_GetTruckConstants(g_ctx.telemetryHandle, &truck, sizeof(truck));
+            SwitchTruckProfile(truck.brand_id, truck.id);
+        }
+
         // All offset finding is now centralized in the Offsets module.
-        // We call it here, when the game world is ready and code is in memory.
-        if (Offsets::Find(g_ctx.hooksAPI))
+        // We start it here, when the game world is ready and code is in memory. With a valid offset cache
+        // this completes immediately; otherwise the scan runs in the background and OnUpdate installs the
+        // hook when it is done, so loading the world does not wait for it.
+        if (!Offsets::BeginDiscovery(g_ctx.hooksAPI))
         {
-            // If offsets were found successfully, initialize the camera hook manager.
-            if (CameraHookManager::Initialize(g_ctx.hooksAPI, PLUGIN_NAME))
-            {
-                g_ctx.loadAPI->logger->Log(g_ctx.loggerHandle, SPF_LOG_INFO, "[OnGameWorldReady] Camera hook initialized successfully.");
-            }
-            else
-            {
-                g_ctx.loadAPI->logger->Log(g_ctx.loggerHandle, SPF_LOG_ERROR, "[OnGameWorldReady] Failed to initialize camera hook.");
-            }
+            return; // The log is already written by the Offsets module.
         }
-        else
+
+        g_camera_hook_pending = true;
+        WakeUp();
+        PollOffsetDiscovery();
+    }
+
+    // =================================================================================================
+    // 5. Telemetry Callbacks
+    // =================================================================================================
+    // Both are fired by the framework on the game thread before OnUpdate. They only copy the values the
+    // plugin needs into `g_ctx.telemetry`.
+
+    void OnTimestamps(const SPF_Timestamps *data, void *user_data)
+    {
+        PluginContext *ctx = static_cast<PluginContext *>(user_data);
+        if (!data || !ctx)
+        {
+            return;
+        }
+
+        ctx->telemetry.simulation_time = data->simulation;
+        ++ctx->telemetry.frame;
+    }
+
+    void OnTruckData(const SPF_TruckData *data, void *user_data)
+    {
+        PluginContext *ctx = static_cast<PluginContext *>(user_data);
+        if (!data || !ctx)
+        {
+            return;
+        }
+
+        ctx->telemetry.speed = data->speed;
+        ctx->telemetry.parking_brake = data->parking_brake;
+        ctx->telemetry.has_truck_data = true;
+    }
+
+    void OnTruckConstants(const SPF_TruckConstants *data, void *user_data)
+    {
+        if (!data || !user_data)
         {
-            // Log that initialization failed. The log is already written by the Find function.
-            // We could show a UI warning here if desired.
+            return;
         }
+
+        SwitchTruckProfile(data->brand_id, data->id);
     }
 
     // =================================================================================================
@@ -148,6 +148,12 @@ namespace SPF_CabinWalk
                   float min;
                   float max;
               } walk_zone_z;
+              WalkZone walk_zone_x; // Sideways, relative to the standing position.
+              struct FloorStep
+              {
+                  float z;      // The floor is raised towards +Z from here...
+                  float height; // ...by this much.
+              } floor_step;
           } walking;
 
           struct StanceControl
@@ -176,6 +182,26 @@ namespace SPF_CabinWalk
           float pitch_up;
           float pitch_down;
       } sofa_limits;
+
+      struct Performance
+      {
+          bool hook_driven_animation; // Advance transitions from the camera hook's delta_time instead of OnUpdate.
+          int32_t settings_preview_smoothing_ms; // Time constant for easing to an edited position; 0 snaps.
+      } performance;
+
+      struct Diagnostics
+      {
+          int32_t trace_mode;     // CameraTrace::Mode: 0 = off, 1 = record, 2 = replay.
+          int32_t trace_capacity; // Number of frames the trace ring holds.
+          char trace_file[260];
+      } diagnostics;
+
+      struct AnimationAssets
+      {
+          char file[260];  // Binary transition curves that replace the built-in ones; empty for none.
+          bool hot_reload; // Reload the file when it changes on disk.
+          bool quantized;  // Seed a missing file in the compact quantized key format.
+      } animation_assets;
   };
 
 
@@ -216,6 +242,8 @@ namespace SPF_CabinWalk
     SPF_KeyBinds_Handle *keybindsHandle = nullptr;    // Requires: SPF_KeyBinds_API.h
     SPF_UI_API *uiAPI = nullptr;                      // Requires: SPF_UI_API.h
     SPF_Window_Handle *warningWindowHandle = nullptr; // Requires: SPF_UI_API.h
+    SPF_Window_Handle *profilerWindowHandle = nullptr; // Only used when built with SPF_CABINWALK_ENABLE_PROFILER
+    SPF_Window_Handle *debugOverlayWindowHandle = nullptr; // Only used when built with SPF_CABINWALK_ENABLE_DEBUG_OVERLAY
     SPF_Telemetry_Handle *telemetryHandle = nullptr;  // Requires: SPF_Telemetry_API.h
     SPF_Hooks_API *hooksAPI = nullptr;                // Requires: SPF_Hooks_API.h
     // SPF_GameConsole_API* gameConsoleAPI = nullptr;     // Requires: SPF_GameConsole_API.h
@@ -228,11 +256,11 @@ namespace SPF_CabinWalk
     // is good practice, though their lifetime is automatically tied to 'telemetryHandle'.
     // Requires: SPF_Telemetry_API.h
     // SPF_Telemetry_Callback_Handle* gameStateSubscription = nullptr;
-    // SPF_Telemetry_Callback_Handle* timestampsSubscription = nullptr;
+    SPF_Telemetry_Callback_Handle* timestampsSubscription = nullptr;
     // SPF_Telemetry_Callback_Handle* commonDataSubscription = nullptr;
-    // SPF_Telemetry_Callback_Handle* truckConstantsSubscription = nullptr;
+    SPF_Telemetry_Callback_Handle* truckConstantsSubscription = nullptr;
     // SPF_Telemetry_Callback_Handle* trailerConstantsSubscription = nullptr;
-    // SPF_Telemetry_Callback_Handle* truckDataSubscription = nullptr;
+    SPF_Telemetry_Callback_Handle* truckDataSubscription = nullptr;
     // SPF_Telemetry_Callback_Handle* trailersSubscription = nullptr;
     // SPF_Telemetry_Callback_Handle* jobConstantsSubscription = nullptr;
     // SPF_Telemetry_Callback_Handle* jobDataSubscription = nullptr;
@@ -248,7 +276,18 @@ namespace SPF_CabinWalk
     bool is_warning_active = false;
     uint64_t warning_start_time = 0;
 
-    SPF_TruckData last_truck_data = {0}; // Cache for last known truck data
+    /**
+     * @brief The few telemetry values the plugin reads, cached by the telemetry callbacks.
+     * @details Every module reads this one snapshot instead of copying telemetry structs itself.
+     */
+    struct TelemetrySnapshot
+    {
+        uint64_t simulation_time = 0; // SPF_Timestamps::simulation, in microseconds.
+        float speed = 0.0f;           // SPF_TruckData::speed, in meters/second.
+        bool parking_brake = false;   // SPF_TruckData::parking_brake
+        bool has_truck_data = false;  // Truck data has been received at least once.
+        uint64_t frame = 0;           // Incremented on every timestamps update.
+    } telemetry;
       };  /**
    * @brief The single global instance of the plugin's context.
    * @details This is defined once in `SPF_CabinWalk.cpp` and declared `extern` here, making it
@@ -354,6 +393,18 @@ namespace SPF_CabinWalk
    */
   void DrawWarningWindow(SPF_UI_API *ui, void *user_data);
 
+  /**
+   * @brief Renders the per-zone timing statistics of the profiler overlay.
+   * @details Only registered when the plugin is built with SPF_CABINWALK_ENABLE_PROFILER.
+   */
+  void DrawProfilerWindow(SPF_UI_API *ui, void *user_data);
+
+  /**
+   * @brief Renders the animation debug overlay: transition curves, walk zone and stance timers.
+   * @details Only registered when the plugin is built with SPF_CABINWALK_ENABLE_DEBUG_OVERLAY.
+   */
+  void DrawDebugOverlayWindow(SPF_UI_API *ui, void *user_data);
+
   /**
    * @brief Callback executed when a keybind action is triggered by the user.
    * @details This is for the "move to passenger seat" action.
@@ -377,6 +428,12 @@ namespace SPF_CabinWalk
    */
   void OnCycleSofaPositions();
 
+  /**
+   * @brief Callback executed when the keybind to capture the current pose is triggered.
+   * @details Stores the live camera pose as the settings of the current position.
+   */
+  void OnCapturePose();
+
   /**
    * @brief Returns true if the walk key is currently being held down.
    */
@@ -399,11 +456,11 @@ namespace SPF_CabinWalk
   // Requires: SPF_Telemetry_API.h
 
   // void OnGameState(const SPF_GameState* data, void* user_data);
-  // void OnTimestamps(const SPF_Timestamps* data, void* user_data);
+  void OnTimestamps(const SPF_Timestamps* data, void* user_data);
   // void OnCommonData(const SPF_CommonData* data, void* user_data);
-  // void OnTruckConstants(const SPF_TruckConstants* data, void* user_data);
+  void OnTruckConstants(const SPF_TruckConstants* data, void* user_data);
   // void OnTrailerConstants(const SPF_TrailerConstants* data, void* user_data);
-  // void OnTruckData(const SPF_TruckData* data, void* user_data);
+  void OnTruckData(const SPF_TruckData* data, void* user_data);
   // void OnTrailers(const SPF_Trailer* trailers, uint32_t count, void* user_data);
   // void OnJobConstants(const SPF_JobConstants* data, void* user_data);
   // void OnJobData(const SPF_JobData* data, void* user_data);
@@ -0,0 +1,143 @@
+#include "Settings/ConfigBatch.hpp"
+#include "Settings/SettingsFields.hpp"
+#include <cstring>
+
+namespace SPF_CabinWalk::ConfigBatch
+{
+    // =================================================================================================
+    // Internal State
+    // =================================================================================================
+
+    constexpr size_t G_MAX_KEY = 128;
+
+    enum class WriteType : uint8_t
+    {
+        Float,
+        Bool
+    };
+
+    struct StagedWrite
+    {
+        char key[G_MAX_KEY];
+        WriteType type;
+        float number;
+        bool flag;
+    };
+
+    static StagedWrite g_writes[MAX_STAGED_WRITES];
+    static uint32_t g_write_count = 0;
+    static bool g_flushing = false;
+
+    // =================================================================================================
+    // Internal Helpers
+    // =================================================================================================
+
+    /**
+     * @brief Finds the staged write of a key, or reserves a new one.
+     * @return nullptr if the key does not fit or the batch is full.
+     */
+    static StagedWrite *Stage(const char *key, WriteType type)
+    {
+        if (!key || std::strlen(key) >= G_MAX_KEY)
+        {
+            return nullptr;
+        }
+
+        for (uint32_t i = 0; i < g_write_count; ++i)
+        {
+            if (std::strcmp(g_writes[i].key, key) == 0)
+            {
+                g_writes[i].type = type;
+                return &g_writes[i];
+            }
+        }
+
+        if (g_write_count == MAX_STAGED_WRITES)
+        {
+            return nullptr;
+        }
+
+        StagedWrite &write = g_writes[g_write_count++];
+        std::strcpy(write.key, key);
+        write.type = type;
+        return &write;
+    }
+
+    // =================================================================================================
+    // Public Functions
+    // =================================================================================================
+
+    bool StageFloat(const char *key, float value)
+    {
+        StagedWrite *write = Stage(key, WriteType::Float);
+        if (!write)
+        {
+            return false;
+        }
+        write->number = value;
+        return true;
+    }
+
+    bool StageBool(const char *key, bool value)
+    {
+        StagedWrite *write = Stage(key, WriteType::Bool);
+        if (!write)
+        {
+            return false;
+        }
+        write->flag = value;
+        return true;
+    }
+
+    bool HasPending()
+    {
+        return g_write_count > 0;
+    }
+
+    bool IsFlushing()
+    {
+        return g_flushing;
+    }
+
+    uint32_t Flush(const SPF_Config_API *config_api, SPF_Config_Handle *config_handle, AppSettings &settings)
+    {
+        if (!config_api || !config_handle || g_write_count == 0)
+        {
+            Clear();
+            return SettingsFields::DIRTY_NONE;
+        }
+
+        // --- Write everything while change notifications are ignored ---
+        g_flushing = true;
+        for (uint32_t i = 0; i < g_write_count; ++i)
+        {
+            const StagedWrite &write = g_writes[i];
+            if (write.type == WriteType::Float)
+            {
+                config_api->Cfg_SetFloat(config_handle, write.key, write.number);
+            }
+            else
+            {
+                config_api->Cfg_SetBool(config_handle, write.key, write.flag);
+            }
+        }
+        g_flushing = false;
+
+        // --- Then reload the written fields, collecting what they invalidate ---
+        uint32_t dirty = SettingsFields::DIRTY_NONE;
+        for (uint32_t i = 0; i < g_write_count; ++i)
+        {
+            bool known = false;
+            dirty |= SettingsFields::LoadKey(config_api, config_handle, g_writes[i].key, settings, &known);
+        }
+
+        Clear();
+        return dirty;
+    }
+
+    void Clear()
+    {
+        g_write_count = 0;
+    }
+
+} // namespace SPF_CabinWalk::ConfigBatch
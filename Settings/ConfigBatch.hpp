@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+#include <SPF_Config_API.h>
+
+namespace SPF_CabinWalk
+{
+    struct AppSettings;
+}
+
+namespace SPF_CabinWalk::ConfigBatch
+{
+    // Writes that fit in one batch. Staging more is refused; the caller logs the refusal.
+    constexpr uint32_t MAX_STAGED_WRITES = 32;
+
+    /**
+     * @brief Stages a float write. Staging the same key again replaces the earlier value.
+     * @return False if the batch is full.
+     */
+    bool StageFloat(const char *key, float value);
+
+    /**
+     * @brief Stages a bool write. See StageFloat().
+     */
+    bool StageBool(const char *key, bool value);
+
+    /**
+     * @brief Checks whether any write is staged.
+     */
+    bool HasPending();
+
+    /**
+     * @brief Checks whether a flush is writing to the config right now.
+     * @details OnSettingChanged ignores the notifications the flush causes; Flush() reloads its keys itself.
+     */
+    bool IsFlushing();
+
+    /**
+     * @brief Writes every staged value, then re-reads the written keys into the settings once.
+     * @return The SettingsFields::DirtyFlags of the fields that changed.
+     */
+    uint32_t Flush(const SPF_Config_API *config_api, SPF_Config_Handle *config_handle, AppSettings &settings);
+
+    /**
+     * @brief Drops every staged write.
+     */
+    void Clear();
+
+} // namespace SPF_CabinWalk::ConfigBatch
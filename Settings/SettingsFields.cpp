@@ -0,0 +1,727 @@
+#include "Settings/SettingsFields.hpp"
+#include "SPF_CabinWalk.hpp" // For AppSettings
+#include <array>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+
+namespace SPF_CabinWalk::SettingsFields
+{
+    // =================================================================================================
+    // Schema
+    // =================================================================================================
+    // The one description of the settings tree. Loading, per-key change dispatch, the manifest's
+    // default JSON and its UI metadata are all generated from the tables below.
+
+    enum class FieldType : uint8_t
+    {
+        Int32,
+        Float,
+        Bool,
+        String
+    };
+
+    /**
+     * @brief The settings UI widget of a field.
+     */
+    struct Widget
+    {
+        const char *type;   // Meta_AddCustomSetting widget, or nullptr if the field has no metadata of its own.
+        const char *params; // Widget parameters JSON.
+        const char *desc;   // Description key; nullptr for "settings.<path>.desc".
+    };
+
+    /**
+     * @brief Where one config key lives in AppSettings, its default, what it invalidates and how it is edited.
+     */
+    struct Field
+    {
+        const char *key;
+        FieldType type;
+        size_t offset; // offsetof(AppSettings, ...)
+        size_t size;   // Buffer size for strings.
+        double default_number;
+        const char *default_string;
+        const char *default_json; // The default as source text; a float's 'f' suffix is dropped in the JSON.
+        uint32_t dirty;
+        const char *title;
+        const char *default_desc;
+        Widget widget;
+    };
+
+    /**
+     * @brief An object of the settings tree that has metadata of its own.
+     */
+    struct Group
+    {
+        const char *path;          // Below "settings.".
+        const char *title;         // nullptr for a hidden group.
+        bool hidden;               // Edited in the settings file only.
+        const char *contents_json; // Default contents of a group that other modules own and that has no fields.
+    };
+
+#define CW_INT(path, member, def, dirty, widget) \
+    {"settings." path, FieldType::Int32, offsetof(AppSettings, member), sizeof(int32_t), def, nullptr, #def, dirty, "settings." path ".title", "settings." path ".desc", widget}
+#define CW_FLOAT(path, member, def, dirty, widget) \
+    {"settings." path, FieldType::Float, offsetof(AppSettings, member), sizeof(float), def, nullptr, #def, dirty, "settings." path ".title", "settings." path ".desc", widget}
+#define CW_BOOL(path, member, def, dirty, widget) \
+    {"settings." path, FieldType::Bool, offsetof(AppSettings, member), sizeof(bool), (def) ? 1.0 : 0.0, nullptr, #def, dirty, "settings." path ".title", "settings." path ".desc", widget}
+#define CW_STRING(path, member, def, dirty, widget) \
+    {"settings." path, FieldType::String, offsetof(AppSettings, member), sizeof(AppSettings::member), 0.0, def, #def, dirty, "settings." path ".title", "settings." path ".desc", widget}
+
+#define CW_NO_WIDGET {nullptr, nullptr, nullptr}
+#define CW_SLIDER_DESC(min, max, format, desc) {"slider", "{ \"min\": " #min ", \"max\": " #max ", \"format\": " #format " }", desc}
+#define CW_SLIDER(min, max, format) CW_SLIDER_DESC(min, max, format, nullptr)
+#define CW_DRAG_DESC(speed, min, max, format, desc) {"drag", "{ \"speed\": " #speed ", \"min\": " #min ", \"max\": " #max ", \"format\": " #format " }", desc}
+#define CW_CHECKBOX_DESC(desc) {"checkbox", nullptr, desc}
+#define CW_RADIO(options) {"radio", options, nullptr}
+
+#define CW_DURATION_SLIDER CW_SLIDER(100.0, 10000.0, "%d ms")
+#define CW_COORD_DRAG CW_DRAG_DESC(0.01, -5.0, 5.0, "%.2f m", "settings.positions.coord.desc")
+#define CW_ROTATION_DRAG CW_DRAG_DESC(0.01, -3.14159, 3.14159, "%.2f rad", "settings.positions.rot.desc")
+
+// Positions feed the pose of the position itself and the active truck profile; the passenger seat also
+// sets the mirrored azimuth pivot. Baked transitions take them from the states passed to Bind.
+#define CW_POSITION(name, on, px, py, pz, rx, ry, dirty)                                                                         \
+    CW_BOOL("positions." #name ".enabled", positions.name.enabled, on, dirty, CW_CHECKBOX_DESC("settings.positions.enabled.desc")), \
+    CW_FLOAT("positions." #name ".position.x", positions.name.position.x, px, dirty, CW_COORD_DRAG),                              \
+    CW_FLOAT("positions." #name ".position.y", positions.name.position.y, py, dirty, CW_COORD_DRAG),                              \
+    CW_FLOAT("positions." #name ".position.z", positions.name.position.z, pz, dirty, CW_COORD_DRAG),                              \
+    CW_FLOAT("positions." #name ".rotation.x", positions.name.rotation.x, rx, dirty, CW_ROTATION_DRAG),                           \
+    CW_FLOAT("positions." #name ".rotation.y", positions.name.rotation.y, ry, dirty, CW_ROTATION_DRAG)
+
+    constexpr uint32_t POSITION_DIRTY = DIRTY_CAMERA_POSE | DIRTY_TRUCK_PROFILE;
+
+    constexpr char G_CABIN_LAYOUT_OPTIONS[] = R"json({ "options": [
+            { "value": 0, "labelKey": "settings.general.cabin_layout.lhd" },
+            { "value": 1, "labelKey": "settings.general.cabin_layout.rhd" }
+        ]})json";
+
+    // In settings file order. The keys of one object must be contiguous (checked below).
+    constexpr Field G_FIELDS[] = {
+        // --- General ---
+        CW_INT("general.warning_duration_ms", general.warning_duration_ms, 3000, DIRTY_NONE, CW_SLIDER(0.0, 30000.0, "%d ms")),
+        CW_INT("general.cabin_layout", general.cabin_layout, 0, DIRTY_TRANSITIONS, CW_RADIO(G_CABIN_LAYOUT_OPTIONS)),
+        CW_FLOAT("general.height", general.height, 0.25f, DIRTY_TRANSITIONS, CW_SLIDER(0.0, 1.0, "%.2f m")),
+
+        // --- Positions ---
+        CW_POSITION(passenger_seat, true, 0.95f, 0.0f, -0.03f, 0.03f, 0.03f, POSITION_DIRTY | DIRTY_AZIMUTH_PROFILES),
+        CW_POSITION(standing, true, 0.5f, 0.2f, 0.25f, -0.17f, -0.3f, POSITION_DIRTY),
+        CW_POSITION(sofa_sit1, true, 0.5f, 0.0f, 0.8f, 0.0f, 0.0f, POSITION_DIRTY),
+        CW_POSITION(sofa_lie, true, -0.15f, -0.25f, 1.25f, -1.65f, 0.35f, POSITION_DIRTY),
+        CW_POSITION(sofa_sit2, true, 0.65f, 0.0f, 1.0f, -1.0f, -0.10f, POSITION_DIRTY),
+
+        // --- Animation Durations ---
+        CW_INT("animation_durations.main_animation_speed.driver_to_passenger", animation_durations.main_animation_speed.driver_to_passenger, 4000, DIRTY_TRANSITIONS, CW_DURATION_SLIDER),
+        CW_INT("animation_durations.main_animation_speed.passenger_to_driver", animation_durations.main_animation_speed.passenger_to_driver, 3000, DIRTY_TRANSITIONS, CW_DURATION_SLIDER),
+        CW_INT("animation_durations.main_animation_speed.driver_to_standing", animation_durations.main_animation_speed.driver_to_standing, 3600, DIRTY_TRANSITIONS, CW_DURATION_SLIDER),
+        CW_INT("animation_durations.main_animation_speed.standing_to_driver", animation_durations.main_animation_speed.standing_to_driver, 4300, DIRTY_TRANSITIONS, CW_DURATION_SLIDER),
+        CW_INT("animation_durations.main_animation_speed.passenger_to_standing", animation_durations.main_animation_speed.passenger_to_standing, 3300, DIRTY_TRANSITIONS, CW_DURATION_SLIDER),
+        CW_INT("animation_durations.main_animation_speed.standing_to_passenger", animation_durations.main_animation_speed.standing_to_passenger, 4500, DIRTY_TRANSITIONS, CW_DURATION_SLIDER),
+        CW_INT("animation_durations.main_animation_speed.standing_to_sofa", animation_durations.main_animation_speed.standing_to_sofa, 2900, DIRTY_TRANSITIONS, CW_DURATION_SLIDER),
+        CW_INT("animation_durations.main_animation_speed.sofa_to_standing", animation_durations.main_animation_speed.sofa_to_standing, 1700, DIRTY_TRANSITIONS, CW_DURATION_SLIDER),
+
+        CW_INT("animation_durations.sofa_animation_speed.sofa_sit1_to_lie", animation_durations.sofa_animation_speed.sofa_sit1_to_lie, 4000, DIRTY_TRANSITIONS, CW_DURATION_SLIDER),
+        CW_INT("animation_durations.sofa_animation_speed.sofa_lie_to_sit2", animation_durations.sofa_animation_speed.sofa_lie_to_sit2, 2500, DIRTY_TRANSITIONS, CW_DURATION_SLIDER),
+        CW_INT("animation_durations.sofa_animation_speed.sofa_sit2_to_sit1", animation_durations.sofa_animation_speed.sofa_sit2_to_sit1, 1200, DIRTY_TRANSITIONS, CW_DURATION_SLIDER),
+        CW_INT("animation_durations.sofa_animation_speed.sofa_lie_to_sit1_shortcut", animation_durations.sofa_animation_speed.sofa_lie_to_sit1_shortcut, 1700, DIRTY_TRANSITIONS, CW_DURATION_SLIDER),
+
+        // The stance spring and the gait read these when a move starts, so they invalidate nothing.
+        CW_INT("animation_durations.crouch_and_stand_animation_speed.crouch", animation_durations.crouch_and_stand_animation_speed.crouch, 1250, DIRTY_NONE, CW_DURATION_SLIDER),
+        CW_INT("animation_durations.crouch_and_stand_animation_speed.tiptoe", animation_durations.crouch_and_stand_animation_speed.tiptoe, 1100, DIRTY_NONE, CW_DURATION_SLIDER),
+
+        // walk_step is in milliseconds, the length of one stride. The walk_first_step_* keys are in microseconds;
+        // they timed the keyframed first step the gait replaced and are kept so existing settings files round-trip.
+        CW_INT("walking_animation_speed.walk_step", walking_animation_speed.walk_step, 450, DIRTY_NONE, CW_NO_WIDGET),
+        CW_INT("walking_animation_speed.walk_first_step_base", walking_animation_speed.walk_first_step_base, 250000, DIRTY_NONE, CW_NO_WIDGET),
+        CW_INT("walking_animation_speed.walk_first_step_turn_extra", walking_animation_speed.walk_first_step_turn_extra, 1000000, DIRTY_NONE, CW_NO_WIDGET),
+
+        // --- Standing Movement ---
+        CW_FLOAT("standing_movement.walking.step_amount", standing_movement.walking.step_amount, 0.35f, DIRTY_WALK_ZONE, CW_SLIDER(0.01, 1.0, "%.2f m")),
+        CW_FLOAT("standing_movement.walking.bob_amount", standing_movement.walking.bob_amount, 0.02f, DIRTY_WALK_ZONE, CW_SLIDER(0.0, 0.2, "%.3f m")),
+        CW_FLOAT("standing_movement.walking.walk_zone_z.min", standing_movement.walking.walk_zone_z.min, -0.55f, DIRTY_WALK_ZONE,
+                 CW_SLIDER_DESC(-2.0, 2.0, "%.2f m", "settings.standing_movement.walking.walk_zone_z.desc")),
+        CW_FLOAT("standing_movement.walking.walk_zone_z.max", standing_movement.walking.walk_zone_z.max, 0.65f, DIRTY_WALK_ZONE,
+                 CW_SLIDER_DESC(-2.0, 2.0, "%.2f m", "settings.standing_movement.walking.walk_zone_z.desc")),
+        CW_FLOAT("standing_movement.walking.walk_zone_x.min", standing_movement.walking.walk_zone_x.min, -0.2f, DIRTY_WALK_ZONE | DIRTY_TRUCK_PROFILE,
+                 CW_SLIDER_DESC(-1.0, 0.0, "%.2f m", "settings.standing_movement.walking.walk_zone_x.desc")),
+        CW_FLOAT("standing_movement.walking.walk_zone_x.max", standing_movement.walking.walk_zone_x.max, 0.2f, DIRTY_WALK_ZONE | DIRTY_TRUCK_PROFILE,
+                 CW_SLIDER_DESC(0.0, 1.0, "%.2f m", "settings.standing_movement.walking.walk_zone_x.desc")),
+        CW_FLOAT("standing_movement.walking.floor_step.z", standing_movement.walking.floor_step.z, 0.65f, DIRTY_WALK_ZONE | DIRTY_TRUCK_PROFILE,
+                 CW_SLIDER_DESC(-2.0, 2.0, "%.2f m", "settings.standing_movement.walking.floor_step.desc")),
+        CW_FLOAT("standing_movement.walking.floor_step.height", standing_movement.walking.floor_step.height, 0.0f, DIRTY_WALK_ZONE | DIRTY_TRUCK_PROFILE,
+                 CW_SLIDER_DESC(-0.5, 0.5, "%.2f m", "settings.standing_movement.walking.floor_step.desc")),
+
+        CW_INT("standing_movement.stance_control.hold_time_ms", standing_movement.stance_control.hold_time_ms, 1000, DIRTY_WALK_ZONE, CW_SLIDER(100.0, 5000.0, "%d ms")),
+
+        CW_FLOAT("standing_movement.stance_control.crouch.depth", standing_movement.stance_control.crouch.depth, 0.5f, DIRTY_WALK_ZONE, CW_SLIDER(0.1, 1.0, "%.2f m")),
+        CW_FLOAT("standing_movement.stance_control.crouch.activation_angle", standing_movement.stance_control.crouch.activation_angle, -0.7f, DIRTY_WALK_ZONE,
+                 CW_SLIDER_DESC(-1.57, 0.0, "%.2f rad", "settings.standing_movement.stance_control.activation_angle.desc")),
+        CW_FLOAT("standing_movement.stance_control.crouch.deactivation_angle", standing_movement.stance_control.crouch.deactivation_angle, 0.3f, DIRTY_WALK_ZONE,
+                 CW_SLIDER_DESC(0.0, 1.57, "%.2f rad", "settings.standing_movement.stance_control.deactivation_angle.desc")),
+
+        CW_FLOAT("standing_movement.stance_control.tiptoe.height", standing_movement.stance_control.tiptoe.height, 0.17f, DIRTY_WALK_ZONE, CW_SLIDER(0.05, 0.5, "%.2f m")),
+        CW_FLOAT("standing_movement.stance_control.tiptoe.activation_angle", standing_movement.stance_control.tiptoe.activation_angle, 0.5f, DIRTY_WALK_ZONE,
+                 CW_SLIDER_DESC(0.0, 1.57, "%.2f rad", "settings.standing_movement.stance_control.activation_angle.desc")),
+        CW_FLOAT("standing_movement.stance_control.tiptoe.deactivation_angle", standing_movement.stance_control.tiptoe.deactivation_angle, -0.3f, DIRTY_WALK_ZONE,
+                 CW_SLIDER_DESC(-1.57, 0.0, "%.2f rad", "settings.standing_movement.stance_control.deactivation_angle.desc")),
+
+        // --- Sofa Limits ---
+        CW_FLOAT("sofa_limits.yaw_left", sofa_limits.yaw_left, 180.0f, DIRTY_AZIMUTH_PROFILES, CW_NO_WIDGET),
+        CW_FLOAT("sofa_limits.yaw_right", sofa_limits.yaw_right, -180.0f, DIRTY_AZIMUTH_PROFILES, CW_NO_WIDGET),
+        CW_FLOAT("sofa_limits.pitch_up", sofa_limits.pitch_up, 90.0f, DIRTY_AZIMUTH_PROFILES, CW_NO_WIDGET),
+        CW_FLOAT("sofa_limits.pitch_down", sofa_limits.pitch_down, -65.0f, DIRTY_AZIMUTH_PROFILES, CW_NO_WIDGET),
+
+        // --- Performance --- (read live every frame)
+        CW_BOOL("performance.hook_driven_animation", performance.hook_driven_animation, false, DIRTY_NONE, CW_NO_WIDGET),
+        CW_INT("performance.settings_preview_smoothing_ms", performance.settings_preview_smoothing_ms, 120, DIRTY_NONE, CW_NO_WIDGET),
+
+        // --- Diagnostics ---
+        CW_INT("diagnostics.trace_mode", diagnostics.trace_mode, 0, DIRTY_TRACE, CW_NO_WIDGET),
+        CW_INT("diagnostics.trace_capacity", diagnostics.trace_capacity, 36000, DIRTY_TRACE, CW_NO_WIDGET),
+        CW_STRING("diagnostics.trace_file", diagnostics.trace_file, "SPF_CabinWalk_trace.bin", DIRTY_TRACE, CW_NO_WIDGET),
+
+        // --- Animation Assets ---
+        CW_STRING("animation_assets.file", animation_assets.file, "", DIRTY_ANIMATION_ASSETS, CW_NO_WIDGET),
+        CW_BOOL("animation_assets.hot_reload", animation_assets.hot_reload, true, DIRTY_NONE, CW_NO_WIDGET),
+        CW_BOOL("animation_assets.quantized", animation_assets.quantized, false, DIRTY_NONE, CW_NO_WIDGET),
+    };
+
+#define CW_GROUP(path) {path, "settings." path ".title", false, nullptr}
+#define CW_GROUP_TITLED(path, title) {path, title, false, nullptr}
+#define CW_HIDDEN_GROUP(path) {path, nullptr, true, nullptr}
+#define CW_EXTERNAL_GROUP(path, contents) {path, nullptr, true, contents}
+#define CW_POSITION_GROUPS(name)                                                                          \
+    CW_GROUP("positions." #name),                                                                         \
+    CW_GROUP_TITLED("positions." #name ".position", "settings.positions.position_group.title"),           \
+    CW_GROUP_TITLED("positions." #name ".rotation", "settings.positions.rotation_group.title")
+
+    constexpr Group G_GROUPS[] = {
+        CW_GROUP("general"),
+        CW_GROUP("positions"),
+        CW_POSITION_GROUPS(passenger_seat),
+        CW_POSITION_GROUPS(standing),
+        CW_POSITION_GROUPS(sofa_sit1),
+        CW_POSITION_GROUPS(sofa_lie),
+        CW_POSITION_GROUPS(sofa_sit2),
+        CW_GROUP("animation_durations"),
+        CW_GROUP("animation_durations.main_animation_speed"),
+        CW_GROUP("animation_durations.sofa_animation_speed"),
+        CW_GROUP("animation_durations.crouch_and_stand_animation_speed"),
+        CW_GROUP("standing_movement"),
+        CW_GROUP("standing_movement.walking"),
+        CW_GROUP("standing_movement.walking.walk_zone_z"),
+        CW_GROUP("standing_movement.walking.walk_zone_x"),
+        CW_GROUP("standing_movement.walking.floor_step"),
+        CW_GROUP("standing_movement.stance_control"),
+        CW_GROUP("standing_movement.stance_control.crouch"),
+        CW_GROUP("standing_movement.stance_control.tiptoe"),
+
+        CW_HIDDEN_GROUP("sofa_limits"),
+        CW_HIDDEN_GROUP("walking_animation_speed"),
+        CW_HIDDEN_GROUP("performance"),
+        // Camera trace recorder and animation asset file, edited in the settings file only.
+        CW_HIDDEN_GROUP("diagnostics"),
+        CW_HIDDEN_GROUP("animation_assets"),
+
+        // Per-truck positions, written by TruckProfiles and edited through "positions" while in the truck.
+        CW_EXTERNAL_GROUP("truck_profiles", "{}"),
+        // Written by Offsets::Find, not user-editable.
+        CW_EXTERNAL_GROUP("offset_cache", R"json({ "build_key": 0, "update_camera_from_input": 0, "azimuth_array_and_count": 0, "update_interior_camera": 0, )json"
+                                          R"json("start_azimuth": 0, "end_azimuth": 0, "azimuth_outside_flag": 0, "head_offsets": 0, "camera_pivot": 0, )json"
+                                          R"json("cache_exterior_sound_angle_range": 0 })json"),
+    };
+
+#undef CW_POSITION_GROUPS
+#undef CW_EXTERNAL_GROUP
+#undef CW_HIDDEN_GROUP
+#undef CW_GROUP_TITLED
+#undef CW_GROUP
+#undef CW_POSITION
+#undef CW_ROTATION_DRAG
+#undef CW_COORD_DRAG
+#undef CW_DURATION_SLIDER
+#undef CW_RADIO
+#undef CW_CHECKBOX_DESC
+#undef CW_DRAG_DESC
+#undef CW_SLIDER
+#undef CW_SLIDER_DESC
+#undef CW_NO_WIDGET
+#undef CW_STRING
+#undef CW_BOOL
+#undef CW_FLOAT
+#undef CW_INT
+
+    // =================================================================================================
+    // Settings JSON
+    // =================================================================================================
+    // The manifest's default JSON is written from G_FIELDS at compile time: each field's parent objects
+    // are opened as its key path enters them and closed as the next key leaves them.
+
+    constexpr size_t G_SETTINGS_PREFIX_LENGTH = sizeof("settings.") - 1;
+    constexpr size_t G_MAX_DEPTH = 8;
+
+    /**
+     * @brief Appends to a buffer, or only counts the characters when there is none.
+     */
+    class JsonWriter
+    {
+    public:
+        constexpr explicit JsonWriter(char *out) : m_out(out) {}
+
+        constexpr void Put(char c)
+        {
+            if (m_out)
+            {
+                m_out[m_length] = c;
+            }
+            ++m_length;
+        }
+
+        constexpr void Put(const char *text, size_t length)
+        {
+            for (size_t i = 0; i < length; ++i)
+            {
+                Put(text[i]);
+            }
+        }
+
+        constexpr void Put(const char *text)
+        {
+            while (*text)
+            {
+                Put(*text++);
+            }
+        }
+
+        constexpr size_t GetLength() const { return m_length; }
+
+    private:
+        char *m_out;
+        size_t m_length = 0;
+    };
+
+    constexpr const char *GetPath(const Field &field)
+    {
+        return field.key + G_SETTINGS_PREFIX_LENGTH;
+    }
+
+    constexpr size_t Length(const char *text)
+    {
+        size_t length = 0;
+        while (text[length])
+        {
+            ++length;
+        }
+        return length;
+    }
+
+    /**
+     * @brief Gets the length of the path of a key's parent object: 3 for "a.b.c", 0 for a top-level key.
+     */
+    constexpr size_t GetParentLength(const char *path)
+    {
+        size_t parent = 0;
+        for (size_t i = 0; path[i]; ++i)
+        {
+            if (path[i] == '.')
+            {
+                parent = i;
+            }
+        }
+        return parent;
+    }
+
+    /**
+     * @brief Counts the objects of an object path, 0 for the root.
+     */
+    constexpr size_t GetDepth(const char *path, size_t length)
+    {
+        size_t depth = length > 0 ? 1 : 0;
+        for (size_t i = 0; i < length; ++i)
+        {
+            depth += path[i] == '.' ? 1 : 0;
+        }
+        return depth;
+    }
+
+    /**
+     * @brief Counts the leading objects two object paths share.
+     */
+    constexpr size_t GetCommonDepth(const char *a, size_t a_length, const char *b, size_t b_length)
+    {
+        size_t depth = 0;
+        size_t start = 0;
+        while (start < a_length && start < b_length)
+        {
+            size_t end = start;
+            while (end < a_length && end < b_length && a[end] == b[end] && a[end] != '.')
+            {
+                ++end;
+            }
+            const bool a_ends = end == a_length || a[end] == '.';
+            const bool b_ends = end == b_length || b[end] == '.';
+            if (!a_ends || !b_ends || end == start)
+            {
+                break;
+            }
+            ++depth;
+            start = end + 1;
+        }
+        return depth;
+    }
+
+    constexpr bool KeysEqual(const char *a, const char *b)
+    {
+        while (*a && *a == *b)
+        {
+            ++a;
+            ++b;
+        }
+        return *a == *b;
+    }
+
+    /**
+     * @brief Checks that no key repeats and that no object is left and entered again, so the JSON is valid.
+     * @details An object was left and re-entered if some earlier key shares more of its path with a key
+     *          than the key right before it does.
+     */
+    constexpr bool IsSchemaWellFormed()
+    {
+        constexpr size_t count = sizeof(G_FIELDS) / sizeof(G_FIELDS[0]);
+        for (size_t k = 1; k < count; ++k)
+        {
+            const char *path = GetPath(G_FIELDS[k]);
+            const size_t parent = GetParentLength(path);
+            const char *previous = GetPath(G_FIELDS[k - 1]);
+            const size_t shared = GetCommonDepth(previous, GetParentLength(previous), path, parent);
+            for (size_t i = 0; i < k; ++i)
+            {
+                const char *other = GetPath(G_FIELDS[i]);
+                if (KeysEqual(other, path) || GetCommonDepth(other, GetParentLength(other), path, parent) > shared)
+                {
+                    return false;
+                }
+            }
+            if (GetDepth(path, parent) > G_MAX_DEPTH)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static_assert(IsSchemaWellFormed(), "Settings keys must be unique and the keys of one object contiguous");
+
+    constexpr void PutMemberSeparator(JsonWriter &json, bool (&has_members)[G_MAX_DEPTH + 1], size_t depth)
+    {
+        if (has_members[depth])
+        {
+            json.Put(", ");
+        }
+        has_members[depth] = true;
+    }
+
+    constexpr void PutName(JsonWriter &json, const char *name, size_t length)
+    {
+        json.Put('"');
+        json.Put(name, length);
+        json.Put("\": ");
+    }
+
+    /**
+     * @brief Writes the settings JSON that the manifest installs under "settings".
+     * @param out The buffer, or nullptr to only measure it.
+     * @return The length, without a terminator.
+     */
+    constexpr size_t WriteSettingsJson(char *out)
+    {
+        JsonWriter json(out);
+        bool has_members[G_MAX_DEPTH + 1] = {};
+        const char *open_path = "";
+        size_t open_length = 0;
+        size_t open_depth = 0;
+
+        json.Put('{');
+        for (const Field &field : G_FIELDS)
+        {
+            const char *path = GetPath(field);
+            const size_t parent = GetParentLength(path);
+
+            // Leave the objects this key is not in, then enter the ones it is in.
+            const size_t common = GetCommonDepth(open_path, open_length, path, parent);
+            for (; open_depth > common; --open_depth)
+            {
+                json.Put('}');
+            }
+
+            size_t start = 0;
+            for (size_t depth = 0; depth < common; ++depth)
+            {
+                while (path[start] != '.')
+                {
+                    ++start;
+                }
+                ++start;
+            }
+            for (const size_t depth = GetDepth(path, parent); open_depth < depth; ++open_depth)
+            {
+                size_t end = start;
+                while (end < parent && path[end] != '.')
+                {
+                    ++end;
+                }
+                PutMemberSeparator(json, has_members, open_depth);
+                PutName(json, path + start, end - start);
+                json.Put('{');
+                has_members[open_depth + 1] = false;
+                start = end + 1;
+            }
+
+            PutMemberSeparator(json, has_members, open_depth);
+            const char *name = path + (parent > 0 ? parent + 1 : 0);
+            PutName(json, name, Length(name));
+            size_t value_length = Length(field.default_json);
+            if (field.type == FieldType::Float && value_length > 0 && (field.default_json[value_length - 1] == 'f' || field.default_json[value_length - 1] == 'F'))
+            {
+                --value_length;
+            }
+            json.Put(field.default_json, value_length);
+
+            open_path = path;
+            open_length = parent;
+        }
+        for (; open_depth > 0; --open_depth)
+        {
+            json.Put('}');
+        }
+
+        for (const Group &group : G_GROUPS)
+        {
+            if (group.contents_json)
+            {
+                PutMemberSeparator(json, has_members, 0);
+                PutName(json, group.path, Length(group.path));
+                json.Put(group.contents_json);
+            }
+        }
+        json.Put('}');
+        return json.GetLength();
+    }
+
+    constexpr size_t G_SETTINGS_JSON_LENGTH = WriteSettingsJson(nullptr);
+
+    constexpr std::array<char, G_SETTINGS_JSON_LENGTH + 1> G_SETTINGS_JSON = []()
+    {
+        std::array<char, G_SETTINGS_JSON_LENGTH + 1> json = {};
+        WriteSettingsJson(json.data());
+        return json;
+    }();
+
+    // =================================================================================================
+    // Internal Helpers
+    // =================================================================================================
+
+    /**
+     * @brief Reads one field into the settings.
+     * @return True if the stored value changed.
+     */
+    static bool ReadField(const SPF_Config_API *config_api, SPF_Config_Handle *config_handle, const Field &field, AppSettings &settings)
+    {
+        void *target = reinterpret_cast<uint8_t *>(&settings) + field.offset;
+
+        switch (field.type)
+        {
+        case FieldType::Int32:
+        {
+            const int32_t value = config_api->Cfg_GetInt32(config_handle, field.key, static_cast<int32_t>(field.default_number));
+            const bool changed = std::memcmp(target, &value, sizeof(value)) != 0;
+            std::memcpy(target, &value, sizeof(value));
+            return changed;
+        }
+        case FieldType::Float:
+        {
+            const float value = static_cast<float>(config_api->Cfg_GetFloat(config_handle, field.key, field.default_number));
+            const bool changed = std::memcmp(target, &value, sizeof(value)) != 0;
+            std::memcpy(target, &value, sizeof(value));
+            return changed;
+        }
+        case FieldType::Bool:
+        {
+            const bool value = config_api->Cfg_GetBool(config_handle, field.key, field.default_number != 0.0);
+            const bool changed = std::memcmp(target, &value, sizeof(value)) != 0;
+            std::memcpy(target, &value, sizeof(value));
+            return changed;
+        }
+        case FieldType::String:
+        {
+            char value[260] = {};
+            const int buffer_size = static_cast<int>(field.size < sizeof(value) ? field.size : sizeof(value));
+            config_api->Cfg_GetString(config_handle, field.key, field.default_string, value, buffer_size);
+            value[buffer_size - 1] = '\0';
+            const bool changed = std::strncmp(static_cast<const char *>(target), value, field.size) != 0;
+            std::memcpy(target, value, static_cast<size_t>(buffer_size));
+            return changed;
+        }
+        }
+        return false;
+    }
+
+    static const char G_POSITIONS_PREFIX[] = "settings.positions.";
+
+    /**
+     * @brief Builds the key of a truck profile field under a profile group prefix.
+     * @details Positions drop "settings.positions.", as profiles stored them before they held anything
+     *          else; the other fields drop "settings.". A null prefix gives the field's own key.
+     * @return False if the field is not part of a truck profile or the key does not fit.
+     */
+    static bool MakeProfileKey(const Field &field, const char *prefix, char *key, size_t key_size)
+    {
+        if (!(field.dirty & DIRTY_TRUCK_PROFILE))
+        {
+            return false;
+        }
+
+        const char *name = field.key;
+        if (prefix)
+        {
+            constexpr size_t POSITIONS_LENGTH = sizeof(G_POSITIONS_PREFIX) - 1;
+            const bool is_position = std::strncmp(field.key, G_POSITIONS_PREFIX, POSITIONS_LENGTH) == 0;
+            name += is_position ? POSITIONS_LENGTH : G_SETTINGS_PREFIX_LENGTH;
+        }
+
+        const int length = std::snprintf(key, key_size, "%s%s", prefix ? prefix : "", name);
+        return length > 0 && static_cast<size_t>(length) < key_size;
+    }
+
+    // =================================================================================================
+    // Public Functions
+    // =================================================================================================
+
+    uint32_t LoadAll(const SPF_Config_API *config_api, SPF_Config_Handle *config_handle, AppSettings &settings)
+    {
+        for (const Field &field : G_FIELDS)
+        {
+            ReadField(config_api, config_handle, field, settings);
+        }
+        return DIRTY_ALL;
+    }
+
+    uint32_t LoadKey(const SPF_Config_API *config_api, SPF_Config_Handle *config_handle, const char *key_path, AppSettings &settings, bool *known)
+    {
+        *known = false;
+        if (!key_path)
+        {
+            return DIRTY_NONE;
+        }
+
+        // A linear scan of ~70 short keys costs far less than the config read it replaces.
+        for (const Field &field : G_FIELDS)
+        {
+            if (std::strcmp(field.key, key_path) == 0)
+            {
+                *known = true;
+                return ReadField(config_api, config_handle, field, settings) ? field.dirty : DIRTY_NONE;
+            }
+        }
+        return DIRTY_NONE;
+    }
+
+    void LoadTruckProfile(const SPF_Config_API *config_api, SPF_Config_Handle *config_handle, const char *prefix, AppSettings &settings)
+    {
+        char key[256];
+        for (const Field &field : G_FIELDS)
+        {
+            if (!MakeProfileKey(field, prefix, key, sizeof(key)))
+            {
+                continue;
+            }
+
+            // The current value is the default, so a partly written group only overrides what it has.
+            void *target = reinterpret_cast<uint8_t *>(&settings) + field.offset;
+            if (field.type == FieldType::Bool)
+            {
+                *static_cast<bool *>(target) = config_api->Cfg_GetBool(config_handle, key, *static_cast<bool *>(target));
+            }
+            else if (field.type == FieldType::Float)
+            {
+                *static_cast<float *>(target) = static_cast<float>(config_api->Cfg_GetFloat(config_handle, key, *static_cast<float *>(target)));
+            }
+        }
+    }
+
+    void StoreTruckProfile(const SPF_Config_API *config_api, SPF_Config_Handle *config_handle, const char *prefix, const AppSettings &settings)
+    {
+        char key[256];
+        for (const Field &field : G_FIELDS)
+        {
+            if (!MakeProfileKey(field, prefix, key, sizeof(key)))
+            {
+                continue;
+            }
+
+            const void *source = reinterpret_cast<const uint8_t *>(&settings) + field.offset;
+            if (field.type == FieldType::Bool)
+            {
+                config_api->Cfg_SetBool(config_handle, key, *static_cast<const bool *>(source));
+            }
+            else if (field.type == FieldType::Float)
+            {
+                config_api->Cfg_SetFloat(config_handle, key, *static_cast<const float *>(source));
+            }
+        }
+    }
+
+    void ApplyDefaults(AppSettings &settings)
+    {
+        for (const Field &field : G_FIELDS)
+        {
+            void *target = reinterpret_cast<uint8_t *>(&settings) + field.offset;
+            switch (field.type)
+            {
+            case FieldType::Int32:
+                *static_cast<int32_t *>(target) = static_cast<int32_t>(field.default_number);
+                break;
+            case FieldType::Float:
+                *static_cast<float *>(target) = static_cast<float>(field.default_number);
+                break;
+            case FieldType::Bool:
+                *static_cast<bool *>(target) = field.default_number != 0.0;
+                break;
+            case FieldType::String:
+                std::snprintf(static_cast<char *>(target), field.size, "%s", field.default_string);
+                break;
+            }
+        }
+    }
+
+    void SetManifestDefaults(SPF_Manifest_Builder_Handle *h, const SPF_Manifest_Builder_API *api)
+    {
+        api->Settings_SetJson(h, G_SETTINGS_JSON.data());
+    }
+
+    void AddManifestMetadata(SPF_Manifest_Builder_Handle *h, const SPF_Manifest_Builder_API *api)
+    {
+        for (const Group &group : G_GROUPS)
+        {
+            if (group.hidden)
+            {
+                api->Meta_AddCustomSetting(h, group.path, nullptr, nullptr, nullptr, nullptr, true);
+            }
+            else
+            {
+                api->Meta_AddCustomSetting(h, group.path, group.title, "", nullptr, nullptr, false);
+            }
+        }
+
+        for (const Field &field : G_FIELDS)
+        {
+            if (field.widget.type)
+            {
+                const char *desc = field.widget.desc ? field.widget.desc : field.default_desc;
+                api->Meta_AddCustomSetting(h, GetPath(field), field.title, desc, field.widget.type, field.widget.params, false);
+            }
+        }
+    }
+
+} // namespace SPF_CabinWalk::SettingsFields
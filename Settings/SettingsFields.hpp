@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstdint>
+#include <SPF_Config_API.h>
+#include <SPF_Manifest_API.h>
+
+namespace SPF_CabinWalk
+{
+    struct AppSettings;
+}
+
+namespace SPF_CabinWalk::SettingsFields
+{
+    /**
+     * @brief The caches and subsystems a settings field feeds. A changed field marks only its own bits.
+     */
+    enum DirtyFlags : uint32_t
+    {
+        DIRTY_NONE = 0,
+        DIRTY_TRANSITIONS = 1u << 0,      // Baked transitions and the route table (HashTransitionSettings).
+        DIRTY_CAMERA_POSE = 1u << 1,      // The pose of the current position must be re-applied.
+        DIRTY_AZIMUTH_PROFILES = 1u << 2, // Derived azimuth profiles (passenger pivot, sofa limits).
+        DIRTY_WALK_ZONE = 1u << 3,        // Walking and stance bounds of the standing position.
+        DIRTY_TRACE = 1u << 4,            // The camera trace recorder.
+        DIRTY_ANIMATION_ASSETS = 1u << 5, // The animation asset file.
+        DIRTY_TRUCK_PROFILE = 1u << 6,    // The profile of the current truck: positions, sideways walk zone and floor step.
+        DIRTY_ALL = 0xFFFFFFFFu
+    };
+
+    /**
+     * @brief Reads every field from the config.
+     * @return DIRTY_ALL.
+     */
+    uint32_t LoadAll(const SPF_Config_API *config_api, SPF_Config_Handle *config_handle, AppSettings &settings);
+
+    /**
+     * @brief Re-reads the single field stored under a key path.
+     * @param key_path The full key path, e.g. "settings.positions.standing.position.x".
+     * @param[out] known Set to whether the key path belongs to a field at all.
+     * @return The dirty flags of the field if its value changed, DIRTY_NONE otherwise.
+     */
+    uint32_t LoadKey(const SPF_Config_API *config_api, SPF_Config_Handle *config_handle, const char *key_path, AppSettings &settings, bool *known);
+
+    /**
+     * @brief Reads the truck profile fields (those flagged DIRTY_TRUCK_PROFILE) from a profile group.
+     * @param prefix Profile group, e.g. "settings.truck_profiles.scania.". Position keys replace
+     *               "settings.positions." with it, the other fields "settings.".
+     * @param[in,out] settings Only the profile fields are written. Fields missing from the group keep their value.
+     */
+    void LoadTruckProfile(const SPF_Config_API *config_api, SPF_Config_Handle *config_handle, const char *prefix, AppSettings &settings);
+
+    /**
+     * @brief Writes the truck profile fields to a profile group, or to their own keys if `prefix` is null.
+     *        See LoadTruckProfile().
+     */
+    void StoreTruckProfile(const SPF_Config_API *config_api, SPF_Config_Handle *config_handle, const char *prefix, const AppSettings &settings);
+
+    /**
+     * @brief Sets every field to its default, as a config without the plugin's settings would.
+     */
+    void ApplyDefaults(AppSettings &settings);
+
+    /**
+     * @brief Installs the default settings JSON, generated from the field table at compile time.
+     */
+    void SetManifestDefaults(SPF_Manifest_Builder_Handle *h, const SPF_Manifest_Builder_API *api);
+
+    /**
+     * @brief Adds the settings UI metadata of every group and field: titles, descriptions, widgets and hidden groups.
+     */
+    void AddManifestMetadata(SPF_Manifest_Builder_Handle *h, const SPF_Manifest_Builder_API *api);
+
+} // namespace SPF_CabinWalk::SettingsFields
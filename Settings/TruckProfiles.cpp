@@ -0,0 +1,178 @@
+#include "Settings/TruckProfiles.hpp"
+#include "Settings/SettingsFields.hpp"
+#include "SPF_CabinWalk.hpp" // For g_ctx, AppSettings
+#include <cctype>
+#include <cstdio>
+#include <list>
+#include <string>
+#include <unordered_map>
+
+namespace SPF_CabinWalk::TruckProfiles
+{
+    // =================================================================================================
+    // Internal State
+    // =================================================================================================
+
+    // The fields flagged DIRTY_TRUCK_PROFILE in SettingsFields; Capture() and Restore() must name each.
+    struct Profile
+    {
+        std::string key;
+        AppSettings::Positions positions;
+        AppSettings::StandingMovement::Walking::WalkZone walk_zone_x;
+        AppSettings::StandingMovement::Walking::FloorStep floor_step;
+    };
+
+    // Most recently used first; the front is the active profile while g_has_active is set.
+    static std::list<Profile> g_profiles;
+    static std::unordered_map<std::string, std::list<Profile>::iterator> g_index;
+    static bool g_has_active = false;
+    static bool g_applying = false;
+
+    // =================================================================================================
+    // Internal Helpers
+    // =================================================================================================
+
+    /**
+     * @brief Appends an id to a profile key, replacing anything that is not valid in a config key path.
+     */
+    static void AppendId(std::string &key, const char *id)
+    {
+        for (const char *c = id; *c; ++c)
+        {
+            const unsigned char ch = static_cast<unsigned char>(*c);
+            key.push_back(std::isalnum(ch) || ch == '_' ? static_cast<char>(ch) : '_');
+        }
+    }
+
+    static std::string MakeKey(const char *brand_id, const char *model_id)
+    {
+        std::string key;
+        if (!brand_id || !model_id || !brand_id[0] || !model_id[0])
+        {
+            return key;
+        }
+
+        AppendId(key, brand_id);
+        key.push_back('.');
+        AppendId(key, model_id);
+        return key;
+    }
+
+    /**
+     * @brief Builds the config group prefix of a profile, e.g. "settings.truck_profiles.scania.s_2016.".
+     */
+    static std::string MakePrefix(const std::string &key)
+    {
+        return std::string(CONFIG_PREFIX) + key + ".";
+    }
+
+    static void Capture(Profile &profile, const AppSettings &settings)
+    {
+        profile.positions = settings.positions;
+        profile.walk_zone_x = settings.standing_movement.walking.walk_zone_x;
+        profile.floor_step = settings.standing_movement.walking.floor_step;
+    }
+
+    static void Restore(const Profile &profile, AppSettings &settings)
+    {
+        settings.positions = profile.positions;
+        settings.standing_movement.walking.walk_zone_x = profile.walk_zone_x;
+        settings.standing_movement.walking.floor_step = profile.floor_step;
+    }
+
+    static bool HasConfig()
+    {
+        return g_ctx.configAPI && g_ctx.configHandle;
+    }
+
+    // =================================================================================================
+    // Public Functions
+    // =================================================================================================
+
+    bool Activate(const char *brand_id, const char *model_id, AppSettings &settings)
+    {
+        const std::string key = MakeKey(brand_id, model_id);
+        if (key.empty() || (g_has_active && g_profiles.front().key == key))
+        {
+            return false;
+        }
+
+        auto found = g_index.find(key);
+        if (found != g_index.end())
+        {
+            // Cached: move it to the front and swap it in.
+            g_profiles.splice(g_profiles.begin(), g_profiles, found->second);
+            Restore(g_profiles.front(), settings);
+        }
+        else
+        {
+            // A truck without a stored profile keeps the current values as its starting point.
+            const std::string prefix = MakePrefix(key);
+            if (HasConfig())
+            {
+                const std::string group(prefix.c_str(), prefix.size() - 1);
+                if (g_ctx.configAPI->Cfg_GetJsonValueHandle(g_ctx.configHandle, group.c_str()))
+                {
+                    SettingsFields::LoadTruckProfile(g_ctx.configAPI, g_ctx.configHandle, prefix.c_str(), settings);
+                }
+                else
+                {
+                    SettingsFields::StoreTruckProfile(g_ctx.configAPI, g_ctx.configHandle, prefix.c_str(), settings);
+                }
+            }
+
+            g_profiles.push_front({key, {}, {}, {}});
+            Capture(g_profiles.front(), settings);
+            g_index[key] = g_profiles.begin();
+
+            while (g_profiles.size() > MAX_CACHED_PROFILES)
+            {
+                g_index.erase(g_profiles.back().key);
+                g_profiles.pop_back();
+            }
+        }
+        g_has_active = true;
+
+        // The settings UI edits the fields' own keys, so they must show the active truck.
+        if (HasConfig())
+        {
+            g_applying = true;
+            SettingsFields::StoreTruckProfile(g_ctx.configAPI, g_ctx.configHandle, nullptr, settings);
+            g_applying = false;
+        }
+        return true;
+    }
+
+    bool IsApplying()
+    {
+        return g_applying;
+    }
+
+    void StoreActive(const AppSettings &settings)
+    {
+        if (!g_has_active)
+        {
+            return;
+        }
+
+        Profile &active = g_profiles.front();
+        Capture(active, settings);
+        if (HasConfig())
+        {
+            SettingsFields::StoreTruckProfile(g_ctx.configAPI, g_ctx.configHandle, MakePrefix(active.key).c_str(), settings);
+        }
+    }
+
+    const char *GetActiveKey()
+    {
+        return g_has_active ? g_profiles.front().key.c_str() : "";
+    }
+
+    void Reset()
+    {
+        g_profiles.clear();
+        g_index.clear();
+        g_has_active = false;
+    }
+
+} // namespace SPF_CabinWalk::TruckProfiles
@@ -0,0 +1,56 @@
+#pragma once
+#include <cstddef>
+
+namespace SPF_CabinWalk
+{
+    struct AppSettings;
+}
+
+namespace SPF_CabinWalk::TruckProfiles
+{
+    /**
+     * @brief The config group that holds one profile per truck, keyed by "<brand_id>.<model id>".
+     * @details Written by this module only; OnSettingChanged ignores keys under it.
+     */
+    constexpr const char *CONFIG_PREFIX = "settings.truck_profiles.";
+
+    // Profiles kept in memory. Older ones are dropped and re-read from the config when their truck returns.
+    constexpr size_t MAX_CACHED_PROFILES = 8;
+
+    /**
+     * @brief Makes the profile of a truck the active one and copies it into `settings`.
+     * @details A profile holds the positions, the sideways walk zone and the floor step: the fields
+     *          flagged SettingsFields::DIRTY_TRUCK_PROFILE. A cached profile is swapped in without reading
+     *          the config. A truck seen for the first time reads its stored profile, or, if it has none,
+     *          starts from the current values. The active profile is also written to the fields' own
+     *          keys, so the settings UI edits it.
+     * @param brand_id SPF_TruckConstants::brand_id
+     * @param model_id SPF_TruckConstants::id
+     * @return True if the active truck changed. The caller then applies the whole profile at once.
+     */
+    bool Activate(const char *brand_id, const char *model_id, AppSettings &settings);
+
+    /**
+     * @brief Checks whether Activate() is writing the profile to the fields' own keys right now.
+     * @details OnSettingChanged ignores the notifications these writes cause, so the profile is applied
+     *          once rather than once per key.
+     */
+    bool IsApplying();
+
+    /**
+     * @brief Saves the current profile fields as the profile of the active truck.
+     * @details Called after one of them was edited. Does nothing before a truck is known.
+     */
+    void StoreActive(const AppSettings &settings);
+
+    /**
+     * @brief Gets the key of the active truck, or an empty string if none is known yet.
+     */
+    const char *GetActiveKey();
+
+    /**
+     * @brief Drops every cached profile. The stored profiles are kept.
+     */
+    void Reset();
+
+} // namespace SPF_CabinWalk::TruckProfiles
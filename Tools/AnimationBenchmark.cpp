@@ -0,0 +1,152 @@
+// Headless microbenchmark for the Animation subsystem.
+//
+// Builds and plays every registered transition sequence against a stub camera API, and
+// reports the cost of building a sequence, of one frame of playback and of a single track evaluation,
+// together with the heap allocations each of them makes. Built only with -DSPF_CABINWALK_BUILD_BENCHMARK=ON.
+
+#include "Camera/CameraFacade.hpp"
+#include "Tools/SequenceCases.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+// =================================================================================================
+// Allocation Counting
+// =================================================================================================
+
+static uint64_t g_heap_allocations = 0;
+
+void *operator new(size_t size)
+{
+    ++g_heap_allocations;
+    if (void *p = std::malloc(size ? size : 1))
+    {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete(void *p, size_t) noexcept { std::free(p); }
+
+// =================================================================================================
+// Plugin Stubs
+// =================================================================================================
+
+namespace SPF_CabinWalk
+{
+    PluginContext g_ctx;
+
+    namespace AnimationController
+    {
+        // The sequences only ask this to pick their timing; the benchmark measures the single-move variants.
+        bool HasPendingMoves() { return false; }
+    }
+}
+
+namespace
+{
+    using namespace SPF_CabinWalk;
+
+    // =============================================================================================
+    // Cases
+    // =============================================================================================
+
+    using Tools::Case;
+    using Tools::START_STATE;
+    using Clock = std::chrono::steady_clock;
+
+    constexpr uint32_t BUILD_ITERATIONS = 2000;
+    constexpr uint32_t PLAYBACK_RUNS = 20;
+    constexpr uint64_t FRAME_TIME_US = 16667; // 60 FPS
+    constexpr uint32_t EVAL_SAMPLES = 4096;
+
+    // Keeps the evaluated values observable, so the evaluation loop cannot be optimized away.
+    volatile float g_sink = 0.0f;
+
+    double NsPer(Clock::duration elapsed, uint64_t count)
+    {
+        return count ? static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) / static_cast<double>(count) : 0.0;
+    }
+
+    double Per(uint64_t total, uint64_t count)
+    {
+        return count ? static_cast<double>(total) / static_cast<double>(count) : 0.0;
+    }
+
+    void RunCase(const Case &c)
+    {
+        // --- Build ---
+        uint64_t allocations_before = g_heap_allocations;
+        Clock::time_point start = Clock::now();
+        for (uint32_t i = 0; i < BUILD_ITERATIONS; ++i)
+        {
+            c.build();
+        }
+        const double build_ns = NsPer(Clock::now() - start, BUILD_ITERATIONS);
+        const double build_allocs = Per(g_heap_allocations - allocations_before, BUILD_ITERATIONS);
+
+        const std::unique_ptr<Animation::AnimationSequence> sequence = c.build();
+        const uint32_t keyframes = sequence->GetKeyframeCount();
+
+        // --- Playback (AnimationSequence::Update plus the facade flush, as in OnUpdate) ---
+        uint64_t frames = 0;
+        allocations_before = g_heap_allocations;
+        start = Clock::now();
+        for (uint32_t run = 0; run < PLAYBACK_RUNS; ++run)
+        {
+            CameraFacade::BeginFrame();
+            sequence->Start(START_STATE);
+            bool playing = true;
+            while (playing)
+            {
+                playing = sequence->Update(FRAME_TIME_US);
+                CameraFacade::Flush();
+                ++frames;
+            }
+        }
+        const double update_ns = NsPer(Clock::now() - start, frames);
+        const double update_allocs = Per(g_heap_allocations - allocations_before, frames);
+
+        // --- Track::Evaluate on every keyed channel, sweeping progress forward like playback does ---
+        uint64_t evals = 0;
+        float sink = 0.0f;
+        start = Clock::now();
+        for (size_t channel = 0; channel < Animation::CHANNEL_COUNT; ++channel)
+        {
+            Animation::Track<float> track = sequence->GetTrack(static_cast<Animation::Channel>(channel));
+            if (track.GetKeyframeCount() == 0)
+            {
+                continue;
+            }
+
+            track.ResetCursor();
+            for (uint32_t i = 0; i < EVAL_SAMPLES; ++i)
+            {
+                sink += track.Evaluate(static_cast<float>(i) / static_cast<float>(EVAL_SAMPLES - 1), 0.0f);
+                ++evals;
+            }
+        }
+        const double eval_ns = NsPer(Clock::now() - start, evals);
+
+        g_sink = sink;
+
+        std::printf("%-28s %6u %12.1f %10.2f %12.1f %10.2f %12.2f\n",
+                    c.name, keyframes, build_ns, build_allocs, update_ns, update_allocs, eval_ns);
+    }
+} // namespace
+
+int main()
+{
+    static SPF_Camera_API camera_api = Tools::MakeStubCameraAPI();
+    g_ctx.cameraAPI = &camera_api;
+    Tools::ApplyDefaultSettings(g_ctx.settings);
+
+    std::printf("%-28s %6s %12s %10s %12s %10s %12s\n", "sequence", "keys", "ns/build", "allocs", "ns/update", "allocs", "ns/eval");
+    for (const Case &c : Tools::MakeCases())
+    {
+        RunCase(c);
+    }
+    return 0;
+}
@@ -0,0 +1,499 @@
+// Headless regression check for the Animation subsystem.
+//
+// Plays every registered transition sequence on a fixed clock and compares the sampled pose
+// with the golden traces checked in next to this file, then checks the frame budget of playback: no heap
+// allocations and at most one camera write per property per frame. Both are counted, not timed, so the
+// check gives the same answer on any machine and under any load. Last, it holds the pitch in each stance
+// trigger zone and checks that the stance changes once hold_time_ms has passed, and not before. Exits
+// non-zero on any failure.
+//
+//   AnimationGoldenCheck [--update] [--budget-ns N] [golden_file]
+//
+// --update rewrites the golden file after an intended change to the motion. --budget-ns also fails a
+// sequence whose frames take longer than N ns on average; it is meant for a quiet machine, not for CTest.
+// Registered with CTest as AnimationGoldenCheck (-DSPF_CABINWALK_BUILD_GOLDEN_CHECK, on by default).
+
+#include "Camera/CameraFacade.hpp"
+#include "Tools/SequenceCases.hpp"
+#include "Animation/AnimationScheduler.hpp"
+#include "Animation/StandingAnimController.hpp"
+#include "Diagnostics/DebugOverlay.hpp"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+#include <vector>
+
+// =================================================================================================
+// Allocation Counting
+// =================================================================================================
+
+static uint64_t g_heap_allocations = 0;
+
+void *operator new(size_t size)
+{
+    ++g_heap_allocations;
+    if (void *p = std::malloc(size ? size : 1))
+    {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete(void *p, size_t) noexcept { std::free(p); }
+
+// =================================================================================================
+// Plugin Stubs
+// =================================================================================================
+
+static bool g_has_pending_moves = false;
+
+namespace SPF_CabinWalk
+{
+    PluginContext g_ctx;
+
+    namespace AnimationController
+    {
+        // Transitions are traced once per value, since some of them shape their last leg by it.
+        bool HasPendingMoves() { return g_has_pending_moves; }
+
+        // The stance check never walks to a seat.
+        bool MoveTo(CameraPosition) { return false; }
+    }
+
+    namespace DebugOverlay
+    {
+        std::atomic<bool> Detail::g_enabled{false};
+        void PublishStanding(const StandingState &) {}
+    }
+}
+
+namespace
+{
+    using namespace SPF_CabinWalk;
+    using Clock = std::chrono::steady_clock;
+
+    constexpr char GOLDEN_HEADER[] = "# CabinWalk golden curves v1";
+    constexpr uint64_t SAMPLE_TIME_US = 50000; // Golden traces are sampled at 20 Hz.
+    constexpr float TOLERANCE = 1e-4f;         // Metres or radians.
+    constexpr size_t SAMPLE_CHANNELS = 5;      // x, y, z, yaw, pitch
+
+    constexpr uint32_t PLAYBACK_RUNS = 20;
+    constexpr uint64_t FRAME_TIME_US = 16667; // 60 FPS
+    constexpr uint64_t MAX_CAMERA_WRITES_PER_FRAME = 2; // The seat position and the head rotation, once each.
+
+    struct Sample
+    {
+        uint64_t time_us;
+        float values[SAMPLE_CHANNELS];
+    };
+
+    struct Trace
+    {
+        std::string name;
+        std::vector<Sample> samples;
+    };
+
+    const char *const CHANNEL_NAMES[SAMPLE_CHANNELS] = {"x", "y", "z", "yaw", "pitch"};
+
+    // =============================================================================================
+    // Tracing
+    // =============================================================================================
+
+    Sample MakeSample(uint64_t time_us, const Animation::CurrentCameraState &state)
+    {
+        return {time_us, {state.position.x, state.position.y, state.position.z, state.rotation.x, state.rotation.y}};
+    }
+
+    Trace Record(const Tools::Case &c, bool has_pending_moves)
+    {
+        g_has_pending_moves = has_pending_moves;
+        const std::unique_ptr<Animation::AnimationSequence> sequence = c.build();
+        g_has_pending_moves = false;
+
+        Trace trace = {std::string(c.name) + (has_pending_moves ? "+pending" : ""), {}};
+        sequence->Start(Tools::START_STATE);
+        uint64_t time_us = 0;
+        trace.samples.push_back(MakeSample(time_us, sequence->Evaluate()));
+        bool playing = true;
+        while (playing)
+        {
+            playing = sequence->Advance(SAMPLE_TIME_US);
+            time_us += SAMPLE_TIME_US;
+            trace.samples.push_back(MakeSample(time_us, sequence->Evaluate()));
+        }
+        return trace;
+    }
+
+    std::vector<Trace> RecordAll(const std::vector<Tools::Case> &cases)
+    {
+        std::vector<Trace> traces;
+        for (const Tools::Case &c : cases)
+        {
+            traces.push_back(Record(c, false));
+            traces.push_back(Record(c, true));
+        }
+        return traces;
+    }
+
+    // =============================================================================================
+    // Golden File
+    // =============================================================================================
+
+    bool WriteGolden(const char *path, const std::vector<Trace> &traces)
+    {
+        std::FILE *file = std::fopen(path, "w");
+        if (!file)
+        {
+            return false;
+        }
+
+        std::fprintf(file, "%s\n", GOLDEN_HEADER);
+        for (const Trace &trace : traces)
+        {
+            std::fprintf(file, "trace %s %zu\n", trace.name.c_str(), trace.samples.size());
+            for (const Sample &sample : trace.samples)
+            {
+                std::fprintf(file, "%llu", static_cast<unsigned long long>(sample.time_us));
+                for (float value : sample.values)
+                {
+                    std::fprintf(file, " %.6f", value);
+                }
+                std::fprintf(file, "\n");
+            }
+        }
+        return std::fclose(file) == 0;
+    }
+
+    bool ReadGolden(const char *path, std::vector<Trace> &traces)
+    {
+        std::FILE *file = std::fopen(path, "r");
+        if (!file)
+        {
+            return false;
+        }
+
+        char line[128] = {};
+        bool ok = std::fgets(line, sizeof(line), file) && std::strncmp(line, GOLDEN_HEADER, sizeof(GOLDEN_HEADER) - 1) == 0;
+
+        char name[96];
+        size_t count = 0;
+        while (ok && std::fscanf(file, " trace %95s %zu", name, &count) == 2)
+        {
+            Trace trace = {name, std::vector<Sample>(count)};
+            for (Sample &s : trace.samples)
+            {
+                unsigned long long time_us = 0;
+                ok = std::fscanf(file, "%llu %f %f %f %f %f", &time_us, &s.values[0], &s.values[1], &s.values[2], &s.values[3], &s.values[4]) == 6;
+                s.time_us = time_us;
+                if (!ok)
+                {
+                    break;
+                }
+            }
+            traces.push_back(std::move(trace));
+        }
+
+        ok = ok && std::feof(file);
+        std::fclose(file);
+        return ok;
+    }
+
+    const Trace *FindTrace(const std::vector<Trace> &traces, const std::string &name)
+    {
+        for (const Trace &trace : traces)
+        {
+            if (trace.name == name)
+            {
+                return &trace;
+            }
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief Compares a trace with its golden version and reports the first sample that differs.
+     */
+    bool CompareTrace(const Trace &actual, const Trace &golden)
+    {
+        if (actual.samples.size() != golden.samples.size())
+        {
+            std::printf("FAIL %-28s duration changed: %zu samples, golden has %zu\n", actual.name.c_str(), actual.samples.size(), golden.samples.size());
+            return false;
+        }
+
+        for (size_t i = 0; i < actual.samples.size(); ++i)
+        {
+            for (size_t channel = 0; channel < SAMPLE_CHANNELS; ++channel)
+            {
+                const float value = actual.samples[i].values[channel];
+                const float expected = golden.samples[i].values[channel];
+                if (!(std::fabs(value - expected) <= TOLERANCE))
+                {
+                    std::printf("FAIL %-28s %s at %llu us: %.6f, golden %.6f\n", actual.name.c_str(), CHANNEL_NAMES[channel],
+                                static_cast<unsigned long long>(actual.samples[i].time_us), value, expected);
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    // =============================================================================================
+    // Budget
+    // =============================================================================================
+
+    /**
+     * @brief Plays a sequence as OnUpdate does and checks the cost of one frame against the budget.
+     * @param budget_ns The wall-clock budget of one frame, or 0 to check only the counted budget.
+     */
+    bool CheckBudget(const Tools::Case &c, double budget_ns)
+    {
+        const std::unique_ptr<Animation::AnimationSequence> sequence = c.build();
+
+        uint64_t frames = 0;
+        const uint64_t allocations_before = g_heap_allocations;
+        const uint64_t writes_before = Tools::g_camera_writes;
+        const Clock::time_point start = Clock::now();
+        for (uint32_t run = 0; run < PLAYBACK_RUNS; ++run)
+        {
+            CameraFacade::BeginFrame();
+            sequence->Start(Tools::START_STATE);
+            bool playing = true;
+            while (playing)
+            {
+                playing = sequence->Update(FRAME_TIME_US);
+                CameraFacade::Flush();
+                ++frames;
+            }
+        }
+        const double ns_per_frame = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count()) / static_cast<double>(frames);
+        const uint64_t allocations = g_heap_allocations - allocations_before;
+        const uint64_t writes = Tools::g_camera_writes - writes_before;
+
+        if (allocations != 0)
+        {
+            std::printf("FAIL %-28s %llu allocations during playback\n", c.name, static_cast<unsigned long long>(allocations));
+            return false;
+        }
+        if (writes > frames * MAX_CAMERA_WRITES_PER_FRAME)
+        {
+            std::printf("FAIL %-28s %llu camera writes in %llu frames\n", c.name, static_cast<unsigned long long>(writes), static_cast<unsigned long long>(frames));
+            return false;
+        }
+        if (budget_ns > 0.0 && ns_per_frame > budget_ns)
+        {
+            std::printf("FAIL %-28s %.1f ns per frame, budget %.1f\n", c.name, ns_per_frame, budget_ns);
+            return false;
+        }
+        return true;
+    }
+
+    // =============================================================================================
+    // Stance Holds
+    // =============================================================================================
+
+    using StandingAnimController::Stance;
+
+    const char *const STANCE_NAMES[] = {"Standing", "Crouching", "Tiptoes", "InTransition", "WalkingToFinalDestination"};
+
+    Animation::CurrentCameraState PitchedBy(float pitch)
+    {
+        Animation::CurrentCameraState state = {};
+        state.rotation.y = pitch;
+        return state;
+    }
+
+    /**
+     * @brief Runs the scheduler for one frame; in Standing that ticks the standing controller.
+     */
+    void PlayFrame(const FrameContext &frame)
+    {
+        uint32_t events = 0;
+        AnimationScheduler::Update(frame, &events);
+    }
+
+    /**
+     * @brief Holds a pitch from `from` and checks that the stance changes once hold_time_ms has passed, not before.
+     */
+    bool CheckHold(const char *name, float pitch, Stance from)
+    {
+        FrameContext frame;
+        frame.delta_time_us = FRAME_TIME_US;
+        frame.camera = PitchedBy(pitch);
+
+        const uint64_t hold_time_us = static_cast<uint64_t>(g_ctx.settings.standing_movement.stance_control.hold_time_ms) * 1000ull;
+        uint64_t held_us = 0;
+        while (held_us + FRAME_TIME_US < hold_time_us)
+        {
+            PlayFrame(frame);
+            held_us += FRAME_TIME_US;
+            if (StandingAnimController::GetCurrentStance() != from)
+            {
+                std::printf("FAIL %-28s fired after %llu of %d ms\n", name, static_cast<unsigned long long>(held_us / 1000),
+                            g_ctx.settings.standing_movement.stance_control.hold_time_ms);
+                return false;
+            }
+        }
+
+        // Ticks and frames are both 60 Hz, so the hold ends within a frame or two of hold_time_ms.
+        for (uint32_t i = 0; i < 2; ++i)
+        {
+            PlayFrame(frame);
+            if (StandingAnimController::GetCurrentStance() != from)
+            {
+                return true;
+            }
+        }
+        std::printf("FAIL %-28s still %s after %d ms\n", name, STANCE_NAMES[static_cast<size_t>(from)], g_ctx.settings.standing_movement.stance_control.hold_time_ms);
+        return false;
+    }
+
+    /**
+     * @brief Plays frames at `pitch` until the stance change in progress reaches `to`.
+     */
+    bool Settle(float pitch, Stance to)
+    {
+        FrameContext frame;
+        frame.delta_time_us = FRAME_TIME_US;
+        frame.camera = PitchedBy(pitch);
+        for (uint32_t i = 0; i < 600 && StandingAnimController::GetCurrentStance() != to; ++i)
+        {
+            PlayFrame(frame);
+        }
+        if (StandingAnimController::GetCurrentStance() != to)
+        {
+            std::printf("FAIL %-28s never settled\n", STANCE_NAMES[static_cast<size_t>(to)]);
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Runs the crouch, stand-up, tiptoe and stand-down holds in turn.
+     * @return The number of failures.
+     */
+    size_t CheckStanceHolds()
+    {
+        static const SPF_Core_API core_api = {};
+        g_ctx.coreAPI = &core_api; // StandingAnimController::Tick runs only once the core API is known.
+        StandingAnimController::Initialize(&g_ctx);
+        StandingAnimController::OnEnterStandingState();
+
+        const auto &stance = g_ctx.settings.standing_movement.stance_control;
+        const float crouch_pitch = stance.crouch.activation_angle - 0.1f;
+        const float stand_up_pitch = stance.crouch.deactivation_angle + 0.01f;
+        const float tiptoe_pitch = stance.tiptoe.activation_angle + 0.1f;
+        const float stand_down_pitch = stance.tiptoe.deactivation_angle - 0.01f;
+
+        // Each hold starts from the stance the one before it settled into, so the first failure ends the check.
+        const struct
+        {
+            const char *name;
+            float pitch;
+            Stance from;
+            float settle_pitch; // Outside every trigger zone of `to`.
+            Stance to;
+        } holds[] = {
+            {"CrouchHold", crouch_pitch, Stance::Standing, crouch_pitch, Stance::Crouching},
+            {"StandUpHold", stand_up_pitch, Stance::Crouching, 0.0f, Stance::Standing},
+            {"TiptoeHold", tiptoe_pitch, Stance::Standing, tiptoe_pitch, Stance::Tiptoes},
+            {"StandDownHold", stand_down_pitch, Stance::Tiptoes, 0.0f, Stance::Standing},
+        };
+        for (const auto &hold : holds)
+        {
+            if (!CheckHold(hold.name, hold.pitch, hold.from) || !Settle(hold.settle_pitch, hold.to))
+            {
+                return 1;
+            }
+        }
+        return 0;
+    }
+} // namespace
+
+int main(int argc, char **argv)
+{
+    bool update = false;
+    double budget_ns = 0.0;
+    const char *path = SPF_CABINWALK_GOLDEN_FILE;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--update") == 0)
+        {
+            update = true;
+        }
+        else if (std::strcmp(argv[i], "--budget-ns") == 0 && i + 1 < argc)
+        {
+            budget_ns = std::atof(argv[++i]);
+        }
+        else
+        {
+            path = argv[i];
+        }
+    }
+
+    static SPF_Camera_API camera_api = Tools::MakeStubCameraAPI();
+    g_ctx.cameraAPI = &camera_api;
+    Tools::ApplyDefaultSettings(g_ctx.settings);
+
+    const std::vector<Tools::Case> cases = Tools::MakeCases();
+    const std::vector<Trace> traces = RecordAll(cases);
+
+    if (update)
+    {
+        if (!WriteGolden(path, traces))
+        {
+            std::printf("Cannot write %s\n", path);
+            return 1;
+        }
+        std::printf("Wrote %zu traces to %s\n", traces.size(), path);
+        return 0;
+    }
+
+    std::vector<Trace> golden;
+    if (!ReadGolden(path, golden))
+    {
+        std::printf("Cannot read %s; run with --update to create it.\n", path);
+        return 1;
+    }
+
+    size_t failures = 0;
+    for (const Trace &trace : traces)
+    {
+        const Trace *expected = FindTrace(golden, trace.name);
+        if (!expected)
+        {
+            std::printf("FAIL %-28s has no golden trace\n", trace.name.c_str());
+            ++failures;
+        }
+        else if (!CompareTrace(trace, *expected))
+        {
+            ++failures;
+        }
+    }
+    for (const Trace &trace : golden)
+    {
+        if (!FindTrace(traces, trace.name))
+        {
+            std::printf("FAIL %-28s is no longer registered\n", trace.name.c_str());
+            ++failures;
+        }
+    }
+
+    for (const Tools::Case &c : cases)
+    {
+        if (!CheckBudget(c, budget_ns))
+        {
+            ++failures;
+        }
+    }
+
+    failures += CheckStanceHolds();
+
+    std::printf("%zu traces, %zu sequences, %zu failures\n", traces.size(), cases.size(), failures);
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,95 @@
+// Shared by the headless tools: a stub camera API, the default settings and the table of every
+// registered transition sequence.
+
+#pragma once
+#include "SPF_CabinWalk.hpp"
+#include "Animation/AnimationSequence.hpp"
+#include "Animation/Sequences/DriverToPassenger.hpp"
+#include "Animation/Sequences/PassengerToDriver.hpp"
+#include "Animation/Sequences/DriverToStanding.hpp"
+#include "Animation/Sequences/StandingToDriver.hpp"
+#include "Animation/Sequences/PassengerToStanding.hpp"
+#include "Animation/Sequences/StandingToPassenger.hpp"
+#include "Animation/Sequences/StandingToSofa.hpp"
+#include "Animation/Sequences/SofaToStanding.hpp"
+#include "Animation/Sequences/SofaStances.hpp"
+#include "Settings/SettingsFields.hpp"
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace SPF_CabinWalk::Tools
+{
+    // =================================================================================================
+    // Stub Camera
+    // =================================================================================================
+
+    inline float g_seat[3] = {};
+    inline float g_head[2] = {};
+    inline uint64_t g_camera_writes = 0; // Calls to either setter, for the per-frame write budget.
+
+    inline bool StubGetSeatPos(float *x, float *y, float *z) { *x = g_seat[0]; *y = g_seat[1]; *z = g_seat[2]; return true; }
+    inline void StubSetSeatPos(float x, float y, float z) { g_seat[0] = x; g_seat[1] = y; g_seat[2] = z; ++g_camera_writes; }
+    inline bool StubGetHeadRot(float *yaw, float *pitch) { *yaw = g_head[0]; *pitch = g_head[1]; return true; }
+    inline void StubSetHeadRot(float yaw, float pitch) { g_head[0] = yaw; g_head[1] = pitch; ++g_camera_writes; }
+
+    inline SPF_Camera_API MakeStubCameraAPI()
+    {
+        SPF_Camera_API api;
+        std::memset(&api, 0, sizeof(api));
+        api.Cam_GetInteriorSeatPos = StubGetSeatPos;
+        api.Cam_SetInteriorSeatPos = StubSetSeatPos;
+        api.Cam_GetInteriorHeadRot = StubGetHeadRot;
+        api.Cam_SetInteriorHeadRot = StubSetHeadRot;
+        return api;
+    }
+
+    // The defaults of the settings manifest.
+    inline void ApplyDefaultSettings(AppSettings &s)
+    {
+        SettingsFields::ApplyDefaults(s);
+    }
+
+    // =================================================================================================
+    // Cases
+    // =================================================================================================
+
+    inline const Animation::CurrentCameraState START_STATE = {{0.1f, -0.05f, 0.3f}, {0.4f, -0.2f, 0.0f}};
+    inline const Animation::CurrentCameraState TARGET_STATE = {{0.7f, 0.1f, -0.4f}, {-1.2f, 0.05f, 0.0f}};
+
+    struct Case
+    {
+        const char *name;
+        std::function<std::unique_ptr<Animation::AnimationSequence>()> build;
+    };
+
+    inline Case Transition(const char *name, std::unique_ptr<Animation::AnimationSequence> (*factory)(const Animation::CurrentCameraState &, const Animation::CurrentCameraState &))
+    {
+        return {name, [factory]() { return factory(START_STATE, TARGET_STATE); }};
+    }
+
+    /**
+     * @brief Gets every registered transition sequence.
+     */
+    inline std::vector<Case> MakeCases()
+    {
+        namespace S = AnimationSequences;
+        return {
+            Transition("DriverToPassenger", S::CreateDriverToPassengerSequence),
+            Transition("PassengerToDriver", S::CreatePassengerToDriverSequence),
+            Transition("DriverToStanding", S::CreateDriverToStandingSequence),
+            Transition("StandingToDriver", S::CreateStandingToDriverSequence),
+            Transition("PassengerToStanding", S::CreatePassengerToStandingSequence),
+            Transition("StandingToPassenger", S::CreateStandingToPassengerSequence),
+            Transition("StandingToSofa", S::CreateStandingToSofaSequence),
+            Transition("SofaToStanding", S::CreateSofaToStandingSequence),
+            Transition("SofaSit1ToLie", S::CreateSofaSit1ToLieSequence),
+            Transition("SofaLieToSit2", S::CreateSofaLieToSit2Sequence),
+            Transition("SofaLieToSofa1", S::CreateSofaLieToSofa1Sequence),
+            Transition("SofaSit2ToSit1", S::CreateSofaSit2ToSit1Sequence),
+            Transition("SofaSit1ToSit2", S::CreateSofaSit1ToSit2Sequence),
+        };
+    }
+
+} // namespace SPF_CabinWalk::Tools
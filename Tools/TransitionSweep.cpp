@@ -0,0 +1,718 @@
+// Headless sweep of the transition settings for comfort.
+//
+// Runs the transition factories without the game, on every core, over candidate animation durations,
+// the general height and small nudges of the configured positions. Every transition is sampled at a
+// fixed step and scored for comfort: peak angular velocity, peak linear acceleration and path length,
+// plus a weight on duration so the sweep does not simply slow everything down. The best value of each
+// setting is written out as a settings JSON.
+//
+// The factories read their settings through the thread-local Animation::FactoryContext, so every job
+// installs its own candidate settings and no job touches the plugin's globals. Jobs run on a small
+// work-stealing pool: each worker drains its own deque from the back and steals from the front of the
+// others' when it runs dry.
+//
+// The search is one pass of coordinate descent: each setting is swept with all others at their best
+// value so far, scored only on the transitions it affects.
+//
+//   TransitionSweep [--out <file>] [--threads <n>] [--weights <ang,acc,path,time>]
+//                   [--driver <x,y,z,yaw,pitch>] [--position-radius <m>] [--set <key>=<value>]...
+//
+// `--set` overrides the starting value of a swept setting, e.g. the positions of a particular truck:
+//   --set settings.positions.standing.position.z=0.35
+
+#include "SPF_CabinWalk.hpp"
+#include "Animation/AnimationSequence.hpp"
+#include "Animation/FactoryContext.hpp"
+#include "Animation/ReversedTransition.hpp"
+#include "Tools/SequenceCases.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace SPF_CabinWalk
+{
+    PluginContext g_ctx;
+
+    // Transition factories read this only when no FactoryContext is installed, which never happens here.
+    bool AnimationController::HasPendingMoves() { return false; }
+} // namespace SPF_CabinWalk
+
+using namespace SPF_CabinWalk;
+
+namespace
+{
+    // =================================================================================================
+    // Constants
+    // =================================================================================================
+
+    constexpr uint64_t SAMPLE_TIME_US = 10000;    // 100 Hz; a finer step turns every keyframe kink into an acceleration spike.
+    constexpr int32_t MIN_DURATION_MS = 100;      // The range of the duration sliders.
+    constexpr int32_t MAX_DURATION_MS = 10000;
+    constexpr double DURATION_FACTORS[] = {0.6, 0.7, 0.8, 0.9, 1.0, 1.1, 1.2, 1.35, 1.6};
+    constexpr double HEIGHT_STEP = 0.025;         // general.height is swept this far apart...
+    constexpr int HEIGHT_STEPS = 4;               // ...this many steps either way.
+    constexpr int POSITION_STEPS = 2;             // Each coordinate is nudged this many steps either way of the radius.
+    constexpr double DEFAULT_POSITION_RADIUS = 0.03;
+
+    // =================================================================================================
+    // Work-Stealing Pool
+    // =================================================================================================
+
+    /**
+     * @class WorkStealingPool
+     * @brief Runs batches of jobs on a fixed set of workers, each with its own deque.
+     * @details A batch is dealt round-robin over the deques. A worker takes from the back of its own
+     *          deque and, once it is empty, steals from the front of the others', so uneven jobs (long
+     *          transitions, slow candidates) even out without a shared queue every pop contends on.
+     */
+    class WorkStealingPool
+    {
+    public:
+        explicit WorkStealingPool(unsigned worker_count)
+        {
+            worker_count = std::max(worker_count, 1u);
+            for (unsigned i = 0; i < worker_count; ++i)
+            {
+                m_queues.push_back(std::make_unique<Queue>());
+            }
+            for (unsigned i = 0; i < worker_count; ++i)
+            {
+                m_workers.emplace_back([this, i] { WorkerLoop(i); });
+            }
+        }
+
+        ~WorkStealingPool()
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_wake_mutex);
+                m_stop = true;
+            }
+            m_wake.notify_all();
+            for (std::thread &worker : m_workers)
+            {
+                worker.join();
+            }
+        }
+
+        size_t GetWorkerCount() const { return m_workers.size(); }
+
+        /**
+         * @brief Runs every job of a batch and returns once all of them have finished.
+         */
+        void Run(std::vector<std::function<void()>> &jobs)
+        {
+            if (jobs.empty())
+            {
+                return;
+            }
+
+            // Counted before any job is queued: a worker still draining the last batch may pick one up at once.
+            m_pending.store(jobs.size());
+            for (size_t i = 0; i < jobs.size(); ++i)
+            {
+                Queue &queue = *m_queues[i % m_queues.size()];
+                std::lock_guard<std::mutex> lock(queue.mutex);
+                queue.jobs.push_back(&jobs[i]);
+            }
+
+            std::unique_lock<std::mutex> lock(m_wake_mutex);
+            ++m_generation;
+            m_wake.notify_all();
+            m_done.wait(lock, [this] { return m_pending.load() == 0; });
+        }
+
+    private:
+        using Job = std::function<void()>;
+
+        struct Queue
+        {
+            std::mutex mutex;
+            std::deque<Job *> jobs;
+        };
+
+        Job *TryPop(size_t self)
+        {
+            {
+                Queue &own = *m_queues[self];
+                std::lock_guard<std::mutex> lock(own.mutex);
+                if (!own.jobs.empty())
+                {
+                    Job *job = own.jobs.back();
+                    own.jobs.pop_back();
+                    return job;
+                }
+            }
+            for (size_t i = 1; i < m_queues.size(); ++i)
+            {
+                Queue &victim = *m_queues[(self + i) % m_queues.size()];
+                std::lock_guard<std::mutex> lock(victim.mutex);
+                if (!victim.jobs.empty())
+                {
+                    Job *job = victim.jobs.front();
+                    victim.jobs.pop_front();
+                    return job;
+                }
+            }
+            return nullptr;
+        }
+
+        void WorkerLoop(size_t self)
+        {
+            uint64_t seen_generation = 0;
+            for (;;)
+            {
+                {
+                    std::unique_lock<std::mutex> lock(m_wake_mutex);
+                    m_wake.wait(lock, [&] { return m_stop || m_generation != seen_generation; });
+                    if (m_stop)
+                    {
+                        return;
+                    }
+                    seen_generation = m_generation;
+                }
+
+                while (Job *job = TryPop(self))
+                {
+                    (*job)();
+                    if (m_pending.fetch_sub(1) == 1)
+                    {
+                        std::lock_guard<std::mutex> lock(m_wake_mutex);
+                        m_done.notify_all();
+                    }
+                }
+            }
+        }
+
+        std::vector<std::unique_ptr<Queue>> m_queues;
+        std::vector<std::thread> m_workers;
+        std::mutex m_wake_mutex;
+        std::condition_variable m_wake;
+        std::condition_variable m_done;
+        std::atomic<size_t> m_pending{0};
+        uint64_t m_generation = 0;
+        bool m_stop = false;
+    };
+
+    // =================================================================================================
+    // Transitions
+    // =================================================================================================
+
+    enum class Spot : uint8_t
+    {
+        Driver = 0,
+        Passenger,
+        Standing,
+        SofaSit1,
+        SofaLie,
+        SofaSit2,
+        Count
+    };
+
+    // The settings child of each configurable spot; the driver seat is the game's and is given on the command line.
+    constexpr const char *SPOT_KEYS[] = {nullptr, "passenger_seat", "standing", "sofa_sit1", "sofa_lie", "sofa_sit2"};
+    static_assert(std::size(SPOT_KEYS) == static_cast<size_t>(Spot::Count), "One key per spot");
+
+    struct SweptTransition
+    {
+        const char *name;
+        Spot from;
+        Spot to;
+        Animation::SequenceFactory factory;
+    };
+
+    // Every transition AnimationController registers, as it does.
+    const SweptTransition TRANSITIONS[] = {
+        {"DriverToPassenger", Spot::Driver, Spot::Passenger, AnimationSequences::CreateDriverToPassengerSequence},
+        {"PassengerToDriver", Spot::Passenger, Spot::Driver, AnimationSequences::CreatePassengerToDriverSequence},
+        {"DriverToStanding", Spot::Driver, Spot::Standing, AnimationSequences::CreateDriverToStandingSequence},
+        {"StandingToDriver", Spot::Standing, Spot::Driver, AnimationSequences::CreateStandingToDriverSequence},
+        {"PassengerToStanding", Spot::Passenger, Spot::Standing, AnimationSequences::CreatePassengerToStandingSequence},
+        {"StandingToPassenger", Spot::Standing, Spot::Passenger, AnimationSequences::CreateStandingToPassengerSequence},
+        {"StandingToSofa", Spot::Standing, Spot::SofaSit1, AnimationSequences::CreateStandingToSofaSequence},
+        {"SofaToStanding", Spot::SofaSit1, Spot::Standing, AnimationSequences::CreateSofaToStandingSequence},
+        {"SofaSit1ToLie", Spot::SofaSit1, Spot::SofaLie, AnimationSequences::CreateSofaSit1ToLieSequence},
+        {"SofaLieToSit2", Spot::SofaLie, Spot::SofaSit2, AnimationSequences::CreateSofaLieToSit2Sequence},
+        {"SofaLieToSofa1", Spot::SofaLie, Spot::SofaSit1, AnimationSequences::CreateSofaLieToSofa1Sequence},
+        {"SofaSit2ToSit1", Spot::SofaSit2, Spot::SofaSit1, AnimationSequences::CreateSofaSit2ToSit1Sequence},
+        {"SofaSit1ToSit2", Spot::SofaSit1, Spot::SofaSit2,
+         Animation::CreateReversedSequence<AnimationSequences::CreateSofaSit2ToSit1Sequence, AnimationSequences::CreateSofaSit1ToSit2Sequence,
+                                           Animation::ChannelBit(Animation::Channel::RotationYaw)>},
+    };
+    constexpr size_t TRANSITION_COUNT = std::size(TRANSITIONS);
+    static_assert(TRANSITION_COUNT <= 32, "Transition sets are bit masks");
+
+    constexpr uint32_t ALL_TRANSITIONS = (1u << TRANSITION_COUNT) - 1;
+
+    uint32_t TransitionBit(const char *name)
+    {
+        for (size_t i = 0; i < TRANSITION_COUNT; ++i)
+        {
+            if (std::strcmp(TRANSITIONS[i].name, name) == 0)
+            {
+                return 1u << i;
+            }
+        }
+        std::fprintf(stderr, "Unknown transition %s\n", name);
+        std::abort();
+    }
+
+    uint32_t TransitionsTouching(Spot spot)
+    {
+        uint32_t mask = 0;
+        for (size_t i = 0; i < TRANSITION_COUNT; ++i)
+        {
+            if (TRANSITIONS[i].from == spot || TRANSITIONS[i].to == spot)
+            {
+                mask |= 1u << i;
+            }
+        }
+        return mask;
+    }
+
+    const AppSettings::PositionSetting &GetSpotSetting(const AppSettings &settings, Spot spot)
+    {
+        switch (spot)
+        {
+        case Spot::Passenger: return settings.positions.passenger_seat;
+        case Spot::Standing: return settings.positions.standing;
+        case Spot::SofaSit1: return settings.positions.sofa_sit1;
+        case Spot::SofaLie: return settings.positions.sofa_lie;
+        default: return settings.positions.sofa_sit2;
+        }
+    }
+
+    Animation::CurrentCameraState GetSpotState(const AppSettings &settings, Spot spot, const Animation::CurrentCameraState &driver)
+    {
+        if (spot == Spot::Driver)
+        {
+            return driver;
+        }
+        const AppSettings::PositionSetting &setting = GetSpotSetting(settings, spot);
+        return {setting.position, {setting.rotation.x, setting.rotation.y, 0.0f}};
+    }
+
+    // =================================================================================================
+    // Comfort Scoring
+    // =================================================================================================
+
+    struct Weights
+    {
+        double angular_velocity = 1.0; // Per rad/s of the fastest turn of the head.
+        double acceleration = 1.0;     // Per m/s^2 of the hardest change of speed.
+        double path_length = 2.0;      // Per metre travelled.
+        double duration = 0.5;         // Per second; keeps the sweep from slowing every move to a crawl.
+    };
+
+    struct Comfort
+    {
+        double peak_angular_velocity = 0.0; // rad/s
+        double peak_acceleration = 0.0;     // m/s^2
+        double path_length = 0.0;           // m
+        double duration = 0.0;              // s
+        bool valid = false;
+
+        double Score(const Weights &w) const
+        {
+            return w.angular_velocity * peak_angular_velocity + w.acceleration * peak_acceleration + w.path_length * path_length +
+                   w.duration * duration;
+        }
+    };
+
+    /**
+     * @brief Builds one transition with the settings of the calling thread's FactoryContext and samples it.
+     */
+    Comfort Measure(const SweptTransition &transition, const AppSettings &settings, const Animation::CurrentCameraState &driver)
+    {
+        Comfort comfort;
+        const Animation::CurrentCameraState start = GetSpotState(settings, transition.from, driver);
+        const Animation::CurrentCameraState target = GetSpotState(settings, transition.to, driver);
+        std::unique_ptr<Animation::AnimationSequence> sequence = transition.factory(start, target);
+        if (!sequence)
+        {
+            return comfort;
+        }
+
+        const double dt = static_cast<double>(SAMPLE_TIME_US) / 1000000.0;
+        sequence->Start(start);
+        Animation::CurrentCameraState previous = sequence->Evaluate();
+        double velocity[3] = {};
+        bool has_velocity = false;
+        bool playing = true;
+        while (playing)
+        {
+            playing = sequence->Advance(SAMPLE_TIME_US);
+            const Animation::CurrentCameraState current = sequence->Evaluate();
+
+            const double d[3] = {current.position.x - previous.position.x, current.position.y - previous.position.y,
+                                 current.position.z - previous.position.z};
+            const double step = std::sqrt(d[0] * d[0] + d[1] * d[1] + d[2] * d[2]);
+            comfort.path_length += step;
+
+            const double yaw = Animation::WrapAngle(current.rotation.x - previous.rotation.x);
+            const double pitch = current.rotation.y - previous.rotation.y;
+            comfort.peak_angular_velocity = std::max(comfort.peak_angular_velocity, std::sqrt(yaw * yaw + pitch * pitch) / dt);
+
+            const double v[3] = {d[0] / dt, d[1] / dt, d[2] / dt};
+            if (has_velocity)
+            {
+                const double a[3] = {(v[0] - velocity[0]) / dt, (v[1] - velocity[1]) / dt, (v[2] - velocity[2]) / dt};
+                comfort.peak_acceleration = std::max(comfort.peak_acceleration, std::sqrt(a[0] * a[0] + a[1] * a[1] + a[2] * a[2]));
+            }
+            std::copy(std::begin(v), std::end(v), velocity);
+            has_velocity = true;
+            previous = current;
+        }
+
+        comfort.duration = static_cast<double>(sequence->GetDuration()) / 1000000.0;
+        comfort.valid = true;
+        return comfort;
+    }
+
+    /**
+     * @brief Scores a set of transitions with candidate settings, on the calling thread.
+     * @return The summed score, or infinity if any of them cannot be built.
+     */
+    double ScoreTransitions(uint32_t transitions, const AppSettings &settings, const Animation::CurrentCameraState &driver, const Weights &weights)
+    {
+        const Animation::FactoryContext context = {&settings, false};
+        const Animation::FactoryContextScope scope(context);
+
+        double score = 0.0;
+        for (size_t i = 0; i < TRANSITION_COUNT; ++i)
+        {
+            if (transitions & (1u << i))
+            {
+                const Comfort comfort = Measure(TRANSITIONS[i], settings, driver);
+                if (!comfort.valid)
+                {
+                    return HUGE_VAL;
+                }
+                score += comfort.Score(weights);
+            }
+        }
+        return score;
+    }
+
+    // =================================================================================================
+    // Swept Settings
+    // =================================================================================================
+
+    struct Parameter
+    {
+        std::string key;       // Key path below "settings.", as in the settings manifest.
+        size_t offset;         // Of the field in AppSettings.
+        bool is_duration;      // An int32_t duration in ms; otherwise a float.
+        uint32_t transitions;  // The transitions whose score the field changes.
+    };
+
+    double GetValue(const AppSettings &settings, const Parameter &p)
+    {
+        const char *field = reinterpret_cast<const char *>(&settings) + p.offset;
+        return p.is_duration ? static_cast<double>(*reinterpret_cast<const int32_t *>(field)) : static_cast<double>(*reinterpret_cast<const float *>(field));
+    }
+
+    void SetValue(AppSettings &settings, const Parameter &p, double value)
+    {
+        char *field = reinterpret_cast<char *>(&settings) + p.offset;
+        if (p.is_duration)
+        {
+            *reinterpret_cast<int32_t *>(field) = static_cast<int32_t>(std::lround(value));
+        }
+        else
+        {
+            *reinterpret_cast<float *>(field) = static_cast<float>(value);
+        }
+    }
+
+#define CW_DURATION(name, field, affected) {"animation_durations." name, offsetof(AppSettings, animation_durations.field), true, affected}
+
+    std::vector<Parameter> MakeParameters()
+    {
+        std::vector<Parameter> parameters = {
+            CW_DURATION("main_animation_speed.driver_to_passenger", main_animation_speed.driver_to_passenger, TransitionBit("DriverToPassenger")),
+            CW_DURATION("main_animation_speed.passenger_to_driver", main_animation_speed.passenger_to_driver, TransitionBit("PassengerToDriver")),
+            CW_DURATION("main_animation_speed.driver_to_standing", main_animation_speed.driver_to_standing, TransitionBit("DriverToStanding")),
+            CW_DURATION("main_animation_speed.standing_to_driver", main_animation_speed.standing_to_driver, TransitionBit("StandingToDriver")),
+            CW_DURATION("main_animation_speed.passenger_to_standing", main_animation_speed.passenger_to_standing, TransitionBit("PassengerToStanding")),
+            CW_DURATION("main_animation_speed.standing_to_passenger", main_animation_speed.standing_to_passenger, TransitionBit("StandingToPassenger")),
+            CW_DURATION("main_animation_speed.standing_to_sofa", main_animation_speed.standing_to_sofa, TransitionBit("StandingToSofa")),
+            CW_DURATION("main_animation_speed.sofa_to_standing", main_animation_speed.sofa_to_standing, TransitionBit("SofaToStanding")),
+            CW_DURATION("sofa_animation_speed.sofa_sit1_to_lie", sofa_animation_speed.sofa_sit1_to_lie, TransitionBit("SofaSit1ToLie")),
+            CW_DURATION("sofa_animation_speed.sofa_lie_to_sit2", sofa_animation_speed.sofa_lie_to_sit2, TransitionBit("SofaLieToSit2")),
+            CW_DURATION("sofa_animation_speed.sofa_sit2_to_sit1", sofa_animation_speed.sofa_sit2_to_sit1, TransitionBit("SofaSit2ToSit1") | TransitionBit("SofaSit1ToSit2")),
+            CW_DURATION("sofa_animation_speed.sofa_lie_to_sit1_shortcut", sofa_animation_speed.sofa_lie_to_sit1_shortcut, TransitionBit("SofaLieToSofa1")),
+            {"general.height", offsetof(AppSettings, general.height), false, ALL_TRANSITIONS},
+        };
+
+        static const AppSettings layout = {};
+        for (size_t spot = static_cast<size_t>(Spot::Passenger); spot < static_cast<size_t>(Spot::Count); ++spot)
+        {
+            const size_t base = reinterpret_cast<const char *>(&GetSpotSetting(layout, static_cast<Spot>(spot)).position) -
+                                reinterpret_cast<const char *>(&layout);
+            const char *axes[] = {"x", "y", "z"};
+            for (size_t axis = 0; axis < 3; ++axis)
+            {
+                parameters.push_back({std::string("positions.") + SPOT_KEYS[spot] + ".position." + axes[axis], base + axis * sizeof(float), false,
+                                      TransitionsTouching(static_cast<Spot>(spot))});
+            }
+        }
+        return parameters;
+    }
+
+#undef CW_DURATION
+
+    std::vector<double> MakeCandidates(const Parameter &p, double current, double position_radius)
+    {
+        std::vector<double> candidates;
+        if (p.is_duration)
+        {
+            for (double factor : DURATION_FACTORS)
+            {
+                candidates.push_back(std::clamp(std::round(current * factor), static_cast<double>(MIN_DURATION_MS), static_cast<double>(MAX_DURATION_MS)));
+            }
+        }
+        else if (p.key == "general.height")
+        {
+            for (int i = -HEIGHT_STEPS; i <= HEIGHT_STEPS; ++i)
+            {
+                candidates.push_back(std::clamp(current + i * HEIGHT_STEP, 0.0, 1.0));
+            }
+        }
+        else
+        {
+            for (int i = -POSITION_STEPS; i <= POSITION_STEPS; ++i)
+            {
+                candidates.push_back(current + position_radius * i / POSITION_STEPS);
+            }
+        }
+        candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+        return candidates;
+    }
+
+    // =================================================================================================
+    // Output
+    // =================================================================================================
+
+    // A key path tree, so the output nests as the settings manifest does.
+    struct JsonNode
+    {
+        std::map<std::string, JsonNode> children;
+        std::string value;
+    };
+
+    void WriteNode(FILE *file, const JsonNode &node, int indent)
+    {
+        if (node.children.empty())
+        {
+            std::fputs(node.value.c_str(), file);
+            return;
+        }
+        std::fputs("{\n", file);
+        size_t i = 0;
+        for (const auto &[name, child] : node.children)
+        {
+            std::fprintf(file, "%*s\"%s\": ", indent + 2, "", name.c_str());
+            WriteNode(file, child, indent + 2);
+            std::fputs(++i < node.children.size() ? ",\n" : "\n", file);
+        }
+        std::fprintf(file, "%*s}", indent, "");
+    }
+
+    bool WriteSettings(const char *path, const std::vector<Parameter> &parameters, const AppSettings &settings)
+    {
+        JsonNode root;
+        for (const Parameter &p : parameters)
+        {
+            JsonNode *node = &root.children["settings"];
+            size_t begin = 0;
+            while (begin <= p.key.size())
+            {
+                const size_t end = std::min(p.key.find('.', begin), p.key.size());
+                node = &node->children[p.key.substr(begin, end - begin)];
+                begin = end + 1;
+            }
+            char text[32];
+            const double value = GetValue(settings, p);
+            p.is_duration ? std::snprintf(text, sizeof(text), "%d", static_cast<int>(value)) : std::snprintf(text, sizeof(text), "%.4f", value);
+            node->value = text;
+        }
+
+        FILE *file = std::fopen(path, "w");
+        if (!file)
+        {
+            return false;
+        }
+        WriteNode(file, root, 0);
+        std::fputs("\n", file);
+        return std::fclose(file) == 0;
+    }
+
+    void PrintComfort(const AppSettings &settings, const Animation::CurrentCameraState &driver, const Weights &weights)
+    {
+        const Animation::FactoryContext context = {&settings, false};
+        const Animation::FactoryContextScope scope(context);
+
+        std::printf("  %-22s %9s %9s %8s %7s %8s\n", "transition", "rad/s", "m/s^2", "path m", "time s", "score");
+        for (const SweptTransition &transition : TRANSITIONS)
+        {
+            const Comfort c = Measure(transition, settings, driver);
+            std::printf("  %-22s %9.3f %9.3f %8.3f %7.2f %8.3f\n", transition.name, c.peak_angular_velocity, c.peak_acceleration, c.path_length,
+                        c.duration, c.Score(weights));
+        }
+    }
+
+    bool ParseList(const char *text, double *values, size_t count)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            char *end = nullptr;
+            values[i] = std::strtod(text, &end);
+            if (end == text || (i + 1 < count && *end != ','))
+            {
+                return false;
+            }
+            text = end + 1;
+        }
+        return true;
+    }
+} // namespace
+
+int main(int argc, char **argv)
+{
+    const char *out_path = "cabinwalk_tuned_settings.json";
+    unsigned thread_count = std::thread::hardware_concurrency();
+    double position_radius = DEFAULT_POSITION_RADIUS;
+    Weights weights;
+    Animation::CurrentCameraState driver = {};
+    std::vector<std::pair<std::string, double>> overrides;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const bool has_value = i + 1 < argc;
+        double list[5];
+        if (std::strcmp(argv[i], "--out") == 0 && has_value)
+        {
+            out_path = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--threads") == 0 && has_value)
+        {
+            thread_count = static_cast<unsigned>(std::atoi(argv[++i]));
+        }
+        else if (std::strcmp(argv[i], "--position-radius") == 0 && has_value)
+        {
+            position_radius = std::atof(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--weights") == 0 && has_value && ParseList(argv[++i], list, 4))
+        {
+            weights = {list[0], list[1], list[2], list[3]};
+        }
+        else if (std::strcmp(argv[i], "--driver") == 0 && has_value && ParseList(argv[++i], list, 5))
+        {
+            driver = {{static_cast<float>(list[0]), static_cast<float>(list[1]), static_cast<float>(list[2])},
+                      {static_cast<float>(list[3]), static_cast<float>(list[4]), 0.0f}};
+        }
+        else if (std::strcmp(argv[i], "--set") == 0 && has_value && std::strchr(argv[i + 1], '='))
+        {
+            const std::string assignment = argv[++i];
+            const size_t equals = assignment.find('=');
+            overrides.emplace_back(assignment.substr(0, equals), std::atof(assignment.c_str() + equals + 1));
+        }
+        else
+        {
+            std::printf("Usage: %s [--out <file>] [--threads <n>] [--weights <ang,acc,path,time>] [--driver <x,y,z,yaw,pitch>]\n"
+                        "       [--position-radius <m>] [--set <key>=<value>]...\n",
+                        argv[0]);
+            return 1;
+        }
+    }
+
+    static SPF_Camera_API camera_api = Tools::MakeStubCameraAPI();
+    g_ctx.cameraAPI = &camera_api;
+    AppSettings best;
+    Tools::ApplyDefaultSettings(best);
+
+    const std::vector<Parameter> parameters = MakeParameters();
+    for (const auto &[key, value] : overrides)
+    {
+        const std::string path = key.rfind("settings.", 0) == 0 ? key.substr(std::strlen("settings.")) : key;
+        const auto it = std::find_if(parameters.begin(), parameters.end(), [&](const Parameter &p) { return p.key == path; });
+        if (it == parameters.end())
+        {
+            std::printf("%s is not a swept setting\n", key.c_str());
+            return 1;
+        }
+        SetValue(best, *it, value);
+    }
+
+    WorkStealingPool pool(thread_count);
+    std::printf("Sweeping %zu settings on %zu threads\n\nBefore:\n", parameters.size(), pool.GetWorkerCount());
+    PrintComfort(best, driver, weights);
+    const double score_before = ScoreTransitions(ALL_TRANSITIONS, best, driver, weights);
+
+    size_t evaluations = 0;
+    for (const Parameter &p : parameters)
+    {
+        if (!p.is_duration && p.key != "general.height" && position_radius <= 0.0)
+        {
+            continue;
+        }
+
+        const double current = GetValue(best, p);
+        const std::vector<double> candidates = MakeCandidates(p, current, position_radius);
+        std::vector<double> scores(candidates.size(), HUGE_VAL);
+        std::vector<std::function<void()>> jobs;
+        for (size_t i = 0; i < candidates.size(); ++i)
+        {
+            jobs.push_back([&, i] {
+                AppSettings candidate = best;
+                SetValue(candidate, p, candidates[i]);
+                scores[i] = ScoreTransitions(p.transitions, candidate, driver, weights);
+            });
+        }
+        pool.Run(jobs);
+        evaluations += candidates.size();
+
+        // Ties keep the current value, so a setting the score does not feel is left alone.
+        size_t chosen = std::find(candidates.begin(), candidates.end(), current) - candidates.begin();
+        double chosen_score = chosen < candidates.size() ? scores[chosen] : HUGE_VAL;
+        for (size_t i = 0; i < candidates.size(); ++i)
+        {
+            if (scores[i] < chosen_score - 1e-9)
+            {
+                chosen = i;
+                chosen_score = scores[i];
+            }
+        }
+        if (chosen < candidates.size() && candidates[chosen] != current)
+        {
+            SetValue(best, p, candidates[chosen]);
+            std::printf("  %-64s %10.4f -> %10.4f\n", p.key.c_str(), current, candidates[chosen]);
+        }
+    }
+
+    std::printf("\nAfter (%zu candidates):\n", evaluations);
+    PrintComfort(best, driver, weights);
+    const double score_after = ScoreTransitions(ALL_TRANSITIONS, best, driver, weights);
+    std::printf("\nTotal score %.3f -> %.3f\n", score_before, score_after);
+
+    if (!WriteSettings(out_path, parameters, best))
+    {
+        std::printf("Cannot write %s\n", out_path);
+        return 1;
+    }
+    std::printf("Wrote %s\n", out_path);
+    return 0;
+}
@@ -0,0 +1,108 @@
+#include "UI/UIResources.hpp"
+#include "SPF_CabinWalk.hpp" // For g_ctx
+
+namespace SPF_CabinWalk::UIResources
+{
+    // =================================================================================================
+    // Internal State
+    // =================================================================================================
+
+    // Warning window geometry.
+    constexpr float WARNING_WINDOW_W = 400.0f; // The width from the manifest.
+    constexpr float WARNING_WINDOW_H = 100.0f;
+    constexpr float WARNING_OFFSET_FROM_BOTTOM = 100.0f;
+
+    static SPF_UI_API *g_ui = nullptr;
+    static SPF_TextStyle_Handle g_warning_style = nullptr;
+    static SPF_Localization_Handle *g_localization = nullptr;
+
+    static char g_warning_message[512] = {};
+    static bool g_text_valid = false;
+
+    // Viewport the layout was computed for; negative until the first layout.
+    static float g_layout_viewport_w = -1.0f;
+    static float g_layout_viewport_h = -1.0f;
+
+    // =================================================================================================
+    // Public Functions
+    // =================================================================================================
+
+    void Initialize(SPF_UI_API *ui, const char *plugin_name)
+    {
+        Shutdown();
+        if (g_ctx.loadAPI && g_ctx.loadAPI->localization && plugin_name)
+        {
+            g_localization = g_ctx.loadAPI->localization->Loc_GetContext(plugin_name);
+        }
+
+        g_ui = ui;
+        if (!g_ui)
+        {
+            return;
+        }
+
+        g_warning_style = g_ui->UI_Style_Create();
+        if (g_warning_style)
+        {
+            g_ui->UI_Style_SetFont(g_warning_style, SPF_FONT_H1);             // Make it a header
+            g_ui->UI_Style_SetAlign(g_warning_style, SPF_TEXT_ALIGN_CENTER);  // Center it
+            g_ui->UI_Style_SetColor(g_warning_style, 1.0f, 0.0f, 0.0f, 1.0f); // Keep it red
+        }
+
+        // A new UI instance has not seen our window configuration yet.
+        g_layout_viewport_w = -1.0f;
+        g_layout_viewport_h = -1.0f;
+    }
+
+    void Shutdown()
+    {
+        if (g_ui && g_warning_style)
+        {
+            g_ui->UI_Style_Destroy(g_warning_style);
+        }
+        g_warning_style = nullptr;
+        g_ui = nullptr;
+        g_localization = nullptr;
+        g_text_valid = false;
+    }
+
+    void InvalidateText()
+    {
+        g_text_valid = false;
+    }
+
+    SPF_TextStyle_Handle GetWarningStyle()
+    {
+        return g_warning_style;
+    }
+
+    const char *GetWarningMessage()
+    {
+        if (!g_text_valid && g_localization && g_ctx.loadAPI && g_ctx.loadAPI->localization)
+        {
+            g_ctx.loadAPI->localization->Loc_GetString(g_localization, "messages.warning_not_safe_to_move",
+                                                       g_warning_message, sizeof(g_warning_message));
+            g_text_valid = true;
+        }
+        return g_warning_message;
+    }
+
+    bool UpdateWarningLayout(float viewport_w, float viewport_h, WarningLayout *layout)
+    {
+        if (viewport_w == g_layout_viewport_w && viewport_h == g_layout_viewport_h)
+        {
+            return false;
+        }
+
+        g_layout_viewport_w = viewport_w;
+        g_layout_viewport_h = viewport_h;
+
+        // Centered horizontally, a fixed distance above the bottom edge.
+        layout->pos_x = static_cast<int>((viewport_w / 2.0f) - (WARNING_WINDOW_W / 2.0f));
+        layout->pos_y = static_cast<int>(viewport_h - WARNING_WINDOW_H - WARNING_OFFSET_FROM_BOTTOM);
+        layout->size_w = static_cast<int>(WARNING_WINDOW_W);
+        layout->size_h = static_cast<int>(WARNING_WINDOW_H);
+        return true;
+    }
+
+} // namespace SPF_CabinWalk::UIResources
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <SPF_UI_API.h> // For SPF_UI_API, SPF_TextStyle_Handle
+
+namespace SPF_CabinWalk::UIResources
+{
+    /**
+     * @brief Where the warning window goes for a given viewport.
+     */
+    struct WarningLayout
+    {
+        int pos_x;
+        int pos_y;
+        int size_w;
+        int size_h;
+    };
+
+    /**
+     * @brief Creates the retained styles and looks up the localization context. Called from OnRegisterUI.
+     * @details Any styles created for a previous UI API are released first.
+     * @param ui The UI API the styles belong to.
+     * @param plugin_name The plugin name, for the localization context.
+     */
+    void Initialize(SPF_UI_API *ui, const char *plugin_name);
+
+    /**
+     * @brief Releases every retained style. Called from OnUnload, while the UI API is still valid.
+     */
+    void Shutdown();
+
+    /**
+     * @brief Drops the cached localized text, so it is fetched again in the new language on next use.
+     */
+    void InvalidateText();
+
+    /**
+     * @brief Gets the red, centered header style of the warning message.
+     * @return The style, or nullptr if it could not be created.
+     */
+    SPF_TextStyle_Handle GetWarningStyle();
+
+    /**
+     * @brief Gets the localized "not safe to move" message, fetched once per language.
+     */
+    const char *GetWarningMessage();
+
+    /**
+     * @brief Recomputes the warning window layout if the viewport size changed.
+     * @param viewport_w The current viewport width.
+     * @param viewport_h The current viewport height.
+     * @param[out] layout Receives the new layout when the function returns true.
+     * @return True if the layout changed and must be written to the window configuration.
+     */
+    bool UpdateWarningLayout(float viewport_w, float viewport_h, WarningLayout *layout);
+
+} // namespace SPF_CabinWalk::UIResources